@@ -0,0 +1,358 @@
+#include "funexp.h"
+#include "interval.h"
+#include "taylormodel.h"
+#include "transformations.h"
+#include "variables.h"
+#include <assert.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Microbenchmarks of the hot expression transformations and interval
+  kernels, over generated polynomials of controllable size and degree.
+
+  Every case first runs untimed warm-up samples, which also calibrate the
+  number of calls per sample such that a sample takes at least
+  MIN_SAMPLE_SECONDS. Then the timed samples run, and their time per call
+  is summarized by its median, 95th percentile, minimum and mean. The
+  results are printed as JSON, so they can be compared across commits. */
+
+#define MIN_SAMPLE_SECONDS 1e-3
+
+/* The number of intervals the interval kernels run over per call. */
+#define INTERVAL_BATCH 1024
+
+/* The size of the generated polynomials, and of the measurements. */
+typedef struct BenchSettings {
+  unsigned int vars;
+  unsigned int terms;
+  unsigned int degree;
+  unsigned int warmup;
+  unsigned int runs;
+  uint64_t seed;
+} BenchSettings;
+
+/* The inputs shared by all cases. */
+typedef struct BenchInputs {
+  ExpTree *poly;
+  ExpTree *product;
+  ExpTree *expanded;
+  ExpTree *target;
+  Domain *domains;
+  Valuation *values;
+  unsigned int degree;
+  Interval intervals[INTERVAL_BATCH];
+  Interval results[INTERVAL_BATCH];
+} BenchInputs;
+
+/* A benchmark case: one call of its body. */
+typedef void (*BenchBody)(BenchInputs *inputs);
+
+typedef struct BenchCase {
+  const char *name;
+  BenchBody body;
+  /* The number of operations per call, to report the time per operation. */
+  unsigned int ops;
+} BenchCase;
+
+/* A small, seeded generator, so the inputs are the same across runs. */
+static uint64_t nextRandom(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static double nextUniform(uint64_t *state) {
+  return (double)(nextRandom(state) >> 11) / (double)((uint64_t)1 << 53);
+}
+
+static void varName(char *str, const size_t size, const unsigned int index) {
+  snprintf(str, size, "x%u", index);
+}
+
+/* A polynomial of the given number of terms, each a random coefficient
+  times a random monomial of degree at most degree, as the parser builds
+  it. */
+static ExpTree *newRandomPolynomial(const BenchSettings *settings,
+                                    const unsigned int terms,
+                                    uint64_t *state) {
+  ExpTree *sum = NULL;
+  char str[50];
+  for (unsigned int term = 0; term < terms; ++term) {
+    const double coefficient = 2 * nextUniform(state) - 1;
+    snprintf(str, sizeof(str), "%.3f", coefficient < 0 ? -coefficient
+                                                       : coefficient);
+    ExpTree *monomial = newExpLeaf(EXP_NUM, str);
+
+    unsigned int degree = nextRandom(state) % (settings->degree + 1);
+    while (degree > 0) {
+      const unsigned int exponent = 1 + nextRandom(state) % degree;
+      varName(str, sizeof(str), nextRandom(state) % settings->vars);
+      ExpTree *factor = newExpLeaf(EXP_VAR, str);
+      if (exponent > 1) {
+        snprintf(str, sizeof(str), "%u", exponent);
+        factor = newExpOp(EXP_EXP_OP, factor, newExpLeaf(EXP_NUM, str));
+      }
+      monomial = newExpOp(EXP_MUL_OP, monomial, factor);
+      degree -= exponent;
+    }
+
+    if (sum == NULL)
+      sum = (coefficient < 0) ? newExpOp(EXP_NEG, monomial, NULL) : monomial;
+    else
+      sum = newExpOp((coefficient < 0) ? EXP_SUB_OP : EXP_ADD_OP, sum,
+                     monomial);
+  }
+  return sum;
+}
+
+static unsigned int countNodes(const ExpTree *tree) {
+  if (tree == NULL)
+    return 0;
+  return 1 + countNodes(tree->left) + countNodes(tree->right);
+}
+
+static double wallTime(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + 1e-9 * (double)now.tv_nsec;
+}
+
+static void benchToSumOfProducts(BenchInputs *inputs) {
+  delExpTree(toSumOfProducts(inputs->product));
+}
+
+static void benchTruncate2(BenchInputs *inputs) {
+  ExpTree *collected = NULL;
+  delExpTree(truncate2(inputs->expanded, inputs->degree / 2, &collected));
+  if (collected != NULL)
+    delExpTree(collected);
+}
+
+static void benchSimplifyOperators(BenchInputs *inputs) {
+  delExpTree(simplifyOperators(inputs->poly));
+}
+
+static void benchSubstitute(BenchInputs *inputs) {
+  delExpTree(substitute(inputs->poly, "x0", inputs->target));
+}
+
+static void benchDerivative(BenchInputs *inputs) {
+  delExpTree(derivative(inputs->poly, "x0"));
+}
+
+static void benchEvaluateExpTree(BenchInputs *inputs) {
+  inputs->results[0] = evaluateExpTree(inputs->poly, inputs->domains);
+}
+
+static void benchEvaluateExpTreeReal(BenchInputs *inputs) {
+  inputs->results[0].left =
+      evaluateExpTreeReal(inputs->poly, inputs->values);
+}
+
+static void benchMulInterval(BenchInputs *inputs) {
+  for (unsigned int it = 0; it + 1 < INTERVAL_BATCH; ++it)
+    inputs->results[it] =
+        mulInterval(&inputs->intervals[it], &inputs->intervals[it + 1]);
+}
+
+static void benchPow2Interval(BenchInputs *inputs) {
+  for (unsigned int it = 0; it < INTERVAL_BATCH; ++it)
+    inputs->results[it] = pow2Interval(&inputs->intervals[it], 3);
+}
+
+static const BenchCase CASES[] = {
+    {"toSumOfProducts", benchToSumOfProducts, 1},
+    {"truncate2", benchTruncate2, 1},
+    {"simplifyOperators", benchSimplifyOperators, 1},
+    {"substitute", benchSubstitute, 1},
+    {"derivative", benchDerivative, 1},
+    {"evaluateExpTree", benchEvaluateExpTree, 1},
+    {"evaluateExpTreeReal", benchEvaluateExpTreeReal, 1},
+    {"mulInterval", benchMulInterval, INTERVAL_BATCH - 1},
+    {"pow2Interval", benchPow2Interval, INTERVAL_BATCH},
+};
+
+#define NUM_CASES (sizeof(CASES) / sizeof(CASES[0]))
+
+static int compareDoubles(const void *left, const void *right) {
+  const double first = *(const double *)left;
+  const double second = *(const double *)right;
+  return (first > second) - (first < second);
+}
+
+/* Run one sample of the given number of calls, and return its time per
+  operation in nanoseconds. */
+static double runSample(const BenchCase *bench, BenchInputs *inputs,
+                        const unsigned int calls) {
+  const double start = wallTime();
+  for (unsigned int it = 0; it < calls; ++it)
+    bench->body(inputs);
+  return 1e9 * (wallTime() - start) / ((double)calls * bench->ops);
+}
+
+static void runCase(const BenchCase *bench, BenchInputs *inputs,
+                    const BenchSettings *settings, const bool last) {
+  /* Warm up, and double the calls per sample until a sample is long
+    enough to time. */
+  unsigned int calls = 1;
+  for (unsigned int it = 0; it < settings->warmup || it == 0; ++it) {
+    while (runSample(bench, inputs, calls) * calls * bench->ops <
+           1e9 * MIN_SAMPLE_SECONDS)
+      calls *= 2;
+  }
+
+  double *samples = (double *)malloc(settings->runs * sizeof(double));
+  if (samples == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  double mean = 0;
+  for (unsigned int it = 0; it < settings->runs; ++it) {
+    samples[it] = runSample(bench, inputs, calls);
+    mean += samples[it] / settings->runs;
+  }
+  qsort(samples, settings->runs, sizeof(double), compareDoubles);
+
+  const unsigned int n = settings->runs;
+  const double median = (n % 2 == 1)
+                            ? samples[n / 2]
+                            : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+  /* The nearest rank percentile */
+  const unsigned int rank = (95 * n + 99) / 100;
+  printf("    {\"name\": \"%s\", \"calls_per_sample\": %u, "
+         "\"ops_per_call\": %u, \"median_ns\": %.3f, \"p95_ns\": %.3f, "
+         "\"min_ns\": %.3f, \"mean_ns\": %.3f}%s\n",
+         bench->name, calls, bench->ops, median, samples[rank - 1],
+         samples[0], mean, last ? "" : ",");
+  fflush(stdout);
+
+  /* Clean */
+  free(samples);
+}
+
+static void usage(const char *program) {
+  fprintf(stderr,
+          "Usage: %s [-v vars] [-t terms] [-d degree] [-w warmup] "
+          "[-r runs] [-s seed] [case ...]\n"
+          "  -v  number of variables of the polynomials (default 3)\n"
+          "  -t  number of terms of the polynomials (default 20)\n"
+          "  -d  maximum degree of the terms (default 4)\n"
+          "  -w  number of warm-up samples per case (default 3)\n"
+          "  -r  number of timed samples per case (default 25)\n"
+          "  -s  seed of the generated inputs (default 1)\n"
+          "Without cases, all of them run.\n",
+          program);
+}
+
+int main(int argc, char *argv[]) {
+  BenchSettings settings = {3, 20, 4, 3, 25, 1};
+
+  int opt;
+  while ((opt = getopt(argc, argv, "v:t:d:w:r:s:")) != -1) {
+    switch (opt) {
+    case 'v':
+      settings.vars = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 't':
+      settings.terms = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 'd':
+      settings.degree = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 'w':
+      settings.warmup = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 'r':
+      settings.runs = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 's':
+      settings.seed = strtoull(optarg, NULL, 10);
+      break;
+    default:
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (settings.vars == 0 || settings.terms == 0 || settings.runs == 0 ||
+      settings.seed == 0) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  /* Generate the inputs. The product is expanded by toSumOfProducts, and
+    its expansion is truncated by truncate2. */
+  uint64_t state = settings.seed;
+  BenchInputs *inputs = (BenchInputs *)malloc(sizeof(BenchInputs));
+  if (inputs == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  inputs->poly = newRandomPolynomial(&settings, settings.terms, &state);
+  ExpTree *factor = newRandomPolynomial(&settings, 4, &state);
+  inputs->product =
+      newExpOp(EXP_MUL_OP, cpyExpTree(inputs->poly), factor);
+  inputs->expanded = toSumOfProducts(inputs->product);
+  inputs->target = newExpOp(EXP_ADD_OP, newExpLeaf(EXP_VAR, "x1"),
+                            newExpLeaf(EXP_NUM, "1"));
+  inputs->degree = settings.degree;
+  inputs->domains = NULL;
+  inputs->values = NULL;
+  for (unsigned int it = settings.vars; it-- > 0;) {
+    char name[50];
+    varName(name, sizeof(name), it);
+    inputs->domains =
+        newDomainElem(inputs->domains, strdup(name), newInterval(-1, 1));
+    inputs->values = newValuationElem(inputs->values, strdup(name),
+                                      nextUniform(&state));
+  }
+  for (unsigned int it = 0; it < INTERVAL_BATCH; ++it) {
+    double left = 4 * nextUniform(&state) - 2;
+    inputs->intervals[it] =
+        newInterval(left, left + 2 * nextUniform(&state));
+  }
+
+  printf("{\n");
+  printf("  \"settings\": {\"vars\": %u, \"terms\": %u, \"degree\": %u, "
+         "\"warmup\": %u, \"runs\": %u, \"seed\": %llu},\n",
+         settings.vars, settings.terms, settings.degree, settings.warmup,
+         settings.runs, (unsigned long long)settings.seed);
+  printf("  \"nodes\": {\"poly\": %u, \"product\": %u, \"expanded\": %u},\n",
+         countNodes(inputs->poly), countNodes(inputs->product),
+         countNodes(inputs->expanded));
+  printf("  \"results\": [\n");
+
+  /* Run the selected cases, or all of them. */
+  int status = EXIT_SUCCESS;
+  const BenchCase *selected[NUM_CASES];
+  unsigned int count = 0;
+  for (unsigned int it = 0; it < NUM_CASES; ++it) {
+    bool found = optind == argc;
+    for (int arg = optind; arg < argc; ++arg)
+      found = found || strcmp(argv[arg], CASES[it].name) == 0;
+    if (found)
+      selected[count++] = &CASES[it];
+  }
+  if (count < (unsigned int)(argc - optind)) {
+    fprintf(stderr, "Unknown case among the arguments\n");
+    status = EXIT_FAILURE;
+  }
+  for (unsigned int it = 0; it < count; ++it)
+    runCase(selected[it], inputs, &settings, it + 1 == count);
+  printf("  ]\n}\n");
+
+  /* Clean */
+  delValuation(inputs->values);
+  delDomain(inputs->domains);
+  delExpTree(inputs->target);
+  delExpTree(inputs->expanded);
+  delExpTree(inputs->product);
+  delExpTree(inputs->poly);
+  free(inputs);
+
+  return status;
+}
@@ -0,0 +1,215 @@
+#include "funexp.h"
+#include "odeparse.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "tmflowpipe.h"
+#include "variables.h"
+#include "varparse.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+/* Benchmark the Taylor model pipeline on reference nonlinear systems.
+
+  Every model runs at each order of ORDERS. The symbolic Taylor expansion,
+  see computeTaylorPolynomial, does not depend on the initial set, so it runs
+  once per order. The TM arithmetic, see picardIterationTM, runs once per
+  order and initial set width of WIDTHS, over a box centered at the model's
+  initial state.
+
+  The results are printed as CSV, one row per run:
+
+    model,dim,order,width,phase,seconds,peak_rss_kb,nodes
+
+  where seconds is the wall time of the run, peak_rss_kb the peak resident
+  set size of the process so far and nodes the total size of the output
+  expression trees. Usage: models_bench [model [N]], where N is the number
+  of oscillators of the coupled oscillator model. Without arguments, all
+  the models run. */
+
+#define TIME_HORIZON 0.01
+
+static const unsigned int ORDERS[] = {2, 4, 6};
+static const double WIDTHS[] = {0.01, 0.1, 0.5};
+
+/* A reference model: its vector field and its initial state, as point
+  intervals. */
+typedef struct BenchModel {
+  const char *name;
+  const char *odes;
+  const char *initial;
+} BenchModel;
+
+static const BenchModel MODELS[] = {
+    {"vanderpol", "x' = y; y' = (1 - x^2) * y - x;",
+     "x in [1.25, 1.25]; y in [2.3, 2.3];"},
+    {"lorenz",
+     "x' = 10 * (y - x); y' = x * (28 - z) - y; z' = x * y - 8 / 3 * z;",
+     "x in [1, 1]; y in [1, 1]; z in [1, 1];"},
+    {"brusselator", "x' = 1 + x^2 * y - 2.5 * x; y' = 1.5 * x - x^2 * y;",
+     "x in [0.9, 0.9]; y in [0.1, 0.1];"},
+    {"rossler", "x' = -y - z; y' = x + 0.2 * y; z' = 0.2 + z * (x - 5.7);",
+     "x in [1, 1]; y in [1, 1]; z in [0.1, 0.1];"},
+    {"lotkavolterra", "x' = 1.5 * x - x * y; y' = x * y - 3 * y;",
+     "x in [4.8, 4.8]; y in [1.2, 1.2];"},
+    /* A planar arm under gravity, with PD control of both joints and a
+      constant, diagonal inertia. */
+    {"robotarm",
+     "p' = v; q' = w;"
+     "v' = -2 * v - 4 * (p - 0.5) - 9.81 * cos(p);"
+     "w' = -2 * w - 4 * (q - 0.3) - 4.9 * cos(p + q);",
+     "p in [0, 0]; q in [0, 0]; v in [0, 0]; w in [0, 0];"},
+};
+
+#define NUM_MODELS (sizeof(MODELS) / sizeof(MODELS[0]))
+
+/* The default number of coupled oscillators. */
+#define OSCILLATORS 4
+
+static double wallTime(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + 1e-9 * (double)now.tv_nsec;
+}
+
+static long peakRss(void) {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+static unsigned int countNodes(const ExpTree *tree) {
+  if (tree == NULL)
+    return 0;
+  return 1 + countNodes(tree->left) + countNodes(tree->right);
+}
+
+static unsigned int countModelNodes(const TaylorModel *list) {
+  unsigned int nodes = 0;
+  for (; list != NULL; list = list->next)
+    nodes += countNodes(list->exp);
+  return nodes;
+}
+
+static void printRow(const BenchModel *model, const unsigned int dim,
+                     const unsigned int order, const double width,
+                     const char *phase, const double seconds,
+                     const unsigned int nodes) {
+  printf("%s,%u,%u,", model->name, dim, order);
+  if (width > 0)
+    printf("%g", width);
+  printf(",%s,%.6f,%ld,%u\n", phase, seconds, peakRss(), nodes);
+  fflush(stdout);
+}
+
+/* The initial box of the given width around the initial state, over the
+  time horizon. */
+static Domain *initialBox(const Domain *initial, const double width) {
+  Domain *box = cpyDomain(initial);
+  for (Domain *it = box; it != NULL; it = it->next)
+    it->domain = newInterval(it->domain.left - width / 2,
+                             it->domain.right + width / 2);
+  return newDomainElem(box, strdup(VAR_TIME), newInterval(0, TIME_HORIZON));
+}
+
+static void runModel(const BenchModel *model) {
+  ODEList *system;
+  Domain *initial;
+  int code = parseOdeString(model->odes, &system);
+  assert(code == 0);
+  code = parseVarString(model->initial, &initial);
+  assert(code == 0);
+  const unsigned int dim = lengthOdeList(system);
+
+  for (unsigned int it = 0; it < sizeof(ORDERS) / sizeof(ORDERS[0]); ++it) {
+    const unsigned int order = ORDERS[it];
+
+    double start = wallTime();
+    TaylorModel *polynomials = computeTaylorPolynomial(system, order, order);
+    printRow(model, dim, order, 0, "taylor", wallTime() - start,
+             countModelNodes(polynomials));
+    delTaylorModel(polynomials);
+
+    for (unsigned int w = 0; w < sizeof(WIDTHS) / sizeof(WIDTHS[0]); ++w) {
+      Domain *box = initialBox(initial, WIDTHS[w]);
+      TaylorModel *seed = initTaylorModel(system);
+
+      start = wallTime();
+      TaylorModel *flowpipe =
+          picardIterationTM(system, seed, box, order, order + 2, NULL);
+      printRow(model, dim, order, WIDTHS[w], "tm", wallTime() - start,
+               countModelNodes(flowpipe));
+
+      /* Clean */
+      delTaylorModel(flowpipe);
+      delTaylorModel(seed);
+      delDomain(box);
+    }
+  }
+
+  /* Clean */
+  delDomain(initial);
+  delOdeList(system);
+}
+
+/* A chain of n Duffing oscillators with diffusive coupling, of dimension
+  2n. */
+static void runOscillators(const unsigned int n) {
+  const size_t size = 160 * (size_t)n + 1;
+  char *odes = (char *)malloc(size);
+  char *initial = (char *)malloc(size);
+  if (odes == NULL || initial == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  size_t odesLength = 0, initialLength = 0;
+  for (unsigned int i = 1; i <= n; ++i) {
+    odesLength += snprintf(odes + odesLength, size - odesLength,
+                           "x%u' = v%u; v%u' = -x%u - x%u^3", i, i, i, i, i);
+    if (i > 1)
+      odesLength += snprintf(odes + odesLength, size - odesLength,
+                             " + 0.1 * (x%u - x%u)", i - 1, i);
+    if (i < n)
+      odesLength += snprintf(odes + odesLength, size - odesLength,
+                             " + 0.1 * (x%u - x%u)", i + 1, i);
+    odesLength += snprintf(odes + odesLength, size - odesLength, ";");
+    initialLength +=
+        snprintf(initial + initialLength, size - initialLength,
+                 "x%u in [%g, %g]; v%u in [0, 0];", i, 1.0 / i, 1.0 / i, i);
+  }
+
+  char name[50];
+  snprintf(name, sizeof(name), "oscillator%u", n);
+  const BenchModel model = {name, odes, initial};
+  runModel(&model);
+
+  /* Clean */
+  free(initial);
+  free(odes);
+}
+
+int main(int argc, char *argv[]) {
+  printf("model,dim,order,width,phase,seconds,peak_rss_kb,nodes\n");
+
+  bool found = false;
+  for (unsigned int it = 0; it < NUM_MODELS; ++it) {
+    if (argc < 2 || strcmp(argv[1], MODELS[it].name) == 0) {
+      runModel(&MODELS[it]);
+      found = true;
+    }
+  }
+  if (argc < 2 || strcmp(argv[1], "oscillator") == 0) {
+    runOscillators((argc > 2) ? (unsigned int)atoi(argv[2]) : OSCILLATORS);
+    found = true;
+  }
+
+  if (!found) {
+    fprintf(stderr, "Unknown model: %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
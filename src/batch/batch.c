@@ -0,0 +1,357 @@
+#include "batch.h"
+#include "intervalbox.h"
+#include "odeparse.h"
+#include "tmcache.h"
+#include "tmflowpipe.h"
+#include "varparse.h"
+#include <assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+BatchJob *newBatchJob(char *system, char *initial, const double horizon,
+                      char *output) {
+  assert(system != NULL);
+  assert(initial != NULL);
+  assert(output != NULL);
+
+  BatchJob *list = (BatchJob *)malloc(sizeof(BatchJob));
+  if (list == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  list->system = system;
+  list->initial = initial;
+  list->horizon = horizon;
+  list->output = output;
+  list->systemIndex = 0;
+  list->status = BATCH_PENDING;
+  list->next = NULL;
+  return list;
+}
+
+BatchJob *appBatchJobElem(BatchJob *tail, BatchJob *head) {
+  assert(head != NULL);
+  assert(head->next == NULL);
+
+  head->next = tail;
+  return head;
+}
+
+unsigned int lengthBatchJob(const BatchJob *list) {
+  unsigned int length = 0;
+  for (; list != NULL; list = list->next)
+    ++length;
+  return length;
+}
+
+void delBatchJob(BatchJob *list) {
+  while (list != NULL) {
+    BatchJob *next = list->next;
+    free(list->system);
+    free(list->initial);
+    free(list->output);
+    free(list);
+    list = next;
+  }
+}
+
+void printBatchJob(const BatchJob *list, FILE *where) {
+  static const char *const names[] = {"pending", "done", "invalid",
+                                      "output error"};
+  for (; list != NULL; list = list->next)
+    fprintf(where, "%s: %s\n", list->output, names[list->status]);
+}
+
+/* Strip leading and trailing whitespace in-place. */
+static char *trim(char *str) {
+  while (isspace((unsigned char)*str))
+    ++str;
+  char *end = str + strlen(str);
+  while (end > str && isspace((unsigned char)end[-1]))
+    --end;
+  *end = '\0';
+  return str;
+}
+
+int parseBatchJobs(FILE *input, BatchJob **jobs) {
+  assert(input != NULL);
+  assert(jobs != NULL);
+
+  /* Jobs that share an output would race on it. */
+  SymbolTable *outputs = newSymbolTable();
+  BatchJob *reversed = NULL;
+  char *line = NULL;
+  size_t capacity = 0;
+  unsigned int lineno = 0;
+  int rv = 0;
+  while (getline(&line, &capacity, input) != -1) {
+    ++lineno;
+    char *content = trim(line);
+    if (*content == '\0' || *content == '#')
+      continue;
+
+    /* system | initial set | horizon [| output] */
+    char *fields[4] = {NULL, NULL, NULL, NULL};
+    unsigned int count = 0;
+    for (char *field = content; field != NULL && count < 4; ++count) {
+      char *bar = strchr(field, '|');
+      if (bar != NULL)
+        *bar++ = '\0';
+      fields[count] = trim(field);
+      field = bar;
+    }
+
+    char *end = NULL;
+    double horizon = (count >= 3) ? strtod(fields[2], &end) : 0;
+    if (count < 3 || end == fields[2] || *end != '\0' || !(horizon >= 0)) {
+      fprintf(stderr, "[line %u] Error: expected 'system | initial set | "
+                      "horizon [| output]'\n",
+              lineno);
+      rv = 1;
+      break;
+    }
+
+    char *output;
+    if (count == 4 && *fields[3] != '\0') {
+      output = strdup(fields[3]);
+    } else {
+      char name[32];
+      snprintf(name, sizeof(name), "job%u.txt", lineno);
+      output = strdup(name);
+    }
+    if (findSymbol(outputs, output) != SYMBOL_NOT_FOUND) {
+      fprintf(stderr, "[line %u] Error: duplicate output '%s'\n", lineno,
+              output);
+      free(output);
+      rv = 1;
+      break;
+    }
+    internSymbol(outputs, output);
+
+    BatchJob *job =
+        newBatchJob(strdup(fields[0]), strdup(fields[1]), horizon, output);
+    reversed = appBatchJobElem(reversed, job);
+  }
+  free(line);
+  delSymbolTable(outputs);
+
+  /* The list was built back to front. */
+  BatchJob *ordered = NULL;
+  while (reversed != NULL) {
+    BatchJob *next = reversed->next;
+    reversed->next = NULL;
+    ordered = appBatchJobElem(ordered, reversed);
+    reversed = next;
+  }
+
+  if (rv != 0) {
+    delBatchJob(ordered);
+    ordered = NULL;
+  }
+  *jobs = ordered;
+  return rv;
+}
+
+/* The parsed form of a job. */
+typedef struct BatchWork {
+  BatchJob *job;
+  ODEList *system;
+  /* The structural hash of the system, see hashExpansionKey. */
+  uint64_t hash;
+  Domain *domain;
+} BatchWork;
+
+/* The state shared by all the jobs of one batch. */
+typedef struct BatchContext {
+  const BatchOptions *options;
+  ThreadPool *pool;
+  BatchWork *work;
+  /* The distinct systems, and their expansions. */
+  ODEList **systems;
+  TaylorExpansion **expansions;
+} BatchContext;
+
+/* Whether every variable of the expression has a domain. */
+static bool hasDomains(const ExpTree *exp, const Domain *domain) {
+  if (exp == NULL)
+    return true;
+  if (exp->type == EXP_VAR) {
+    while (domain != NULL && strcmp(domain->var, exp->data) != 0)
+      domain = domain->next;
+    return domain != NULL;
+  }
+  return hasDomains(exp->left, domain) && hasDomains(exp->right, domain);
+}
+
+/* Parse the initial set and fix the time domain to [0, horizon]. Returns
+  NULL if the initial set is invalid, or misses the domain of a variable. */
+static Domain *parseJobDomain(const BatchJob *job, const ODEList *system) {
+  Domain *domain = NULL;
+  if (parseVarString(job->initial, &domain) != 0)
+    return NULL;
+
+  Domain *time = domain;
+  while (time != NULL && strcmp(time->var, VAR_TIME) != 0)
+    time = time->next;
+  if (time != NULL)
+    time->domain = newInterval(0, job->horizon);
+  else
+    domain = newDomainElem(domain, strdup(VAR_TIME),
+                           newInterval(0, job->horizon));
+
+  /* Every state variable, and every free variable or parameter of the
+    vector field, needs a domain, else evaluation fails. */
+  for (; system != NULL; system = system->next) {
+    const Domain *dom = domain;
+    while (dom != NULL && strcmp(dom->var, system->fun) != 0)
+      dom = dom->next;
+    if (dom == NULL || !hasDomains(system->exp, domain)) {
+      delDomain(domain);
+      return NULL;
+    }
+  }
+  return domain;
+}
+
+/* Parse a job. Each call has its own parsers, so jobs parse in parallel. */
+static void runParse(unsigned int index, void *context) {
+  BatchContext *ctx = (BatchContext *)context;
+  BatchWork *work = &ctx->work[index];
+
+  /* The parser output is only meaningful on success. */
+  ODEList *system = NULL;
+  if (parseOdeString(work->job->system, &system) != 0 || system == NULL) {
+    work->job->status = BATCH_INVALID;
+    return;
+  }
+  work->domain = parseJobDomain(work->job, system);
+  if (work->domain == NULL) {
+    work->job->status = BATCH_INVALID;
+    delOdeList(system);
+    return;
+  }
+  work->system = system;
+  work->hash = hashExpansionKey(system, ctx->options->order, ctx->options->k);
+}
+
+static void runExpansion(unsigned int index, void *context) {
+  BatchContext *ctx = (BatchContext *)context;
+  ctx->expansions[index] =
+      newTaylorExpansion(ctx->systems[index], ctx->options->order,
+                         ctx->options->k, ctx->pool);
+}
+
+static void runJob(unsigned int index, void *context) {
+  BatchContext *ctx = (BatchContext *)context;
+  BatchWork *work = &ctx->work[index];
+  if (work->job->status != BATCH_PENDING)
+    return;
+
+  const BatchOptions *options = ctx->options;
+  FlowpipeSegment *segments = splitTaylorExpansion(
+      ctx->expansions[work->job->systemIndex], work->domain, options->threshold,
+      options->maxDepth, options->heuristic, ctx->pool);
+
+  FILE *out = fopen(work->job->output, "w");
+  if (out == NULL) {
+    work->job->status = BATCH_OUTPUT_ERROR;
+  } else {
+    fprintf(out, "# system: %s\n", work->job->system);
+    fprintf(out, "# initial set: %s\n", work->job->initial);
+    fprintf(out, "# horizon: %g\n", work->job->horizon);
+    printFlowpipeSegment(segments, out);
+    work->job->status = (fclose(out) == 0) ? BATCH_DONE : BATCH_OUTPUT_ERROR;
+  }
+
+  /* Clean */
+  delFlowpipeSegment(segments);
+}
+
+unsigned int runBatch(BatchJob *jobs, const BatchOptions *options,
+                      ThreadPool *pool) {
+  assert(options != NULL);
+
+  const unsigned int length = lengthBatchJob(jobs);
+  BatchContext ctx = {options, pool, NULL, NULL, NULL};
+  ctx.work = (BatchWork *)calloc(length + 1, sizeof(BatchWork));
+  ctx.systems = (ODEList **)calloc(length + 1, sizeof(ODEList *));
+  if (ctx.work == NULL || ctx.systems == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  unsigned int index = 0;
+  for (BatchJob *job = jobs; job != NULL; job = job->next, ++index) {
+    ctx.work[index].job = job;
+    job->status = BATCH_PENDING;
+  }
+  parallelFor(pool, length, runParse, &ctx);
+
+  /* Identical systems are mapped onto the same index, in job order. The
+    distinct systems are bucketed by hash, in an open-addressing index that
+    is at most half full, so only systems of equal hash are compared. */
+  unsigned int capacity = 2;
+  while (capacity < 2 * length)
+    capacity *= 2;
+  unsigned int *slots = (unsigned int *)calloc(capacity, sizeof(unsigned int));
+  uint64_t *hashes = (uint64_t *)calloc(length + 1, sizeof(uint64_t));
+  if (slots == NULL || hashes == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  unsigned int distinct = 0;
+  for (index = 0; index < length; ++index) {
+    BatchWork *work = &ctx.work[index];
+    if (work->system == NULL)
+      continue;
+
+    /* A slot holds the index of a distinct system + 1, or 0 if empty. */
+    unsigned int slot = (unsigned int)work->hash & (capacity - 1);
+    while (slots[slot] != 0 &&
+           (hashes[slots[slot] - 1] != work->hash ||
+            !isEqualOdeList(ctx.systems[slots[slot] - 1], work->system)))
+      slot = (slot + 1) & (capacity - 1);
+
+    if (slots[slot] == 0) {
+      hashes[distinct] = work->hash;
+      ctx.systems[distinct++] = work->system;
+      slots[slot] = distinct;
+    } else {
+      delOdeList(work->system);
+    }
+    work->system = NULL;
+    work->job->systemIndex = slots[slot] - 1;
+  }
+  free(slots);
+  free(hashes);
+
+  ctx.expansions =
+      (TaylorExpansion **)calloc(distinct + 1, sizeof(TaylorExpansion *));
+  if (ctx.expansions == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  parallelFor(pool, distinct, runExpansion, &ctx);
+  parallelFor(pool, length, runJob, &ctx);
+
+  unsigned int failed = 0;
+  for (index = 0; index < length; ++index) {
+    if (ctx.work[index].job->status != BATCH_DONE)
+      ++failed;
+    if (ctx.work[index].domain != NULL)
+      delDomain(ctx.work[index].domain);
+  }
+
+  /* Clean */
+  for (index = 0; index < distinct; ++index) {
+    delTaylorExpansion(ctx.expansions[index]);
+    delOdeList(ctx.systems[index]);
+  }
+  free(ctx.expansions);
+  free(ctx.systems);
+  free(ctx.work);
+
+  return failed;
+}
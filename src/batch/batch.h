@@ -0,0 +1,170 @@
+/**
+ * @file batch.h
+ * @brief Run many flowpipe jobs, each a (system, initial set, horizon)
+ * tuple, in a single process.
+ * @details A job list holds one job per line, with the fields separated by
+ * vertical bars:
+ *
+ *     system | initial set | horizon [| output]
+ *
+ * e.g.
+ *
+ *     x' = 1 + y; y' = x^2; | x in [-1, 1]; y in [-0.5, 0.5]; | 0.1 | xy.txt
+ *
+ * The system and initial set use the syntax of @ref parseOdeString and
+ * @ref parseVarString. The horizon T fixes the time domain to [0, T]. If the
+ * output path is omitted, then the job writes to "job<line>.txt". No two
+ * jobs may share an output path. Empty lines and lines starting with '#' are
+ * ignored.
+ *
+ * Identical systems are detected after parsing, by their structural hash, so
+ * their Taylor expansion is computed only once and shared by all jobs of that
+ * system. The jobs themselves are independent and run concurrently on a
+ * thread pool.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "sysode.h"
+#include "threadpool.h"
+#include "tmsplit.h"
+#include "variables.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * @brief The outcome of a batch job.
+ */
+typedef enum BatchStatus {
+  /// @brief The job has not run yet.
+  BATCH_PENDING,
+  /// @brief The flowpipe was computed and written to the output.
+  BATCH_DONE,
+  /// @brief The system or initial set could not be parsed, or the initial
+  ///        set does not bound every variable of the system, including
+  ///        its parameters.
+  BATCH_INVALID,
+  /// @brief The output could not be written.
+  BATCH_OUTPUT_ERROR,
+} BatchStatus;
+
+/**
+ * @brief A list of batch jobs, as a linked list.
+ *
+ * @invariant The members @ref BatchJob.system, @ref BatchJob.initial and
+ * @ref BatchJob.output may never be NULL.
+ */
+typedef struct BatchJob {
+  /// @brief The system of ODEs, as a string.
+  char *system;
+  /// @brief The initial set, as a string.
+  char *initial;
+  /// @brief The time horizon T, the time domain becomes [0, T].
+  double horizon;
+  /// @brief The path of the file to write the flowpipe to.
+  char *output;
+  /// @brief The index of the job's system among the distinct systems of the
+  ///        batch. Jobs with the same index share their Taylor expansion.
+  unsigned int systemIndex;
+  /// @brief The outcome of the job.
+  BatchStatus status;
+  /// @brief The next job of the list.
+  struct BatchJob *next;
+} BatchJob;
+
+/**
+ * @brief The settings shared by all the jobs of a batch.
+ */
+typedef struct BatchOptions {
+  /// @brief The order of the Taylor polynomials.
+  unsigned int order;
+  /// @brief The truncation order applied during TM arithmetic.
+  unsigned int k;
+  /// @brief The widest remainder a flowpipe segment may have, see
+  ///        @ref splitTaylorExpansion.
+  double threshold;
+  /// @brief The maximum number of bisections of the initial set.
+  unsigned int maxDepth;
+  /// @brief The choice of bisection dimension.
+  SplitHeuristic heuristic;
+} BatchOptions;
+
+/**
+ * @brief Create a new, single element list.
+ * @pre \p system, \p initial and \p output may **not** be NULL and must be
+ * heap-allocated.
+ * @post Transfers ownership of all heap-allocated arguments to the
+ * newly created BatchJob instance.
+ *
+ * @param[in] system  The system of ODEs, as a string.
+ * @param[in] initial The initial set, as a string.
+ * @param[in] horizon The time horizon.
+ * @param[in] output  The path of the output file.
+ * @return BatchJob* A heap-allocated, pending job.
+ */
+BatchJob *newBatchJob(char *system, char *initial, const double horizon,
+                      char *output);
+
+/**
+ * @brief Attach the second element as the head of the first list.
+ * @pre The \p head argument must be a single element list (not NULL).
+ * @pre The \p tail argument must be NULL or heap-allocated.
+ * @post Transfers ownership of \p tail to \p head.
+ *
+ * @return BatchJob* The \p head pointer, with the tail attached.
+ */
+BatchJob *appBatchJobElem(BatchJob *tail, BatchJob *head);
+
+/**
+ * @brief The number of jobs in the list.
+ */
+unsigned int lengthBatchJob(const BatchJob *list);
+
+/**
+ * @brief Deallocate the entire list.
+ */
+void delBatchJob(BatchJob *list);
+
+/**
+ * @brief Print the status of each job, one job per line.
+ */
+void printBatchJob(const BatchJob *list, FILE *where);
+
+/**
+ * @brief Read a job list, see the file description for the format.
+ * @details Malformed lines and duplicate output paths are reported to
+ * stderr, in the style of the system and initial set parsers.
+ * @pre \p input and \p jobs may **not** be NULL.
+ * @post On success, \p jobs holds the jobs in the order of the job list.
+ * On failure, it holds NULL.
+ *
+ * @param[in]  input The job list.
+ * @param[out] jobs  The parsed jobs.
+ * @return int A return code, 0 on success.
+ */
+int parseBatchJobs(FILE *input, BatchJob **jobs);
+
+/**
+ * @brief Run all the jobs of the batch.
+ * @details All the jobs are parsed up front, concurrently on the \p pool.
+ * Then the Taylor expansion of each distinct system is computed once, and
+ * finally the jobs run concurrently on the \p pool. Each job writes the
+ * ordered segments of its flowpipe to its own output file.
+ * @pre \p options may **not** be NULL.
+ * @post The status of every job is updated.
+ *
+ * @param[in,out] jobs    The jobs to run.
+ * @param[in]     options The settings shared by all jobs.
+ * @param[in]     pool    The pool to run the jobs on, or NULL.
+ * @return unsigned int The number of jobs that failed.
+ */
+unsigned int runBatch(BatchJob *jobs, const BatchOptions *options,
+                      ThreadPool *pool);
+
+#endif
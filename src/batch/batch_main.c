@@ -0,0 +1,100 @@
+#include "batch.h"
+#include "threadpool.h"
+#include "tmcache.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static void usage(const char *program) {
+  fprintf(stderr,
+          "Usage: %s [-j workers] [-n order] [-k truncation] "
+          "[-r threshold] [-d depth] [-s] [-c directory] [-m megabytes] "
+          "jobs.txt\n"
+          "  -j  number of worker threads, 0 for one per processor "
+          "(default 0)\n"
+          "  -n  order of the Taylor polynomials (default 3)\n"
+          "  -k  truncation order of TM arithmetic (default: the order)\n"
+          "  -r  widest remainder before an initial set is split "
+          "(default: never split)\n"
+          "  -d  maximum number of initial set bisections (default 8)\n"
+          "  -s  bisect the most sensitive instead of the widest variable\n"
+          "  -c  directory to cache Taylor expansions in across runs\n"
+          "  -m  size bound of the cache directory in megabytes "
+          "(default 1024)\n",
+          program);
+}
+
+int main(int argc, char *argv[]) {
+  unsigned int workers = 0;
+  BatchOptions options = {3, 0, INFINITY, 8, SPLIT_WIDEST};
+  const char *cache = NULL;
+  size_t cacheBytes = EXPANSION_CACHE_MAX_BYTES;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "j:n:k:r:d:sc:m:")) != -1) {
+    switch (opt) {
+    case 'j':
+      workers = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 'n':
+      options.order = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 'k':
+      options.k = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 'r':
+      options.threshold = strtod(optarg, NULL);
+      break;
+    case 'd':
+      options.maxDepth = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 's':
+      options.heuristic = SPLIT_SENSITIVE;
+      break;
+    case 'c':
+      cache = optarg;
+      break;
+    case 'm':
+      cacheBytes = (size_t)strtoul(optarg, NULL, 10) << 20;
+      break;
+    default:
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.k == 0)
+    options.k = options.order;
+  if (optind != argc - 1 || options.order == 0 || options.k < options.order) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (cache != NULL && setExpansionCache(cache, cacheBytes) != 0) {
+    perror(cache);
+    return EXIT_FAILURE;
+  }
+
+  FILE *input = fopen(argv[optind], "r");
+  if (input == NULL) {
+    perror(argv[optind]);
+    return EXIT_FAILURE;
+  }
+  BatchJob *jobs;
+  int code = parseBatchJobs(input, &jobs);
+  fclose(input);
+  if (code != 0)
+    return EXIT_FAILURE;
+
+  ThreadPool *pool = newThreadPool(workers);
+  unsigned int failed = runBatch(jobs, &options, pool);
+  printBatchJob(jobs, stdout);
+  fprintf(stderr, "%u of %u jobs failed\n", failed, lengthBatchJob(jobs));
+
+  /* Clean */
+  setExpansionCache(NULL, 0);
+  delThreadPool(pool);
+  delBatchJob(jobs);
+
+  return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,4 +1,5 @@
 #include "funexp.h"
+#include "counters.h"
 #include <assert.h>
 #include <ctype.h>
 #include <stdbool.h>
@@ -12,6 +13,7 @@ ExpTree *newExpLeaf(const ExpType type, const char *const name) {
   assert(name != NULL);
 
   ExpTree *tree = (ExpTree *)malloc(sizeof(ExpTree));
+  COUNT_EVENT(COUNTER_NODES_ALLOCATED, 1);
   tree->data = strdup(name);
   tree->type = type;
   switch (type) {
@@ -37,6 +39,7 @@ ExpTree *newExpOp(const ExpType type, ExpTree *left, ExpTree *right) {
 ExpTree *newExpTree(const ExpType type, char *name, ExpTree *left,
                     ExpTree *right) {
   ExpTree *tree = (ExpTree *)malloc(sizeof(ExpTree));
+  COUNT_EVENT(COUNTER_NODES_ALLOCATED, 1);
   tree->data = name;
   tree->type = type;
   switch (type) {
@@ -78,6 +81,7 @@ void delExpTree(ExpTree *tree) {
   if (tree->data != NULL)
     free(tree->data);
   free(tree);
+  COUNT_EVENT(COUNTER_NODES_FREED, 1);
 }
 
 static void printBinOp(ExpType type, FILE *where) {
@@ -160,6 +164,7 @@ ExpTree *cpyExpTree(const ExpTree *const src) {
     fprintf(stderr, "Memory allocation error\n");
     exit(EXIT_FAILURE);
   }
+  COUNT_EVENT(COUNTER_NODES_ALLOCATED, 1);
 
   copy->type = src->type;
   copy->data = (src->data != NULL) ? strdup(src->data) : NULL;
@@ -243,6 +248,25 @@ ExpTree *derivative(const ExpTree *expr, const char *var) {
     return newExpOp(EXP_ADD_OP, left_term, right_term);
   }
 
+  case EXP_DIV_OP: {
+    ExpTree *left_derivative = derivative(expr->left, var);
+    ExpTree *right_derivative = derivative(expr->right, var);
+
+    /* (f / g)' = (f' * g - f * g') / g^2 */
+    ExpTree *left_term =
+        newExpOp(EXP_MUL_OP, left_derivative, cpyExpTree(expr->right));
+    ExpTree *right_term =
+        newExpOp(EXP_MUL_OP, cpyExpTree(expr->left), right_derivative);
+    ExpTree *square = newExpOp(EXP_EXP_OP, cpyExpTree(expr->right),
+                               newExpLeaf(EXP_NUM, "2"));
+
+    return newExpOp(EXP_DIV_OP,
+                    newExpOp(EXP_SUB_OP, left_term, right_term), square);
+  }
+
+  case EXP_NEG:
+    return newExpOp(EXP_NEG, derivative(expr->left, var), NULL);
+
   case EXP_EXP_OP: {
     ExpTree *base = cpyExpTree(expr->left);
     ExpTree *exponent = cpyExpTree(expr->right);
@@ -306,6 +330,43 @@ ExpTree *derivative(const ExpTree *expr, const char *var) {
           EXP_MUL_OP, half,
           newExpOp(EXP_DIV_OP, arg_derivative,
                    newExpTree(EXP_FUN, strdup("sqrt"), cpyExpTree(arg), NULL)));
+    } else if (strcmp(function_name, "exp") == 0) {
+      ExpTree *arg = expr->left;
+      ExpTree *arg_derivative = derivative(arg, var);
+
+      /* Derivative of exp */
+      ExpTree *exp_func =
+          newExpTree(EXP_FUN, strdup("exp"), cpyExpTree(arg), NULL);
+      derivative_result = newExpOp(EXP_MUL_OP, exp_func, arg_derivative);
+    } else if (strcmp(function_name, "log") == 0) {
+      ExpTree *arg = expr->left;
+      ExpTree *arg_derivative = derivative(arg, var);
+
+      /* Derivative of log */
+      derivative_result =
+          newExpOp(EXP_DIV_OP, arg_derivative, cpyExpTree(arg));
+    } else if (strcmp(function_name, "atan") == 0) {
+      ExpTree *arg = expr->left;
+      ExpTree *arg_derivative = derivative(arg, var);
+
+      /* Derivative of atan */
+      ExpTree *square =
+          newExpOp(EXP_EXP_OP, cpyExpTree(arg), newExpLeaf(EXP_NUM, "2"));
+      derivative_result = newExpOp(
+          EXP_DIV_OP, arg_derivative,
+          newExpOp(EXP_ADD_OP, newExpLeaf(EXP_NUM, "1"), square));
+    } else if (strcmp(function_name, "tanh") == 0) {
+      ExpTree *arg = expr->left;
+      ExpTree *arg_derivative = derivative(arg, var);
+
+      /* Derivative of tanh */
+      ExpTree *tanh_func =
+          newExpTree(EXP_FUN, strdup("tanh"), cpyExpTree(arg), NULL);
+      ExpTree *square =
+          newExpOp(EXP_EXP_OP, tanh_func, newExpLeaf(EXP_NUM, "2"));
+      derivative_result = newExpOp(
+          EXP_MUL_OP, newExpOp(EXP_SUB_OP, newExpLeaf(EXP_NUM, "1"), square),
+          arg_derivative);
     }
 
     /* Clean. */
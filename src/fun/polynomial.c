@@ -0,0 +1,856 @@
+#include "polynomial.h"
+#include <fenv.h>
+#include <limits.h>
+
+/* Create the zero polynomial over a copy of the given (sorted) variables. */
+static Polynomial *newPolynomial(char *const *vars, const unsigned int nvars) {
+  Polynomial *poly = (Polynomial *)malloc(sizeof(Polynomial));
+  char **names = (char **)malloc((nvars + 1) * sizeof(char *));
+  if (poly == NULL || names == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (unsigned int it = 0; it < nvars; ++it)
+    names[it] = strdup(vars[it]);
+
+  poly->nvars = nvars;
+  poly->vars = names;
+  poly->length = 0;
+  poly->capacity = 0;
+  poly->coefficients = NULL;
+  poly->exponents = NULL;
+  return poly;
+}
+
+/* Append a term, without restoring the invariants. */
+static void appendTerm(Polynomial *poly, const double coefficient,
+                       const unsigned int *exponents) {
+  if (poly->length == poly->capacity) {
+    poly->capacity = (poly->capacity == 0) ? 4 : 2 * poly->capacity;
+    double *coefficients = (double *)realloc(
+        poly->coefficients, poly->capacity * sizeof(double));
+    unsigned int *exps = (unsigned int *)realloc(
+        poly->exponents,
+        ((size_t)poly->capacity * poly->nvars + 1) * sizeof(unsigned int));
+    if (coefficients == NULL || exps == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+    poly->coefficients = coefficients;
+    poly->exponents = exps;
+  }
+
+  poly->coefficients[poly->length] = coefficient;
+  for (unsigned int it = 0; it < poly->nvars; ++it)
+    poly->exponents[poly->length * poly->nvars + it] =
+        (exponents != NULL) ? exponents[it] : 0;
+  ++poly->length;
+}
+
+static unsigned int sumExponents(const unsigned int *exponents,
+                                 const unsigned int nvars) {
+  unsigned int degree = 0;
+  for (unsigned int it = 0; it < nvars; ++it)
+    degree += exponents[it];
+  return degree;
+}
+
+static unsigned int termDegree(const Polynomial *poly,
+                               const unsigned int term) {
+  return sumExponents(&poly->exponents[term * poly->nvars], poly->nvars);
+}
+
+/* Compare two exponent vectors in polynomial order: < 0 if the left one
+  comes first, 0 if they are equal. */
+static int compareExponents(const unsigned int *left,
+                            const unsigned int *right,
+                            const unsigned int nvars) {
+  const unsigned int leftDegree = sumExponents(left, nvars);
+  const unsigned int rightDegree = sumExponents(right, nvars);
+  if (leftDegree != rightDegree)
+    return (leftDegree < rightDegree) ? -1 : 1;
+
+  for (unsigned int it = 0; it < nvars; ++it)
+    if (left[it] != right[it])
+      return (left[it] > right[it]) ? -1 : 1;
+  return 0;
+}
+
+static int compareTerms(const Polynomial *poly, const unsigned int left,
+                        const unsigned int right) {
+  return compareExponents(&poly->exponents[left * poly->nvars],
+                          &poly->exponents[right * poly->nvars], poly->nvars);
+}
+
+/* Merge sort of term indices; qsort does not pass a context. */
+static void sortTerms(const Polynomial *poly, unsigned int *order,
+                      unsigned int *buffer, const unsigned int length) {
+  if (length < 2)
+    return;
+
+  const unsigned int half = length / 2;
+  sortTerms(poly, order, buffer, half);
+  sortTerms(poly, order + half, buffer, length - half);
+
+  unsigned int left = 0;
+  unsigned int right = half;
+  for (unsigned int it = 0; it < length; ++it) {
+    if (right >= length ||
+        (left < half && compareTerms(poly, order[left], order[right]) <= 0))
+      buffer[it] = order[left++];
+    else
+      buffer[it] = order[right++];
+  }
+  memcpy(order, buffer, length * sizeof(unsigned int));
+}
+
+/* Restore the invariants: sort the terms, merge terms with equal exponents
+  and drop terms with zero coefficient. */
+static void normalizePolynomial(Polynomial *poly) {
+  const unsigned int length = poly->length;
+  unsigned int *order =
+      (unsigned int *)malloc((length + 1) * sizeof(unsigned int));
+  unsigned int *buffer =
+      (unsigned int *)malloc((length + 1) * sizeof(unsigned int));
+  if (order == NULL || buffer == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (unsigned int it = 0; it < length; ++it)
+    order[it] = it;
+  sortTerms(poly, order, buffer, length);
+
+  Polynomial *sorted = newPolynomial(poly->vars, poly->nvars);
+  for (unsigned int it = 0; it < length;) {
+    double coefficient = 0;
+    unsigned int next = it;
+    while (next < length && compareTerms(poly, order[it], order[next]) == 0)
+      coefficient += poly->coefficients[order[next++]];
+    if (coefficient != 0)
+      appendTerm(sorted, coefficient,
+                 &poly->exponents[order[it] * poly->nvars]);
+    it = next;
+  }
+
+  /* Move the sorted terms into the original polynomial. */
+  free(poly->coefficients);
+  free(poly->exponents);
+  poly->length = sorted->length;
+  poly->capacity = sorted->capacity;
+  poly->coefficients = sorted->coefficients;
+  poly->exponents = sorted->exponents;
+  sorted->coefficients = NULL;
+  sorted->exponents = NULL;
+  sorted->length = 0;
+
+  /* Clean */
+  delPolynomial(sorted);
+  free(order);
+  free(buffer);
+}
+
+/* The sorted union of the variables of both polynomials. */
+static char **unionVars(const Polynomial *left, const Polynomial *right,
+                        unsigned int *nvars) {
+  char **vars =
+      (char **)malloc((left->nvars + right->nvars + 1) * sizeof(char *));
+  if (vars == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  unsigned int l = 0, r = 0, n = 0;
+  while (l < left->nvars || r < right->nvars) {
+    int cmp = (l == left->nvars)    ? 1
+              : (r == right->nvars) ? -1
+                                    : strcmp(left->vars[l], right->vars[r]);
+    if (cmp <= 0)
+      vars[n++] = left->vars[l++];
+    else
+      vars[n++] = right->vars[r++];
+    if (cmp == 0)
+      ++r;
+  }
+  *nvars = n;
+  return vars;
+}
+
+/* Express the polynomial over a superset of its variables. */
+static Polynomial *remapPolynomial(const Polynomial *poly, char *const *vars,
+                                   const unsigned int nvars) {
+  unsigned int *index =
+      (unsigned int *)malloc((poly->nvars + 1) * sizeof(unsigned int));
+  unsigned int *exponents =
+      (unsigned int *)calloc(nvars + 1, sizeof(unsigned int));
+  if (index == NULL || exponents == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (unsigned int it = 0, pos = 0; it < poly->nvars; ++it) {
+    while (strcmp(vars[pos], poly->vars[it]) != 0)
+      ++pos;
+    index[it] = pos;
+  }
+
+  Polynomial *remapped = newPolynomial(vars, nvars);
+  for (unsigned int term = 0; term < poly->length; ++term) {
+    for (unsigned int it = 0; it < poly->nvars; ++it)
+      exponents[index[it]] = poly->exponents[term * poly->nvars + it];
+    appendTerm(remapped, poly->coefficients[term], exponents);
+  }
+
+  /* Clean */
+  free(index);
+  free(exponents);
+
+  return remapped;
+}
+
+/* Addition of polynomials over the same variables. */
+static Polynomial *addSameVars(const Polynomial *left,
+                               const Polynomial *right) {
+  Polynomial *sum = cpyPolynomial(left);
+  for (unsigned int it = 0; it < right->length; ++it)
+    appendTerm(sum, right->coefficients[it],
+               &right->exponents[it * right->nvars]);
+  normalizePolynomial(sum);
+  return sum;
+}
+
+/* Multiplication of polynomials over the same variables. */
+static Polynomial *mulSameVars(const Polynomial *left,
+                               const Polynomial *right) {
+  const unsigned int nvars = left->nvars;
+  unsigned int *exponents =
+      (unsigned int *)malloc((nvars + 1) * sizeof(unsigned int));
+  if (exponents == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  Polynomial *product = newPolynomial(left->vars, nvars);
+  for (unsigned int l = 0; l < left->length; ++l) {
+    for (unsigned int r = 0; r < right->length; ++r) {
+      for (unsigned int it = 0; it < nvars; ++it)
+        exponents[it] = left->exponents[l * nvars + it] +
+                        right->exponents[r * nvars + it];
+      appendTerm(product, left->coefficients[l] * right->coefficients[r],
+                 exponents);
+    }
+  }
+  normalizePolynomial(product);
+
+  /* Clean */
+  free(exponents);
+
+  return product;
+}
+
+/* The constant polynomial c over the given variables. */
+static Polynomial *newConstant(char *const *vars, const unsigned int nvars,
+                               const double constant) {
+  Polynomial *poly = newPolynomial(vars, nvars);
+  if (constant != 0)
+    appendTerm(poly, constant, NULL);
+  return poly;
+}
+
+/* Check whether the polynomial is a constant, and if so, return it. */
+static bool isConstantPolynomial(const Polynomial *poly, double *constant) {
+  if (poly->length == 0) {
+    *constant = 0;
+    return true;
+  }
+  if (poly->length == 1 && termDegree(poly, 0) == 0) {
+    *constant = poly->coefficients[0];
+    return true;
+  }
+  return false;
+}
+
+/* Collect the distinct variables of the tree, in sorted order. */
+static void collectVars(const ExpTree *tree, char ***vars,
+                        unsigned int *nvars) {
+  if (tree == NULL)
+    return;
+
+  if (tree->type == EXP_VAR) {
+    unsigned int pos = 0;
+    while (pos < *nvars && strcmp((*vars)[pos], tree->data) < 0)
+      ++pos;
+    if (pos < *nvars && strcmp((*vars)[pos], tree->data) == 0)
+      return;
+
+    char **grown = (char **)realloc(*vars, (*nvars + 1) * sizeof(char *));
+    if (grown == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+    memmove(&grown[pos + 1], &grown[pos], (*nvars - pos) * sizeof(char *));
+    grown[pos] = tree->data;
+    *vars = grown;
+    ++*nvars;
+    return;
+  }
+
+  collectVars(tree->left, vars, nvars);
+  collectVars(tree->right, vars, nvars);
+}
+
+/* Convert the tree to a polynomial over the given variables, which must
+  include all variables of the tree. */
+static Polynomial *buildPolynomial(const ExpTree *tree, char *const *vars,
+                                   const unsigned int nvars) {
+  assert(tree != NULL);
+
+  switch (tree->type) {
+  case EXP_NUM:
+    return newConstant(vars, nvars, atof(tree->data));
+
+  case EXP_VAR: {
+    unsigned int *exponents =
+        (unsigned int *)calloc(nvars + 1, sizeof(unsigned int));
+    if (exponents == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+    for (unsigned int it = 0; it < nvars; ++it)
+      if (strcmp(vars[it], tree->data) == 0)
+        exponents[it] = 1;
+
+    Polynomial *poly = newPolynomial(vars, nvars);
+    appendTerm(poly, 1, exponents);
+    free(exponents);
+    return poly;
+  }
+
+  case EXP_NEG: {
+    Polynomial *operand = buildPolynomial(tree->left, vars, nvars);
+    if (operand == NULL)
+      return NULL;
+    Polynomial *neg = scalePolynomial(operand, -1);
+    delPolynomial(operand);
+    return neg;
+  }
+
+  case EXP_ADD_OP:
+  case EXP_SUB_OP:
+  case EXP_MUL_OP:
+  case EXP_DIV_OP: {
+    Polynomial *left = buildPolynomial(tree->left, vars, nvars);
+    Polynomial *right =
+        (left != NULL) ? buildPolynomial(tree->right, vars, nvars) : NULL;
+    if (right == NULL) {
+      if (left != NULL)
+        delPolynomial(left);
+      return NULL;
+    }
+
+    Polynomial *result = NULL;
+    double constant;
+    if (tree->type == EXP_ADD_OP) {
+      result = addSameVars(left, right);
+    } else if (tree->type == EXP_SUB_OP) {
+      Polynomial *neg = scalePolynomial(right, -1);
+      result = addSameVars(left, neg);
+      delPolynomial(neg);
+    } else if (tree->type == EXP_MUL_OP) {
+      result = mulSameVars(left, right);
+    } else if (isConstantPolynomial(right, &constant) && constant != 0) {
+      /* Only division by a non-zero constant yields a polynomial. */
+      result = scalePolynomial(left, 1 / constant);
+    }
+
+    /* Clean */
+    delPolynomial(left);
+    delPolynomial(right);
+
+    return result;
+  }
+
+  case EXP_EXP_OP: {
+    /* Only non-negative integer exponents yield a polynomial. */
+    if (tree->right->type != EXP_NUM)
+      return NULL;
+    double exponent = atof(tree->right->data);
+    if (exponent < 0 || exponent != floor(exponent))
+      return NULL;
+
+    Polynomial *base = buildPolynomial(tree->left, vars, nvars);
+    if (base == NULL)
+      return NULL;
+
+    /* Exponentiation by squaring. */
+    Polynomial *power = newConstant(vars, nvars, 1);
+    for (unsigned int n = (unsigned int)exponent; n > 0; n /= 2) {
+      if (n % 2 == 1) {
+        Polynomial *product = mulSameVars(power, base);
+        delPolynomial(power);
+        power = product;
+      }
+      if (n > 1) {
+        Polynomial *squared = mulSameVars(base, base);
+        delPolynomial(base);
+        base = squared;
+      }
+    }
+
+    /* Clean */
+    delPolynomial(base);
+
+    return power;
+  }
+
+  default:
+    return NULL;
+  }
+}
+
+Polynomial *toPolynomial(const ExpTree *tree) {
+  assert(tree != NULL);
+
+  char **vars = NULL;
+  unsigned int nvars = 0;
+  collectVars(tree, &vars, &nvars);
+  Polynomial *poly = buildPolynomial(tree, vars, nvars);
+
+  /* Clean: the names are borrowed from the tree. */
+  free(vars);
+
+  return poly;
+}
+
+/* Print the shortest decimal that parses back to exactly the same value. */
+static void formatCoefficient(char *str, const size_t size,
+                              const double value) {
+  for (int digits = 15; digits <= 17; ++digits) {
+    snprintf(str, size, "%.*g", digits, value);
+    if (atof(str) == value)
+      return;
+  }
+}
+
+ExpTree *fromPolynomial(const Polynomial *poly) {
+  assert(poly != NULL);
+
+  ExpTree *sum = NULL;
+  for (unsigned int term = 0; term < poly->length; ++term) {
+    const double coefficient = poly->coefficients[term];
+    char str[50];
+
+    /* The monomial: (((|c| * x^a) * y^b) * ...) */
+    ExpTree *monomial = NULL;
+    if (fabs(coefficient) != 1 || termDegree(poly, term) == 0) {
+      formatCoefficient(str, sizeof(str), fabs(coefficient));
+      monomial = newExpLeaf(EXP_NUM, str);
+    }
+    for (unsigned int it = 0; it < poly->nvars; ++it) {
+      unsigned int exponent = poly->exponents[term * poly->nvars + it];
+      if (exponent == 0)
+        continue;
+
+      ExpTree *factor = newExpLeaf(EXP_VAR, poly->vars[it]);
+      if (exponent > 1) {
+        snprintf(str, sizeof(str), "%u", exponent);
+        factor = newExpOp(EXP_EXP_OP, factor, newExpLeaf(EXP_NUM, str));
+      }
+      monomial = (monomial == NULL) ? factor
+                                    : newExpOp(EXP_MUL_OP, monomial, factor);
+    }
+
+    if (sum == NULL)
+      sum = (coefficient < 0) ? newExpOp(EXP_NEG, monomial, NULL) : monomial;
+    else
+      sum = newExpOp((coefficient < 0) ? EXP_SUB_OP : EXP_ADD_OP, sum,
+                     monomial);
+  }
+
+  return (sum != NULL) ? sum : newExpLeaf(EXP_NUM, "0");
+}
+
+ExpTree *collectTerms(const ExpTree *source) {
+  assert(source != NULL);
+
+  Polynomial *poly = toPolynomial(source);
+  if (poly == NULL)
+    return cpyExpTree(source);
+
+  ExpTree *collected = fromPolynomial(poly);
+  delPolynomial(poly);
+  return collected;
+}
+
+/* The floating-point exceptions by which a result is not exact. */
+#define INEXACT_EXCEPTIONS (FE_INEXACT | FE_OVERFLOW | FE_UNDERFLOW)
+
+/* The number of nodes of fromPolynomial(poly), without building it. */
+static unsigned int countPolynomialNodes(const Polynomial *poly) {
+  unsigned int nodes = 0;
+  for (unsigned int term = 0; term < poly->length; ++term) {
+    /* The sign, resp. the sum node, and the coefficient. */
+    unsigned int factors = (fabs(poly->coefficients[term]) != 1 ||
+                            termDegree(poly, term) == 0);
+    nodes += (term > 0 || poly->coefficients[term] < 0) + factors;
+    for (unsigned int it = 0; it < poly->nvars; ++it) {
+      unsigned int exponent = poly->exponents[term * poly->nvars + it];
+      if (exponent == 0)
+        continue;
+      /* The variable, and its power. */
+      nodes += (exponent > 1) ? 3 : 1;
+      ++factors;
+    }
+    nodes += factors - 1;
+  }
+  return (nodes > 0) ? nodes : 1;
+}
+
+/* Whether every coefficient is spelled exactly by fromPolynomial, so that
+  parsing the collected tree gives back the same polynomial. */
+static bool isExactlySpelled(const Polynomial *poly) {
+  for (unsigned int term = 0; term < poly->length; ++term) {
+    char str[50];
+    formatCoefficient(str, sizeof(str), fabs(poly->coefficients[term]));
+    feclearexcept(INEXACT_EXCEPTIONS);
+    volatile double value = atof(str);
+    (void)value;
+    if (fetestexcept(INEXACT_EXCEPTIONS))
+      return false;
+  }
+  return true;
+}
+
+/* Combine the polynomials of the operands as the node does, or return NULL
+  if that is not a polynomial, is not exact in double arithmetic, or grows
+  beyond maxTerms terms on the way. */
+static Polynomial *combineExact(const ExpTree *source, const Polynomial *left,
+                                const Polynomial *right,
+                                const unsigned int maxTerms) {
+  Polynomial *result = NULL;
+  double constant;
+  feclearexcept(INEXACT_EXCEPTIONS);
+
+  switch (source->type) {
+  case EXP_NEG:
+    result = scalePolynomial(left, -1);
+    break;
+
+  case EXP_ADD_OP:
+    result = addSameVars(left, right);
+    break;
+
+  case EXP_SUB_OP: {
+    Polynomial *neg = scalePolynomial(right, -1);
+    result = addSameVars(left, neg);
+    delPolynomial(neg);
+    break;
+  }
+
+  case EXP_MUL_OP:
+    if ((unsigned long long)left->length * right->length <= maxTerms)
+      result = mulSameVars(left, right);
+    break;
+
+  case EXP_DIV_OP:
+    /* Only division by a non-zero constant yields a polynomial. */
+    if (isConstantPolynomial(right, &constant) && constant != 0) {
+      result = cpyPolynomial(left);
+      for (unsigned int it = 0; it < result->length; ++it)
+        result->coefficients[it] /= constant;
+      normalizePolynomial(result);
+    }
+    break;
+
+  case EXP_EXP_OP: {
+    /* Only non-negative integer exponents yield a polynomial. */
+    if (source->right->type != EXP_NUM)
+      break;
+    double exponent = atof(source->right->data);
+    if (exponent < 0 || exponent != floor(exponent) || exponent > UINT_MAX)
+      break;
+
+    /* Exponentiation by squaring, while the terms stay within bounds. */
+    Polynomial *base = cpyPolynomial(left);
+    result = newConstant(left->vars, left->nvars, 1);
+    for (unsigned int n = (unsigned int)exponent; result != NULL && n > 0;
+         n /= 2) {
+      if (n % 2 == 1) {
+        Polynomial *product =
+            ((unsigned long long)result->length * base->length <= maxTerms)
+                ? mulSameVars(result, base)
+                : NULL;
+        delPolynomial(result);
+        result = product;
+      }
+      if (result != NULL && n > 1) {
+        if ((unsigned long long)base->length * base->length > maxTerms) {
+          delPolynomial(result);
+          result = NULL;
+          break;
+        }
+        Polynomial *squared = mulSameVars(base, base);
+        delPolynomial(base);
+        base = squared;
+      }
+    }
+
+    /* Clean */
+    delPolynomial(base);
+
+    break;
+  }
+
+  default:
+    break;
+  }
+
+  if (result != NULL &&
+      (fetestexcept(INEXACT_EXCEPTIONS) || result->length > maxTerms)) {
+    delPolynomial(result);
+    result = NULL;
+  }
+  return result;
+}
+
+/* The recursive kernel of normalizeExpTree, over the variables of the whole
+  tree. Returns the normalized tree, or NULL if the tree is collected into
+  *poly instead. The number of nodes of source is stored in *size. */
+static ExpTree *normalizeNode(const ExpTree *source, char *const *vars,
+                              const unsigned int nvars, unsigned int *size,
+                              Polynomial **poly) {
+  *poly = NULL;
+  if (source->left == NULL) {
+    *size = 1;
+    /* Numbers are spelled canonically, if that does not round them. */
+    feclearexcept(INEXACT_EXCEPTIONS);
+    Polynomial *leaf = buildPolynomial(source, vars, nvars);
+    if (leaf != NULL &&
+        (fetestexcept(INEXACT_EXCEPTIONS) || !isExactlySpelled(leaf))) {
+      delPolynomial(leaf);
+      leaf = NULL;
+    }
+    *poly = leaf;
+    return (leaf != NULL) ? NULL : cpyExpTree(source);
+  }
+
+  unsigned int leftSize, rightSize = 0;
+  Polynomial *leftPoly, *rightPoly = NULL;
+  ExpTree *left = normalizeNode(source->left, vars, nvars, &leftSize,
+                                &leftPoly);
+  ExpTree *right = (source->right == NULL)
+                       ? NULL
+                       : normalizeNode(source->right, vars, nvars, &rightSize,
+                                       &rightPoly);
+  *size = 1 + leftSize + rightSize;
+
+  /* Collect a polynomial as a whole, unless its expansion blows up or is
+    not exact. Functions are never collected. */
+  const unsigned int maxTerms = NORMALIZE_MAX_GROWTH * *size;
+  Polynomial *collected = NULL;
+  if (leftPoly != NULL && (source->right == NULL || rightPoly != NULL) &&
+      source->type != EXP_FUN)
+    collected = combineExact(source, leftPoly, rightPoly, maxTerms);
+  if (collected != NULL && (countPolynomialNodes(collected) > maxTerms ||
+                            !isExactlySpelled(collected))) {
+    delPolynomial(collected);
+    collected = NULL;
+  }
+
+  if (collected != NULL) {
+    *poly = collected;
+  } else {
+    /* Else, keep the node, over the normalized operands. */
+    if (leftPoly != NULL)
+      left = fromPolynomial(leftPoly);
+    if (rightPoly != NULL)
+      right = fromPolynomial(rightPoly);
+    char *data = (source->data == NULL) ? NULL : strdup(source->data);
+    left = newExpTree(source->type, data, left, right);
+    right = NULL;
+  }
+
+  /* Clean */
+  if (leftPoly != NULL)
+    delPolynomial(leftPoly);
+  if (rightPoly != NULL)
+    delPolynomial(rightPoly);
+  if (collected != NULL) {
+    if (left != NULL)
+      delExpTree(left);
+    if (right != NULL)
+      delExpTree(right);
+    return NULL;
+  }
+  return left;
+}
+
+ExpTree *normalizeExpTree(const ExpTree *source) {
+  assert(source != NULL);
+
+  char **vars = NULL;
+  unsigned int nvars = 0;
+  collectVars(source, &vars, &nvars);
+
+  unsigned int size;
+  Polynomial *poly;
+  ExpTree *normalized = normalizeNode(source, vars, nvars, &size, &poly);
+  if (normalized == NULL) {
+    normalized = fromPolynomial(poly);
+    delPolynomial(poly);
+  }
+
+  /* Clean: the names are borrowed from the tree. */
+  free(vars);
+
+  return normalized;
+}
+
+Polynomial *cpyPolynomial(const Polynomial *source) {
+  assert(source != NULL);
+
+  Polynomial *copy = newPolynomial(source->vars, source->nvars);
+  for (unsigned int it = 0; it < source->length; ++it)
+    appendTerm(copy, source->coefficients[it],
+               &source->exponents[it * source->nvars]);
+  return copy;
+}
+
+void delPolynomial(Polynomial *poly) {
+  assert(poly != NULL);
+
+  for (unsigned int it = 0; it < poly->nvars; ++it)
+    free(poly->vars[it]);
+  free(poly->vars);
+  free(poly->coefficients);
+  free(poly->exponents);
+  free(poly);
+}
+
+void printPolynomial(const Polynomial *poly, FILE *where) {
+  ExpTree *tree = fromPolynomial(poly);
+  printExpTree(tree, where);
+  delExpTree(tree);
+}
+
+unsigned int degreePolynomial(const Polynomial *poly) {
+  assert(poly != NULL);
+
+  unsigned int degree = 0;
+  for (unsigned int it = 0; it < poly->length; ++it) {
+    unsigned int current = termDegree(poly, it);
+    degree = (current > degree) ? current : degree;
+  }
+  return degree;
+}
+
+Polynomial *addPolynomial(const Polynomial *left, const Polynomial *right) {
+  assert(left != NULL);
+  assert(right != NULL);
+
+  unsigned int nvars;
+  char **vars = unionVars(left, right, &nvars);
+  Polynomial *leftRemapped = remapPolynomial(left, vars, nvars);
+  Polynomial *rightRemapped = remapPolynomial(right, vars, nvars);
+  Polynomial *sum = addSameVars(leftRemapped, rightRemapped);
+
+  /* Clean */
+  delPolynomial(leftRemapped);
+  delPolynomial(rightRemapped);
+  free(vars);
+
+  return sum;
+}
+
+Polynomial *mulPolynomial(const Polynomial *left, const Polynomial *right) {
+  assert(left != NULL);
+  assert(right != NULL);
+
+  unsigned int nvars;
+  char **vars = unionVars(left, right, &nvars);
+  Polynomial *leftRemapped = remapPolynomial(left, vars, nvars);
+  Polynomial *rightRemapped = remapPolynomial(right, vars, nvars);
+  Polynomial *product = mulSameVars(leftRemapped, rightRemapped);
+
+  /* Clean */
+  delPolynomial(leftRemapped);
+  delPolynomial(rightRemapped);
+  free(vars);
+
+  return product;
+}
+
+Polynomial *scalePolynomial(const Polynomial *poly, const double factor) {
+  assert(poly != NULL);
+
+  Polynomial *scaled = cpyPolynomial(poly);
+  for (unsigned int it = 0; it < scaled->length; ++it)
+    scaled->coefficients[it] *= factor;
+  normalizePolynomial(scaled);
+  return scaled;
+}
+
+Polynomial *integratePolynomial(const Polynomial *poly, const char *var) {
+  assert(poly != NULL);
+  assert(var != NULL);
+
+  /* Make sure the variable of integration is part of the polynomial. */
+  char *name = (char *)var;
+  Polynomial single = {.nvars = 1, .vars = &name};
+  unsigned int nvars;
+  char **vars = unionVars(poly, &single, &nvars);
+  Polynomial *integrated = remapPolynomial(poly, vars, nvars);
+  free(vars);
+
+  unsigned int index = 0;
+  while (strcmp(integrated->vars[index], var) != 0)
+    ++index;
+
+  /* c v^n  ->  c / (n + 1) v^(n + 1) */
+  for (unsigned int it = 0; it < integrated->length; ++it) {
+    unsigned int *exponent = &integrated->exponents[it * nvars + index];
+    integrated->coefficients[it] /= *exponent + 1;
+    ++*exponent;
+  }
+  normalizePolynomial(integrated);
+  return integrated;
+}
+
+bool isEqualPolynomial(const Polynomial *left, const Polynomial *right,
+                       const double tolerance) {
+  assert(left != NULL);
+  assert(right != NULL);
+
+  unsigned int nvars;
+  char **vars = unionVars(left, right, &nvars);
+  Polynomial *leftRemapped = remapPolynomial(left, vars, nvars);
+  Polynomial *rightRemapped = remapPolynomial(right, vars, nvars);
+  free(vars);
+
+  /* Both term lists are sorted, so walk them side by side; a term missing
+    from one side has coefficient zero there. */
+  bool equal = true;
+  unsigned int l = 0, r = 0;
+  while (equal && (l < leftRemapped->length || r < rightRemapped->length)) {
+    int cmp;
+    if (l == leftRemapped->length)
+      cmp = 1;
+    else if (r == rightRemapped->length)
+      cmp = -1;
+    else
+      cmp = compareExponents(&leftRemapped->exponents[l * nvars],
+                             &rightRemapped->exponents[r * nvars], nvars);
+
+    double a = (cmp <= 0) ? leftRemapped->coefficients[l] : 0;
+    double b = (cmp >= 0) ? rightRemapped->coefficients[r] : 0;
+    double scale = fmax(1, fmax(fabs(a), fabs(b)));
+    equal = fabs(a - b) <= tolerance * scale;
+
+    l += (cmp <= 0);
+    r += (cmp >= 0);
+  }
+
+  /* Clean */
+  delPolynomial(leftRemapped);
+  delPolynomial(rightRemapped);
+
+  return equal;
+}
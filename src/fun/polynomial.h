@@ -0,0 +1,190 @@
+/**
+ * @file polynomial.h
+ * @brief A sparse, canonical representation of multivariate polynomials.
+ * @details Expression trees represent the same polynomial in many shapes,
+ * e.g. \f$ x(x + y) \f$, \f$ xx + xy \f$ and \f$ xy + x^2 \f$, and TM
+ * arithmetic on trees never collects like terms, so the trees keep growing.
+ * A polynomial stores every distinct monomial exactly once, as an exponent
+ * vector with a coefficient, in a fixed order. Converting a tree to a
+ * polynomial and back therefore yields a compact, canonical tree.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef POLYNOMIAL_H
+#define POLYNOMIAL_H
+
+#include "funexp.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief A multivariate polynomial as a sparse list of monomials.
+ * @details Term i is \f$ c_i \prod_j vars_j^{e_{ij}} \f$, with
+ * \f$ c_i \f$ = coefficients[i] and \f$ e_{ij} \f$ = exponents[i * nvars + j].
+ *
+ * @invariant The variables are sorted by name and contain no duplicates.
+ * @invariant The terms are sorted by total degree, then by descending
+ * exponents in variable order, e.g. \f$ 1, x, y, x^2, xy, y^2 \f$. No two
+ * terms have the same exponents and no coefficient is zero.
+ */
+typedef struct Polynomial {
+  /// @brief The number of variables.
+  unsigned int nvars;
+  /// @brief The names of the variables, sorted.
+  char **vars;
+  /// @brief The number of terms (monomials).
+  unsigned int length;
+  /// @brief The number of terms that fit in the allocated arrays.
+  unsigned int capacity;
+  /// @brief The coefficient of each term.
+  double *coefficients;
+  /// @brief The exponent vector of each term, term by term.
+  unsigned int *exponents;
+} Polynomial;
+
+/**
+ * @brief Convert an expression tree to a polynomial.
+ * @details Supported are numbers, variables, +, -, *, unary -, division by
+ * a (non-zero) constant and non-negative integer powers.
+ * @pre \p tree may **not** be NULL.
+ *
+ * @param[in] tree The expression to convert.
+ * @return Polynomial* A newly heap-allocated polynomial over the variables of
+ * the \p tree, or NULL if the expression is not a polynomial, e.g. if it
+ * contains functions or division by a variable.
+ */
+Polynomial *toPolynomial(const ExpTree *tree);
+
+/**
+ * @brief Convert a polynomial to an expression tree.
+ * @details The tree is a sum of products, e.g.
+ * \f$ ((2 + x) - ((0.5 * x^2) * y)) \f$, whose terms appear in polynomial
+ * order. Negative terms are subtracted, so all number leaves are
+ * non-negative. Coefficients are printed such that they round-trip exactly.
+ * @pre \p poly may **not** be NULL.
+ *
+ * @return ExpTree* A newly heap-allocated expression tree, "0" for the zero
+ * polynomial.
+ */
+ExpTree *fromPolynomial(const Polynomial *poly);
+
+/**
+ * @brief Collect the like terms of an expression into canonical form.
+ * @details This is @ref toPolynomial followed by @ref fromPolynomial.
+ * @pre \p source may **not** be NULL.
+ *
+ * @param[in] source The expression to collect.
+ * @return ExpTree* A newly heap-allocated, canonical sum of products, or a
+ * copy of \p source if it is not a polynomial.
+ */
+ExpTree *collectTerms(const ExpTree *source);
+
+/// @brief The factor by which @ref normalizeExpTree may grow a polynomial
+/// subexpression, in nodes and terms, when expanding it into a sum of
+/// products.
+#define NORMALIZE_MAX_GROWTH 2
+
+/**
+ * @brief Normalize an expression into a compact canonical form.
+ * @details Every maximal polynomial subexpression is collected as in
+ * @ref collectTerms, which folds its constants, flattens its sums and
+ * products into left-deep chains and spells its numbers canonically. Only
+ * exact results are folded: a subexpression is kept as written, and its
+ * operands are normalized instead, if
+ *    - a number or a coefficient would be rounded, e.g. 0.1 or
+ *      \f$ \frac{x}{3} \f$, so the normalized system is the one that was
+ *      written, or
+ *    - its expansion would exceed @ref NORMALIZE_MAX_GROWTH times its size,
+ *      e.g. \f$ (x + y)^{10} \f$. The expansion stops as soon as it does.
+ *
+ * Functions are never evaluated, even on constant arguments, as that would
+ * round the result. Every node is converted once, so normalization takes
+ * about as long as @ref toPolynomial.
+ * @pre \p source may **not** be NULL.
+ *
+ * @param[in] source The expression to normalize.
+ * @return ExpTree* A newly heap-allocated, normalized expression tree.
+ */
+ExpTree *normalizeExpTree(const ExpTree *source);
+
+/**
+ * @brief Create a copy of the given polynomial.
+ * @pre \p source may **not** be NULL.
+ */
+Polynomial *cpyPolynomial(const Polynomial *source);
+
+/**
+ * @brief Deallocate the given polynomial.
+ * @pre \p poly may **not** be NULL.
+ */
+void delPolynomial(Polynomial *poly);
+
+/**
+ * @brief Print the polynomial, as its canonical expression tree.
+ */
+void printPolynomial(const Polynomial *poly, FILE *where);
+
+/**
+ * @brief The total degree of the polynomial, 0 for the zero polynomial.
+ */
+unsigned int degreePolynomial(const Polynomial *poly);
+
+/**
+ * @brief Binary polynomial addition.
+ * @details The operands need not share the same variables; the result is
+ * over the union of both.
+ *
+ * @return Polynomial* A newly heap-allocated polynomial, \p left + \p right.
+ */
+Polynomial *addPolynomial(const Polynomial *left, const Polynomial *right);
+
+/**
+ * @brief Binary polynomial multiplication.
+ * @details The operands need not share the same variables; the result is
+ * over the union of both.
+ *
+ * @return Polynomial* A newly heap-allocated polynomial, \p left * \p right.
+ */
+Polynomial *mulPolynomial(const Polynomial *left, const Polynomial *right);
+
+/**
+ * @brief Multiply every coefficient by a constant.
+ *
+ * @return Polynomial* A newly heap-allocated polynomial,
+ * \p factor * \p poly.
+ */
+Polynomial *scalePolynomial(const Polynomial *poly, const double factor);
+
+/**
+ * @brief The antiderivative that vanishes at zero,
+ * \f$ \int_0^{v} p \, dv \f$.
+ * @details Every term \f$ c v^n \f$ becomes \f$ \frac{c}{n+1} v^{n+1} \f$.
+ * The variable \p var is added to the result if \p poly does not contain it.
+ * @pre \p poly and \p var may **not** be NULL.
+ *
+ * @return Polynomial* A newly heap-allocated polynomial.
+ */
+Polynomial *integratePolynomial(const Polynomial *poly, const char *var);
+
+/**
+ * @brief Check whether two polynomials have the same terms and, up to the
+ * \p tolerance, the same coefficients.
+ * @details Two coefficients a and b are equal if
+ * \f$ |a - b| \le tolerance \cdot \max(1, |a|, |b|) \f$, i.e. the tolerance
+ * is relative for coefficients above 1 and absolute below; a term that only
+ * occurs in one polynomial has coefficient zero in the other. The variables
+ * need not match, e.g. \f$ x + 0y = x \f$.
+ *
+ * @return bool True if the polynomials are equal, else false.
+ */
+bool isEqualPolynomial(const Polynomial *left, const Polynomial *right,
+                       const double tolerance);
+
+#endif
@@ -1,4 +1,5 @@
 #include "transformations.h"
+#include "counters.h"
 
 ExpTree *simplify(const ExpTree *source) {
   ExpTree *simplified = simplifyOperators(source);
@@ -190,6 +191,7 @@ ExpTree *truncateTerms(const ExpTree *source, const unsigned int k,
     which to compute a degree and which to optionally prune. */
   default: {
     if (degreeMonomial(source) > k) {
+      COUNT_EVENT(COUNTER_TRUNCATED_TERMS, 1);
       /* If required, push up the pruned term.
         Note: the output ptr is always NULL, so this must not be verified. */
       if (collect)
@@ -0,0 +1,353 @@
+#include "threadpool.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* A queued unit of work. Jobs of a parallelFor batch are allocated as one
+  array by the batch, so they must not be freed by whoever runs them. */
+typedef struct ThreadPoolJob {
+  ThreadPoolTask task;
+  void *arg;
+  bool heapAllocated;
+  struct ThreadPoolJob *prev;
+  struct ThreadPoolJob *next;
+} ThreadPoolJob;
+
+/* A double-ended job queue. Its owner pushes and pops at the head, so it
+  works depth-first on the jobs it spawned itself; thieves take the oldest
+  jobs from the tail, which tend to be the largest ones. */
+typedef struct WorkQueue {
+  pthread_mutex_t lock;
+  ThreadPoolJob *head;
+  ThreadPoolJob *tail;
+} WorkQueue;
+
+struct ThreadPool {
+  /* Guards the counters and the stopping flag below. */
+  pthread_mutex_t lock;
+  /* Broadcast whenever a job is queued, a job finishes or the pool stops. */
+  pthread_cond_t changed;
+  /* One queue per worker, followed by one shared queue for the jobs
+    submitted by threads outside of the pool. */
+  WorkQueue *queues;
+  /* The number of jobs that are queued. */
+  unsigned int queued;
+  /* The number of jobs that are queued or running. */
+  unsigned int pending;
+  bool stopping;
+  unsigned int size;
+  pthread_t *workers;
+};
+
+typedef struct WorkerStart {
+  ThreadPool *pool;
+  unsigned int index;
+} WorkerStart;
+
+typedef struct ParallelForBatch {
+  ThreadPool *pool;
+  ParallelForBody body;
+  void *context;
+  /* The number of unfinished iterations, guarded by the pool lock. */
+  unsigned int remaining;
+} ParallelForBatch;
+
+typedef struct ParallelForItem {
+  ParallelForBatch *batch;
+  unsigned int index;
+} ParallelForItem;
+
+/* The pool that the current thread works for, if any, and its queue index. */
+static _Thread_local ThreadPool *currentPool = NULL;
+static _Thread_local unsigned int currentQueue = 0;
+
+/* The queue that jobs spawned by the current thread are pushed onto. */
+static unsigned int ownQueue(const ThreadPool *pool) {
+  return (currentPool == pool) ? currentQueue : pool->size;
+}
+
+static void pushJob(ThreadPool *pool, unsigned int index, ThreadPoolJob *job) {
+  WorkQueue *queue = &pool->queues[index];
+  pthread_mutex_lock(&queue->lock);
+  job->prev = NULL;
+  job->next = queue->head;
+  if (queue->head == NULL)
+    queue->tail = job;
+  else
+    queue->head->prev = job;
+  queue->head = job;
+  pthread_mutex_unlock(&queue->lock);
+}
+
+static ThreadPoolJob *popJobHead(WorkQueue *queue) {
+  pthread_mutex_lock(&queue->lock);
+  ThreadPoolJob *job = queue->head;
+  if (job != NULL) {
+    queue->head = job->next;
+    if (queue->head == NULL)
+      queue->tail = NULL;
+    else
+      queue->head->prev = NULL;
+  }
+  pthread_mutex_unlock(&queue->lock);
+  return job;
+}
+
+static ThreadPoolJob *popJobTail(WorkQueue *queue) {
+  pthread_mutex_lock(&queue->lock);
+  ThreadPoolJob *job = queue->tail;
+  if (job != NULL) {
+    queue->tail = job->prev;
+    if (queue->tail == NULL)
+      queue->head = NULL;
+    else
+      queue->tail->next = NULL;
+  }
+  pthread_mutex_unlock(&queue->lock);
+  return job;
+}
+
+/* Find a job for the current thread: first the newest job of its own queue,
+  then the oldest job of the shared queue, and finally the oldest job of any
+  other worker. Returns NULL if every queue looked empty. */
+static ThreadPoolJob *findJob(ThreadPool *pool) {
+  const unsigned int own = ownQueue(pool);
+  ThreadPoolJob *job = popJobHead(&pool->queues[own]);
+  if (job == NULL && own != pool->size)
+    job = popJobTail(&pool->queues[pool->size]);
+  for (unsigned int it = 1; job == NULL && it <= pool->size; ++it) {
+    unsigned int victim = (own + it) % (pool->size + 1);
+    if (victim != pool->size)
+      job = popJobTail(&pool->queues[victim]);
+  }
+
+  if (job != NULL) {
+    pthread_mutex_lock(&pool->lock);
+    assert(pool->queued > 0);
+    pool->queued--;
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return job;
+}
+
+/* Account for jobs that are about to be queued and wake up idle threads.
+  Announcing before pushing keeps the counters from ever dropping below the
+  number of jobs actually in the queues; idle threads briefly retry until the
+  announced jobs show up. */
+static void announceJobs(ThreadPool *pool, unsigned int count) {
+  pthread_mutex_lock(&pool->lock);
+  pool->queued += count;
+  pool->pending += count;
+  pthread_cond_broadcast(&pool->changed);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/* Run a found job, then account for its completion.
+  Must be called without holding the pool lock. */
+static void runJob(ThreadPool *pool, ThreadPoolJob *job) {
+  /* A batch job may be released by its batch as soon as the task finishes,
+    so never touch the job after running it. */
+  const bool heapAllocated = job->heapAllocated;
+  job->task(job->arg);
+  if (heapAllocated)
+    free(job);
+
+  pthread_mutex_lock(&pool->lock);
+  assert(pool->pending > 0);
+  pool->pending--;
+  pthread_cond_broadcast(&pool->changed);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+static void *workerLoop(void *arg) {
+  WorkerStart *start = (WorkerStart *)arg;
+  ThreadPool *pool = start->pool;
+  currentPool = pool;
+  currentQueue = start->index;
+  free(start);
+
+  while (true) {
+    ThreadPoolJob *job = findJob(pool);
+    if (job != NULL) {
+      runJob(pool, job);
+      continue;
+    }
+
+    /* Only stop once the queues are drained. A job may have been queued
+      after the search above, hence the recheck under the lock. */
+    pthread_mutex_lock(&pool->lock);
+    if (pool->queued == 0 && pool->stopping) {
+      pthread_mutex_unlock(&pool->lock);
+      break;
+    }
+    if (pool->queued == 0)
+      pthread_cond_wait(&pool->changed, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+  }
+
+  currentPool = NULL;
+  return NULL;
+}
+
+ThreadPool *newThreadPool(unsigned int workers) {
+  if (workers == 0) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    workers = (online > 0) ? (unsigned int)online : 1;
+  }
+
+  ThreadPool *pool = (ThreadPool *)malloc(sizeof(ThreadPool));
+  if (pool == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->changed, NULL);
+  pool->queued = 0;
+  pool->pending = 0;
+  pool->stopping = false;
+  pool->size = workers;
+  pool->queues = (WorkQueue *)malloc((workers + 1) * sizeof(WorkQueue));
+  pool->workers = (pthread_t *)malloc(workers * sizeof(pthread_t));
+  if (pool->queues == NULL || pool->workers == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (unsigned int it = 0; it <= workers; ++it) {
+    pthread_mutex_init(&pool->queues[it].lock, NULL);
+    pool->queues[it].head = NULL;
+    pool->queues[it].tail = NULL;
+  }
+
+  for (unsigned int it = 0; it < workers; ++it) {
+    WorkerStart *start = (WorkerStart *)malloc(sizeof(WorkerStart));
+    if (start == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+    start->pool = pool;
+    start->index = it;
+    if (pthread_create(&pool->workers[it], NULL, workerLoop, start) != 0) {
+      fprintf(stderr, "Thread creation error\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+  return pool;
+}
+
+void delThreadPool(ThreadPool *pool) {
+  assert(pool != NULL);
+
+  pthread_mutex_lock(&pool->lock);
+  pool->stopping = true;
+  pthread_cond_broadcast(&pool->changed);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (unsigned int it = 0; it < pool->size; ++it)
+    pthread_join(pool->workers[it], NULL);
+
+  assert(pool->queued == 0);
+  assert(pool->pending == 0);
+  for (unsigned int it = 0; it <= pool->size; ++it) {
+    assert(pool->queues[it].head == NULL);
+    pthread_mutex_destroy(&pool->queues[it].lock);
+  }
+  pthread_cond_destroy(&pool->changed);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool->queues);
+  free(pool->workers);
+  free(pool);
+}
+
+unsigned int threadPoolSize(const ThreadPool *pool) {
+  assert(pool != NULL);
+  return pool->size;
+}
+
+void submitThreadPool(ThreadPool *pool, ThreadPoolTask task, void *arg) {
+  assert(pool != NULL);
+  assert(task != NULL);
+
+  ThreadPoolJob *job = (ThreadPoolJob *)malloc(sizeof(ThreadPoolJob));
+  if (job == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  job->task = task;
+  job->arg = arg;
+  job->heapAllocated = true;
+
+  announceJobs(pool, 1);
+  pushJob(pool, ownQueue(pool), job);
+}
+
+void waitThreadPool(ThreadPool *pool) {
+  assert(pool != NULL);
+
+  pthread_mutex_lock(&pool->lock);
+  while (pool->pending > 0)
+    pthread_cond_wait(&pool->changed, &pool->lock);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+static void runParallelForItem(void *arg) {
+  ParallelForItem *item = (ParallelForItem *)arg;
+  ParallelForBatch *batch = item->batch;
+
+  batch->body(item->index, batch->context);
+
+  pthread_mutex_lock(&batch->pool->lock);
+  assert(batch->remaining > 0);
+  batch->remaining--;
+  pthread_mutex_unlock(&batch->pool->lock);
+}
+
+void parallelFor(ThreadPool *pool, unsigned int count, ParallelForBody body,
+                 void *context) {
+  assert(body != NULL);
+
+  /* Serial fallback: no pool, or nothing worth distributing. */
+  if (pool == NULL || count <= 1) {
+    for (unsigned int index = 0; index < count; ++index)
+      body(index, context);
+    return;
+  }
+
+  ParallelForBatch batch = {pool, body, context, count};
+  ParallelForItem *items =
+      (ParallelForItem *)malloc(count * sizeof(ParallelForItem));
+  ThreadPoolJob *jobs = (ThreadPoolJob *)malloc(count * sizeof(ThreadPoolJob));
+  if (items == NULL || jobs == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  /* Push in reverse, so the caller itself starts at index 0 while idle
+    workers steal from the other end of the range. */
+  const unsigned int own = ownQueue(pool);
+  announceJobs(pool, count);
+  for (unsigned int index = count; index > 0; --index) {
+    items[index - 1] = (ParallelForItem){&batch, index - 1};
+    jobs[index - 1] = (ThreadPoolJob){runParallelForItem, &items[index - 1],
+                                      false, NULL, NULL};
+    pushJob(pool, own, &jobs[index - 1]);
+  }
+
+  /* Help out instead of idling: this is what makes nesting safe, since a
+    task waiting on its own batch keeps draining the queues. */
+  pthread_mutex_lock(&pool->lock);
+  while (batch.remaining > 0) {
+    pthread_mutex_unlock(&pool->lock);
+    ThreadPoolJob *job = findJob(pool);
+    if (job != NULL)
+      runJob(pool, job);
+    pthread_mutex_lock(&pool->lock);
+    if (job == NULL && batch.remaining > 0 && pool->queued == 0)
+      pthread_cond_wait(&pool->changed, &pool->lock);
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  free(jobs);
+  free(items);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file threadpool.h
+ * @brief A small, fixed-size pthread pool for distributing independent
+ * tasks across cores.
+ * @details Tasks are plain function pointers with an opaque argument. The
+ * pool does not interpret the argument in any way; ownership of it remains
+ * the submitter's.
+ *
+ * Every worker owns a job queue. Jobs spawned from within a task are queued
+ * on the queue of the worker running that task, which processes them newest
+ * first; idle workers steal the oldest jobs from the queues of busy ones.
+ * This keeps recursive, irregular workloads (e.g. adaptive splitting) spread
+ * across all workers without a central bottleneck.
+ *
+ * Besides fire-and-forget submission, the pool offers @ref parallelFor,
+ * which blocks until a batch of indexed tasks has completed. The calling
+ * thread helps execute queued tasks while it waits, so @ref parallelFor may
+ * safely be nested inside tasks that themselves run on the pool.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stdbool.h>
+
+/**
+ * @brief A task to execute on the pool.
+ *
+ * @param[in,out] arg The argument passed at submission.
+ */
+typedef void (*ThreadPoolTask)(void *arg);
+
+/**
+ * @brief The body of a @ref parallelFor loop.
+ *
+ * @param[in]     index   The loop index, in [0, count).
+ * @param[in,out] context The context passed to @ref parallelFor.
+ */
+typedef void (*ParallelForBody)(unsigned int index, void *context);
+
+/**
+ * @brief An opaque pool of worker threads, see @ref newThreadPool.
+ */
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * @brief Create a new thread pool and start its workers.
+ *
+ * @param[in] workers The number of worker threads. If 0, then one worker
+ *                    per online processor is started.
+ * @return ThreadPool* A newly heap-allocated, running thread pool.
+ */
+ThreadPool *newThreadPool(unsigned int workers);
+
+/**
+ * @brief Wait for all submitted tasks to finish, then stop and deallocate
+ * the pool.
+ * @pre The given pool must not be NULL.
+ * @pre Must **not** be called from a task running on the pool itself.
+ */
+void delThreadPool(ThreadPool *pool);
+
+/**
+ * @brief The number of worker threads of the pool.
+ * @pre The given pool must not be NULL.
+ */
+unsigned int threadPoolSize(const ThreadPool *pool);
+
+/**
+ * @brief Queue a task for asynchronous execution.
+ * @pre \p pool and \p task may **not** be NULL.
+ * @post Ownership of \p arg remains the caller's, it must outlive the task.
+ *
+ * @param[in] pool The pool to execute the task on.
+ * @param[in] task The task to execute.
+ * @param[in] arg  The argument to pass to the task.
+ */
+void submitThreadPool(ThreadPool *pool, ThreadPoolTask task, void *arg);
+
+/**
+ * @brief Block until every task submitted so far has finished.
+ * @pre The given pool must not be NULL.
+ * @pre Must **not** be called from a task running on the pool itself,
+ * use @ref parallelFor for nested parallelism instead.
+ */
+void waitThreadPool(ThreadPool *pool);
+
+/**
+ * @brief Execute \p body for every index in [0, \p count) on the pool, and
+ * block until all of them have finished.
+ * @details The iterations may run in any order and on any thread, so each
+ * iteration must only write to the output slot(s) belonging to its index.
+ * Writing results by index is what keeps the output ordering deterministic.
+ *
+ * If \p pool is NULL, then the loop simply runs serially on the calling
+ * thread. This allows callers to treat parallelism as optional.
+ * @pre \p body may **not** be NULL.
+ *
+ * @param[in]     pool    The pool to distribute the iterations over, or NULL.
+ * @param[in]     count   The number of iterations.
+ * @param[in]     body    The loop body.
+ * @param[in,out] context The context passed to each iteration.
+ */
+void parallelFor(ThreadPool *pool, unsigned int count, ParallelForBody body,
+                 void *context);
+
+#endif
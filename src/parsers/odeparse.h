@@ -12,7 +12,10 @@
 #ifndef ODEPARSE_H
 #define ODEPARSE_H
 
+#include "intervalbox.h"
 #include "sysode.h"
+#include <stdbool.h>
+#include <stdio.h>
 
 /**
  * @brief Parse a string representation of a system of ODEs into a
@@ -21,10 +24,115 @@
  * of a system of ODEs, and produce the second parameter, a structured
  * representation of the input, as output.
  *
+ * The ODEs may be preceded by parameter declarations, e.g.
+ *
+ *     param mu;
+ *     x' = y; y' = mu * (1 - x^2) * y - x;
+ *
+ * A parameter is a constant that is left symbolic, so the system can be
+ * analyzed for many of its values at once, see @ref tmsweep.h. It may not
+ * also be a state variable. The word param is not reserved: it may still
+ * name a variable or a function.
+ *
+ * Safe to call from multiple threads at once, as every call uses its own
+ * @ref OdeParser.
+ *
  * @return int A return code.
  */
 int parseOdeString(const char *, ODEList **);
-void setOdeInputString(const char *);
-void endOdeScan(void);
+
+/**
+ * @brief The state of a reentrant parser, see @ref newOdeParser.
+ * @details A parser may be reused for any number of inputs, but by one
+ * thread at a time. Distinct parsers may be used concurrently.
+ */
+typedef struct OdeParser OdeParser;
+
+/**
+ * @brief Create a new parser.
+ *
+ * @return OdeParser* A newly heap-allocated parser.
+ */
+OdeParser *newOdeParser(void);
+
+/**
+ * @brief Deallocate the given parser.
+ * @pre The given parser must not be NULL.
+ */
+void delOdeParser(OdeParser *parser);
+
+/**
+ * @brief Set whether the parser normalizes the vector fields it parses.
+ * @details Normalized vector fields are compact and canonical, see
+ * @ref normalizeOdeList, which speeds up every later stage. Parsers do not
+ * normalize by default, so the parsed systems are exactly as written.
+ * @pre The given parser must not be NULL.
+ *
+ * @param[in,out] parser    The parser to configure.
+ * @param[in]     normalize Whether to normalize.
+ */
+void setOdeParserNormalize(OdeParser *parser, const bool normalize);
+
+/**
+ * @brief Parse a string representation of a system of ODEs
+ * with the given parser.
+ * @see parseOdeString
+ * @pre \p parser and \p in must **not** be NULL.
+ *
+ * @param[in,out] parser The parser to use.
+ * @param[in]     in     The string to parse.
+ * @param[out]    ptlist The parsed structure, only meaningful on success.
+ * @return int A return code, 0 on success.
+ */
+int parseOdeStringWith(OdeParser *parser, const char *in, ODEList **ptlist);
+
+/**
+ * @brief Parse a stream containing a representation of a system of ODEs
+ * with the given parser.
+ * @details The stream is read in blocks, so memory use does not grow with
+ * the size of the input, only with the size of the result.
+ * @see parseOdeString
+ * @pre \p parser and \p in must **not** be NULL.
+ *
+ * @param[in,out] parser The parser to use.
+ * @param[in]     in     The stream to parse, up to its end.
+ * @param[out]    ptlist The parsed structure, only meaningful on success.
+ * @return int A return code, 0 on success.
+ */
+int parseOdeFileWith(OdeParser *parser, FILE *in, ODEList **ptlist);
+
+/**
+ * @brief Parse the file behind a file descriptor containing a
+ * representation of a system of ODEs with the given parser.
+ * @details A regular file is mapped into memory and scanned in place,
+ * without copying it. Any other file, e.g. a pipe, is streamed as by
+ * @ref parseOdeFileWith.
+ * @see parseOdeString
+ * @pre \p parser must **not** be NULL.
+ * @post \p fd remains open and owned by the caller.
+ *
+ * @param[in,out] parser The parser to use.
+ * @param[in]     fd     A file descriptor open for reading.
+ * @param[out]    ptlist The parsed structure, only meaningful on success.
+ * @return int A return code, 0 on success.
+ */
+int parseOdeFdWith(OdeParser *parser, const int fd, ODEList **ptlist);
+
+/**
+ * @brief The parameters declared in the last input of the parser.
+ * @pre The given parser must not be NULL.
+ *
+ * @return const SymbolTable* The parameter names, owned by the parser and
+ * valid until its next parse.
+ */
+const SymbolTable *odeParserParameters(const OdeParser *parser);
+
+/**
+ * @brief The line of the syntax error in the last input of the parser.
+ * @pre The given parser must not be NULL.
+ *
+ * @return int The line number, or 0 if the last parse succeeded.
+ */
+int odeParserErrorLine(const OdeParser *parser);
 
 #endif
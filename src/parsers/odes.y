@@ -4,17 +4,44 @@
 /* To be compatible with Bison 3.0.4 */
 %define parse.error verbose
 %define api.prefix {odes}
+%define api.pure full
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {OdeParser *parser}
 
 %code top {
   #include "odeparse.h"
-  #include "odes.lex.h"
   #include "sysode.h"
+  #include "trace.h"
+  #include "utils.h"
+  #include <assert.h>
   #include <stddef.h>
   #include <stdio.h>
+  #include <stdlib.h>
+  #include <string.h>
+  #include <unistd.h>
+}
+%code requires {
+  #include "odeparse.h"
+
+  /* Shared with the scanner, which defines it the same way. */
+  #ifndef YY_TYPEDEF_YY_SCANNER_T
+  #define YY_TYPEDEF_YY_SCANNER_T
+  typedef void *yyscan_t;
+  #endif
 }
 %code {
-  void yyerror(const char *);
-  ODEList *finlist;
+  #include "odes.lex.h"
+
+  /* The state of one parse, see odeparse.h */
+  struct OdeParser {
+    yyscan_t scanner;
+    ODEList *result;
+    SymbolTable *parameters;
+    int errorLine;
+    bool normalize;
+  };
+
+  void yyerror(yyscan_t, OdeParser *, const char *);
 }
 
 /* tokens that will be used */
@@ -23,7 +50,7 @@
   ExpTree *tree;
   char *str;
 }
-%token SCOLON LPAR RPAR UNKNOWN
+%token SCOLON COMMA LPAR RPAR UNKNOWN
 %token ADD SUB MUL DIV EXP EQUAL PRIME
 %token <str> FLOAT INTEGER IDENT
 %type <list> odelist odedef
@@ -31,9 +58,38 @@
 
 %%
 
-spec: odelist { finlist = $1; }
+spec: paramlist odelist  {
+        /* A parameter may not also be a state variable. */
+        for (ODEList *ode = $2; ode != NULL; ode = ode->next) {
+          if (findSymbol(parser->parameters, ode->fun) != SYMBOL_NOT_FOUND) {
+            yyerror(scanner, parser, "parameter used as a state variable");
+            delOdeList($2);
+            YYABORT;
+          }
+        }
+        parser->result = $2;
+      }
     ;
 
+/* "param" is not reserved, so that it stays usable as a name: a declaration
+  is told apart from an ODE by the identifier that follows it. */
+paramlist: %empty
+         | paramlist IDENT paramnames SCOLON  {
+             bool declaration = strcmp($2, "param") == 0;
+             free($2);
+             if (!declaration) {
+               yyerror(scanner, parser, "expected \"param\" or an ODE");
+               YYABORT;
+             }
+           }
+         ;
+
+paramnames: IDENT                   { internSymbol(parser->parameters, $1);
+                                      free($1); }
+          | paramnames COMMA IDENT  { internSymbol(parser->parameters, $3);
+                                      free($3); }
+          ;
+
 odelist: odedef          { $$ = $1; }
        | odelist odedef  { $$ = appOdeElem($1, $2); }
        ;
@@ -69,14 +125,118 @@ number: FLOAT    { $$ = newExpLeaf(EXP_NUM, $1); free($1); }
 
 %%
 
-void yyerror(const char *str) {
-  fprintf(stderr, "[line %d] Error: %s\n", odeslineno, str);
+void yyerror(yyscan_t scanner, OdeParser *parser, const char *str) {
+  parser->errorLine = odesget_lineno(scanner);
+  fprintf(stderr, "[line %d] Error: %s\n", parser->errorLine, str);
+}
+
+OdeParser *newOdeParser(void) {
+  OdeParser *parser = (OdeParser *)malloc(sizeof(OdeParser));
+  if (parser == NULL || odeslex_init(&parser->scanner) != 0) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  parser->result = NULL;
+  parser->parameters = newSymbolTable();
+  parser->errorLine = 0;
+  parser->normalize = false;
+  return parser;
+}
+
+void delOdeParser(OdeParser *parser) {
+  assert(parser != NULL);
+
+  odeslex_destroy(parser->scanner);
+  delSymbolTable(parser->parameters);
+  free(parser);
+}
+
+void setOdeParserNormalize(OdeParser *parser, const bool normalize) {
+  assert(parser != NULL);
+
+  parser->normalize = normalize;
+}
+
+const SymbolTable *odeParserParameters(const OdeParser *parser) {
+  assert(parser != NULL);
+
+  return parser->parameters;
+}
+
+int odeParserErrorLine(const OdeParser *parser) {
+  assert(parser != NULL);
+
+  return parser->errorLine;
+}
+
+/* Parse the given input buffer of the scanner, and delete it. */
+static int parseOdeBuffer(OdeParser *parser, YY_BUFFER_STATE buffer,
+                          ODEList **ptlist) {
+  /* Every parse starts afresh, only the scanner is reused. */
+  TRACE_BEGIN(span, "parseOdes");
+  parser->result = NULL;
+  delSymbolTable(parser->parameters);
+  parser->parameters = newSymbolTable();
+  parser->errorLine = 0;
+  odes_switch_to_buffer(buffer, parser->scanner);
+  odesset_lineno(1, parser->scanner);
+  int rv = yyparse(parser->scanner, parser);
+  odes_delete_buffer(buffer, parser->scanner);
+  if (rv == 0 && parser->normalize)
+    normalizeOdeList(parser->result);
+  *ptlist = parser->result;
+  TRACE_END(span);
+  return rv;
+}
+
+int parseOdeStringWith(OdeParser *parser, const char *in, ODEList **ptlist) {
+  assert(parser != NULL);
+  assert(in != NULL);
+
+  return parseOdeBuffer(parser, odes_scan_string(in, parser->scanner), ptlist);
+}
+
+int parseOdeFileWith(OdeParser *parser, FILE *in, ODEList **ptlist) {
+  assert(parser != NULL);
+  assert(in != NULL);
+
+  return parseOdeBuffer(
+      parser, odes_create_buffer(in, YY_BUF_SIZE, parser->scanner), ptlist);
+}
+
+int parseOdeFdWith(OdeParser *parser, const int fd, ODEList **ptlist) {
+  assert(parser != NULL);
+
+  /* Scan a mapped file in place. Flex requires the buffer to end in two
+    NUL bytes, and temporarily writes into it while scanning. */
+  size_t length;
+  char *data = mapFile(fd, 2, &length);
+  if (data != NULL) {
+    YY_BUFFER_STATE buffer =
+        odes_scan_buffer(data, length + 2, parser->scanner);
+    int rv = parseOdeBuffer(parser, buffer, ptlist);
+    unmapFile(data, length, 2);
+    return rv;
+  }
+
+  /* Stream anything else, e.g. a pipe. The stream closes a duplicate, so
+    the caller keeps ownership of fd. */
+  int copy = dup(fd);
+  FILE *in = (copy < 0) ? NULL : fdopen(copy, "r");
+  if (in == NULL) {
+    if (copy >= 0)
+      close(copy);
+    *ptlist = NULL;
+    return -1;
+  }
+  int rv = parseOdeFileWith(parser, in, ptlist);
+  fclose(in);
+  return rv;
 }
 
 int parseOdeString(const char *in, ODEList **ptlist) {
-  setOdeInputString(in);
-  int rv = yyparse();
-  endOdeScan();
-  *ptlist = finlist;
+  OdeParser *parser = newOdeParser();
+  int rv = parseOdeStringWith(parser, in, ptlist);
+  delOdeParser(parser);
   return rv;
 }
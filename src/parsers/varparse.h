@@ -14,6 +14,7 @@
 #define VARPARSE_H
 
 #include "variables.h"
+#include <stdio.h>
 
 /**
  * @brief Parse a string representation of the domains of a vector of variables
@@ -22,10 +23,85 @@
  * of the domains that a vector of variables is restricted to, and produce
  * the second parameter, a structured representation of the input, as output.
  *
+ * Safe to call from multiple threads at once, as every call uses its own
+ * @ref VarParser.
+ *
  * @return int A return code.
  */
 int parseVarString(const char *, Domain **);
-void setVarInputString(const char *);
-void endVarScan(void);
+
+/**
+ * @brief The state of a reentrant parser, see @ref newVarParser.
+ * @details A parser may be reused for any number of inputs, but by one
+ * thread at a time. Distinct parsers may be used concurrently.
+ */
+typedef struct VarParser VarParser;
+
+/**
+ * @brief Create a new parser.
+ *
+ * @return VarParser* A newly heap-allocated parser.
+ */
+VarParser *newVarParser(void);
+
+/**
+ * @brief Deallocate the given parser.
+ * @pre The given parser must not be NULL.
+ */
+void delVarParser(VarParser *parser);
+
+/**
+ * @brief Parse a string representation of the domains of a vector of variables
+ * with the given parser.
+ * @see parseVarString
+ * @pre \p parser and \p in must **not** be NULL.
+ *
+ * @param[in,out] parser The parser to use.
+ * @param[in]     in     The string to parse.
+ * @param[out]    ptlist The parsed structure, only meaningful on success.
+ * @return int A return code, 0 on success.
+ */
+int parseVarStringWith(VarParser *parser, const char *in, Domain **ptlist);
+
+/**
+ * @brief Parse a stream containing a representation of the domains of a
+ * vector of variables with the given parser.
+ * @details The stream is read in blocks, so memory use does not grow with
+ * the size of the input, only with the size of the result.
+ * @see parseVarString
+ * @pre \p parser and \p in must **not** be NULL.
+ *
+ * @param[in,out] parser The parser to use.
+ * @param[in]     in     The stream to parse, up to its end.
+ * @param[out]    ptlist The parsed structure, only meaningful on success.
+ * @return int A return code, 0 on success.
+ */
+int parseVarFileWith(VarParser *parser, FILE *in, Domain **ptlist);
+
+/**
+ * @brief Parse the file behind a file descriptor containing a
+ * representation of the domains of a vector of variables with the given
+ * parser.
+ * @details A regular file is mapped into memory and scanned in place,
+ * without copying it. Any other file, e.g. a pipe, is streamed as by
+ * @ref parseVarFileWith.
+ * @see parseVarString
+ * @pre \p parser must **not** be NULL.
+ * @post \p fd remains open and owned by the caller.
+ *
+ * @param[in,out] parser The parser to use.
+ * @param[in]     fd     A file descriptor open for reading.
+ * @param[out]    ptlist The parsed structure, only meaningful on success.
+ * @return int A return code, 0 on success.
+ */
+int parseVarFdWith(VarParser *parser, const int fd, Domain **ptlist);
+
+/**
+ * @brief The line of the syntax error in the last input of the parser.
+ * @pre The given parser must not be NULL.
+ *
+ * @return int The line number, or 0 if the last parse succeeded.
+ */
+int varParserErrorLine(const VarParser *parser);
 
 #endif
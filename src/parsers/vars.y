@@ -3,17 +3,41 @@
 /* To be compatible with Bison 3.0.4 */
 %define parse.error verbose
 %define api.prefix {vars}
+%define api.pure full
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {VarParser *parser}
 
 %code top {
   #include "varparse.h"
-  #include "vars.lex.h"
+  #include "trace.h"
+  #include "utils.h"
   #include "variables.h"
+  #include <assert.h>
   #include <stddef.h>
   #include <stdio.h>
+  #include <stdlib.h>
+  #include <unistd.h>
+}
+%code requires {
+  #include "varparse.h"
+
+  /* Shared with the scanner, which defines it the same way. */
+  #ifndef YY_TYPEDEF_YY_SCANNER_T
+  #define YY_TYPEDEF_YY_SCANNER_T
+  typedef void *yyscan_t;
+  #endif
 }
 %code {
-  void yyerror(const char *);
-  Domain *finlist;
+  #include "vars.lex.h"
+
+  /* The state of one parse, see varparse.h */
+  struct VarParser {
+    yyscan_t scanner;
+    Domain *result;
+    int errorLine;
+  };
+
+  void yyerror(yyscan_t, VarParser *, const char *);
 }
 
 /* tokens that will be used */
@@ -33,7 +57,7 @@
 
 %%
 
-spec: varlist { finlist = $1; }
+spec: varlist { parser->result = $1; }
     ;
 
 varlist: vardef          { $$ = $1; }
@@ -52,14 +76,99 @@ number: FLOAT    { $$ = $1; }
 
 %%
 
-void yyerror(const char *str) {
-  fprintf(stderr, "[line %d] Error: %s\n", varslineno, str);
+void yyerror(yyscan_t scanner, VarParser *parser, const char *str) {
+  parser->errorLine = varsget_lineno(scanner);
+  fprintf(stderr, "[line %d] Error: %s\n", parser->errorLine, str);
+}
+
+VarParser *newVarParser(void) {
+  VarParser *parser = (VarParser *)malloc(sizeof(VarParser));
+  if (parser == NULL || varslex_init(&parser->scanner) != 0) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  parser->result = NULL;
+  parser->errorLine = 0;
+  return parser;
+}
+
+void delVarParser(VarParser *parser) {
+  assert(parser != NULL);
+
+  varslex_destroy(parser->scanner);
+  free(parser);
+}
+
+int varParserErrorLine(const VarParser *parser) {
+  assert(parser != NULL);
+
+  return parser->errorLine;
+}
+
+/* Parse the given input buffer of the scanner, and delete it. */
+static int parseVarBuffer(VarParser *parser, YY_BUFFER_STATE buffer,
+                          Domain **ptlist) {
+  /* Every parse starts afresh, only the scanner is reused. */
+  TRACE_BEGIN(span, "parseVars");
+  parser->result = NULL;
+  parser->errorLine = 0;
+  vars_switch_to_buffer(buffer, parser->scanner);
+  varsset_lineno(1, parser->scanner);
+  int rv = yyparse(parser->scanner, parser);
+  vars_delete_buffer(buffer, parser->scanner);
+  *ptlist = parser->result;
+  TRACE_END(span);
+  return rv;
+}
+
+int parseVarStringWith(VarParser *parser, const char *in, Domain **ptlist) {
+  assert(parser != NULL);
+  assert(in != NULL);
+
+  return parseVarBuffer(parser, vars_scan_string(in, parser->scanner), ptlist);
+}
+
+int parseVarFileWith(VarParser *parser, FILE *in, Domain **ptlist) {
+  assert(parser != NULL);
+  assert(in != NULL);
+
+  return parseVarBuffer(
+      parser, vars_create_buffer(in, YY_BUF_SIZE, parser->scanner), ptlist);
+}
+
+int parseVarFdWith(VarParser *parser, const int fd, Domain **ptlist) {
+  assert(parser != NULL);
+
+  /* Scan a mapped file in place. Flex requires the buffer to end in two
+    NUL bytes, and temporarily writes into it while scanning. */
+  size_t length;
+  char *data = mapFile(fd, 2, &length);
+  if (data != NULL) {
+    YY_BUFFER_STATE buffer =
+        vars_scan_buffer(data, length + 2, parser->scanner);
+    int rv = parseVarBuffer(parser, buffer, ptlist);
+    unmapFile(data, length, 2);
+    return rv;
+  }
+
+  /* Stream anything else, e.g. a pipe. The stream closes a duplicate, so
+    the caller keeps ownership of fd. */
+  int copy = dup(fd);
+  FILE *in = (copy < 0) ? NULL : fdopen(copy, "r");
+  if (in == NULL) {
+    if (copy >= 0)
+      close(copy);
+    *ptlist = NULL;
+    return -1;
+  }
+  int rv = parseVarFileWith(parser, in, ptlist);
+  fclose(in);
+  return rv;
 }
 
 int parseVarString(const char *in, Domain **ptlist) {
-  setVarInputString(in);
-  int rv = yyparse();
-  endVarScan();
-  *ptlist = finlist;
+  VarParser *parser = newVarParser();
+  int rv = parseVarStringWith(parser, in, ptlist);
+  delVarParser(parser);
   return rv;
 }
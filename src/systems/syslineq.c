@@ -0,0 +1,241 @@
+#include "syslineq.h"
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Express the expression as an affine form over the state variables of the
+  system: row[0..dim-1] are the coefficients and row[dim] the constant, each
+  an enclosure. Returns false if the expression is not affine. */
+static bool affineForm(const ExpTree *exp, const ODEList *system,
+                       const unsigned int dim, Interval *row);
+
+static bool isConstantForm(const Interval *row, const unsigned int dim) {
+  for (unsigned int it = 0; it < dim; ++it)
+    if (row[it].left != 0 || row[it].right != 0)
+      return false;
+  return true;
+}
+
+static Interval *newForm(const unsigned int dim) {
+  Interval *row = (Interval *)calloc(dim + 1, sizeof(Interval));
+  if (row == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  return row;
+}
+
+/* An enclosure of base^exponent for a constant base, or false if it is not
+  defined for every value of the base. */
+static bool constantPower(const Interval *base, const char *exponent,
+                          Interval *power) {
+  const double value = atof(exponent);
+  if (value == floor(value) && fabs(value) <= UINT_MAX) {
+    *power = powInterval(base, (unsigned int)fabs(value));
+    if (value >= 0)
+      return true;
+    if (elemInterval(0, power))
+      return false;
+    Interval one = newInterval(1, 1);
+    *power = divInterval(&one, power);
+    return true;
+  }
+
+  /* b^e = exp(e log(b)) for b > 0 */
+  if (!(base->left > 0))
+    return false;
+  Interval enclosure = strtoInterval(exponent);
+  Interval logarithm = logInterval(base);
+  Interval product = mulInterval(&enclosure, &logarithm);
+  *power = expInterval(&product);
+  return true;
+}
+
+static bool affineForm(const ExpTree *exp, const ODEList *system,
+                       const unsigned int dim, Interval *row) {
+  assert(exp != NULL);
+
+  for (unsigned int it = 0; it <= dim; ++it)
+    row[it] = newInterval(0, 0);
+
+  switch (exp->type) {
+  case EXP_NUM:
+    row[dim] = strtoInterval(exp->data);
+    return true;
+
+  /* Only state variables are allowed; time or unknown variables are not. */
+  case EXP_VAR: {
+    unsigned int index = 0;
+    for (const ODEList *ode = system; ode != NULL; ode = ode->next, ++index) {
+      if (strcmp(ode->fun, exp->data) == 0) {
+        row[index] = newInterval(1, 1);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  case EXP_NEG:
+    if (!affineForm(exp->left, system, dim, row))
+      return false;
+    for (unsigned int it = 0; it <= dim; ++it)
+      row[it] = negInterval(&row[it]);
+    return true;
+
+  case EXP_ADD_OP:
+  case EXP_SUB_OP:
+  case EXP_MUL_OP:
+  case EXP_DIV_OP: {
+    Interval *right = newForm(dim);
+    bool affine = affineForm(exp->left, system, dim, row) &&
+                  affineForm(exp->right, system, dim, right);
+
+    if (affine && exp->type == EXP_ADD_OP) {
+      for (unsigned int it = 0; it <= dim; ++it)
+        row[it] = addInterval(&row[it], &right[it]);
+    } else if (affine && exp->type == EXP_SUB_OP) {
+      for (unsigned int it = 0; it <= dim; ++it)
+        row[it] = subInterval(&row[it], &right[it]);
+    } else if (affine && exp->type == EXP_MUL_OP) {
+      /* At least one of the factors must be constant. */
+      if (isConstantForm(row, dim)) {
+        Interval factor = row[dim];
+        for (unsigned int it = 0; it <= dim; ++it)
+          row[it] = mulInterval(&factor, &right[it]);
+      } else if (isConstantForm(right, dim)) {
+        for (unsigned int it = 0; it <= dim; ++it)
+          row[it] = mulInterval(&row[it], &right[dim]);
+      } else {
+        affine = false;
+      }
+    } else if (affine && exp->type == EXP_DIV_OP) {
+      /* Only division by a nonzero constant is affine. */
+      if (isConstantForm(right, dim) && !elemInterval(0, &right[dim])) {
+        for (unsigned int it = 0; it <= dim; ++it)
+          row[it] = divInterval(&row[it], &right[dim]);
+      } else {
+        affine = false;
+      }
+    }
+
+    free(right);
+    return affine;
+  }
+
+  /* x^0 and x^1 are affine, as is any power of a constant. */
+  case EXP_EXP_OP: {
+    if (exp->right->type != EXP_NUM)
+      return false;
+    double exponent = atof(exp->right->data);
+    if (!affineForm(exp->left, system, dim, row))
+      return false;
+
+    if (isConstantForm(row, dim)) {
+      Interval base = row[dim];
+      return constantPower(&base, exp->right->data, &row[dim]);
+    }
+    if (exponent == 0) {
+      for (unsigned int it = 0; it < dim; ++it)
+        row[it] = newInterval(0, 0);
+      row[dim] = newInterval(1, 1);
+      return true;
+    }
+    return exponent == 1;
+  }
+
+  default:
+    return false;
+  }
+}
+
+LinearSystem *newLinearSystem(const ODEList *system) {
+  assert(system != NULL);
+
+  const unsigned int dim = lengthOdeList(system);
+  Interval *row = newForm(dim);
+  Interval *matrix =
+      (Interval *)calloc((size_t)dim * dim + 1, sizeof(Interval));
+  Interval *offset = (Interval *)calloc(dim + 1, sizeof(Interval));
+  if (matrix == NULL || offset == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  unsigned int index = 0;
+  for (const ODEList *ode = system; ode != NULL; ode = ode->next, ++index) {
+    if (!affineForm(ode->exp, system, dim, row)) {
+      free(row);
+      free(matrix);
+      free(offset);
+      return NULL;
+    }
+    for (unsigned int it = 0; it < dim; ++it)
+      matrix[index * dim + it] = row[it];
+    offset[index] = row[dim];
+  }
+  free(row);
+
+  LinearSystem *linear = (LinearSystem *)malloc(sizeof(LinearSystem));
+  char **vars = (char **)malloc((dim + 1) * sizeof(char *));
+  if (linear == NULL || vars == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  index = 0;
+  for (const ODEList *ode = system; ode != NULL; ode = ode->next, ++index)
+    vars[index] = strdup(ode->fun);
+
+  linear->dim = dim;
+  linear->vars = vars;
+  linear->matrix = matrix;
+  linear->offset = offset;
+  return linear;
+}
+
+bool isAffineOdeList(const ODEList *system) {
+  LinearSystem *linear = newLinearSystem(system);
+  if (linear == NULL)
+    return false;
+  delLinearSystem(linear);
+  return true;
+}
+
+void delLinearSystem(LinearSystem *system) {
+  assert(system != NULL);
+
+  for (unsigned int it = 0; it < system->dim; ++it)
+    free(system->vars[it]);
+  free(system->vars);
+  free(system->matrix);
+  free(system->offset);
+  free(system);
+}
+
+/* Print a point coefficient as a number, else as an interval. Adding zero
+  turns negative zeros into positive ones. */
+static void printCoefficient(const Interval *coefficient, FILE *where) {
+  if (coefficient->left == coefficient->right)
+    fprintf(where, "%g", coefficient->left + 0.0);
+  else
+    fprintf(where, "[%g, %g]", coefficient->left, coefficient->right);
+}
+
+void printLinearSystem(const LinearSystem *system, FILE *where) {
+  assert(system != NULL);
+
+  for (unsigned int row = 0; row < system->dim; ++row) {
+    fprintf(where, "%s' = [", system->vars[row]);
+    for (unsigned int col = 0; col < system->dim; ++col) {
+      fprintf(where, (col == 0) ? "" : " ");
+      printCoefficient(&system->matrix[row * system->dim + col], where);
+    }
+    fprintf(where, " | ");
+    printCoefficient(&system->offset[row], where);
+    fprintf(where, "]\n");
+  }
+}
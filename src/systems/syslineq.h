@@ -1,6 +1,11 @@
 #ifndef SYSLINEQ_H
 #define SYSLINEQ_H
 
+#include "interval.h"
+#include "sysode.h"
+#include <stdbool.h>
+#include <stdio.h>
+
 /* Ordinary differential expression trees */
 typedef enum LINEQExpType {
   LINEQ_NUM,
@@ -38,4 +43,60 @@ LINEQList *appLineqElem(LINEQList *, LINEQList *);
 void delLineqList(LINEQList *);
 void printLineqList(LINEQList *, FILE *);
 
+/**
+ * @brief A dense representation of an affine system of ODEs,
+ * \f$ \dot{x} = Ax + b \f$.
+ * @details Affine systems have closed form flows, \f$ x(t) = e^{At} x(0) +
+ * \int_0^t e^{As} b\,ds \f$, so they do not need the symbolic Taylor model
+ * pipeline. The coefficients are enclosures, since numbers such as 0.1 and
+ * constant subexpressions such as 1 / 3 are not representable.
+ *
+ * @invariant The members @ref LinearSystem.vars, @ref LinearSystem.matrix and
+ * @ref LinearSystem.offset hold dim, dim * dim and dim elements.
+ */
+typedef struct LinearSystem {
+  /// @brief The number of state variables.
+  unsigned int dim;
+  /// @brief The state variables, in the order of the ODEs.
+  char **vars;
+  /// @brief An enclosure of the matrix A, row-major. Row i holds the
+  ///        coefficients of \f$ \dot{x}_i \f$.
+  Interval *matrix;
+  /// @brief An enclosure of the constant vector b.
+  Interval *offset;
+} LinearSystem;
+
+/**
+ * @brief Convert a system of ODEs into dense affine form.
+ * @details A system is affine iff. every vector field component is a
+ * constant plus a weighted sum of state variables, e.g. x' = 2 * (x - y) + 1.
+ * Constant subexpressions, such as 3 / 2 or 2^3, may appear anywhere; they
+ * are enclosed with outward-rounded interval arithmetic.
+ * Products of state variables, functions of them or dependencies on time
+ * make the system non-affine.
+ * @pre The ODEs \p system may **not** be NULL.
+ *
+ * @param[in] system The system of ODEs to convert.
+ * @return LinearSystem* A newly heap-allocated affine system, or NULL if
+ * the system is not affine.
+ */
+LinearSystem *newLinearSystem(const ODEList *system);
+
+/**
+ * @brief Verify if the system of ODEs is affine, see @ref newLinearSystem.
+ * @pre The ODEs \p system may **not** be NULL.
+ */
+bool isAffineOdeList(const ODEList *system);
+
+/**
+ * @brief Deallocate the given affine system.
+ * @pre The given system may **not** be NULL.
+ */
+void delLinearSystem(LinearSystem *system);
+
+/**
+ * @brief Print the affine system, one row of [A | b] per line.
+ */
+void printLinearSystem(const LinearSystem *system, FILE *where);
+
 #endif
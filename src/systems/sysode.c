@@ -4,6 +4,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 ODEList *newOdeList(char *fun, ExpTree *exp) {
   ODEList *list = (ODEList *)malloc(sizeof(ODEList));
@@ -25,6 +26,32 @@ ODEList *newOdeElem(ODEList *tail, char *fun, ExpTree *exp) {
   return appOdeElem(tail, head);
 }
 
+unsigned int lengthOdeList(const ODEList *list) {
+  unsigned int length = 0;
+  for (; list != NULL; list = list->next)
+    ++length;
+  return length;
+}
+
+bool isEqualOdeList(const ODEList *left, const ODEList *right) {
+  for (; left != NULL && right != NULL;
+       left = left->next, right = right->next) {
+    if (strcmp(left->fun, right->fun) != 0)
+      return false;
+    if (!isEqual(left->exp, right->exp))
+      return false;
+  }
+  return left == NULL && right == NULL;
+}
+
+void normalizeOdeList(ODEList *list) {
+  for (; list != NULL; list = list->next) {
+    ExpTree *normalized = normalizeExpTree(list->exp);
+    delExpTree(list->exp);
+    list->exp = normalized;
+  }
+}
+
 void delOdeList(ODEList *list) {
   if (list->next != NULL)
     delOdeList(list->next);
@@ -15,6 +15,7 @@
 #include <stdio.h>
 
 #include "funexp.h"
+#include "polynomial.h"
 
 /* Lists of ODEs */
 
@@ -85,6 +86,30 @@ ODEList *appOdeElem(ODEList *tail, ODEList *head);
  */
 ODEList *newOdeElem(ODEList *tail, char *fun, ExpTree *exp);
 
+/**
+ * @brief Compute the number of elements in the list.
+ *
+ * @return unsigned int The list length, 0 for the empty (NULL) list.
+ */
+unsigned int lengthOdeList(const ODEList *list);
+
+/**
+ * @brief Check whether two systems are identical, i.e. they have the same
+ * components in the same order, with structurally equal vector fields.
+ *
+ * @return true  The systems are identical.
+ * @return false The systems differ.
+ */
+bool isEqualOdeList(const ODEList *left, const ODEList *right);
+
+/**
+ * @brief Normalize the vector fields of the list in place, see
+ * @ref normalizeExpTree.
+ *
+ * @param[in,out] list The list to normalize, may be NULL.
+ */
+void normalizeOdeList(ODEList *list);
+
 /**
  * @brief Deallocate the given list.
  * @pre The given list must not be NULL.
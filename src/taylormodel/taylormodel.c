@@ -1,4 +1,12 @@
 #include "taylormodel.h"
+#include "counters.h"
+#include "trace.h"
+#include "tmbernstein.h"
+#include "tmbranch.h"
+#include "tmcentered.h"
+#include "tmcollect.h"
+#include <pthread.h>
+#include <stdatomic.h>
 
 TaylorModel *newTaylorModel(char *const fun, ExpTree *const exp,
                             const Interval remainder) {
@@ -87,20 +95,52 @@ TaylorModel *reverseTaylorModel(TaylorModel *const list) {
   return lastElem;
 }
 
-Interval evaluateExpTree(const ExpTree *const tree,
-                         const Domain *const domains) {
-  assert(domains != NULL);
+/* The variable domains of an interval evaluation: either a domain list, or
+  a box indexed by the symbol table. */
+typedef struct IntervalEnv {
+  const Domain *domains;
+  const SymbolTable *symbols;
+  const IntervalBox *box;
+} IntervalEnv;
+
+/* Apply the named function to an interval argument. */
+static Interval evaluateFunInterval(const char *const name,
+                                    const Interval *const arg) {
+  if (strcmp(name, "sqrt") == 0)
+    return sqrtInterval(arg);
+  if (strcmp(name, "sin") == 0)
+    return sinInterval(arg);
+  if (strcmp(name, "cos") == 0)
+    return cosInterval(arg);
+  if (strcmp(name, "exp") == 0)
+    return expInterval(arg);
+  if (strcmp(name, "log") == 0)
+    return logInterval(arg);
+  if (strcmp(name, "atan") == 0)
+    return atanInterval(arg);
+  if (strcmp(name, "tanh") == 0)
+    return tanhInterval(arg);
+
+  /* Unknown function, abort */
+  assert(false);
+  return newInterval(0, 0);
+}
+
+/* The recursive kernel of evaluateExpTree and evaluateExpTreeBox, which runs
+  inside a single outward rounding scope. */
+static Interval evaluateIntervalTree(const ExpTree *const tree,
+                                     const IntervalEnv *const env) {
   assert(tree != NULL);
 
   switch (tree->type) {
-  /* A number constant becomes a degenerate interval. */
+  /* A number constant becomes the tightest interval around it, which is
+    degenerate if the number is representable. */
   case EXP_NUM: {
     assert(tree->left == NULL);
     assert(tree->right == NULL);
     assert(tree->data != NULL);
 
-    double value = atof(tree->data);
-    return newInterval(value, value);
+    return strtoInterval(tree->data);
   }
 
   /* A variable is substituted by the corresponding interval domain. */
@@ -109,7 +149,15 @@ Interval evaluateExpTree(const ExpTree *const tree,
     assert(tree->right == NULL);
     assert(tree->data != NULL);
 
-    const Domain *dom = domains;
+    if (env->box != NULL) {
+      unsigned int id = findSymbol(env->symbols, tree->data);
+      /* The expression tree contains a variable whose valuation is
+        unknown. */
+      assert(id < env->box->dim);
+      return env->box->data[id];
+    }
+
+    const Domain *dom = env->domains;
     while (dom != NULL) {
       assert(dom->var != NULL);
 
@@ -128,8 +176,8 @@ Interval evaluateExpTree(const ExpTree *const tree,
     assert(tree->left != NULL);
     assert(tree->right != NULL);
 
-    Interval left = evaluateExpTree(tree->left, domains);
-    Interval right = evaluateExpTree(tree->right, domains);
+    Interval left = evaluateIntervalTree(tree->left, env);
+    Interval right = evaluateIntervalTree(tree->right, env);
     return addInterval(&left, &right);
   }
 
@@ -137,8 +185,8 @@ Interval evaluateExpTree(const ExpTree *const tree,
     assert(tree->left != NULL);
     assert(tree->right != NULL);
 
-    Interval left = evaluateExpTree(tree->left, domains);
-    Interval right = evaluateExpTree(tree->right, domains);
+    Interval left = evaluateIntervalTree(tree->left, env);
+    Interval right = evaluateIntervalTree(tree->right, env);
     return subInterval(&left, &right);
   }
 
@@ -146,8 +194,8 @@ Interval evaluateExpTree(const ExpTree *const tree,
     assert(tree->left != NULL);
     assert(tree->right != NULL);
 
-    Interval left = evaluateExpTree(tree->left, domains);
-    Interval right = evaluateExpTree(tree->right, domains);
+    Interval left = evaluateIntervalTree(tree->left, env);
+    Interval right = evaluateIntervalTree(tree->right, env);
     return mulInterval(&left, &right);
   }
 
@@ -155,8 +203,8 @@ Interval evaluateExpTree(const ExpTree *const tree,
     assert(tree->left != NULL);
     assert(tree->right != NULL);
 
-    Interval left = evaluateExpTree(tree->left, domains);
-    Interval right = evaluateExpTree(tree->right, domains);
+    Interval left = evaluateIntervalTree(tree->left, env);
+    Interval right = evaluateIntervalTree(tree->right, env);
     return divInterval(&left, &right);
   }
 
@@ -164,7 +212,7 @@ Interval evaluateExpTree(const ExpTree *const tree,
     assert(tree->left != NULL);
     assert(tree->right == NULL);
 
-    Interval left = evaluateExpTree(tree->left, domains);
+    Interval left = evaluateIntervalTree(tree->left, env);
     return negInterval(&left);
   }
 
@@ -176,7 +224,7 @@ Interval evaluateExpTree(const ExpTree *const tree,
     assert(tree->right->type == EXP_NUM);
     unsigned int exponent = (unsigned int)round(atof(tree->right->data));
 
-    Interval left = evaluateExpTree(tree->left, domains);
+    Interval left = evaluateIntervalTree(tree->left, env);
     return pow2Interval(&left, exponent);
   }
 
@@ -185,21 +233,196 @@ Interval evaluateExpTree(const ExpTree *const tree,
     assert(tree->right == NULL);
     assert(tree->data != NULL);
 
-    Interval left = evaluateExpTree(tree->left, domains);
+    Interval left = evaluateIntervalTree(tree->left, env);
+    return evaluateFunInterval(tree->data, &left);
+  }
 
-    if (strcmp(tree->data, "sqrt") == 0)
-      return sqrtInterval(&left);
+  /* Unknown operator or leaf to evaluate. */
+  default:
+    assert(false);
+    break;
+  }
+}
 
-    /* Unknown function, abort */
+Interval evaluateExpTree(const ExpTree *const tree,
+                         const Domain *const domains) {
+  assert(domains != NULL);
+  COUNT_EVENT(COUNTER_EVALUATE, 1);
+
+  IntervalEnv env = {domains, NULL, NULL};
+  beginOutwardRounding();
+  Interval enclosure = evaluateIntervalTree(tree, &env);
+  endOutwardRounding();
+  return enclosure;
+}
+
+Interval evaluateExpTreeBox(const ExpTree *const tree,
+                            const SymbolTable *const symbols,
+                            const IntervalBox *const box) {
+  assert(symbols != NULL);
+  assert(box != NULL);
+
+  IntervalEnv env = {NULL, symbols, box};
+  beginOutwardRounding();
+  Interval enclosure = evaluateIntervalTree(tree, &env);
+  endOutwardRounding();
+  return enclosure;
+}
+
+/* The recursive kernel of evaluateExpTreeAffine: variable i of the domain
+  list gets noise symbol i. */
+static AffineForm *evaluateAffineTree(const ExpTree *const tree,
+                                      const Domain *const domains,
+                                      const unsigned int length) {
+  assert(tree != NULL);
+
+  switch (tree->type) {
+  case EXP_NUM: {
+    assert(tree->data != NULL);
+
+    Interval constant = strtoInterval(tree->data);
+    return newAffineForm(&constant, length);
+  }
+
+  case EXP_VAR: {
+    assert(tree->data != NULL);
+
+    unsigned int symbol = 0;
+    for (const Domain *dom = domains; dom != NULL; dom = dom->next, ++symbol)
+      if (strcmp(tree->data, dom->var) == 0)
+        return newAffineVariable(&dom->domain, symbol, length);
+
+    /* The expression tree contains a variable whose valuation is unknown. */
     assert(false);
     break;
   }
 
+  case EXP_ADD_OP:
+  case EXP_SUB_OP:
+  case EXP_MUL_OP:
+  case EXP_DIV_OP: {
+    assert(tree->left != NULL);
+    assert(tree->right != NULL);
+
+    AffineForm *left = evaluateAffineTree(tree->left, domains, length);
+    AffineForm *right = evaluateAffineTree(tree->right, domains, length);
+    AffineForm *result;
+    if (tree->type == EXP_ADD_OP)
+      result = addAffineForm(left, right);
+    else if (tree->type == EXP_SUB_OP)
+      result = subAffineForm(left, right);
+    else if (tree->type == EXP_MUL_OP)
+      result = mulAffineForm(left, right);
+    else
+      result = divAffineForm(left, right);
+    delAffineForm(left);
+    delAffineForm(right);
+    return result;
+  }
+
+  case EXP_NEG: {
+    assert(tree->left != NULL);
+
+    AffineForm *left = evaluateAffineTree(tree->left, domains, length);
+    AffineForm *result = negAffineForm(left);
+    delAffineForm(left);
+    return result;
+  }
+
+  case EXP_EXP_OP: {
+    assert(tree->left != NULL);
+    assert(tree->right != NULL);
+
+    /* Assume the exponent is always a natural number. */
+    assert(tree->right->type == EXP_NUM);
+    unsigned int exponent = (unsigned int)round(atof(tree->right->data));
+
+    AffineForm *left = evaluateAffineTree(tree->left, domains, length);
+    AffineForm *result = pow2AffineForm(left, exponent);
+    delAffineForm(left);
+    return result;
+  }
+
+  /* Functions are applied to the range of their argument. */
+  case EXP_FUN: {
+    assert(tree->left != NULL);
+    assert(tree->data != NULL);
+
+    AffineForm *left = evaluateAffineTree(tree->left, domains, length);
+    Interval range = rangeAffineForm(left);
+    Interval image = evaluateFunInterval(tree->data, &range);
+    delAffineForm(left);
+    return newAffineForm(&image, length);
+  }
+
   /* Unknown operator or leaf to evaluate. */
   default:
     assert(false);
     break;
   }
+  return NULL;
+}
+
+Interval evaluateExpTreeAffine(const ExpTree *const tree,
+                               const Domain *const domains) {
+  assert(domains != NULL);
+
+  unsigned int length = 0;
+  for (const Domain *dom = domains; dom != NULL; dom = dom->next)
+    ++length;
+
+  beginOutwardRounding();
+  AffineForm *form = evaluateAffineTree(tree, domains, length);
+  Interval enclosure = rangeAffineForm(form);
+  endOutwardRounding();
+  delAffineForm(form);
+  return enclosure;
+}
+
+/* The range bounder of TM arithmetic, shared by all threads. It is atomic,
+  so that the worker threads may read it while it is set, but each bound
+  reads it only once. */
+static _Atomic RangeBounder rangeBounder = RANGE_BOUNDER_INTERVAL;
+
+void setRangeBounder(const RangeBounder bounder) {
+  atomic_store(&rangeBounder, bounder);
+}
+
+RangeBounder getRangeBounder(void) { return atomic_load(&rangeBounder); }
+
+/* Intersect a sound enclosure of the range of the tree with that of interval
+  evaluation. Neither contains the other in general, e.g. affine forms lose
+  the sign of x * x, while both are sound. Interval evaluation is cheap next
+  to the other bounders. */
+static Interval intersectExpTree(const Interval enclosure,
+                                 const ExpTree *const tree,
+                                 const Domain *const domains) {
+  Interval interval = evaluateExpTree(tree, domains);
+  return newInterval(fmax(enclosure.left, interval.left),
+                     fmin(enclosure.right, interval.right));
+}
+
+Interval boundExpTree(const ExpTree *const tree, const Domain *const domains) {
+  switch (atomic_load_explicit(&rangeBounder, memory_order_relaxed)) {
+  case RANGE_BOUNDER_AFFINE:
+    return intersectExpTree(evaluateExpTreeAffine(tree, domains), tree,
+                            domains);
+  case RANGE_BOUNDER_BERNSTEIN:
+    return intersectExpTree(evaluateExpTreeBernstein(tree, domains), tree,
+                            domains);
+  case RANGE_BOUNDER_CENTERED:
+    return intersectExpTree(evaluateExpTreeCentered(tree, domains), tree,
+                            domains);
+  /* Branch and bound starts from interval evaluation, so it is never
+    looser. */
+  case RANGE_BOUNDER_BRANCH_BOUND: {
+    BranchBoundBudget budget = newBranchBoundBudget(BRANCH_BOUND_BOXES, 0, 0);
+    return evaluateExpTreeBranchBound(tree, domains, &budget, NULL);
+  }
+  case RANGE_BOUNDER_INTERVAL:
+  default:
+    return evaluateExpTree(tree, domains);
+  }
 }
 
 double evaluateExpTreeReal(const ExpTree *const tree,
@@ -302,6 +525,18 @@ double evaluateExpTreeReal(const ExpTree *const tree,
 
     if (strcmp(tree->data, "sqrt") == 0)
       return sqrt(left);
+    if (strcmp(tree->data, "sin") == 0)
+      return sin(left);
+    if (strcmp(tree->data, "cos") == 0)
+      return cos(left);
+    if (strcmp(tree->data, "exp") == 0)
+      return exp(left);
+    if (strcmp(tree->data, "log") == 0)
+      return log(left);
+    if (strcmp(tree->data, "atan") == 0)
+      return atan(left);
+    if (strcmp(tree->data, "tanh") == 0)
+      return tanh(left);
 
     /* Unknown function, abort */
     assert(false);
@@ -315,6 +550,12 @@ double evaluateExpTreeReal(const ExpTree *const tree,
   }
 }
 
+/* Free an evaluated operand, which is NULL if its evaluation failed. */
+static void delOperandTM(TaylorModel *operand) {
+  if (operand != NULL)
+    delTaylorModel(operand);
+}
+
 TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
                                const TaylorModel *const list,
                                const char *const fun,
@@ -370,9 +611,11 @@ TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
     TaylorModel *left = evaluateExpTreeTM(tree->left, list, fun, variables, k);
     TaylorModel *right =
         evaluateExpTreeTM(tree->right, list, fun, variables, k);
-    TaylorModel *binop = addTM(left, right, variables, k);
-    delTaylorModel(left);
-    delTaylorModel(right);
+    TaylorModel *binop = (left != NULL && right != NULL)
+                             ? addTM(left, right, variables, k)
+                             : NULL;
+    delOperandTM(left);
+    delOperandTM(right);
     return binop;
   }
 
@@ -383,9 +626,11 @@ TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
     TaylorModel *left = evaluateExpTreeTM(tree->left, list, fun, variables, k);
     TaylorModel *right =
         evaluateExpTreeTM(tree->right, list, fun, variables, k);
-    TaylorModel *binop = subTM(left, right, variables, k);
-    delTaylorModel(left);
-    delTaylorModel(right);
+    TaylorModel *binop = (left != NULL && right != NULL)
+                             ? subTM(left, right, variables, k)
+                             : NULL;
+    delOperandTM(left);
+    delOperandTM(right);
     return binop;
   }
 
@@ -396,9 +641,11 @@ TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
     TaylorModel *left = evaluateExpTreeTM(tree->left, list, fun, variables, k);
     TaylorModel *right =
         evaluateExpTreeTM(tree->right, list, fun, variables, k);
-    TaylorModel *binop = mulTM(left, right, variables, k);
-    delTaylorModel(left);
-    delTaylorModel(right);
+    TaylorModel *binop = (left != NULL && right != NULL)
+                             ? mulTM(left, right, variables, k)
+                             : NULL;
+    delOperandTM(left);
+    delOperandTM(right);
     return binop;
   }
 
@@ -409,9 +656,11 @@ TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
     TaylorModel *left = evaluateExpTreeTM(tree->left, list, fun, variables, k);
     TaylorModel *right =
         evaluateExpTreeTM(tree->right, list, fun, variables, k);
-    TaylorModel *binop = divTM(left, right, variables, k);
-    delTaylorModel(left);
-    delTaylorModel(right);
+    TaylorModel *binop = (left != NULL && right != NULL)
+                             ? divTM(left, right, variables, k)
+                             : NULL;
+    delOperandTM(left);
+    delOperandTM(right);
     return binop;
   }
 
@@ -420,8 +669,8 @@ TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
     assert(tree->right == NULL);
 
     TaylorModel *left = evaluateExpTreeTM(tree->left, list, fun, variables, k);
-    TaylorModel *unop = negTM(left, variables, k);
-    delTaylorModel(left);
+    TaylorModel *unop = (left != NULL) ? negTM(left, variables, k) : NULL;
+    delOperandTM(left);
     return unop;
   }
 
@@ -432,8 +681,9 @@ TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
 
     const unsigned int exponent = atou(tree->right->data);
     TaylorModel *left = evaluateExpTreeTM(tree->left, list, fun, variables, k);
-    TaylorModel *binop = powTM(left, exponent, variables, k);
-    delTaylorModel(left);
+    TaylorModel *binop =
+        (left != NULL) ? powTM(left, exponent, variables, k) : NULL;
+    delOperandTM(left);
 
     return binop;
   }
@@ -443,9 +693,26 @@ TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
     assert(tree->right == NULL);
     assert(tree->data != NULL);
 
+    TaylorModel *(*op)(const TaylorModel *const, const Domain *const,
+                       const unsigned int) = NULL;
+    if (strcmp(tree->data, "sin") == 0)
+      op = sinTM;
+    else if (strcmp(tree->data, "cos") == 0)
+      op = cosTM;
+    else if (strcmp(tree->data, "exp") == 0)
+      op = expTM;
+    else if (strcmp(tree->data, "log") == 0)
+      op = logTM;
+    else if (strcmp(tree->data, "sqrt") == 0)
+      op = sqrtTM;
+
     /* Unknown function, abort */
-    assert(false);
-    return NULL;
+    assert(op != NULL);
+
+    TaylorModel *left = evaluateExpTreeTM(tree->left, list, fun, variables, k);
+    TaylorModel *unop = (left != NULL) ? op(left, variables, k) : NULL;
+    delOperandTM(left);
+    return unop;
   }
 
   /* Unknown operator or leaf to evaluate. */
@@ -458,220 +725,186 @@ TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
   return NULL;
 }
 
-TaylorModel *addTM(const TaylorModel *const left,
-                   const TaylorModel *const right,
-                   const Domain *const variables, const unsigned int k) {
-  /* Require equal length lists: if only one is NULL
-    then there is a list length mismatch. */
-  assert((left == NULL) == (right == NULL));
-
-  /* Base case: The tail/next of the last element is NULL. */
-  if (left == NULL && right == NULL)
-    return NULL;
+/* The head-only kernel of truncateTM, see below. */
+static TaylorModel *truncateTMHead(const TaylorModel *const list,
+                                   const Domain *const variables,
+                                   const unsigned int k);
 
+/* The head-only kernel of addTM; the tails of the operands are ignored. */
+static TaylorModel *addTMHead(const TaylorModel *const left,
+                              const TaylorModel *const right,
+                              const Domain *const variables,
+                              const unsigned int k) {
   /* Only compose TMs that correspond to the same variable. */
   assert(left->fun != NULL && right->fun != NULL);
   assert(strcmp(left->fun, right->fun) == 0);
 
-  /* Recursive case: The tail of the new element is everything built until now.
-    (p1, I1) + (p2, I2) = (p1 + p2, I1 + I2) */
+  /* (p1, I1) + (p2, I2) = (p1 + p2, I1 + I2) */
+  COUNT_START(start);
   char *fun = strdup(left->fun);
   ExpTree *exp =
       newExpOp(EXP_ADD_OP, cpyExpTree(left->exp), cpyExpTree(right->exp));
   Interval remainder = addInterval(&left->remainder, &right->remainder);
   TaylorModel *binaryOp = newTaylorModel(fun, exp, remainder);
-  TaylorModel *truncated = truncateTM(binaryOp, variables, k);
+  TaylorModel *truncated = truncateTMHead(binaryOp, variables, k);
 
   /* Clean */
   delTaylorModel(binaryOp);
 
-  return appTMElem(addTM(left->next, right->next, variables, k), truncated);
+  COUNT_STOP(COUNTER_ADD_TM, start);
+  return truncated;
 }
 
-TaylorModel *subTM(const TaylorModel *const left,
+TaylorModel *addTM(const TaylorModel *const left,
                    const TaylorModel *const right,
                    const Domain *const variables, const unsigned int k) {
-  /* Require equal length lists: if only one is NULL
-    then there is a list length mismatch. */
-  assert((left == NULL) == (right == NULL));
-
-  /* Base case: The tail/next of the last element is NULL. */
-  if (left == NULL && right == NULL)
-    return NULL;
+  return addTMParallel(left, right, variables, k, NULL);
+}
 
+/* The head-only kernel of subTM; the tails of the operands are ignored. */
+static TaylorModel *subTMHead(const TaylorModel *const left,
+                              const TaylorModel *const right,
+                              const Domain *const variables,
+                              const unsigned int k) {
   /* Only compose TMs that correspond to the same variable. */
   assert(left->fun != NULL && right->fun != NULL);
   assert(strcmp(left->fun, right->fun) == 0);
 
-  /* Recursive case: The tail of the new element is everything built until now.
-    (p1, I1) - (p2, I2) = (p1 - p2, I1 - I2) */
+  /* (p1, I1) - (p2, I2) = (p1 - p2, I1 - I2) */
   char *fun = strdup(left->fun);
   ExpTree *exp =
       newExpOp(EXP_SUB_OP, cpyExpTree(left->exp), cpyExpTree(right->exp));
   Interval remainder = subInterval(&left->remainder, &right->remainder);
   TaylorModel *binaryOp = newTaylorModel(fun, exp, remainder);
-  TaylorModel *truncated = truncateTM(binaryOp, variables, k);
+  TaylorModel *truncated = truncateTMHead(binaryOp, variables, k);
 
   /* Clean */
   delTaylorModel(binaryOp);
 
-  return appTMElem(subTM(left->next, right->next, variables, k), truncated);
+  return truncated;
 }
 
-TaylorModel *mulTM(const TaylorModel *const left,
+TaylorModel *subTM(const TaylorModel *const left,
                    const TaylorModel *const right,
                    const Domain *const variables, const unsigned int k) {
-  /* Require equal length lists: if only one is NULL
-    then there is a list length mismatch. */
-  assert((left == NULL) == (right == NULL));
-
-  /* Base case: The tail/next of the last element is NULL. */
-  if (left == NULL && right == NULL)
-    return NULL;
+  return subTMParallel(left, right, variables, k, NULL);
+}
 
+/* The head-only kernel of mulTM; the tails of the operands are ignored. */
+static TaylorModel *mulTMHead(const TaylorModel *const left,
+                              const TaylorModel *const right,
+                              const Domain *const variables,
+                              const unsigned int k) {
   /* Only compose TMs that correspond to the same variable. */
   assert(left->fun != NULL && right->fun != NULL);
   assert(strcmp(left->fun, right->fun) == 0);
 
-  /* Recursive case: The tail of the new element is everything built until now.
-    (p1, I1) * (p2, I2)
+  /* (p1, I1) * (p2, I2)
   = (p1 * p2 - pe, Int(pe) + Int(p1)*I2 + Int(p2)*I1 + I1*I2) */
+  COUNT_START(start);
   char *fun = strdup(left->fun);
   ExpTree *exp =
       newExpOp(EXP_MUL_OP, cpyExpTree(left->exp), cpyExpTree(right->exp));
   ExpTree *sumOfProds = toSumOfProducts(exp);
 
-  Interval Intp1 = evaluateExpTree(left->exp, variables);
-  Interval Intp2 = evaluateExpTree(right->exp, variables);
+  beginOutwardRounding();
+  Interval Intp1 = boundExpTree(left->exp, variables);
+  Interval Intp2 = boundExpTree(right->exp, variables);
   Interval p1I2 = mulInterval(&Intp1, &right->remainder);
   Interval p2I1 = mulInterval(&Intp2, &left->remainder);
   Interval I1I2 = mulInterval(&left->remainder, &right->remainder);
   Interval remainder;
   remainder = addInterval(&p1I2, &p2I1);
   remainder = addInterval(&remainder, &I1I2);
+  endOutwardRounding();
 
   TaylorModel *binaryOp = newTaylorModel(fun, sumOfProds, remainder);
-  TaylorModel *truncated = truncateTM(binaryOp, variables, k);
+  TaylorModel *truncated = truncateTMHead(binaryOp, variables, k);
 
   /* Clean */
   delExpTree(exp);
   delTaylorModel(binaryOp);
 
-  return appTMElem(mulTM(left->next, right->next, variables, k), truncated);
+  COUNT_STOP(COUNTER_MUL_TM, start);
+  return truncated;
 }
 
-TaylorModel *divTM(const TaylorModel *const left,
+TaylorModel *mulTM(const TaylorModel *const left,
                    const TaylorModel *const right,
                    const Domain *const variables, const unsigned int k) {
-  /* Require equal length lists: if only one is NULL
-    then there is a list length mismatch. */
-  assert((left == NULL) == (right == NULL));
+  return mulTMParallel(left, right, variables, k, NULL);
+}
 
-  /* Base case: The tail/next of the last element is NULL. */
-  if (left == NULL && right == NULL)
-    return NULL;
+/* The head-only kernel of reciprocalTM, see below. */
+static TaylorModel *reciprocalTMHead(const TaylorModel *const list,
+                                     const Domain *const variables,
+                                     const unsigned int k);
 
+/* The head-only kernel of divTM; the tails of the operands are ignored. */
+static TaylorModel *divTMHead(const TaylorModel *const left,
+                              const TaylorModel *const right,
+                              const Domain *const variables,
+                              const unsigned int k) {
   /* Only compose TMs that correspond to the same variable. */
   assert(left->fun != NULL && right->fun != NULL);
   assert(strcmp(left->fun, right->fun) == 0);
 
-  /* Int((p2, I2)) = Int(p2) + I2 */
-  Interval enclosure = evaluateExpTree(right->exp, variables);
-  enclosure = addInterval(&enclosure, &right->remainder);
-  assert(!elemInterval(0, &enclosure));
-
-  /* c = Mid(Int((p2, I2))) */
-  double c = intervalMidpoint(&enclosure);
-  char cStr[50];
-  dtoa(cStr, sizeof(cStr), c);
-
-  /* b = 1 / c  where c != 0 since 0 not in Int((p2, I2)) */
-  double b = 1 / c;
-  char bStr[50];
-  dtoa(bStr, sizeof(bStr), b);
-
-  /* pk(x) = 1/c * (1 - ((x - c) / c)^1 + ... + (-1)^k * ((x - c) / c)^k)
-           =   b * (1 - ((x - c) * b)^1 + ... + (-1)^k * ((x - c) * b)^k) */
-  ExpTree *inverseExp = newExpLeaf(EXP_NUM, "1");
-  char *fun = left->fun;
-  for (unsigned int it = 1; it <= k; ++it) {
-    char expStr[50];
-    utoa(expStr, sizeof(expStr), it);
-    ExpTree *exponent = newExpLeaf(EXP_NUM, expStr);
-
-    /* ((x - c) / c)^i
-      BUT should not use DIV nodes, to avoid infinite recursion in evaluation.
-    => ((x - c) * b)^i  should be used instead, where b = 1/c is evaluated. */
-    ExpTree *cLeaf = newExpLeaf(EXP_NUM, cStr);
-    ExpTree *bLeaf = newExpLeaf(EXP_NUM, bStr);
-    ExpTree *xLeaf = newExpLeaf(EXP_VAR, fun);
-    ExpTree *term = newExpOp(EXP_SUB_OP, xLeaf, cLeaf);
-    term = newExpOp(EXP_MUL_OP, term, bLeaf);
-    term = newExpOp(EXP_EXP_OP, term, exponent);
-
-    /* Aggregate term into expression */
-    ExpType opType = ((it % 2) == 0) ? EXP_ADD_OP : EXP_SUB_OP;
-    inverseExp = newExpOp(opType, inverseExp, term);
-  }
-  ExpTree *bLeaf = newExpLeaf(EXP_NUM, bStr);
-  inverseExp = newExpOp(EXP_MUL_OP, bLeaf, inverseExp);
-
-  /* Setup leaves for remainder expression. */
-  char expk1Str[12];
-  char expk2Str[12];
-  utoa(expk1Str, sizeof(expk1Str), k + 1);
-  utoa(expk2Str, sizeof(expk2Str), k + 2);
-  ExpTree *expk1 = newExpLeaf(EXP_NUM, expk1Str);
-  ExpTree *expk2 = newExpLeaf(EXP_NUM, expk2Str);
-  ExpTree *one = newExpLeaf(EXP_NUM, "1");
-  ExpTree *cLeaf = newExpLeaf(EXP_NUM, cStr);
-  ExpTree *xLeaf = newExpLeaf(EXP_VAR, fun);
-
-  /* Compose TM (p2 - c, I2) */
-  TaylorModel *rightMod = cpyTaylorModelHead(right);
-  rightMod->exp = newExpOp(EXP_SUB_OP, rightMod->exp, cLeaf);
-
-  /* Compose remainder expression. */
-  /* 1 / x^(k+2) */
-  ExpTree *factor1 = newExpOp(EXP_EXP_OP, xLeaf, expk2);
-  factor1 = newExpOp(EXP_DIV_OP, one, factor1);
-  ExpTree *sub = newExpOp(EXP_SUB_OP, cpyExpTree(xLeaf), cpyExpTree(cLeaf));
-  /* (x - c)^(k+1) */
-  ExpTree *factor2 = newExpOp(EXP_EXP_OP, sub, expk1);
-  ExpTree *remExp = newExpOp(EXP_MUL_OP, factor1, factor2);
-  /* (-1)^(k+1) * ... */
-  if (((k + 1) % 2) == 1)
-    remExp = newExpOp(EXP_NEG, remExp, NULL);
-
-  /* Compute (p3, I3) by substituting (p2 - c, I2) for x in pk(x) */
-  Interval inverseRemainder = evaluateExpTree(remExp, variables);
-  printf("$$$$$$$$$$$$$$$$$$\\\n");
-  fflush(stdout);
-  TaylorModel *inverseTM =
-      evaluateExpTreeTM(inverseExp, rightMod, right->fun, variables, k);
-  printf("$$$$$$$$$$$$$$$$$$/\n");
-  fflush(stdout);
-
-  // TODO: /\/\/\ evaluateExpTM recursively calls divTM ???? Because DIV nodes are used above /\/\/\ 
-
-  inverseTM->remainder = addInterval(&inverseTM->remainder, &inverseRemainder);
-
-  /* Compose TM (p1, I1) / (p2, I2) = (p1, I1) * (p3, I3) */
-  TaylorModel *binaryOp = mulTM(left, inverseTM, variables, k);
-  TaylorModel *truncated = truncateTM(binaryOp, variables, k);
+  /* (p1, I1) / (p2, I2) = (p1, I1) * 1/(p2, I2) */
+  COUNT_START(start);
+  TaylorModel *inverse = reciprocalTMHead(right, variables, k);
+  if (inverse == NULL) {
+    COUNT_STOP(COUNTER_DIV_TM, start);
+    return NULL;
+  }
+  TaylorModel *quotient = mulTMHead(left, inverse, variables, k);
 
   /* Clean */
-  delExpTree(remExp);
-  delExpTree(inverseExp);
-  delTaylorModel(rightMod);
-  delTaylorModel(inverseTM);
-  delTaylorModel(binaryOp);
+  delTaylorModel(inverse);
 
-  return appTMElem(divTM(left->next, right->next, variables, k), truncated);
+  COUNT_STOP(COUNTER_DIV_TM, start);
+  return quotient;
 }
 
-TaylorModel *negTM(const TaylorModel *const list, const Domain *const variables,
-                   const unsigned int k) {
+/* The recursive kernel of divTM, over the whole list. */
+static TaylorModel *divTMList(const TaylorModel *const left,
+                              const TaylorModel *const right,
+                              const Domain *const variables,
+                              const unsigned int k) {
+  /* Require equal length lists: if only one is NULL
+    then there is a list length mismatch. */
+  assert((left == NULL) == (right == NULL));
+
+  /* Base case: The tail/next of the last element is NULL. */
+  if (left == NULL && right == NULL)
+    return NULL;
+
+  /* Recursive case: The tail of the new element is everything built until now.
+    A component whose divisor may be zero fails the whole quotient. */
+  TaylorModel *tail = divTMList(left->next, right->next, variables, k);
+  if (left->next != NULL && tail == NULL)
+    return NULL;
+  TaylorModel *head = divTMHead(left, right, variables, k);
+  if (head == NULL) {
+    if (tail != NULL)
+      delTaylorModel(tail);
+    return NULL;
+  }
+  return appTMElem(tail, head);
+}
+
+TaylorModel *divTM(const TaylorModel *const left,
+                   const TaylorModel *const right,
+                   const Domain *const variables, const unsigned int k) {
+  TRACE_BEGIN(span, "divTM");
+  TaylorModel *quotient = divTMList(left, right, variables, k);
+  TRACE_END(span);
+  return quotient;
+}
+
+/* The recursive kernel of negTM, over the whole list. */
+static TaylorModel *negTMList(const TaylorModel *const list,
+                              const Domain *const variables,
+                              const unsigned int k) {
   /* Base case: The tail/next of the last element is NULL. */
   if (list == NULL)
     return NULL;
@@ -684,12 +917,20 @@ TaylorModel *negTM(const TaylorModel *const list, const Domain *const variables,
   ExpTree *exp = newExpOp(EXP_NEG, cpyExpTree(list->exp), NULL);
   Interval remainder = negInterval(&list->remainder);
   TaylorModel *unaryOp = newTaylorModel(fun, exp, remainder);
-  TaylorModel *truncated = truncateTM(unaryOp, variables, k);
+  TaylorModel *truncated = truncateTMHead(unaryOp, variables, k);
 
   /* Clean */
   delTaylorModel(unaryOp);
 
-  return appTMElem(negTM(list->next, variables, k), truncated);
+  return appTMElem(negTMList(list->next, variables, k), truncated);
+}
+
+TaylorModel *negTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k) {
+  TRACE_BEGIN(span, "negTM");
+  TaylorModel *negated = negTMList(list, variables, k);
+  TRACE_END(span);
+  return negated;
 }
 
 TaylorModel *powTM(const TaylorModel *const left, const unsigned int right,
@@ -700,6 +941,8 @@ TaylorModel *powTM(const TaylorModel *const left, const unsigned int right,
 
   /* For simplicity, disallow 0 exponent. */
   assert(right > 0);
+  COUNT_START(start);
+  TRACE_BEGIN(span, "powTM");
 
   /* Unroll the integer exponent into successive multiplications.
     (p, I)^n = (p, I) * ... * (p, I) */
@@ -719,12 +962,316 @@ TaylorModel *powTM(const TaylorModel *const left, const unsigned int right,
   if (right > 1)
     delTaylorModel(binaryOp);
 
+  COUNT_STOP(COUNTER_POW_TM, start);
+  TRACE_END(span);
   return truncated;
 }
 
-TaylorModel *intTM(const TaylorModel *const list,
-                   const Interval *const intDomain, const char *const intVar,
-                   const Domain *const variables, const unsigned int k) {
+/*
+    Elementary functions.
+*/
+
+/* Fill table[0..n] with enclosures of the Taylor coefficients f^(i)(x) / i!
+  of an elementary function f over the interval x. Each table is built by a
+  recurrence over i, so that the expensive interval functions are evaluated
+  once per table. */
+typedef void (*TMCoefficients)(const Interval *const x, const unsigned int n,
+                               Interval *const table);
+
+/* The number of precomputed enclosures of 1 / i!. */
+#define FACTORIAL_TABLE_SIZE 32
+
+static Interval inverseFactorials[FACTORIAL_TABLE_SIZE];
+static pthread_once_t inverseFactorialsOnce = PTHREAD_ONCE_INIT;
+
+static void initInverseFactorials(void) {
+  inverseFactorials[0] = newInterval(1, 1);
+  for (unsigned int it = 1; it < FACTORIAL_TABLE_SIZE; ++it) {
+    Interval factor = newInterval(it, it);
+    inverseFactorials[it] = divInterval(&inverseFactorials[it - 1], &factor);
+  }
+}
+
+/* An enclosure of 1 / n!, from the table while it lasts. */
+static Interval inverseFactorial(const unsigned int n) {
+  pthread_once(&inverseFactorialsOnce, initInverseFactorials);
+  if (n < FACTORIAL_TABLE_SIZE)
+    return inverseFactorials[n];
+
+  Interval result = inverseFactorials[FACTORIAL_TABLE_SIZE - 1];
+  for (unsigned int it = FACTORIAL_TABLE_SIZE; it <= n; ++it) {
+    Interval factor = newInterval(it, it);
+    result = divInterval(&result, &factor);
+  }
+  return result;
+}
+
+/* exp^(i)(x) / i! = exp(x) / i! */
+static void expCoefficients(const Interval *const x, const unsigned int n,
+                            Interval *const table) {
+  Interval value = expInterval(x);
+  for (unsigned int it = 0; it <= n; ++it) {
+    Interval factor = inverseFactorial(it);
+    table[it] = mulInterval(&value, &factor);
+  }
+}
+
+/* log^(i)(x) / i! = (-1)^(i+1) / (i x^i) for i > 0 */
+static void logCoefficients(const Interval *const x, const unsigned int n,
+                            Interval *const table) {
+  table[0] = logInterval(x);
+  Interval one = newInterval(1, 1);
+  Interval reciprocal = divInterval(&one, x);
+  Interval power = one;
+  for (unsigned int it = 1; it <= n; ++it) {
+    power = mulInterval(&power, &reciprocal);
+    Interval factor = newInterval(it, it);
+    Interval coefficient = divInterval(&power, &factor);
+    table[it] = (it % 2 == 1) ? coefficient : negInterval(&coefficient);
+  }
+}
+
+/* (1/x)^(i) / i! = (-1)^i / x^(i+1) */
+static void reciprocalCoefficients(const Interval *const x,
+                                   const unsigned int n,
+                                   Interval *const table) {
+  Interval one = newInterval(1, 1);
+  Interval reciprocal = divInterval(&one, x);
+  Interval power = reciprocal;
+  for (unsigned int it = 0; it <= n; ++it) {
+    table[it] = (it % 2 == 0) ? power : negInterval(&power);
+    power = mulInterval(&power, &reciprocal);
+  }
+}
+
+/* sqrt^(i)(x) / i! = binom(1/2, i) sqrt(x) / x^i, with
+  binom(1/2, i) = binom(1/2, i - 1) (1/2 - (i - 1)) / i */
+static void sqrtCoefficients(const Interval *const x, const unsigned int n,
+                             Interval *const table) {
+  table[0] = sqrtInterval(x);
+  Interval one = newInterval(1, 1);
+  Interval reciprocal = divInterval(&one, x);
+  for (unsigned int it = 1; it <= n; ++it) {
+    Interval factor = newInterval(0.5 - (it - 1), 0.5 - (it - 1));
+    Interval divisor = newInterval(it, it);
+    factor = divInterval(&factor, &divisor);
+    factor = mulInterval(&factor, &reciprocal);
+    table[it] = mulInterval(&table[it - 1], &factor);
+  }
+}
+
+/* The derivatives of sin cycle through sin, cos, -sin, -cos. */
+static void sinCoefficients(const Interval *const x, const unsigned int n,
+                            Interval *const table) {
+  Interval sine = sinInterval(x);
+  Interval cosine = cosInterval(x);
+  const Interval cycle[4] = {sine, cosine, negInterval(&sine),
+                             negInterval(&cosine)};
+  for (unsigned int it = 0; it <= n; ++it) {
+    Interval factor = inverseFactorial(it);
+    table[it] = mulInterval(&cycle[it % 4], &factor);
+  }
+}
+
+/* The derivatives of cos cycle through cos, -sin, -cos, sin. */
+static void cosCoefficients(const Interval *const x, const unsigned int n,
+                            Interval *const table) {
+  Interval sine = sinInterval(x);
+  Interval cosine = cosInterval(x);
+  const Interval cycle[4] = {cosine, negInterval(&sine), negInterval(&cosine),
+                             sine};
+  for (unsigned int it = 0; it <= n; ++it) {
+    Interval factor = inverseFactorial(it);
+    table[it] = mulInterval(&cycle[it % 4], &factor);
+  }
+}
+
+/* Whether the derivatives of f are bounded over the whole interval. */
+static bool isPositiveInterval(const Interval *const x) { return x->left > 0; }
+
+static bool excludesZero(const Interval *const x) {
+  return !elemInterval(0, x);
+}
+
+/* An elementary function f: its Taylor coefficients, and the intervals over
+  which they can be enclosed, or NULL if that is any interval. */
+typedef struct TMElementary {
+  const char *name;
+  TMCoefficients coefficients;
+  bool (*isInDomain)(const Interval *const x);
+} TMElementary;
+
+static const TMElementary sinElementary = {"sinTM", sinCoefficients, NULL};
+static const TMElementary cosElementary = {"cosTM", cosCoefficients, NULL};
+static const TMElementary expElementary = {"expTM", expCoefficients, NULL};
+static const TMElementary logElementary = {"logTM", logCoefficients,
+                                           isPositiveInterval};
+static const TMElementary sqrtElementary = {"sqrtTM", sqrtCoefficients,
+                                            isPositiveInterval};
+static const TMElementary reciprocalElementary = {
+    "reciprocalTM", reciprocalCoefficients, excludesZero};
+
+/* The constant TM (m, a - m), with m a representable point of the interval
+  coefficient a. */
+static TaylorModel *coefficientTM(const char *const fun,
+                                  const Interval *const coefficient) {
+  char str[50];
+  dtoa(str, sizeof(str), intervalMidpoint(coefficient));
+  /* The string may round the midpoint, so use the value it represents. */
+  Interval center = strtoInterval(str);
+  Interval deviation = subInterval(coefficient, &center);
+  return newTaylorModel(strdup(fun), newExpLeaf(EXP_NUM, str), deviation);
+}
+
+/* The head-only kernel of the elementary functions: the order k Taylor
+  expansion of f around the midpoint c of the range B of (p, I),
+  f(p + I) = sum_{i <= k} f^(i)(c) / i! (p - c + I)^i
+             + f^(k+1)(B) / (k+1)! (B - c)^(k+1),
+  composed in Horner form in a single pass of TM arithmetic. Returns NULL if
+  B is not in the domain of f. */
+static TaylorModel *elementaryTMHead(const TaylorModel *const list,
+                                     const Domain *const variables,
+                                     const unsigned int k,
+                                     const TMElementary *const f) {
+  assert(list->fun != NULL);
+  assert(variables != NULL);
+
+  /* B = Int(p) + I, and a representable c in B. */
+  Interval range = boundExpTree(list->exp, variables);
+  range = addInterval(&range, &list->remainder);
+  if (f->isInDomain != NULL && !f->isInDomain(&range))
+    return NULL;
+  char cStr[50];
+  dtoa(cStr, sizeof(cStr), intervalMidpoint(&range));
+  double c = atof(cStr);
+  Interval center = newInterval(c, c);
+
+  /* (p - c, I), whose range is B - c */
+  TaylorModel *delta = newTaylorModel(
+      strdup(list->fun),
+      newExpOp(EXP_SUB_OP, cpyExpTree(list->exp), newExpLeaf(EXP_NUM, cStr)),
+      list->remainder);
+  Interval deltaRange = subInterval(&range, &center);
+
+  /* The coefficients at c, and the (k+1)-th coefficient over B. */
+  Interval *table = (Interval *)malloc((k + 2) * sizeof(Interval));
+  if (table == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  f->coefficients(&range, k + 1, table);
+  Interval derivative = table[k + 1];
+  f->coefficients(&center, k, table);
+
+  /* a_k, then (... (a_k * delta + a_{k-1}) * delta ...) + a_0 */
+  TaylorModel *result = coefficientTM(list->fun, &table[k]);
+  for (unsigned int it = k; it > 0; --it) {
+    TaylorModel *product = mulTMHead(result, delta, variables, k);
+    TaylorModel *constant = coefficientTM(list->fun, &table[it - 1]);
+    TaylorModel *sum = addTMHead(product, constant, variables, k);
+    delTaylorModel(result);
+    delTaylorModel(product);
+    delTaylorModel(constant);
+
+    /* Collect the terms, so the trees do not grow with every step. The
+      rounding of the collected coefficients moves into the remainder. */
+    result = collectTM(sum, variables);
+    delTaylorModel(sum);
+  }
+
+  /* The Lagrange remainder over the whole range. */
+  Interval power = powInterval(&deltaRange, k + 1);
+  Interval lagrange = mulInterval(&derivative, &power);
+  result->remainder = addInterval(&result->remainder, &lagrange);
+
+  /* Clean */
+  free(table);
+  delTaylorModel(delta);
+
+  return result;
+}
+
+/* The recursive kernel of elementaryTM, over the whole list. Returns NULL
+  if any component fails. */
+static TaylorModel *elementaryTMList(const TaylorModel *const list,
+                                     const Domain *const variables,
+                                     const unsigned int k,
+                                     const TMElementary *const f) {
+  /* Base case: The tail/next of the last element is NULL. */
+  if (list == NULL)
+    return NULL;
+
+  /* Recursive case: The tail of the new element is everything built until now.
+   */
+  TaylorModel *tail = elementaryTMList(list->next, variables, k, f);
+  if (list->next != NULL && tail == NULL)
+    return NULL;
+  TaylorModel *head = elementaryTMHead(list, variables, k, f);
+  if (head == NULL) {
+    if (tail != NULL)
+      delTaylorModel(tail);
+    return NULL;
+  }
+  return appTMElem(tail, head);
+}
+
+/* Apply an elementary function to every component of the list, traced as
+  a single stage. */
+static TaylorModel *elementaryTM(const TaylorModel *const list,
+                                 const Domain *const variables,
+                                 const unsigned int k,
+                                 const TMElementary *const f) {
+  TRACE_BEGIN(span, f->name);
+  TaylorModel *image = elementaryTMList(list, variables, k, f);
+  TRACE_END(span);
+  return image;
+}
+
+TaylorModel *sinTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k) {
+  return elementaryTM(list, variables, k, &sinElementary);
+}
+
+TaylorModel *cosTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k) {
+  return elementaryTM(list, variables, k, &cosElementary);
+}
+
+TaylorModel *expTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k) {
+  return elementaryTM(list, variables, k, &expElementary);
+}
+
+TaylorModel *logTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k) {
+  return elementaryTM(list, variables, k, &logElementary);
+}
+
+TaylorModel *sqrtTM(const TaylorModel *const list,
+                    const Domain *const variables, const unsigned int k) {
+  return elementaryTM(list, variables, k, &sqrtElementary);
+}
+
+/* 1 / (p, I), or NULL if 0 is in Int(p) + I: the expansion around a point
+  of the range needs the reciprocal to be analytic over all of it. */
+static TaylorModel *reciprocalTMHead(const TaylorModel *const list,
+                                     const Domain *const variables,
+                                     const unsigned int k) {
+  return elementaryTMHead(list, variables, k, &reciprocalElementary);
+}
+
+TaylorModel *reciprocalTM(const TaylorModel *const list,
+                          const Domain *const variables,
+                          const unsigned int k) {
+  return elementaryTM(list, variables, k, &reciprocalElementary);
+}
+
+/* The recursive kernel of intTM, over the whole list. */
+static TaylorModel *intTMList(const TaylorModel *const list,
+                              const Interval *const intDomain,
+                              const char *const intVar,
+                              const Domain *const variables,
+                              const unsigned int k) {
   assert(intDomain != NULL);
   assert(intVar != NULL);
   assert(variables != NULL);
@@ -734,6 +1281,7 @@ TaylorModel *intTM(const TaylorModel *const list,
     return NULL;
 
   /* Definite integral bounds should be trees. */
+  COUNT_START(start);
   char lowerBoundStr[50];
   char upperBoundStr[50];
   snprintf(lowerBoundStr, sizeof(lowerBoundStr), "%.15g", intDomain->left);
@@ -751,33 +1299,72 @@ TaylorModel *intTM(const TaylorModel *const list,
   /* Il = (Int(pe) + I) * [ai, bi] */
   Interval enclosure; // Interval enclosure Int(pe)
   Interval remainder; // Updated remainder interval Il
-  enclosure = evaluateExpTree(truncatedTerms, variables);
+  enclosure = boundExpTree(truncatedTerms, variables);
   remainder = addInterval(&enclosure, &list->remainder);
   remainder = mulInterval(&remainder, intDomain);
+  COUNT_STOP(COUNTER_INT_TM, start);
 
   /* Recursive case: The tail of the new element is everything built until now.
    */
-  return newTMElem(intTM(list->next, intDomain, intVar, variables, k),
+  return newTMElem(intTMList(list->next, intDomain, intVar, variables, k),
                    strdup(intVar), exp, remainder);
 }
 
-TaylorModel *truncateTM(const TaylorModel *const list,
-                        const Domain *const variables, const unsigned int k) {
+TaylorModel *intTM(const TaylorModel *const list,
+                   const Interval *const intDomain, const char *const intVar,
+                   const Domain *const variables, const unsigned int k) {
+  TRACE_BEGIN(span, "intTM");
+  TaylorModel *integral = intTMList(list, intDomain, intVar, variables, k);
+  TRACE_END(span);
+  return integral;
+}
+
+/* The recursive kernel of primitiveTM, over the whole list. */
+static TaylorModel *primitiveTMList(const TaylorModel *const list,
+                                    const char *const intVar,
+                                    const Domain *const variables,
+                                    const unsigned int k) {
   /* Base case: The tail/next of the last element is NULL. */
   if (list == NULL)
     return NULL;
 
+  /* (int_0^v p dv, I * Dv), with the rounding of the coefficients enclosed
+    in the remainder. */
+  TaylorModel *primitives = collectPrimitiveTM(list, intVar, variables);
+  TaylorModel *truncated = NULL;
+  for (const TaylorModel *it = primitives; it != NULL; it = it->next)
+    truncated = appTMElem(truncated, truncateTMHead(it, variables, k));
+
+  /* Clean */
+  delTaylorModel(primitives);
+
+  return reverseTaylorModel(truncated);
+}
+
+TaylorModel *primitiveTM(const TaylorModel *const list,
+                         const char *const intVar,
+                         const Domain *const variables, const unsigned int k) {
+  TRACE_BEGIN(span, "primitiveTM");
+  TaylorModel *primitives = primitiveTMList(list, intVar, variables, k);
+  TRACE_END(span);
+  return primitives;
+}
+
+/* The head-only kernel of truncateTM; the tail of the operand is ignored. */
+static TaylorModel *truncateTMHead(const TaylorModel *const list,
+                                   const Domain *const variables,
+                                   const unsigned int k) {
   assert(list->fun != NULL);
   assert(variables != NULL);
 
-  /* Recursive case: The tail of the new element is everything built until now.
-    trunc((p, I) = (p - pe, I + Int(pe))) where pe are the truncated terms and
+  /* trunc((p, I) = (p - pe, I + Int(pe))) where pe are the truncated terms and
     Int(pe) is their interval enclosure. */
+  COUNT_START(start);
   char *fun = strdup(list->fun);
   ExpTree *truncatedTerms = NULL;
   ExpTree *truncated = truncate2(list->exp, k, &truncatedTerms);
   Interval enclosure = (truncatedTerms != NULL)
-                           ? evaluateExpTree(truncatedTerms, variables)
+                           ? boundExpTree(truncatedTerms, variables)
                            : newInterval(0, 0);
   Interval remainder = addInterval(&list->remainder, &enclosure);
 
@@ -785,6 +1372,143 @@ TaylorModel *truncateTM(const TaylorModel *const list,
   if (truncatedTerms != NULL)
     delExpTree(truncatedTerms);
 
-  return newTMElem(truncateTM(list->next, variables, k), fun, truncated,
-                   remainder);
+  COUNT_STOP(COUNTER_TRUNCATE_TM, start);
+  return newTaylorModel(fun, truncated, remainder);
+}
+
+TaylorModel *truncateTM(const TaylorModel *const list,
+                        const Domain *const variables, const unsigned int k) {
+  return truncateTMParallel(list, variables, k, NULL);
+}
+
+/*
+    Parallel vector operations.
+*/
+
+/* The head-only kernel of an elementwise, unary vector operation. */
+typedef TaylorModel *(*TMUnaryHeadOp)(const TaylorModel *const list,
+                                      const Domain *const variables,
+                                      const unsigned int k);
+
+/* The head-only kernel of an elementwise, binary vector operation. */
+typedef TaylorModel *(*TMBinaryHeadOp)(const TaylorModel *const left,
+                                       const TaylorModel *const right,
+                                       const Domain *const variables,
+                                       const unsigned int k);
+
+/* The shared state of one parallel vector operation. Exactly one of the
+  operator kernels is set, and right is only used by binary operators. */
+typedef struct TMParallelContext {
+  const TaylorModel **left;
+  const TaylorModel **right;
+  const Domain *variables;
+  unsigned int k;
+  TMUnaryHeadOp unaryOp;
+  TMBinaryHeadOp binaryOp;
+  TaylorModel **results;
+} TMParallelContext;
+
+static void runTMParallelComponent(unsigned int index, void *context) {
+  TMParallelContext *ctx = (TMParallelContext *)context;
+  if (ctx->binaryOp != NULL)
+    ctx->results[index] = ctx->binaryOp(ctx->left[index], ctx->right[index],
+                                        ctx->variables, ctx->k);
+  else
+    ctx->results[index] =
+        ctx->unaryOp(ctx->left[index], ctx->variables, ctx->k);
+}
+
+/* Flatten the components of a list into a newly heap-allocated array. */
+static const TaylorModel **componentsTaylorModel(const TaylorModel *list,
+                                                 const unsigned int length) {
+  const TaylorModel **components =
+      (const TaylorModel **)malloc(length * sizeof(TaylorModel *));
+  for (unsigned int index = 0; index < length; ++index) {
+    components[index] = list;
+    list = list->next;
+  }
+  return components;
+}
+
+/* Link the per-component results in index order, so that the output order
+  never depends on the order in which components finished. */
+TaylorModel *linkTaylorModels(TaylorModel **components,
+                              const unsigned int length) {
+  TaylorModel *list = NULL;
+  for (unsigned int index = length; index > 0; --index)
+    list = appTMElem(list, components[index - 1]);
+  return list;
+}
+
+static TaylorModel *applyTMParallel(const TaylorModel *const left,
+                                    const TaylorModel *const right,
+                                    const Domain *const variables,
+                                    const unsigned int k,
+                                    TMUnaryHeadOp unaryOp,
+                                    TMBinaryHeadOp binaryOp,
+                                    ThreadPool *pool, const char *name) {
+  const unsigned int length = lengthTaylorModel(left);
+  /* Require equal length lists for binary operators. */
+  assert(binaryOp == NULL || length == lengthTaylorModel(right));
+  if (length == 0)
+    return NULL;
+  TRACE_BEGIN(span, name);
+
+  TMParallelContext ctx;
+  ctx.left = componentsTaylorModel(left, length);
+  ctx.right = (binaryOp != NULL) ? componentsTaylorModel(right, length) : NULL;
+  ctx.variables = variables;
+  ctx.k = k;
+  ctx.unaryOp = unaryOp;
+  ctx.binaryOp = binaryOp;
+  ctx.results = (TaylorModel **)malloc(length * sizeof(TaylorModel *));
+
+  parallelFor(pool, length, runTMParallelComponent, &ctx);
+  TaylorModel *list = linkTaylorModels(ctx.results, length);
+
+  /* Clean */
+  free(ctx.left);
+  free(ctx.right);
+  free(ctx.results);
+
+  TRACE_END(span);
+  return list;
+}
+
+unsigned int lengthTaylorModel(const TaylorModel *list) {
+  unsigned int length = 0;
+  for (; list != NULL; list = list->next)
+    ++length;
+  return length;
+}
+
+TaylorModel *addTMParallel(const TaylorModel *const left,
+                           const TaylorModel *const right,
+                           const Domain *const variables, const unsigned int k,
+                           ThreadPool *pool) {
+  return applyTMParallel(left, right, variables, k, NULL, addTMHead, pool,
+                         "addTM");
+}
+
+TaylorModel *subTMParallel(const TaylorModel *const left,
+                           const TaylorModel *const right,
+                           const Domain *const variables, const unsigned int k,
+                           ThreadPool *pool) {
+  return applyTMParallel(left, right, variables, k, NULL, subTMHead, pool,
+                         "subTM");
+}
+
+TaylorModel *mulTMParallel(const TaylorModel *const left,
+                           const TaylorModel *const right,
+                           const Domain *const variables, const unsigned int k,
+                           ThreadPool *pool) {
+  return applyTMParallel(left, right, variables, k, NULL, mulTMHead, pool,
+                         "mulTM");
+}
+
+TaylorModel *truncateTMParallel(const TaylorModel *const list,
+                                const Domain *const variables,
+                                const unsigned int k, ThreadPool *pool) {
+  return applyTMParallel(list, NULL, variables, k, truncateTMHead, NULL, pool,
+                         "truncateTM");
 }
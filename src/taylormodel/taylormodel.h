@@ -15,8 +15,12 @@
 #ifndef TAYLOR_MODEL_H
 #define TAYLOR_MODEL_H
 
+#include "affine.h"
 #include "funexp.h"
 #include "interval.h"
+#include "intervalbox.h"
+#include "polynomial.h"
+#include "threadpool.h"
 #include "transformations.h"
 #include "utils.h"
 #include "variables.h"
@@ -132,6 +136,27 @@ TaylorModel *cpyTaylorModelHead(const TaylorModel *const list);
  */
 TaylorModel *reverseTaylorModel(TaylorModel *const list);
 
+/**
+ * @brief Compute the number of elements in the list.
+ *
+ * @return unsigned int The list length, 0 for the empty (NULL) list.
+ */
+unsigned int lengthTaylorModel(const TaylorModel *list);
+
+/**
+ * @brief Link an array of single element lists into one list, retaining
+ * the array order.
+ * @pre Each of the \p length array elements must be a single element list.
+ * @post Transfers ownership of the array elements to the returned list.
+ * Ownership of the array itself remains the caller's.
+ *
+ * @param[in] components The single element lists to link.
+ * @param[in] length     The number of elements in \p components.
+ * @return TaylorModel* The head of the linked list, or NULL if empty.
+ */
+TaylorModel *linkTaylorModels(TaylorModel **components,
+                              const unsigned int length);
+
 /**
  * @brief Deallocate the given list.
  * @pre The given list must not be NULL.
@@ -153,6 +178,7 @@ void printTaylorModel(const TaylorModel *const list, FILE *where);
  * @details Interval evaluation consists of first substituting each variable
  * in the expression tree by the corresponding interval in the domains list.
  * Then evaluate the resulting interval expression via interval arithmetic.
+ * The supported functions are sqrt, sin, cos, exp, log, atan and tanh.
  *
  * e.g. domains x &isin; [-1, 1], y &isin; [0, 2] and an expression
  * exp = y * (x + y). <br>
@@ -169,11 +195,100 @@ void printTaylorModel(const TaylorModel *const list, FILE *where);
 Interval evaluateExpTree(const ExpTree *const tree,
                          const Domain *const domains);
 
+/**
+ * @brief Perform interval-valued expression evaluation over a box.
+ * @details Like @ref evaluateExpTree, but each variable is looked up by its
+ * symbol ID in a dense box, rather than by walking a domain list. Prefer
+ * this when evaluating many expressions, or one expression over many boxes.
+ * @pre All arguments must **not** be NULL, and every variable of the
+ * \p tree must have an ID in \p symbols that is a dimension of \p box.
+ *
+ * @param[in] tree    The expression tree to evaluate via interval arithmetic.
+ * @param[in] symbols The symbol table that indexes the box.
+ * @param[in] box     The interval domain of each symbol.
+ * @return Interval The result of interval evaluation.
+ */
+Interval evaluateExpTreeBox(const ExpTree *const tree,
+                            const SymbolTable *const symbols,
+                            const IntervalBox *const box);
+
+/**
+ * @brief Perform interval-valued expression evaluation via affine
+ * arithmetic.
+ * @details Each variable is substituted by an @ref AffineForm with its own
+ * noise symbol, so dependent subexpressions cancel before the range is
+ * taken, e.g. x - x over x &isin; [-1, 1] evaluates to [0, 0] rather than
+ * [-2, 2]. This costs a pass over all noise symbols per operation.
+ * Divisors and function arguments are bounded by their range, so they
+ * keep no dependencies. The supported functions are those of
+ * @ref evaluateExpTree.
+ * @pre Both \p tree and \p domains must **not** be NULL.
+ *
+ * @param[in] tree    The expression tree to evaluate via affine arithmetic.
+ * @param[in] domains The mapping of expression variable to interval domain.
+ * @return Interval The range of the resulting affine form.
+ */
+Interval evaluateExpTreeAffine(const ExpTree *const tree,
+                               const Domain *const domains);
+
+/**
+ * @brief An enumeration of the methods that bound the range of polynomials
+ * in Taylor model arithmetic.
+ */
+typedef enum RangeBounder {
+  RANGE_BOUNDER_INTERVAL,     ///< Interval arithmetic, see
+                              ///< @ref evaluateExpTree.
+  RANGE_BOUNDER_AFFINE,       ///< Affine arithmetic, see
+                              ///< @ref evaluateExpTreeAffine.
+  RANGE_BOUNDER_BERNSTEIN,    ///< Bernstein coefficients, see
+                              ///< @ref evaluateExpTreeBernstein.
+  RANGE_BOUNDER_CENTERED,     ///< The centered form, see
+                              ///< @ref evaluateExpTreeCentered.
+  RANGE_BOUNDER_BRANCH_BOUND, ///< Branch and bound on the calling thread,
+                              ///< with @ref BRANCH_BOUND_BOXES boxes, see
+                              ///< @ref evaluateExpTreeBranchBound.
+} RangeBounder;
+
+/**
+ * @brief Select the range bounder of Taylor model arithmetic.
+ * @details The bounder encloses the truncated terms of @ref truncateTM, the
+ * polynomial ranges of @ref mulTM and of the other operations that bound a
+ * polynomial. Tighter bounds give smaller remainders, at the price of more
+ * work per bound. All other bounders intersect their enclosures with that
+ * of interval evaluation, so they are never looser.
+ * The default is
+ * @ref RANGE_BOUNDER_INTERVAL.
+ * @warning The selection is global to the process. It is atomic, so it may
+ * be changed while other threads compute, but a parallel computation would
+ * then bound some of its polynomials with either bounder. Select the
+ * bounder before any computation that runs in parallel.
+ *
+ * @param[in] bounder The range bounder to use from now on.
+ */
+void setRangeBounder(const RangeBounder bounder);
+
+/**
+ * @brief The range bounder of Taylor model arithmetic, see
+ * @ref setRangeBounder.
+ */
+RangeBounder getRangeBounder(void);
+
+/**
+ * @brief Enclose the range of an expression with the selected range bounder.
+ * @pre Both \p tree and \p domains must **not** be NULL.
+ *
+ * @param[in] tree    The expression tree to bound.
+ * @param[in] domains The mapping of expression variable to interval domain.
+ * @return Interval An enclosure of the range of \p tree over \p domains.
+ */
+Interval boundExpTree(const ExpTree *const tree, const Domain *const domains);
+
 /**
  * @brief Perform real-valued expression evaluation via real arithmetic.
  * @details Real evaluation consists of first substituting each variable
  * in the expression tree by the corresponding value in the valuation list.
  * Then evaluate the resulting expression via real arithmetic.
+ * The supported functions are those of @ref evaluateExpTree.
  *
  * e.g. valuations x = 1, y = 2 and an expression exp = y * (x + y). <br>
  * &rArr; eval(exp, valuations)
@@ -209,7 +324,9 @@ double evaluateExpTreeReal(const ExpTree *const tree,
  *                      The domains of all variables are required for TM
  *                      arithmetic to be possible.
  * @param[in] k         The Taylor polynomial order to adhere to.
- * @return TaylorModel* The result of Taylor model evaluation.
+ * @return TaylorModel* The result of Taylor model evaluation, or NULL if a
+ * division or an elementary function is applied outside of its domain, see
+ * @ref divTM and @ref logTM.
  */
 TaylorModel *evaluateExpTreeTM(const ExpTree *const tree,
                                const TaylorModel *const list,
@@ -272,19 +389,25 @@ TaylorModel *mulTM(const TaylorModel *const left,
  * @brief Binary TM division, via order k TM arithmetic.
  * @details The operation is applied elementwise to the vector operands,
  * meaning: \f$ op(left, right)[i] = op(left[i], right[i]) \f$.
- * @pre Both operands must be lists of equal length.
- * @pre The denominator may **not** contain zero (0) in its enclosure:
+ * The quotient is \f$ left \times \frac{1}{right} \f$, with the
+ * reciprocal computed by the same kernel as @ref reciprocalTM: a Horner
+ * evaluation of the truncated series with a closed-form remainder.
+ *
+ * The denominator may **not** contain zero (0) in its enclosure:
  * for \f$ right = (p_r, I_r) \f$, it must hold that
  * \f$ 0 \notin Int((p_r, I_r)) = Int(p_r) + I_r \f$. Here \f$ p_r \f$
  * is the polynomial part, \f$ Int(p_r) \f$ is an interval enclosure
  * thereof and \f$ I_r \f$ is the remainder part of the denominator TM.
+ * This is checked for every component before the reciprocal is expanded.
+ * @pre Both operands must be lists of equal length.
  * @pre \p variables must **not** be NULL.
  *
  * @param[in] left      The left operand; the dividend (numerator).
  * @param[in] right     The right operand; the divisor (denominator).
  * @param[in] variables The mapping of expression variable to interval domain.
  * @param[in] k         The Taylor polynomial order to adhere to.
- * @return A newly heap-allocated Taylor model: \f$ left \div right \f$.
+ * @return A newly heap-allocated Taylor model: \f$ left \div right \f$, or
+ * NULL if the enclosure of any denominator contains zero.
  */
 TaylorModel *divTM(const TaylorModel *const left,
                    const TaylorModel *const right,
@@ -319,6 +442,84 @@ TaylorModel *negTM(const TaylorModel *const list, const Domain *const variables,
 TaylorModel *powTM(const TaylorModel *const left, const unsigned int right,
                    const Domain *const variables, const unsigned int k);
 
+/**
+ * @brief Unary TM sine, via order k TM arithmetic.
+ * @details The elementary functions f are applied elementwise to the vector
+ * operand. For \f$ (p, I) \f$ with range \f$ B = Int(p) + I \f$, let c be
+ * the midpoint of B. Then
+ * \f[ f((p, I)) = \sum_{i=0}^{k} \frac{f^{(i)}(c)}{i!} (p - c, I)^i
+ *    + \frac{f^{(k+1)}(B)}{(k+1)!} (B - c)^{k+1}, \f]
+ * where the coefficients come from closed-form derivative tables and are
+ * enclosed by interval arithmetic; their rounding is moved into the
+ * remainder. The sum is composed in Horner form, in one pass of TM
+ * multiplications and additions, and its terms are collected after every
+ * step by @ref collectTM, which encloses the rounding of the collected
+ * coefficients in the remainder as well.
+ * @pre \p variables must **not** be NULL.
+ *
+ * @param[in] list      The operand.
+ * @param[in] variables The mapping of expression variable to interval domain.
+ * @param[in] k         The Taylor polynomial order to adhere to.
+ * @return A newly heap-allocated Taylor model: \f$ \sin(list) \f$.
+ */
+TaylorModel *sinTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k);
+
+/**
+ * @brief Unary TM cosine, via order k TM arithmetic.
+ * @details See @ref sinTM.
+ * @pre \p variables must **not** be NULL.
+ *
+ * @return A newly heap-allocated Taylor model: \f$ \cos(list) \f$.
+ */
+TaylorModel *cosTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k);
+
+/**
+ * @brief Unary TM exponential, via order k TM arithmetic.
+ * @details See @ref sinTM.
+ * @pre \p variables must **not** be NULL.
+ *
+ * @return A newly heap-allocated Taylor model: \f$ e^{list} \f$.
+ */
+TaylorModel *expTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k);
+
+/**
+ * @brief Unary TM natural logarithm, via order k TM arithmetic.
+ * @details See @ref sinTM.
+ * @pre \p variables must **not** be NULL.
+ *
+ * @return A newly heap-allocated Taylor model: \f$ \log(list) \f$, or NULL
+ * if the range of any component is not positive.
+ */
+TaylorModel *logTM(const TaylorModel *const list, const Domain *const variables,
+                   const unsigned int k);
+
+/**
+ * @brief Unary TM square root, via order k TM arithmetic.
+ * @details See @ref sinTM.
+ * @pre \p variables must **not** be NULL.
+ *
+ * @return A newly heap-allocated Taylor model: \f$ \sqrt{list} \f$, or NULL
+ * if the range of any component is not positive; 0 is excluded since the
+ * derivatives of sqrt are unbounded there.
+ */
+TaylorModel *sqrtTM(const TaylorModel *const list,
+                    const Domain *const variables, const unsigned int k);
+
+/**
+ * @brief Unary TM reciprocal, via order k TM arithmetic.
+ * @details See @ref sinTM.
+ * @pre \p variables must **not** be NULL.
+ *
+ * @return A newly heap-allocated Taylor model: \f$ 1 / list \f$, or NULL if
+ * the range of any component contains zero (0).
+ */
+TaylorModel *reciprocalTM(const TaylorModel *const list,
+                          const Domain *const variables,
+                          const unsigned int k);
+
 /**
  * @brief Definite TM integration, via order k TM arithmetic.
  * @details The operation is applied elementwise to the vector operand,
@@ -336,6 +537,31 @@ TaylorModel *intTM(const TaylorModel *const list,
                    const Interval *const intDomain, const char *const intVar,
                    const Domain *const variables, const unsigned int k);
 
+/**
+ * @brief Indefinite TM integration from zero, via order k TM arithmetic.
+ * @details Unlike @ref intTM, the result still depends on \p intVar:
+ * \f$ (\int_0^v p \, dv, \; I \cdot D_v) \f$ for integration variable v with
+ * domain \f$ D_v \f$. Since the integrand stays within \f$ p + I \f$ over
+ * the domain, the remainder of the integral stays within \f$ v I \f$. This is
+ * the integral in the Picard operator, \f$ \int_0^t f(g(s)) ds \f$.
+ * The polynomial part of the result has its like terms collected, and the
+ * rounding of its coefficients is enclosed in the remainder, see
+ * @ref collectPrimitiveTM.
+ * The operation is applied elementwise to the vector operand,
+ * meaning: \f$ op(list)[i] = op(list[i]) \f$.
+ * @pre \p variables must **not** be NULL and must contain a domain for
+ * \p intVar. The polynomial parts of \p list must be polynomials.
+ *
+ * @param[in] list      The operand; the integrand.
+ * @param[in] intVar    The variable w.r.t. which to integrate, e.g. t.
+ * @param[in] variables The mapping of expression variable to interval domain.
+ * @param[in] k         The Taylor polynomial order to adhere to.
+ * @return A newly heap-allocated Taylor model: \f$ \int_0^v ( list )dv \f$.
+ */
+TaylorModel *primitiveTM(const TaylorModel *const list,
+                         const char *const intVar,
+                         const Domain *const variables, const unsigned int k);
+
 /**
  * @brief Truncate the given Taylor model to order k.
  * @details Truncating to order k implies:
@@ -354,4 +580,51 @@ TaylorModel *intTM(const TaylorModel *const list,
 TaylorModel *truncateTM(const TaylorModel *const list,
                         const Domain *const variables, const unsigned int k);
 
+/**
+ * @brief Parallel variant of @ref addTM.
+ * @details The vector components are distributed over the \p pool. The output
+ * is identical to that of @ref addTM, including the component order.
+ * If \p pool is NULL, then the components are processed serially; this is
+ * how @ref addTM is computed.
+ */
+TaylorModel *addTMParallel(const TaylorModel *const left,
+                           const TaylorModel *const right,
+                           const Domain *const variables, const unsigned int k,
+                           ThreadPool *pool);
+
+/**
+ * @brief Parallel variant of @ref subTM.
+ * @details The vector components are distributed over the \p pool. The output
+ * is identical to that of @ref subTM, including the component order.
+ * If \p pool is NULL, then the components are processed serially; this is
+ * how @ref subTM is computed.
+ */
+TaylorModel *subTMParallel(const TaylorModel *const left,
+                           const TaylorModel *const right,
+                           const Domain *const variables, const unsigned int k,
+                           ThreadPool *pool);
+
+/**
+ * @brief Parallel variant of @ref mulTM.
+ * @details The vector components are distributed over the \p pool. The output
+ * is identical to that of @ref mulTM, including the component order.
+ * If \p pool is NULL, then the components are processed serially; this is
+ * how @ref mulTM is computed.
+ */
+TaylorModel *mulTMParallel(const TaylorModel *const left,
+                           const TaylorModel *const right,
+                           const Domain *const variables, const unsigned int k,
+                           ThreadPool *pool);
+
+/**
+ * @brief Parallel variant of @ref truncateTM.
+ * @details The vector components are distributed over the \p pool. The output
+ * is identical to that of @ref truncateTM, including the component order.
+ * If \p pool is NULL, then the components are processed serially; this is
+ * how @ref truncateTM is computed.
+ */
+TaylorModel *truncateTMParallel(const TaylorModel *const list,
+                                const Domain *const variables,
+                                const unsigned int k, ThreadPool *pool);
+
 #endif
@@ -0,0 +1,456 @@
+#include "tmbernstein.h"
+#include <math.h>
+#include <pthread.h>
+
+/* The binomial coefficient n over k, exact for the small degrees of TMs. */
+static double binomial(const unsigned int n, const unsigned int k) {
+  double result = 1;
+  for (unsigned int it = 1; it <= k; ++it)
+    result = result * (n - k + it) / it;
+  return result;
+}
+
+/* The distance between consecutive coefficients of variable j. */
+static unsigned int strideBernsteinForm(const BernsteinForm *const form,
+                                        const unsigned int j) {
+  unsigned int stride = 1;
+  for (unsigned int it = j + 1; it < form->nvars; ++it)
+    stride *= form->degrees[it] + 1;
+  return stride;
+}
+
+/* Whether coefficient index is the first of a fiber along variable j, i.e.
+  its index i_j is 0. */
+static bool isFiberStart(const BernsteinForm *const form, const unsigned int j,
+                         const unsigned int stride, const unsigned int index) {
+  return (index / stride) % (form->degrees[j] + 1) == 0;
+}
+
+/* The domain of the named variable. */
+static const Interval *findDomain(const Domain *const domains,
+                                  const char *const name) {
+  for (const Domain *dom = domains; dom != NULL; dom = dom->next)
+    if (strcmp(dom->var, name) == 0)
+      return &dom->domain;
+
+  /* The polynomial contains a variable whose domain is unknown. */
+  assert(false);
+  return NULL;
+}
+
+/* Substitute x_j = a + w t_j, with [a, a + w] the domain of variable j, in
+  the power basis: e_i = w^i sum_{k >= i} C(k, i) a^(k - i) c_k. */
+static void shiftDimension(BernsteinForm *const form, const unsigned int j,
+                           const Interval *const domain, Interval *buffer) {
+  const unsigned int d = form->degrees[j];
+  const unsigned int stride = strideBernsteinForm(form, j);
+  Interval a = newInterval(domain->left, domain->left);
+  Interval b = newInterval(domain->right, domain->right);
+  Interval w = subInterval(&b, &a);
+
+  for (unsigned int base = 0; base < form->length; ++base) {
+    if (!isFiberStart(form, j, stride, base))
+      continue;
+
+    Interval *fiber = &form->coefs[base];
+    for (unsigned int i = 0; i <= d; ++i) {
+      Interval sum = newInterval(0, 0);
+      for (unsigned int k = i; k <= d; ++k) {
+        Interval factor = pow2Interval(&a, k - i);
+        Interval choose = newInterval(binomial(k, i), binomial(k, i));
+        factor = mulInterval(&factor, &choose);
+        factor = mulInterval(&factor, &fiber[k * stride]);
+        sum = addInterval(&sum, &factor);
+      }
+      Interval scale = pow2Interval(&w, i);
+      buffer[i] = mulInterval(&sum, &scale);
+    }
+    for (unsigned int i = 0; i <= d; ++i)
+      fiber[i * stride] = buffer[i];
+  }
+}
+
+/* Convert variable j from the power basis of [0, 1] to the Bernstein basis:
+  b_i = sum_{k <= i} C(i, k) / C(d, k) e_k. */
+static void bernsteinDimension(BernsteinForm *const form, const unsigned int j,
+                               Interval *buffer) {
+  const unsigned int d = form->degrees[j];
+  const unsigned int stride = strideBernsteinForm(form, j);
+
+  for (unsigned int base = 0; base < form->length; ++base) {
+    if (!isFiberStart(form, j, stride, base))
+      continue;
+
+    Interval *fiber = &form->coefs[base];
+    for (unsigned int i = 0; i <= d; ++i) {
+      buffer[i] = newInterval(0, 0);
+      for (unsigned int k = 0; k <= i; ++k) {
+        Interval numerator = newInterval(binomial(i, k), binomial(i, k));
+        Interval denominator = newInterval(binomial(d, k), binomial(d, k));
+        Interval ratio = divInterval(&numerator, &denominator);
+        Interval term = mulInterval(&ratio, &fiber[k * stride]);
+        buffer[i] = addInterval(&buffer[i], &term);
+      }
+    }
+    for (unsigned int i = 0; i <= d; ++i)
+      fiber[i * stride] = buffer[i];
+  }
+}
+
+/* Expand a polynomial with interval coefficients, see newBernsteinForm. */
+static BernsteinForm *newIntervalBernsteinForm(
+    const IntervalPolynomial *const poly, const Domain *const domains) {
+  unsigned int *degrees =
+      (unsigned int *)calloc(poly->nvars + 1, sizeof(unsigned int));
+  if (degrees == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  unsigned int maxDegree = 0;
+  for (unsigned int term = 0; term < poly->length; ++term)
+    for (unsigned int j = 0; j < poly->nvars; ++j) {
+      unsigned int exponent = poly->exponents[term * poly->nvars + j];
+      if (exponent > degrees[j])
+        degrees[j] = exponent;
+      if (exponent > maxDegree)
+        maxDegree = exponent;
+    }
+
+  /* Give up on forms that are too large, without overflowing. */
+  unsigned int length = 1;
+  for (unsigned int j = 0; j < poly->nvars; ++j) {
+    if (length > BERNSTEIN_MAX_COEFFICIENTS / (degrees[j] + 1)) {
+      free(degrees);
+      return NULL;
+    }
+    length *= degrees[j] + 1;
+  }
+
+  BernsteinForm *form = (BernsteinForm *)malloc(sizeof(BernsteinForm));
+  double *widths = (double *)malloc((poly->nvars + 1) * sizeof(double));
+  Interval *coefs = (Interval *)calloc(length, sizeof(Interval));
+  Interval *buffer = (Interval *)malloc((maxDegree + 1) * sizeof(Interval));
+  if (form == NULL || widths == NULL || coefs == NULL || buffer == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  form->nvars = poly->nvars;
+  form->degrees = degrees;
+  form->widths = widths;
+  form->length = length;
+  form->coefs = coefs;
+
+  beginOutwardRounding();
+
+  /* Scatter the terms into the dense power basis. */
+  for (unsigned int term = 0; term < poly->length; ++term) {
+    unsigned int index = 0;
+    for (unsigned int j = 0; j < poly->nvars; ++j)
+      index = index * (degrees[j] + 1) +
+              poly->exponents[term * poly->nvars + j];
+    coefs[index] = poly->coefficients[term];
+  }
+
+  /* Map the box to the unit box, then change the basis, one variable at a
+    time. */
+  for (unsigned int j = 0; j < poly->nvars; ++j) {
+    const Interval *domain = findDomain(domains, poly->vars[j]);
+    widths[j] = domain->right - domain->left;
+    shiftDimension(form, j, domain, buffer);
+    bernsteinDimension(form, j, buffer);
+  }
+
+  endOutwardRounding();
+
+  /* Clean */
+  free(buffer);
+
+  return form;
+}
+
+BernsteinForm *newBernsteinForm(const Polynomial *const poly,
+                                const Domain *const domains) {
+  assert(poly != NULL);
+  assert(domains != NULL);
+
+  /* The coefficients of a polynomial are exact. */
+  Interval *coefficients =
+      (Interval *)malloc((poly->length + 1) * sizeof(Interval));
+  if (coefficients == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (unsigned int term = 0; term < poly->length; ++term)
+    coefficients[term] =
+        newInterval(poly->coefficients[term], poly->coefficients[term]);
+  IntervalPolynomial exact = {poly->vars,   poly->nvars,  poly->length,
+                              poly->length, coefficients, poly->exponents};
+  BernsteinForm *form = newIntervalBernsteinForm(&exact, domains);
+
+  /* Clean */
+  free(coefficients);
+
+  return form;
+}
+
+void delBernsteinForm(BernsteinForm *form) {
+  assert(form != NULL);
+  free(form->degrees);
+  free(form->widths);
+  free(form->coefs);
+  free(form);
+}
+
+/* Split the coefficients along variable j at t_j = 1/2, via de Casteljau's
+  algorithm on every fiber. */
+static void splitDimension(const BernsteinForm *const form,
+                           const Interval *const coefs, Interval *lower,
+                           Interval *upper, const unsigned int j,
+                           Interval *buffer) {
+  const unsigned int d = form->degrees[j];
+  const unsigned int stride = strideBernsteinForm(form, j);
+  const Interval half = newInterval(0.5, 0.5);
+
+  for (unsigned int base = 0; base < form->length; ++base) {
+    if (!isFiberStart(form, j, stride, base))
+      continue;
+
+    for (unsigned int i = 0; i <= d; ++i)
+      buffer[i] = coefs[base + i * stride];
+    lower[base] = buffer[0];
+    upper[base + d * stride] = buffer[d];
+    for (unsigned int r = 1; r <= d; ++r) {
+      for (unsigned int i = 0; i + r <= d; ++i) {
+        Interval sum = addInterval(&buffer[i], &buffer[i + 1]);
+        buffer[i] = mulInterval(&sum, &half);
+      }
+      lower[base + r * stride] = buffer[0];
+      upper[base + (d - r) * stride] = buffer[d - r];
+    }
+  }
+}
+
+/* The recursive kernel of rangeBernsteinForm, over the sub-box whose
+  coefficients are given. */
+static Interval rangeCoefficients(const BernsteinForm *const form,
+                                  const Interval *const coefs,
+                                  const double *const widths,
+                                  const unsigned int depth) {
+  double lower = INFINITY, upper = -INFINITY;
+  double lowerVertex = INFINITY, upperVertex = -INFINITY;
+  for (unsigned int index = 0; index < form->length; ++index) {
+    lower = fmin(lower, coefs[index].left);
+    upper = fmax(upper, coefs[index].right);
+
+    /* Decode the multi-index, last variable first. */
+    bool vertex = true;
+    unsigned int rest = index;
+    for (unsigned int j = form->nvars; j > 0; --j) {
+      unsigned int i = rest % (form->degrees[j - 1] + 1);
+      rest /= form->degrees[j - 1] + 1;
+      vertex &= (i == 0 || i == form->degrees[j - 1]);
+    }
+    if (vertex) {
+      lowerVertex = fmin(lowerVertex, coefs[index].left);
+      upperVertex = fmax(upperVertex, coefs[index].right);
+    }
+  }
+
+  /* Vertex coefficients enclose values of the polynomial, so the bounds are
+    sharp if the extremes are at vertices. */
+  if ((lower == lowerVertex && upper == upperVertex) || depth == 0)
+    return newInterval(lower, upper);
+
+  /* Bisect the widest variable that the polynomial depends on. */
+  unsigned int widest = form->nvars;
+  for (unsigned int j = 0; j < form->nvars; ++j)
+    if (form->degrees[j] > 0 &&
+        (widest == form->nvars || widths[j] > widths[widest]))
+      widest = j;
+  assert(widest < form->nvars);
+
+  Interval *lowerHalf = (Interval *)malloc(form->length * sizeof(Interval));
+  Interval *upperHalf = (Interval *)malloc(form->length * sizeof(Interval));
+  Interval *buffer =
+      (Interval *)malloc((form->degrees[widest] + 1) * sizeof(Interval));
+  double *halfWidths = (double *)malloc(form->nvars * sizeof(double));
+  if (lowerHalf == NULL || upperHalf == NULL || buffer == NULL ||
+      halfWidths == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  splitDimension(form, coefs, lowerHalf, upperHalf, widest, buffer);
+  memcpy(halfWidths, widths, form->nvars * sizeof(double));
+  halfWidths[widest] /= 2;
+
+  Interval lowerRange =
+      rangeCoefficients(form, lowerHalf, halfWidths, depth - 1);
+  Interval upperRange =
+      rangeCoefficients(form, upperHalf, halfWidths, depth - 1);
+
+  /* Clean */
+  free(lowerHalf);
+  free(upperHalf);
+  free(buffer);
+  free(halfWidths);
+
+  return newInterval(fmin(lowerRange.left, upperRange.left),
+                     fmax(lowerRange.right, upperRange.right));
+}
+
+Interval rangeBernsteinForm(const BernsteinForm *const form,
+                            const unsigned int maxDepth) {
+  assert(form != NULL);
+
+  beginOutwardRounding();
+  Interval range = rangeCoefficients(form, form->coefs, form->widths, maxDepth);
+  endOutwardRounding();
+  return range;
+}
+
+/* A cached form, keyed by the interval polynomial and the domains of its
+  variables. The polynomial borrows its variables from vars. The form is NULL
+  for polynomials that are too large. */
+typedef struct BernsteinEntry {
+  unsigned int hash;
+  Polynomial *vars;
+  IntervalPolynomial *poly;
+  Interval *box;
+  BernsteinForm *form;
+  Interval range;
+} BernsteinEntry;
+
+/* A direct-mapped cache: a new form replaces the one in its slot. */
+static BernsteinEntry bernsteinCache[BERNSTEIN_CACHE_SIZE];
+static unsigned int bernsteinHits = 0;
+static unsigned int bernsteinMisses = 0;
+static pthread_mutex_t bernsteinLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* The FNV-1a hash of the given bytes, continuing from hash. */
+static unsigned int hashBytes(unsigned int hash, const void *data,
+                              const size_t size) {
+  const unsigned char *bytes = (const unsigned char *)data;
+  for (size_t it = 0; it < size; ++it) {
+    hash ^= bytes[it];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+static unsigned int hashKey(const IntervalPolynomial *const poly,
+                            const Interval *const box) {
+  unsigned int hash = 2166136261u;
+  for (unsigned int j = 0; j < poly->nvars; ++j)
+    hash = hashBytes(hash, poly->vars[j], strlen(poly->vars[j]) + 1);
+  hash = hashBytes(hash, poly->exponents,
+                   poly->length * poly->nvars * sizeof(unsigned int));
+  hash = hashBytes(hash, poly->coefficients, poly->length * sizeof(Interval));
+  return hashBytes(hash, box, poly->nvars * sizeof(Interval));
+}
+
+static bool isKey(const BernsteinEntry *const entry, const unsigned int hash,
+                  const IntervalPolynomial *const poly,
+                  const Interval *const box) {
+  if (entry->poly == NULL || entry->hash != hash ||
+      entry->poly->nvars != poly->nvars || entry->poly->length != poly->length)
+    return false;
+  for (unsigned int j = 0; j < poly->nvars; ++j)
+    if (strcmp(entry->poly->vars[j], poly->vars[j]) != 0)
+      return false;
+  return memcmp(entry->poly->exponents, poly->exponents,
+                poly->length * poly->nvars * sizeof(unsigned int)) == 0 &&
+         memcmp(entry->poly->coefficients, poly->coefficients,
+                poly->length * sizeof(Interval)) == 0 &&
+         memcmp(entry->box, box, poly->nvars * sizeof(Interval)) == 0;
+}
+
+static void clearEntry(BernsteinEntry *const entry) {
+  if (entry->poly == NULL)
+    return;
+  delIntervalPolynomial(entry->poly);
+  delPolynomial(entry->vars);
+  free(entry->box);
+  if (entry->form != NULL)
+    delBernsteinForm(entry->form);
+  entry->vars = NULL;
+  entry->poly = NULL;
+  entry->box = NULL;
+  entry->form = NULL;
+}
+
+Interval evaluateExpTreeBernstein(const ExpTree *const tree,
+                                  const Domain *const domains) {
+  assert(tree != NULL);
+  assert(domains != NULL);
+
+  /* The double coefficients of toPolynomial may cancel, so the form is built
+    from interval coefficients, over the same variables. */
+  Polynomial *vars = toPolynomial(tree);
+  IntervalPolynomial *poly =
+      (vars != NULL) ? toIntervalPolynomial(tree, vars->vars, vars->nvars)
+                     : NULL;
+  if (poly == NULL) {
+    if (vars != NULL)
+      delPolynomial(vars);
+    return evaluateExpTree(tree, domains);
+  }
+
+  Interval *box = (Interval *)malloc((poly->nvars + 1) * sizeof(Interval));
+  if (box == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (unsigned int j = 0; j < poly->nvars; ++j)
+    box[j] = *findDomain(domains, poly->vars[j]);
+  const unsigned int hash = hashKey(poly, box);
+  BernsteinEntry *entry = &bernsteinCache[hash % BERNSTEIN_CACHE_SIZE];
+
+  /* Compute outside of the lock, so threads only wait for lookups. */
+  pthread_mutex_lock(&bernsteinLock);
+  if (isKey(entry, hash, poly, box)) {
+    Interval range = entry->range;
+    ++bernsteinHits;
+    pthread_mutex_unlock(&bernsteinLock);
+    delIntervalPolynomial(poly);
+    delPolynomial(vars);
+    free(box);
+    return range;
+  }
+  ++bernsteinMisses;
+  pthread_mutex_unlock(&bernsteinLock);
+
+  BernsteinForm *form = newIntervalBernsteinForm(poly, domains);
+  Interval range = (form != NULL)
+                       ? rangeBernsteinForm(form, BERNSTEIN_MAX_DEPTH)
+                       : evaluateExpTree(tree, domains);
+
+  pthread_mutex_lock(&bernsteinLock);
+  clearEntry(entry);
+  entry->hash = hash;
+  entry->vars = vars;
+  entry->poly = poly;
+  entry->box = box;
+  entry->form = form;
+  entry->range = range;
+  pthread_mutex_unlock(&bernsteinLock);
+
+  return range;
+}
+
+void clearBernsteinCache(void) {
+  pthread_mutex_lock(&bernsteinLock);
+  for (unsigned int it = 0; it < BERNSTEIN_CACHE_SIZE; ++it)
+    clearEntry(&bernsteinCache[it]);
+  bernsteinHits = 0;
+  bernsteinMisses = 0;
+  pthread_mutex_unlock(&bernsteinLock);
+}
+
+void bernsteinCacheStats(unsigned int *hits, unsigned int *misses) {
+  pthread_mutex_lock(&bernsteinLock);
+  if (hits != NULL)
+    *hits = bernsteinHits;
+  if (misses != NULL)
+    *misses = bernsteinMisses;
+  pthread_mutex_unlock(&bernsteinLock);
+}
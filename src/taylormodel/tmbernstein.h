@@ -0,0 +1,136 @@
+/**
+ * @file tmbernstein.h
+ * @brief Range enclosures of polynomials via their Bernstein coefficients.
+ * @details Interval evaluation of a sum of products overestimates the range
+ * of a polynomial more the wider the box gets. Expanded in the Bernstein
+ * basis of the box, the range of a polynomial lies between its smallest and
+ * largest Bernstein coefficient, and the coefficients at the vertices of the
+ * box are values of the polynomial. So if the extreme coefficients sit at
+ * vertices, the enclosure is the exact range. Otherwise the box is bisected
+ * via de Casteljau's algorithm, which converges quadratically.
+ *
+ * Taylor model arithmetic bounds the same polynomials over and over within
+ * one step, so the Bernstein forms are cached, keyed by the polynomial and
+ * its box.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_BERNSTEIN_H
+#define TM_BERNSTEIN_H
+
+#include "funexp.h"
+#include "interval.h"
+#include "polynomial.h"
+#include "taylormodel.h"
+#include "tmcollect.h"
+#include "variables.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The largest number of Bernstein coefficients of one form; larger
+/// polynomials are bounded via interval evaluation instead.
+#define BERNSTEIN_MAX_COEFFICIENTS 4096
+
+/// @brief The number of bisections by which @ref evaluateExpTreeBernstein
+/// refines a form at most.
+#define BERNSTEIN_MAX_DEPTH 6
+
+/// @brief The number of slots of the cache of Bernstein forms.
+#define BERNSTEIN_CACHE_SIZE 256
+
+/**
+ * @brief A multivariate polynomial in the tensor Bernstein basis of a box.
+ * @details The polynomial has degree \f$ d_j \f$ in variable j. Coefficient
+ * \f$ b_{i_0 i_1 \ldots} \f$ is stored at index
+ * \f$ \sum_j i_j s_j \f$, with stride \f$ s_j = \prod_{l > j} (d_l + 1) \f$.
+ * The coefficients are intervals, which enclose the rounding errors of the
+ * basis conversion.
+ */
+typedef struct BernsteinForm {
+  /// @brief The number of variables.
+  unsigned int nvars;
+  /// @brief The degree \f$ d_j \f$ of each variable.
+  unsigned int *degrees;
+  /// @brief The width of the box along each variable.
+  double *widths;
+  /// @brief The number of coefficients, \f$ \prod_j (d_j + 1) \f$.
+  unsigned int length;
+  /// @brief The Bernstein coefficients, see above.
+  Interval *coefs;
+} BernsteinForm;
+
+/**
+ * @brief Expand a polynomial in the Bernstein basis of its box.
+ * @pre Neither argument may be NULL, and every variable of \p poly must
+ * have a domain in \p domains.
+ *
+ * @param[in] poly    The polynomial.
+ * @param[in] domains The mapping of polynomial variable to interval domain.
+ * @return BernsteinForm* A heap-allocated form, or NULL if it would have
+ * more than @ref BERNSTEIN_MAX_COEFFICIENTS coefficients.
+ */
+BernsteinForm *newBernsteinForm(const Polynomial *const poly,
+                                const Domain *const domains);
+
+/**
+ * @brief Deallocate the given form.
+ * @pre \p form may **not** be NULL.
+ */
+void delBernsteinForm(BernsteinForm *form);
+
+/**
+ * @brief Enclose the range of the polynomial over its box.
+ * @details The enclosure is the hull of the coefficients. The box is
+ * bisected, along its widest variable, only while the smallest or largest
+ * coefficient is not at a vertex, and at most \p maxDepth times.
+ * @pre \p form may **not** be NULL.
+ *
+ * @param[in] form     The Bernstein form of the polynomial.
+ * @param[in] maxDepth The maximal number of nested bisections.
+ * @return Interval An enclosure of the range.
+ */
+Interval rangeBernsteinForm(const BernsteinForm *const form,
+                            const unsigned int maxDepth);
+
+/**
+ * @brief Enclose the range of an expression via its Bernstein form.
+ * @details The expression is converted to a polynomial with interval
+ * coefficients first, see @ref toIntervalPolynomial, so coefficients that
+ * cancel in double arithmetic are still enclosed. Forms and their ranges are
+ * cached, so bounding the same polynomial over the same box again is a
+ * lookup. Expressions that are not polynomials, and
+ * polynomials with too many coefficients, are bounded via
+ * @ref evaluateExpTree instead. Safe to call from multiple threads.
+ * @pre Both \p tree and \p domains must **not** be NULL.
+ *
+ * @param[in] tree    The expression tree to bound.
+ * @param[in] domains The mapping of expression variable to interval domain.
+ * @return Interval An enclosure of the range of \p tree over \p domains.
+ */
+Interval evaluateExpTreeBernstein(const ExpTree *const tree,
+                                  const Domain *const domains);
+
+/**
+ * @brief Deallocate all cached Bernstein forms.
+ * @details The cache holds at most @ref BERNSTEIN_CACHE_SIZE forms, so
+ * this only frees memory; it is never required for correctness.
+ */
+void clearBernsteinCache(void);
+
+/**
+ * @brief The number of cache lookups so far that found, resp. did not
+ * find, their form.
+ *
+ * @param[out] hits   The number of hits. Ignored if NULL.
+ * @param[out] misses The number of misses. Ignored if NULL.
+ */
+void bernsteinCacheStats(unsigned int *hits, unsigned int *misses);
+
+#endif
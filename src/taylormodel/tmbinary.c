@@ -0,0 +1,357 @@
+#include "tmbinary.h"
+
+/* The sections of a file, in bytes from its start. */
+typedef struct BinaryLayout {
+  uint64_t entries;
+  uint64_t nodes;
+  uint64_t offsets;
+  uint64_t pool;
+  uint64_t size;
+} BinaryLayout;
+
+static BinaryLayout binaryLayout(const BinaryHeader *const header) {
+  /* The counts are 32 bit, so none of the sums overflow before the pool,
+    whose 64 bit size the caller must check first. */
+  BinaryLayout layout;
+  layout.entries = sizeof(BinaryHeader);
+  layout.nodes =
+      layout.entries + (uint64_t)header->entries * sizeof(BinaryEntry);
+  layout.offsets = layout.nodes + (uint64_t)header->nodes * sizeof(BinaryNode);
+  layout.pool = layout.offsets + (uint64_t)header->symbols * sizeof(uint64_t);
+  layout.size = layout.pool + header->poolSize;
+  return layout;
+}
+
+/* The state of a file that is being written. */
+typedef struct BinaryWriter {
+  SymbolTable *symbols;
+  BinaryEntry *entries;
+  uint32_t numEntries;
+  uint32_t capEntries;
+  BinaryNode *nodes;
+  uint32_t numNodes;
+  uint32_t capNodes;
+} BinaryWriter;
+
+static void *growArray(void *array, uint32_t *capacity, const size_t size) {
+  *capacity = 2 * *capacity + 16;
+  array = realloc(array, *capacity * size);
+  if (array == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  return array;
+}
+
+/* Append the tree in post-order, and return the index of its root. */
+static uint32_t addBinaryTree(BinaryWriter *writer, const ExpTree *tree) {
+  if (tree == NULL)
+    return BINARY_NONE;
+
+  BinaryNode node;
+  node.type = (uint32_t)tree->type;
+  node.data = (tree->data == NULL) ? BINARY_NONE
+                                   : internSymbol(writer->symbols, tree->data);
+  node.left = addBinaryTree(writer, tree->left);
+  node.right = addBinaryTree(writer, tree->right);
+
+  if (writer->numNodes == writer->capNodes)
+    writer->nodes = (BinaryNode *)growArray(writer->nodes, &writer->capNodes,
+                                            sizeof(BinaryNode));
+  writer->nodes[writer->numNodes] = node;
+  return writer->numNodes++;
+}
+
+static void addBinaryEntry(BinaryWriter *writer, const char *name,
+                           const ExpTree *tree, const Interval interval) {
+  BinaryEntry entry;
+  memset(&entry, 0, sizeof(BinaryEntry));
+  entry.name = internSymbol(writer->symbols, name);
+  entry.root = addBinaryTree(writer, tree);
+  entry.interval = interval;
+
+  if (writer->numEntries == writer->capEntries)
+    writer->entries = (BinaryEntry *)growArray(
+        writer->entries, &writer->capEntries, sizeof(BinaryEntry));
+  writer->entries[writer->numEntries++] = entry;
+}
+
+/* Write count elements of the array, which may be NULL if count is 0. */
+static bool writeArray(const void *array, const size_t size,
+                       const uint32_t count, FILE *out) {
+  return count == 0 || fwrite(array, size, count, out) == count;
+}
+
+/* Write the collected entries, and deallocate the writer's state. */
+static int finishBinary(BinaryWriter *writer, const BinaryKind kind,
+                        FILE *out) {
+  BinaryHeader header;
+  memset(&header, 0, sizeof(BinaryHeader));
+  memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+  header.version = BINARY_VERSION;
+  header.kind = (uint32_t)kind;
+  header.byteOrder = BINARY_BYTE_ORDER;
+  header.entries = writer->numEntries;
+  header.nodes = writer->numNodes;
+  header.symbols = writer->symbols->length;
+
+  uint64_t *offsets = (uint64_t *)calloc(header.symbols + 1, sizeof(uint64_t));
+  if (offsets == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (uint32_t it = 0; it < header.symbols; ++it) {
+    offsets[it] = header.poolSize;
+    header.poolSize += strlen(symbolName(writer->symbols, it)) + 1;
+  }
+
+  bool ok = fwrite(&header, sizeof(BinaryHeader), 1, out) == 1;
+  ok = ok && writeArray(writer->entries, sizeof(BinaryEntry), header.entries,
+                        out);
+  ok = ok && writeArray(writer->nodes, sizeof(BinaryNode), header.nodes, out);
+  ok = ok && writeArray(offsets, sizeof(uint64_t), header.symbols, out);
+  for (uint32_t it = 0; ok && it < header.symbols; ++it) {
+    const char *name = symbolName(writer->symbols, it);
+    ok = fwrite(name, 1, strlen(name) + 1, out) == strlen(name) + 1;
+  }
+
+  /* Clean */
+  free(offsets);
+  free(writer->nodes);
+  free(writer->entries);
+  delSymbolTable(writer->symbols);
+
+  return ok ? 0 : -1;
+}
+
+int writeOdeListBinary(const ODEList *list, FILE *out) {
+  assert(out != NULL);
+
+  BinaryWriter writer = {newSymbolTable(), NULL, 0, 0, NULL, 0, 0};
+  for (; list != NULL; list = list->next)
+    addBinaryEntry(&writer, list->fun, list->exp, newInterval(0, 0));
+  return finishBinary(&writer, BINARY_ODE_LIST, out);
+}
+
+int writeDomainBinary(const Domain *list, FILE *out) {
+  assert(out != NULL);
+
+  BinaryWriter writer = {newSymbolTable(), NULL, 0, 0, NULL, 0, 0};
+  for (; list != NULL; list = list->next)
+    addBinaryEntry(&writer, list->var, NULL, list->domain);
+  return finishBinary(&writer, BINARY_DOMAIN, out);
+}
+
+int writeTaylorModelBinary(const TaylorModel *list, FILE *out) {
+  assert(out != NULL);
+
+  BinaryWriter writer = {newSymbolTable(), NULL, 0, 0, NULL, 0, 0};
+  for (; list != NULL; list = list->next)
+    addBinaryEntry(&writer, list->fun, list->exp, list->remainder);
+  return finishBinary(&writer, BINARY_TAYLOR_MODEL, out);
+}
+
+/* Whether the node is well-formed, as its constructors would make it. */
+static bool isValidNode(const BinaryNode *node, const uint32_t index,
+                        const uint32_t symbols) {
+  bool leaf = node->type == EXP_NUM || node->type == EXP_VAR;
+  bool unary = node->type == EXP_NEG || node->type == EXP_FUN;
+  if (node->type > EXP_FUN)
+    return false;
+
+  /* Only leaves and functions have data. */
+  if ((leaf || node->type == EXP_FUN) ? node->data >= symbols
+                                      : node->data != BINARY_NONE)
+    return false;
+
+  /* Children precede their parent. */
+  if (leaf)
+    return node->left == BINARY_NONE && node->right == BINARY_NONE;
+  if (unary)
+    return node->left < index && node->right == BINARY_NONE;
+  return node->left < index && node->right < index;
+}
+
+/* Whether the memory holds a complete, well-formed file. */
+static bool isValidImage(const BinaryImage *image) {
+  const BinaryHeader *header = image->header;
+  for (uint32_t it = 0; it < header->symbols; ++it)
+    if (image->offsets[it] >= header->poolSize)
+      return false;
+  /* Then every name ends within the pool. */
+  if (header->symbols > 0 && image->pool[header->poolSize - 1] != '\0')
+    return false;
+
+  /* Every node is referenced at most once, by a parent or an entry, and no
+    tree is deeper than the limit. The depth of a node is 1 + the depth of
+    its deepest child, or 0 if the node is referenced already. */
+  uint32_t *depths = (uint32_t *)calloc(header->nodes + 1, sizeof(uint32_t));
+  if (depths == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  bool valid = true;
+  for (uint32_t it = 0; valid && it < header->nodes; ++it) {
+    const BinaryNode *node = &image->nodes[it];
+    valid = isValidNode(node, it, header->symbols);
+    uint32_t depth = 0;
+    const uint32_t children[2] = {node->left, node->right};
+    for (unsigned int child = 0; valid && child < 2; ++child) {
+      if (children[child] == BINARY_NONE)
+        continue;
+      valid = depths[children[child]] != 0;
+      if (depths[children[child]] > depth)
+        depth = depths[children[child]];
+      depths[children[child]] = 0;
+    }
+    depths[it] = depth + 1;
+    valid = valid && depths[it] <= BINARY_MAX_DEPTH;
+  }
+
+  for (uint32_t it = 0; valid && it < header->entries; ++it) {
+    const BinaryEntry *entry = &image->entries[it];
+    if (entry->name >= header->symbols)
+      valid = false;
+    else if (header->kind == BINARY_DOMAIN)
+      valid = entry->root == BINARY_NONE;
+    else if (entry->root >= header->nodes || depths[entry->root] == 0)
+      valid = false;
+    else
+      depths[entry->root] = 0;
+    /* Also rejects NaN bounds. */
+    valid = valid && entry->interval.left <= entry->interval.right;
+  }
+
+  /* Clean */
+  free(depths);
+
+  return valid;
+}
+
+BinaryImage *newBinaryImage(const void *data, const size_t size) {
+  assert(data != NULL || size == 0);
+  assert((uintptr_t)data % 8 == 0);
+
+  const BinaryHeader *header = (const BinaryHeader *)data;
+  if (size < sizeof(BinaryHeader) ||
+      memcmp(header->magic, BINARY_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != BINARY_VERSION ||
+      header->byteOrder != BINARY_BYTE_ORDER ||
+      header->kind > BINARY_TAYLOR_MODEL || header->poolSize > size)
+    return NULL;
+  BinaryLayout layout = binaryLayout(header);
+  if (layout.size != size)
+    return NULL;
+
+  BinaryImage *image = (BinaryImage *)malloc(sizeof(BinaryImage));
+  if (image == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  const char *base = (const char *)data;
+  image->header = header;
+  image->entries = (const BinaryEntry *)(base + layout.entries);
+  image->nodes = (const BinaryNode *)(base + layout.nodes);
+  image->offsets = (const uint64_t *)(base + layout.offsets);
+  image->pool = base + layout.pool;
+  image->size = size;
+  image->mapping = NULL;
+
+  if (!isValidImage(image)) {
+    free(image);
+    return NULL;
+  }
+  return image;
+}
+
+BinaryImage *mapBinaryImage(const int fd) {
+  size_t size;
+  char *data = mapFile(fd, 0, &size);
+  if (data == NULL)
+    return NULL;
+
+  BinaryImage *image = newBinaryImage(data, size);
+  if (image == NULL) {
+    unmapFile(data, size, 0);
+    return NULL;
+  }
+  image->mapping = data;
+  return image;
+}
+
+void delBinaryImage(BinaryImage *image) {
+  assert(image != NULL);
+
+  unmapFile(image->mapping, image->size, 0);
+  free(image);
+}
+
+const char *binarySymbol(const BinaryImage *image, const uint32_t id) {
+  assert(image != NULL);
+  assert(id < image->header->symbols);
+
+  return image->pool + image->offsets[id];
+}
+
+ExpTree *loadExpTree(const BinaryImage *image, const uint32_t root) {
+  assert(image != NULL);
+  assert(root < image->header->nodes);
+
+  const BinaryNode *node = &image->nodes[root];
+  switch (node->type) {
+  case EXP_NUM:
+  case EXP_VAR:
+    return newExpLeaf((ExpType)node->type, binarySymbol(image, node->data));
+  case EXP_FUN:
+    return newExpTree(EXP_FUN, strdup(binarySymbol(image, node->data)),
+                      loadExpTree(image, node->left), NULL);
+  case EXP_NEG:
+    return newExpOp(EXP_NEG, loadExpTree(image, node->left), NULL);
+  default:
+    return newExpOp((ExpType)node->type, loadExpTree(image, node->left),
+                    loadExpTree(image, node->right));
+  }
+}
+
+ODEList *loadOdeList(const BinaryImage *image) {
+  assert(image != NULL);
+  if (image->header->kind != BINARY_ODE_LIST)
+    return NULL;
+
+  /* Prepend from the back, to keep the order of the entries. */
+  ODEList *list = NULL;
+  for (uint32_t it = image->header->entries; it-- > 0;) {
+    const BinaryEntry *entry = &image->entries[it];
+    list = newOdeElem(list, strdup(binarySymbol(image, entry->name)),
+                      loadExpTree(image, entry->root));
+  }
+  return list;
+}
+
+Domain *loadDomain(const BinaryImage *image) {
+  assert(image != NULL);
+  if (image->header->kind != BINARY_DOMAIN)
+    return NULL;
+
+  Domain *list = NULL;
+  for (uint32_t it = image->header->entries; it-- > 0;) {
+    const BinaryEntry *entry = &image->entries[it];
+    list = newDomainElem(list, strdup(binarySymbol(image, entry->name)),
+                         entry->interval);
+  }
+  return list;
+}
+
+TaylorModel *loadTaylorModel(const BinaryImage *image) {
+  assert(image != NULL);
+  if (image->header->kind != BINARY_TAYLOR_MODEL)
+    return NULL;
+
+  TaylorModel *list = NULL;
+  for (uint32_t it = image->header->entries; it-- > 0;) {
+    const BinaryEntry *entry = &image->entries[it];
+    list = newTMElem(list, strdup(binarySymbol(image, entry->name)),
+                     loadExpTree(image, entry->root), entry->interval);
+  }
+  return list;
+}
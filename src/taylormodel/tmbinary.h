@@ -0,0 +1,226 @@
+/**
+ * @file tmbinary.h
+ * @brief A compact binary format for ODE systems, domains and Taylor models.
+ * @details Parsing the text syntax and rebuilding the trees is repeated by
+ * every run. The binary format stores the same lists flat, so that a file
+ * can be memory-mapped and read in place:
+ *    - a versioned @ref BinaryHeader,
+ *    - one @ref BinaryEntry per list element, in list order,
+ *    - the @ref BinaryNode array of all expression trees, in post-order, so
+ *      that children refer to earlier nodes by index,
+ *    - the symbol table: one offset per symbol into a pool of NUL-terminated
+ *      names and number constants.
+ *
+ * All sections are 8 byte aligned, and integers and doubles are stored in
+ * the byte order of the writer. An image is validated once when it is
+ * opened, after which its arrays may be read directly, or converted into
+ * the regular linked structures in a single pass. As the writer never shares
+ * nodes, a file where a node is referenced twice is invalid, so a tree never
+ * expands beyond the nodes stored in the file.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_BINARY_H
+#define TM_BINARY_H
+
+#include "funexp.h"
+#include "interval.h"
+#include "intervalbox.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "utils.h"
+#include "variables.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The magic bytes that open every binary file.
+#define BINARY_MAGIC "HYBBRISH"
+/// @brief The version of the format, bumped on every incompatible change.
+#define BINARY_VERSION 1
+/// @brief Stored as is, to detect files of a different byte order.
+#define BINARY_BYTE_ORDER 0x01020304u
+/// @brief The index that marks an absent child, root or data symbol.
+#define BINARY_NONE UINT32_MAX
+/// @brief The maximum depth of a tree in a file that is accepted, so that
+///        rebuilding it cannot overflow the stack.
+#define BINARY_MAX_DEPTH 16384
+
+/**
+ * @brief The kind of list stored in a binary file.
+ */
+typedef enum BinaryKind {
+  BINARY_ODE_LIST,     ///< An @ref ODEList.
+  BINARY_DOMAIN,       ///< A @ref Domain.
+  BINARY_TAYLOR_MODEL, ///< A @ref TaylorModel.
+} BinaryKind;
+
+/**
+ * @brief The header at the start of a binary file.
+ */
+typedef struct BinaryHeader {
+  /// @brief @ref BINARY_MAGIC, without NUL byte.
+  char magic[8];
+  /// @brief @ref BINARY_VERSION.
+  uint32_t version;
+  /// @brief The @ref BinaryKind of the list.
+  uint32_t kind;
+  /// @brief @ref BINARY_BYTE_ORDER, in the byte order of the writer.
+  uint32_t byteOrder;
+  /// @brief The number of entries.
+  uint32_t entries;
+  /// @brief The number of expression tree nodes.
+  uint32_t nodes;
+  /// @brief The number of symbols.
+  uint32_t symbols;
+  /// @brief The size of the pool of symbol names in bytes.
+  uint64_t poolSize;
+} BinaryHeader;
+
+/**
+ * @brief One element of the stored list.
+ * @details The members that a kind does not use are @ref BINARY_NONE,
+ * resp. 0.
+ */
+typedef struct BinaryEntry {
+  /// @brief The symbol of the variable, i.e. ODEList.fun, Domain.var or
+  ///        TaylorModel.fun.
+  uint32_t name;
+  /// @brief The root node of ODEList.exp or TaylorModel.exp.
+  uint32_t root;
+  /// @brief Domain.domain or TaylorModel.remainder.
+  Interval interval;
+} BinaryEntry;
+
+/**
+ * @brief One expression tree node.
+ * @invariant The children of a node precede it in the node array.
+ */
+typedef struct BinaryNode {
+  /// @brief The @ref ExpType of the node.
+  uint32_t type;
+  /// @brief The symbol of ExpTree.data, or @ref BINARY_NONE.
+  uint32_t data;
+  /// @brief The index of the left child, or @ref BINARY_NONE.
+  uint32_t left;
+  /// @brief The index of the right child, or @ref BINARY_NONE.
+  uint32_t right;
+} BinaryNode;
+
+/**
+ * @brief A validated view of a binary file in memory.
+ * @details The arrays point into the underlying memory, they are not
+ * copies.
+ */
+typedef struct BinaryImage {
+  /// @brief The header of the file.
+  const BinaryHeader *header;
+  /// @brief The list elements, header->entries many.
+  const BinaryEntry *entries;
+  /// @brief The expression tree nodes, header->nodes many.
+  const BinaryNode *nodes;
+  /// @brief The offset of each symbol name in the pool.
+  const uint64_t *offsets;
+  /// @brief The NUL-terminated symbol names.
+  const char *pool;
+  /// @brief The size of the underlying memory.
+  size_t size;
+  /// @brief The mapping to release, if the image owns one, else NULL.
+  char *mapping;
+} BinaryImage;
+
+/**
+ * @brief Write a system of ODEs in the binary format.
+ * @pre \p out may **not** be NULL.
+ *
+ * @param[in] list The system to write.
+ * @param[in] out  The stream to write to.
+ * @return int A return code, 0 on success.
+ */
+int writeOdeListBinary(const ODEList *list, FILE *out);
+
+/**
+ * @brief Write a domain in the binary format.
+ * @see writeOdeListBinary
+ */
+int writeDomainBinary(const Domain *list, FILE *out);
+
+/**
+ * @brief Write a Taylor model in the binary format.
+ * @see writeOdeListBinary
+ */
+int writeTaylorModelBinary(const TaylorModel *list, FILE *out);
+
+/**
+ * @brief Open a binary file that is already in memory.
+ * @details Nothing is copied: the image refers to \p data, which must
+ * outlive it.
+ * @pre \p data must be 8 byte aligned.
+ *
+ * @param[in] data The contents of the file.
+ * @param[in] size The size of the contents.
+ * @return BinaryImage* A heap-allocated image, or NULL if the contents are
+ * not a valid binary file of this version and byte order.
+ */
+BinaryImage *newBinaryImage(const void *data, const size_t size);
+
+/**
+ * @brief Open a binary file by mapping it into memory.
+ * @post \p fd remains open and owned by the caller.
+ *
+ * @param[in] fd A file descriptor of a regular file, open for reading.
+ * @return BinaryImage* A heap-allocated image that owns the mapping, or
+ * NULL if the file cannot be mapped or is not valid.
+ */
+BinaryImage *mapBinaryImage(const int fd);
+
+/**
+ * @brief Deallocate the given image, and release its mapping if it owns
+ * one.
+ * @pre The given image must not be NULL.
+ */
+void delBinaryImage(BinaryImage *image);
+
+/**
+ * @brief Get the name of a symbol of the image.
+ * @pre \p id must be less than the number of symbols.
+ */
+const char *binarySymbol(const BinaryImage *image, const uint32_t id);
+
+/**
+ * @brief Rebuild the expression tree rooted at a node of the image.
+ * @pre \p root must be less than the number of nodes.
+ *
+ * @return ExpTree* A newly heap-allocated expression tree.
+ */
+ExpTree *loadExpTree(const BinaryImage *image, const uint32_t root);
+
+/**
+ * @brief Rebuild the system of ODEs stored in the image.
+ * @pre \p image may **not** be NULL.
+ *
+ * @return ODEList* A newly heap-allocated list, in the order it was
+ * written, or NULL if the image holds another kind of list.
+ */
+ODEList *loadOdeList(const BinaryImage *image);
+
+/**
+ * @brief Rebuild the domain stored in the image.
+ * @see loadOdeList
+ */
+Domain *loadDomain(const BinaryImage *image);
+
+/**
+ * @brief Rebuild the Taylor model stored in the image.
+ * @see loadOdeList
+ */
+TaylorModel *loadTaylorModel(const BinaryImage *image);
+
+#endif
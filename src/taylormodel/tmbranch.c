@@ -0,0 +1,260 @@
+#include "tmbranch.h"
+#include <math.h>
+#include <time.h>
+
+BranchBoundBudget newBranchBoundBudget(const unsigned int maxBoxes,
+                                       const double maxSeconds,
+                                       const double tolerance) {
+  assert(maxSeconds >= 0);
+  assert(tolerance >= 0);
+
+  BranchBoundBudget budget = {maxBoxes, maxSeconds, tolerance};
+  return budget;
+}
+
+/* A box in the queue, with the lower bound of its enclosure. */
+typedef struct BranchBox {
+  IntervalBox *box;
+  double bound;
+} BranchBox;
+
+/* A binary min-heap of boxes, ordered by bound. */
+typedef struct BranchQueue {
+  unsigned int length;
+  unsigned int capacity;
+  BranchBox *boxes;
+} BranchQueue;
+
+static void pushBranchQueue(BranchQueue *queue, IntervalBox *box,
+                            const double bound) {
+  if (queue->length == queue->capacity) {
+    queue->capacity = 2 * queue->capacity + 16;
+    queue->boxes = (BranchBox *)realloc(queue->boxes,
+                                        queue->capacity * sizeof(BranchBox));
+    if (queue->boxes == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  /* Sift up */
+  unsigned int it = queue->length++;
+  while (it > 0 && queue->boxes[(it - 1) / 2].bound > bound) {
+    queue->boxes[it] = queue->boxes[(it - 1) / 2];
+    it = (it - 1) / 2;
+  }
+  queue->boxes[it].box = box;
+  queue->boxes[it].bound = bound;
+}
+
+static BranchBox popBranchQueue(BranchQueue *queue) {
+  assert(queue->length > 0);
+
+  BranchBox top = queue->boxes[0];
+  BranchBox last = queue->boxes[--queue->length];
+
+  /* Sift down */
+  unsigned int it = 0;
+  while (2 * it + 1 < queue->length) {
+    unsigned int child = 2 * it + 1;
+    if (child + 1 < queue->length &&
+        queue->boxes[child + 1].bound < queue->boxes[child].bound)
+      ++child;
+    if (queue->boxes[child].bound >= last.bound)
+      break;
+    queue->boxes[it] = queue->boxes[child];
+    it = child;
+  }
+  if (queue->length > 0)
+    queue->boxes[it] = last;
+  return top;
+}
+
+/* Mark the dimensions of the variables that occur in the tree. */
+static void markVariables(const ExpTree *const tree,
+                          const SymbolTable *const symbols, bool *relevant) {
+  if (tree == NULL)
+    return;
+  if (tree->type == EXP_VAR) {
+    unsigned int id = findSymbol(symbols, tree->data);
+    /* The expression tree contains a variable whose valuation is unknown. */
+    assert(id != SYMBOL_NOT_FOUND);
+    relevant[id] = true;
+  }
+  markVariables(tree->left, symbols, relevant);
+  markVariables(tree->right, symbols, relevant);
+}
+
+/* The shared state of one search for a lower bound. */
+typedef struct BranchSearch {
+  const ExpTree *tree;
+  const SymbolTable *symbols;
+  const bool *relevant;
+  /* The boxes to bisect in this batch, and per box its two halves with
+    their enclosures and an upper bound on the value at their midpoints. */
+  IntervalBox *parents[BRANCH_BOUND_BATCH];
+  IntervalBox *children[2 * BRANCH_BOUND_BATCH];
+  Interval enclosures[2 * BRANCH_BOUND_BATCH];
+  double values[2 * BRANCH_BOUND_BATCH];
+} BranchSearch;
+
+/* The widest relevant dimension of the box, or box->dim if all relevant
+  dimensions are points. */
+static unsigned int widestRelevant(const IntervalBox *const box,
+                                   const bool *const relevant) {
+  unsigned int widest = box->dim;
+  double width = 0;
+  for (unsigned int it = 0; it < box->dim; ++it) {
+    double current = box->data[it].right - box->data[it].left;
+    if (relevant[it] && current > width) {
+      width = current;
+      widest = it;
+    }
+  }
+  return widest;
+}
+
+/* An upper bound on the value of the tree at the midpoint of the box. */
+static double midpointValue(const BranchSearch *const search,
+                            const IntervalBox *const box) {
+  IntervalBox *point = newIntervalBox(box->dim);
+  for (unsigned int it = 0; it < box->dim; ++it) {
+    double mid = intervalMidpoint(&box->data[it]);
+    point->data[it] = newInterval(mid, mid);
+  }
+  Interval value = evaluateExpTreeBox(search->tree, search->symbols, point);
+  delIntervalBox(point);
+  return value.right;
+}
+
+/* Bisect one box of the batch and evaluate both halves. */
+static void runBranchTask(unsigned int index, void *context) {
+  BranchSearch *search = (BranchSearch *)context;
+  const IntervalBox *parent = search->parents[index];
+  unsigned int dim = widestRelevant(parent, search->relevant);
+  assert(dim < parent->dim);
+
+  for (unsigned int half = 0; half < 2; ++half) {
+    IntervalBox *child = bisectIntervalBox(parent, dim, half == 1);
+    search->children[2 * index + half] = child;
+    search->enclosures[2 * index + half] =
+        evaluateExpTreeBox(search->tree, search->symbols, child);
+    search->values[2 * index + half] = midpointValue(search, child);
+  }
+}
+
+/* The elapsed wall-clock time since start, in seconds. */
+static double elapsedSeconds(const struct timespec *const start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+/* A lower bound on the tree over the box, via branch and bound. */
+static double searchLowerBound(BranchSearch *search, const IntervalBox *root,
+                               const BranchBoundBudget *const budget,
+                               const struct timespec *const start,
+                               ThreadPool *pool) {
+  /* best is attained at some point, so it bounds the minimum from above;
+    settled is the lowest bound of the boxes that cannot be bisected. */
+  double best = midpointValue(search, root);
+  double settled = INFINITY;
+  BranchQueue queue = {0, 0, NULL};
+  Interval enclosure = evaluateExpTreeBox(search->tree, search->symbols, root);
+  pushBranchQueue(&queue, cpyIntervalBox(root), enclosure.left);
+
+  unsigned int processed = 0;
+  while (queue.length > 0 && processed < budget->maxBoxes) {
+    if (budget->maxSeconds > 0 && elapsedSeconds(start) >= budget->maxSeconds)
+      break;
+    if (best - fmin(queue.boxes[0].bound, settled) <= budget->tolerance)
+      break;
+
+    /* Boxes whose bound is not below best cannot contain the minimum. */
+    unsigned int count = 0;
+    while (queue.length > 0 && count < BRANCH_BOUND_BATCH &&
+           processed + count < budget->maxBoxes) {
+      BranchBox next = popBranchQueue(&queue);
+      if (next.bound >= best) {
+        delIntervalBox(next.box);
+        continue;
+      }
+      if (widestRelevant(next.box, search->relevant) == next.box->dim) {
+        settled = fmin(settled, next.bound);
+        delIntervalBox(next.box);
+        continue;
+      }
+      search->parents[count++] = next.box;
+    }
+    if (count == 0)
+      continue;
+
+    parallelFor(pool, count, runBranchTask, search);
+    processed += count;
+
+    /* Merge in batch order, so the result does not depend on the pool. */
+    for (unsigned int it = 0; it < 2 * count; ++it)
+      best = fmin(best, search->values[it]);
+    for (unsigned int it = 0; it < 2 * count; ++it) {
+      if (search->enclosures[it].left < best)
+        pushBranchQueue(&queue, search->children[it],
+                        search->enclosures[it].left);
+      else
+        delIntervalBox(search->children[it]);
+    }
+    for (unsigned int it = 0; it < count; ++it)
+      delIntervalBox(search->parents[it]);
+  }
+
+  /* Pruned boxes are bounded by best, all others are in the queue. */
+  double lower = fmin(best, settled);
+  if (queue.length > 0)
+    lower = fmin(lower, queue.boxes[0].bound);
+
+  /* Clean */
+  for (unsigned int it = 0; it < queue.length; ++it)
+    delIntervalBox(queue.boxes[it].box);
+  free(queue.boxes);
+
+  return lower;
+}
+
+Interval evaluateExpTreeBranchBound(const ExpTree *const tree,
+                                    const Domain *const domains,
+                                    const BranchBoundBudget *const budget,
+                                    ThreadPool *pool) {
+  assert(tree != NULL);
+  assert(domains != NULL);
+  assert(budget != NULL);
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  SymbolTable *symbols = newSymbolTable();
+  IntervalBox *root = toIntervalBox(domains, symbols);
+  bool *relevant = (bool *)calloc(root->dim + 1, sizeof(bool));
+  BranchSearch *search = (BranchSearch *)malloc(sizeof(BranchSearch));
+  if (relevant == NULL || search == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  markVariables(tree, symbols, relevant);
+  search->symbols = symbols;
+  search->relevant = relevant;
+
+  /* The maximum of f is minus the minimum of -f. */
+  search->tree = tree;
+  double lower = searchLowerBound(search, root, budget, &start, pool);
+  ExpTree *negated = newExpOp(EXP_NEG, cpyExpTree(tree), NULL);
+  search->tree = negated;
+  double upper = -searchLowerBound(search, root, budget, &start, pool);
+
+  /* Clean */
+  delExpTree(negated);
+  free(search);
+  free(relevant);
+  delIntervalBox(root);
+  delSymbolTable(symbols);
+
+  return newInterval(lower, upper);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file tmbranch.h
+ * @brief Branch-and-bound range enclosures of expressions over boxes.
+ * @details A single interval evaluation overestimates the range of an
+ * expression more the wider the box is. Branch and bound bisects the box
+ * and takes the hull of the enclosures over the pieces, which converges to
+ * the exact range. It only refines pieces that can still move a bound:
+ * the value of the expression at the midpoint of any piece is attained, so
+ * a piece whose enclosure lies above the smallest such value cannot contain
+ * the minimum, and is pruned (and likewise for the maximum).
+ *
+ * Pieces wait in a priority queue, ordered by their bound, so the most
+ * promising piece is refined first. The pieces are refined in batches,
+ * whose evaluations run in parallel on a thread pool.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_BRANCH_H
+#define TM_BRANCH_H
+
+#include "funexp.h"
+#include "interval.h"
+#include "intervalbox.h"
+#include "taylormodel.h"
+#include "threadpool.h"
+#include "variables.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The number of boxes that are refined in parallel, per bound.
+/// @details Fixed, so that the result does not depend on the pool size.
+#define BRANCH_BOUND_BATCH 16
+
+/// @brief The box budget of the @ref RANGE_BOUNDER_BRANCH_BOUND bounder.
+#define BRANCH_BOUND_BOXES 64
+
+/**
+ * @brief The budget of a branch-and-bound search.
+ * @details The search stops as soon as any limit is reached, and returns
+ * the best enclosure found so far.
+ */
+typedef struct BranchBoundBudget {
+  /// @brief The maximal number of boxes to bisect, per bound.
+  unsigned int maxBoxes;
+  /// @brief The maximal wall-clock time in seconds, or 0 for no limit.
+  double maxSeconds;
+  /// @brief Stop refining a bound once it is within this distance of a
+  /// value of the expression, i.e. of the exact bound.
+  double tolerance;
+} BranchBoundBudget;
+
+/**
+ * @brief Construct a new budget.
+ * @see BranchBoundBudget For the meaning of the arguments.
+ */
+BranchBoundBudget newBranchBoundBudget(const unsigned int maxBoxes,
+                                       const double maxSeconds,
+                                       const double tolerance);
+
+/**
+ * @brief Enclose the range of an expression via branch and bound.
+ * @details The lower and upper bound are searched separately. Each box is
+ * enclosed via @ref evaluateExpTreeBox, and only variables that occur in
+ * \p tree are bisected, widest first. The result is never wider than
+ * @ref evaluateExpTree over the whole box.
+ *
+ * e.g. domain x &isin; [0, 1] and an expression exp = x^2 - x. <br>
+ * &rArr; eval(exp, [0, 1]) = [-1, 1], but after a few bisections the
+ * enclosure approaches the range [-0.25, 0].
+ * @pre \p tree, \p domains and \p budget must **not** be NULL.
+ *
+ * @param[in] tree    The expression tree to bound.
+ * @param[in] domains The mapping of expression variable to interval domain.
+ * @param[in] budget  The limits of the search.
+ * @param[in] pool    The pool to evaluate boxes on, or NULL to evaluate
+ *                    them on the calling thread.
+ * @return Interval An enclosure of the range of \p tree over \p domains.
+ */
+Interval evaluateExpTreeBranchBound(const ExpTree *const tree,
+                                    const Domain *const domains,
+                                    const BranchBoundBudget *const budget,
+                                    ThreadPool *pool);
+
+#endif
@@ -0,0 +1,385 @@
+#include "tmcache.h"
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/* The header of a cache entry. It is followed by three binary images, each
+  padded to a multiple of 8 bytes: the system, the Taylor polynomials and the
+  Lagrange terms. */
+typedef struct CacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t order;
+  uint32_t k;
+  uint32_t reserved;
+  uint64_t sizes[3];
+} CacheHeader;
+
+#define CACHE_MAGIC "HYBCACHE"
+#define CACHE_VERSION 1
+
+static char *cacheDirectory = NULL;
+static size_t cacheMaxBytes = EXPANSION_CACHE_MAX_BYTES;
+static unsigned int cacheHits = 0;
+static unsigned int cacheMisses = 0;
+static pthread_mutex_t cacheLock = PTHREAD_MUTEX_INITIALIZER;
+
+int setExpansionCache(const char *directory, const size_t maxBytes) {
+  free(cacheDirectory);
+  cacheDirectory = NULL;
+  cacheMaxBytes = maxBytes;
+  if (directory == NULL)
+    return 0;
+
+  if (mkdir(directory, 0777) != 0 && errno != EEXIST)
+    return -1;
+  cacheDirectory = strdup(directory);
+  if (cacheDirectory == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  return 0;
+}
+
+const char *getExpansionCache(void) { return cacheDirectory; }
+
+/* 64 bit FNV-1a */
+static uint64_t hashBytes(uint64_t hash, const void *data, const size_t size) {
+  const unsigned char *bytes = (const unsigned char *)data;
+  for (size_t it = 0; it < size; ++it) {
+    hash ^= bytes[it];
+    hash *= 1099511628211u;
+  }
+  return hash;
+}
+
+uint64_t hashExpansionKey(const ODEList *system, const unsigned int order,
+                          const unsigned int k) {
+  /* The binary format is a canonical, pointer-free form of the system. */
+  char *data;
+  size_t size;
+  FILE *stream = open_memstream(&data, &size);
+  if (stream == NULL || writeOdeListBinary(system, stream) != 0 ||
+      fclose(stream) != 0) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  uint64_t hash = hashBytes(14695981039346656037u, data, size);
+  hash = hashBytes(hash, &order, sizeof(order));
+  hash = hashBytes(hash, &k, sizeof(k));
+
+  /* Clean */
+  free(data);
+
+  return hash;
+}
+
+/* The path of an entry, or of a temporary file if suffix is a mkstemp
+  template. */
+static char *cachePath(const uint64_t hash, const char *suffix) {
+  size_t size = strlen(cacheDirectory) + strlen(suffix) + 18;
+  char *path = (char *)malloc(size);
+  if (path == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  snprintf(path, size, "%s/%016llx%s", cacheDirectory,
+           (unsigned long long)hash, suffix);
+  return path;
+}
+
+static uint64_t paddedSize(const uint64_t size) { return (size + 7) / 8 * 8; }
+
+static void countLookup(const bool hit) {
+  pthread_mutex_lock(&cacheLock);
+  if (hit)
+    ++cacheHits;
+  else
+    ++cacheMisses;
+  pthread_mutex_unlock(&cacheLock);
+}
+
+/* Decode a mapped entry, or return NULL if it is not the entry of the
+  key. */
+static TaylorExpansion *decodeEntry(const char *data, const size_t size,
+                                    const ODEList *system,
+                                    const unsigned int order,
+                                    const unsigned int k) {
+  const CacheHeader *header = (const CacheHeader *)data;
+  if (size < sizeof(CacheHeader) ||
+      memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != CACHE_VERSION || header->order != order ||
+      header->k != k)
+    return NULL;
+
+  /* A partially written entry fails here. */
+  uint64_t offsets[3];
+  uint64_t end = sizeof(CacheHeader);
+  for (unsigned int it = 0; it < 3; ++it) {
+    if (header->sizes[it] > size) /* Also guards against overflow */
+      return NULL;
+    offsets[it] = end;
+    end += paddedSize(header->sizes[it]);
+  }
+  if (end != size)
+    return NULL;
+
+  BinaryImage *images[3];
+  for (unsigned int it = 0; it < 3; ++it)
+    images[it] = newBinaryImage(data + offsets[it], header->sizes[it]);
+  TaylorExpansion *expansion = NULL;
+  if (images[0] != NULL && images[1] != NULL && images[2] != NULL) {
+    ODEList *stored = loadOdeList(images[0]);
+    TaylorModel *polynomials = loadTaylorModel(images[1]);
+    TaylorModel *lagrangeTerms = loadTaylorModel(images[2]);
+    if (isEqualOdeList(stored, system) && polynomials != NULL &&
+        lagrangeTerms != NULL) {
+      expansion = (TaylorExpansion *)malloc(sizeof(TaylorExpansion));
+      if (expansion == NULL) {
+        fprintf(stderr, "Memory allocation error\n");
+        exit(EXIT_FAILURE);
+      }
+      expansion->polynomials = polynomials;
+      expansion->lagrangeTerms = lagrangeTerms;
+      expansion->order = order;
+      expansion->linear = NULL;
+    } else {
+      /* A hash collision, or a corrupted entry */
+      if (polynomials != NULL)
+        delTaylorModel(polynomials);
+      if (lagrangeTerms != NULL)
+        delTaylorModel(lagrangeTerms);
+    }
+    if (stored != NULL)
+      delOdeList(stored);
+  }
+
+  /* Clean */
+  for (unsigned int it = 0; it < 3; ++it)
+    if (images[it] != NULL)
+      delBinaryImage(images[it]);
+
+  return expansion;
+}
+
+TaylorExpansion *loadCachedExpansion(const ODEList *system,
+                                     const unsigned int order,
+                                     const unsigned int k) {
+  assert(system != NULL);
+  if (cacheDirectory == NULL)
+    return NULL;
+
+  char *path = cachePath(hashExpansionKey(system, order, k),
+                         EXPANSION_CACHE_SUFFIX);
+  FILE *file = fopen(path, "r");
+  free(path);
+  if (file == NULL) {
+    countLookup(false);
+    return NULL;
+  }
+
+  size_t size;
+  const int fd = fileno(file);
+  char *data = mapFile(fd, 0, &size);
+  TaylorExpansion *expansion = NULL;
+  if (data != NULL) {
+    expansion = decodeEntry(data, size, system, order, k);
+    unmapFile(data, size, 0);
+  }
+  /* Mark the entry as recently used, for eviction. */
+  if (expansion != NULL)
+    futimens(fd, NULL);
+  fclose(file);
+
+  countLookup(expansion != NULL);
+  return expansion;
+}
+
+/* Write one binary image, padded to a multiple of 8 bytes. Returns its
+  size, or 0 on failure. */
+static uint64_t writeSection(FILE *out, const ODEList *system,
+                             const TaylorModel *models) {
+  long start = ftell(out);
+  if (start < 0)
+    return 0;
+  int code = (system != NULL) ? writeOdeListBinary(system, out)
+                              : writeTaylorModelBinary(models, out);
+  long end = ftell(out);
+  if (code != 0 || end < start)
+    return 0;
+
+  const uint64_t size = (uint64_t)(end - start);
+  const char zeros[8] = {0};
+  const size_t padding = paddedSize(size) - size;
+  if (fwrite(zeros, 1, padding, out) != padding)
+    return 0;
+  return size;
+}
+
+/* A file in the cache directory, for eviction. */
+typedef struct CacheFile {
+  char *name;
+  off_t size;
+  struct timespec used;
+} CacheFile;
+
+static int compareCacheFiles(const void *left, const void *right) {
+  const CacheFile *first = (const CacheFile *)left;
+  const CacheFile *second = (const CacheFile *)right;
+  if (first->used.tv_sec != second->used.tv_sec)
+    return (first->used.tv_sec < second->used.tv_sec) ? -1 : 1;
+  if (first->used.tv_nsec != second->used.tv_nsec)
+    return (first->used.tv_nsec < second->used.tv_nsec) ? -1 : 1;
+  return strcmp(first->name, second->name);
+}
+
+/* Delete a file of the cache directory. Another process may have deleted it
+  already. */
+static void removeCacheFile(const char *name) {
+  char *path = (char *)malloc(strlen(cacheDirectory) + strlen(name) + 2);
+  if (path == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  sprintf(path, "%s/%s", cacheDirectory, name);
+  remove(path);
+  free(path);
+}
+
+/* Whether the name is that of a temporary file of storeCachedExpansion:
+  16 hex digits, a dot and the 6 characters that mkstemp filled in. */
+static bool isTemporaryName(const char *name) {
+  if (strlen(name) != 23 || name[16] != '.')
+    return false;
+  for (unsigned int it = 0; it < 16; ++it)
+    if (!isxdigit((unsigned char)name[it]))
+      return false;
+  return true;
+}
+
+/* Delete the temporaries that writers left behind when they crashed, then
+  the least recently used entries until the entries fit in the size
+  bound. */
+static void evictEntries(void) {
+  DIR *dir = opendir(cacheDirectory);
+  if (dir == NULL)
+    return;
+
+  CacheFile *files = NULL;
+  unsigned int length = 0, capacity = 0;
+  uint64_t total = 0;
+  const size_t suffix = strlen(EXPANSION_CACHE_SUFFIX);
+  const time_t now = time(NULL);
+  struct dirent *item;
+  while ((item = readdir(dir)) != NULL) {
+    size_t size = strlen(item->d_name);
+    struct stat info;
+    if (fstatat(dirfd(dir), item->d_name, &info, 0) != 0)
+      continue;
+
+    /* Writers finish in seconds, so an old temporary is of a crashed one. */
+    if (isTemporaryName(item->d_name)) {
+      if (now - info.st_mtim.tv_sec > EXPANSION_CACHE_STALE_SECONDS)
+        removeCacheFile(item->d_name);
+      continue;
+    }
+    if (size <= suffix ||
+        strcmp(item->d_name + size - suffix, EXPANSION_CACHE_SUFFIX) != 0)
+      continue;
+
+    if (length == capacity) {
+      capacity = 2 * capacity + 16;
+      files = (CacheFile *)realloc(files, capacity * sizeof(CacheFile));
+      if (files == NULL) {
+        fprintf(stderr, "Memory allocation error\n");
+        exit(EXIT_FAILURE);
+      }
+    }
+    files[length].name = strdup(item->d_name);
+    files[length].size = info.st_size;
+    files[length].used = info.st_mtim;
+    total += (uint64_t)info.st_size;
+    ++length;
+  }
+
+  qsort(files, length, sizeof(CacheFile), compareCacheFiles);
+  for (unsigned int it = 0; it < length && total > cacheMaxBytes; ++it) {
+    removeCacheFile(files[it].name);
+    total -= (uint64_t)files[it].size;
+  }
+
+  /* Clean */
+  for (unsigned int it = 0; it < length; ++it)
+    free(files[it].name);
+  free(files);
+  closedir(dir);
+}
+
+int storeCachedExpansion(const ODEList *system, const unsigned int k,
+                         const TaylorExpansion *expansion) {
+  assert(system != NULL);
+  assert(expansion != NULL);
+  if (cacheDirectory == NULL || expansion->linear != NULL)
+    return 0;
+
+  const uint64_t hash = hashExpansionKey(system, expansion->order, k);
+  char *temporary = cachePath(hash, ".XXXXXX");
+  int fd = mkstemp(temporary);
+  FILE *out = (fd < 0) ? NULL : fdopen(fd, "w");
+  if (out == NULL) {
+    /* The descriptor is closed with the file. */
+    if (fd >= 0)
+      remove(temporary);
+    free(temporary);
+    return -1;
+  }
+
+  /* The header is written last, once the sizes are known. */
+  CacheHeader header;
+  memset(&header, 0, sizeof(CacheHeader));
+  memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+  header.version = CACHE_VERSION;
+  header.order = expansion->order;
+  header.k = k;
+  bool ok = fwrite(&header, sizeof(CacheHeader), 1, out) == 1;
+  if (ok) {
+    header.sizes[0] = writeSection(out, system, NULL);
+    header.sizes[1] = writeSection(out, NULL, expansion->polynomials);
+    header.sizes[2] = writeSection(out, NULL, expansion->lagrangeTerms);
+    ok = header.sizes[0] > 0 && header.sizes[1] > 0 && header.sizes[2] > 0;
+  }
+  ok = ok && fseek(out, 0, SEEK_SET) == 0 &&
+       fwrite(&header, sizeof(CacheHeader), 1, out) == 1;
+  ok = (fclose(out) == 0) && ok;
+
+  /* Publish the entry atomically. */
+  char *path = cachePath(hash, EXPANSION_CACHE_SUFFIX);
+  ok = ok && rename(temporary, path) == 0;
+  if (!ok)
+    remove(temporary);
+
+  /* Clean */
+  free(path);
+  free(temporary);
+
+  if (ok) {
+    pthread_mutex_lock(&cacheLock);
+    evictEntries();
+    pthread_mutex_unlock(&cacheLock);
+  }
+  return ok ? 0 : -1;
+}
+
+void expansionCacheStats(unsigned int *hits, unsigned int *misses) {
+  pthread_mutex_lock(&cacheLock);
+  if (hits != NULL)
+    *hits = cacheHits;
+  if (misses != NULL)
+    *misses = cacheMisses;
+  pthread_mutex_unlock(&cacheLock);
+}
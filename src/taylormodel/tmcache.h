@@ -0,0 +1,115 @@
+/**
+ * @file tmcache.h
+ * @brief An on-disk cache of Taylor expansions, keyed by system and order.
+ * @details The Taylor expansion of a system of ODEs only depends on the
+ * system, the order and the truncation order, so it is computed once and
+ * stored in a local directory, from where later runs load it in the
+ * @ref tmbinary.h format.
+ *
+ * An entry is named after a structural hash of its key. It also stores the
+ * system itself, so a hash collision is detected rather than returning the
+ * expansion of another system. Entries are written to a temporary file that
+ * is renamed into place, so concurrent processes never see partial entries.
+ * Once the directory grows beyond its size bound, the least recently used
+ * entries are deleted, together with the temporary files of writers that
+ * crashed, once they are @ref EXPANSION_CACHE_STALE_SECONDS old.
+ *
+ * When a directory is set, @ref newTaylorExpansion consults the cache
+ * transparently. The cache works at the level of whole expansions, i.e. the
+ * Taylor polynomials together with the Lagrange terms, so direct calls of
+ * @ref computeTaylorPolynomial or @ref lieDerivativeK do not consult it.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_CACHE_H
+#define TM_CACHE_H
+
+#include "sysode.h"
+#include "taylormodel.h"
+#include "tmbinary.h"
+#include "tmsplit.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The file name suffix of cache entries.
+#define EXPANSION_CACHE_SUFFIX ".expansion"
+
+/// @brief The default size bound of the cache directory, in bytes.
+#define EXPANSION_CACHE_MAX_BYTES ((size_t)1 << 30)
+
+/// @brief The age, in seconds since their last write, after which the
+///        temporary files of crashed writers are deleted.
+#define EXPANSION_CACHE_STALE_SECONDS 3600
+
+/**
+ * @brief Set the directory of the cache, creating it if needed.
+ * @details Not thread-safe: set it before computing any expansions.
+ *
+ * @param[in] directory The cache directory, or NULL to disable the cache.
+ * @param[in] maxBytes  The size bound of the entries in the directory.
+ * @return int A return code, 0 on success. On failure, the cache is
+ * disabled.
+ */
+int setExpansionCache(const char *directory, const size_t maxBytes);
+
+/**
+ * @brief The directory of the cache, or NULL if it is disabled.
+ */
+const char *getExpansionCache(void);
+
+/**
+ * @brief The structural hash of a system and its orders, which names its
+ * cache entry.
+ * @details Equal systems have equal hashes, also across processes.
+ */
+uint64_t hashExpansionKey(const ODEList *system, const unsigned int order,
+                          const unsigned int k);
+
+/**
+ * @brief Look up the Taylor expansion of a system in the cache.
+ * @details Safe to call from multiple threads.
+ * @pre \p system may **not** be NULL.
+ *
+ * @param[in] system The system of ODEs.
+ * @param[in] order  The order of the Taylor polynomials.
+ * @param[in] k      The truncation order applied during TM arithmetic.
+ * @return TaylorExpansion* A newly heap-allocated expansion, or NULL if the
+ * cache is disabled or holds no entry for the key.
+ */
+TaylorExpansion *loadCachedExpansion(const ODEList *system,
+                                     const unsigned int order,
+                                     const unsigned int k);
+
+/**
+ * @brief Store the Taylor expansion of a system in the cache, and evict
+ * entries if the directory exceeds its size bound.
+ * @details Safe to call from multiple threads. Affine expansions are not
+ * stored, as they are cheap to compute.
+ * @pre \p system and \p expansion may **not** be NULL.
+ *
+ * @param[in] system    The system of ODEs.
+ * @param[in] k         The truncation order applied during TM arithmetic.
+ * @param[in] expansion The expansion of \p system.
+ * @return int A return code, 0 on success or if the cache is disabled.
+ */
+int storeCachedExpansion(const ODEList *system, const unsigned int k,
+                         const TaylorExpansion *expansion);
+
+/**
+ * @brief The number of cache lookups so far that found, resp. did not
+ * find, their expansion.
+ *
+ * @param[out] hits   The number of hits. Ignored if NULL.
+ * @param[out] misses The number of misses. Ignored if NULL.
+ */
+void expansionCacheStats(unsigned int *hits, unsigned int *misses);
+
+#endif
@@ -0,0 +1,221 @@
+#include "tmcentered.h"
+#include <pthread.h>
+
+/* The gradient of an expression: the partial derivative for each variable
+  that occurs in it. Entries are shared by the cache and the evaluations
+  that use them, and freed when the last of them lets go. */
+typedef struct GradientEntry {
+  unsigned int hash;
+  ExpTree *tree;
+  unsigned int nvars;
+  char **vars;
+  ExpTree **partials;
+  unsigned int references;
+} GradientEntry;
+
+/* A direct-mapped cache: a new gradient replaces the one in its slot. */
+static GradientEntry *gradientCache[GRADIENT_CACHE_SIZE];
+static unsigned int gradientHits = 0;
+static unsigned int gradientMisses = 0;
+static pthread_mutex_t gradientLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* The FNV-1a hash of the structure and data of a tree. */
+static unsigned int hashExpTree(const ExpTree *const tree, unsigned int hash) {
+  if (tree == NULL)
+    return (hash ^ 0xffu) * 16777619u;
+
+  hash = (hash ^ (unsigned int)tree->type) * 16777619u;
+  if (tree->data != NULL)
+    for (const char *it = tree->data; *it != '\0'; ++it)
+      hash = (hash ^ (unsigned char)*it) * 16777619u;
+  hash = hashExpTree(tree->left, hash);
+  return hashExpTree(tree->right, hash);
+}
+
+/* Append the variables of the tree that are not in vars yet. */
+static void collectVariables(const ExpTree *const tree, char ***vars,
+                             unsigned int *nvars) {
+  if (tree == NULL)
+    return;
+
+  if (tree->type == EXP_VAR) {
+    for (unsigned int it = 0; it < *nvars; ++it)
+      if (strcmp((*vars)[it], tree->data) == 0)
+        return;
+    char **grown = (char **)realloc(*vars, (*nvars + 1) * sizeof(char *));
+    if (grown == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+    grown[(*nvars)++] = strdup(tree->data);
+    *vars = grown;
+    return;
+  }
+
+  collectVariables(tree->left, vars, nvars);
+  collectVariables(tree->right, vars, nvars);
+}
+
+static GradientEntry *newGradientEntry(const ExpTree *const tree,
+                                       const unsigned int hash) {
+  GradientEntry *entry = (GradientEntry *)malloc(sizeof(GradientEntry));
+  if (entry == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  entry->hash = hash;
+  entry->tree = cpyExpTree(tree);
+  entry->nvars = 0;
+  entry->vars = NULL;
+  collectVariables(tree, &entry->vars, &entry->nvars);
+  entry->references = 1;
+
+  entry->partials =
+      (ExpTree **)malloc((entry->nvars + 1) * sizeof(ExpTree *));
+  if (entry->partials == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (unsigned int it = 0; it < entry->nvars; ++it) {
+    ExpTree *partial = derivative(tree, entry->vars[it]);
+    /* The expression contains a function without a derivative. */
+    assert(partial != NULL);
+    entry->partials[it] = simplify(partial);
+    delExpTree(partial);
+  }
+  return entry;
+}
+
+/* Let go of the entry; must hold the lock. */
+static void releaseGradientEntry(GradientEntry *entry) {
+  if (--entry->references > 0)
+    return;
+
+  for (unsigned int it = 0; it < entry->nvars; ++it) {
+    free(entry->vars[it]);
+    delExpTree(entry->partials[it]);
+  }
+  free(entry->vars);
+  free(entry->partials);
+  delExpTree(entry->tree);
+  free(entry);
+}
+
+/* The gradient of the tree, from the cache if possible. The caller must
+  release it. */
+static GradientEntry *acquireGradientEntry(const ExpTree *const tree) {
+  const unsigned int hash = hashExpTree(tree, 2166136261u);
+  GradientEntry **slot = &gradientCache[hash % GRADIENT_CACHE_SIZE];
+
+  pthread_mutex_lock(&gradientLock);
+  if (*slot != NULL && (*slot)->hash == hash && isEqual((*slot)->tree, tree)) {
+    GradientEntry *entry = *slot;
+    ++entry->references;
+    ++gradientHits;
+    pthread_mutex_unlock(&gradientLock);
+    return entry;
+  }
+  ++gradientMisses;
+  pthread_mutex_unlock(&gradientLock);
+
+  /* Derive outside of the lock, so threads only wait for lookups. */
+  GradientEntry *entry = newGradientEntry(tree, hash);
+
+  pthread_mutex_lock(&gradientLock);
+  if (*slot != NULL)
+    releaseGradientEntry(*slot);
+  *slot = entry;
+  ++entry->references;
+  pthread_mutex_unlock(&gradientLock);
+
+  return entry;
+}
+
+/* The domain list element of the named variable. */
+static Domain *findDomainElem(Domain *const domains, const char *const name) {
+  for (Domain *dom = domains; dom != NULL; dom = dom->next)
+    if (strcmp(dom->var, name) == 0)
+      return dom;
+
+  /* The expression tree contains a variable whose valuation is unknown. */
+  assert(false);
+  return NULL;
+}
+
+Interval evaluateExpTreeCentered(const ExpTree *const tree,
+                                 const Domain *const domains) {
+  assert(tree != NULL);
+  assert(domains != NULL);
+
+  GradientEntry *gradient = acquireGradientEntry(tree);
+
+  /* The points at which the lower, resp. upper bound is evaluated: the
+    minimizing, resp. maximizing, endpoint in monotone variables and the
+    midpoint in all others. */
+  Domain *lowerPoint = cpyDomain(domains);
+  Domain *upperPoint = cpyDomain(domains);
+  Interval slope = newInterval(0, 0);
+
+  beginOutwardRounding();
+  for (unsigned int it = 0; it < gradient->nvars; ++it) {
+    Domain *lower = findDomainElem(lowerPoint, gradient->vars[it]);
+    Domain *upper = findDomainElem(upperPoint, gradient->vars[it]);
+    const Interval box = lower->domain;
+    Interval partial = evaluateExpTree(gradient->partials[it], domains);
+
+    if (partial.left >= 0) {
+      /* Increasing */
+      lower->domain = newInterval(box.left, box.left);
+      upper->domain = newInterval(box.right, box.right);
+    } else if (partial.right <= 0) {
+      /* Decreasing */
+      lower->domain = newInterval(box.right, box.right);
+      upper->domain = newInterval(box.left, box.left);
+    } else {
+      /* Centered: partial * (X - c) */
+      double center = intervalMidpoint(&box);
+      Interval point = newInterval(center, center);
+      Interval offset = subInterval(&box, &point);
+      Interval term = mulInterval(&partial, &offset);
+      slope = addInterval(&slope, &term);
+      lower->domain = point;
+      upper->domain = point;
+    }
+  }
+
+  Interval lowerValue = evaluateExpTree(tree, lowerPoint);
+  Interval upperValue = evaluateExpTree(tree, upperPoint);
+  lowerValue = addInterval(&lowerValue, &slope);
+  upperValue = addInterval(&upperValue, &slope);
+  endOutwardRounding();
+
+  /* Clean */
+  delDomain(lowerPoint);
+  delDomain(upperPoint);
+  pthread_mutex_lock(&gradientLock);
+  releaseGradientEntry(gradient);
+  pthread_mutex_unlock(&gradientLock);
+
+  return newInterval(lowerValue.left, upperValue.right);
+}
+
+void clearGradientCache(void) {
+  pthread_mutex_lock(&gradientLock);
+  for (unsigned int it = 0; it < GRADIENT_CACHE_SIZE; ++it) {
+    if (gradientCache[it] != NULL)
+      releaseGradientEntry(gradientCache[it]);
+    gradientCache[it] = NULL;
+  }
+  gradientHits = 0;
+  gradientMisses = 0;
+  pthread_mutex_unlock(&gradientLock);
+}
+
+void gradientCacheStats(unsigned int *hits, unsigned int *misses) {
+  pthread_mutex_lock(&gradientLock);
+  if (hits != NULL)
+    *hits = gradientHits;
+  if (misses != NULL)
+    *misses = gradientMisses;
+  pthread_mutex_unlock(&gradientLock);
+}
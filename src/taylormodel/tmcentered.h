@@ -0,0 +1,84 @@
+/**
+ * @file tmcentered.h
+ * @brief Centered form (mean value form) range enclosures of expressions.
+ * @details By the mean value theorem, the range of f over a box X lies in
+ * \f$ f(c) + \nabla f(X) \cdot (X - c) \f$ for the midpoint c of X. The
+ * overestimation of this centered form shrinks quadratically with the width
+ * of X, against linearly for plain interval evaluation, so it pays off on
+ * the small boxes of Taylor model arithmetic.
+ *
+ * The gradient enclosure also shows in which variables f is monotone. Those
+ * variables are fixed to the endpoint of the box that minimizes, resp.
+ * maximizes, f, so they contribute no overestimation at all.
+ *
+ * The gradient trees are derived symbolically once per expression and
+ * cached.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_CENTERED_H
+#define TM_CENTERED_H
+
+#include "funexp.h"
+#include "interval.h"
+#include "taylormodel.h"
+#include "transformations.h"
+#include "variables.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The number of slots of the cache of gradients.
+#define GRADIENT_CACHE_SIZE 256
+
+/**
+ * @brief Perform interval-valued expression evaluation via the centered
+ * form, with monotonicity detection.
+ * @details The gradient of \p tree is enclosed over the box first. For a
+ * variable whose partial derivative does not change sign, the lower bound
+ * is evaluated at the endpoint where f is smallest, and the upper bound at
+ * the endpoint where f is largest. The other variables are centered:
+ * \f$ f(c) + \sum_i \partial_i f(X) (X_i - c_i) \f$.
+ *
+ * e.g. domain x &isin; [0, 1] and an expression exp = x^2 - x. <br>
+ * &rArr; f(0.5) + (2x - 1)([0, 1]) * ([0, 1] - 0.5)
+ * = -0.25 + [-1, 1] * [-0.5, 0.5]
+ * = [-0.75, 0.25],
+ * where interval evaluation gives [-1, 1].
+ *
+ * The supported functions are those of @ref evaluateExpTree. Safe to call
+ * from multiple threads.
+ * @pre Both \p tree and \p domains must **not** be NULL.
+ * @pre The partial derivatives must be defined on the whole box, e.g. a box
+ * on which sqrt is evaluated may not contain 0.
+ *
+ * @param[in] tree    The expression tree to evaluate.
+ * @param[in] domains The mapping of expression variable to interval domain.
+ * @return Interval An enclosure of the range of \p tree over \p domains.
+ */
+Interval evaluateExpTreeCentered(const ExpTree *const tree,
+                                 const Domain *const domains);
+
+/**
+ * @brief Deallocate all cached gradients.
+ * @details The cache holds at most @ref GRADIENT_CACHE_SIZE gradients, so
+ * this only frees memory; it is never required for correctness.
+ */
+void clearGradientCache(void);
+
+/**
+ * @brief The number of gradient lookups so far that found, resp. did not
+ * find, their gradient.
+ *
+ * @param[out] hits   The number of hits. Ignored if NULL.
+ * @param[out] misses The number of misses. Ignored if NULL.
+ */
+void gradientCacheStats(unsigned int *hits, unsigned int *misses);
+
+#endif
@@ -0,0 +1,442 @@
+#include "tmcollect.h"
+#include <math.h>
+
+static IntervalPolynomial *newIntervalPolynomial(char *const *vars,
+                                                 const unsigned int nvars) {
+  IntervalPolynomial *poly =
+      (IntervalPolynomial *)calloc(1, sizeof(IntervalPolynomial));
+  if (poly == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  poly->vars = vars;
+  poly->nvars = nvars;
+  return poly;
+}
+
+void delIntervalPolynomial(IntervalPolynomial *poly) {
+  assert(poly != NULL);
+  free(poly->coefficients);
+  free(poly->exponents);
+  free(poly);
+}
+
+/* The index of the term with the given exponents, or -1. */
+static int findIntervalTerm(const IntervalPolynomial *poly,
+                            const unsigned int *exponents) {
+  for (unsigned int term = 0; term < poly->length; ++term)
+    if (memcmp(&poly->exponents[term * poly->nvars], exponents,
+               poly->nvars * sizeof(unsigned int)) == 0)
+      return (int)term;
+  return -1;
+}
+
+/* Add the coefficient to the term with the given exponents. */
+static void addIntervalTerm(IntervalPolynomial *poly,
+                            const Interval *const coefficient,
+                            const unsigned int *exponents) {
+  int index = findIntervalTerm(poly, exponents);
+  if (index >= 0) {
+    poly->coefficients[index] =
+        addInterval(&poly->coefficients[index], coefficient);
+    return;
+  }
+
+  if (poly->length == poly->capacity) {
+    poly->capacity = (poly->capacity > 0) ? 2 * poly->capacity : 8;
+    poly->coefficients = (Interval *)realloc(
+        poly->coefficients, poly->capacity * sizeof(Interval));
+    /* One more entry, so that a polynomial without variables allocates. */
+    poly->exponents = (unsigned int *)realloc(
+        poly->exponents,
+        (poly->capacity * poly->nvars + 1) * sizeof(unsigned int));
+    if (poly->coefficients == NULL || poly->exponents == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+  poly->coefficients[poly->length] = *coefficient;
+  memcpy(&poly->exponents[poly->length * poly->nvars], exponents,
+         poly->nvars * sizeof(unsigned int));
+  ++poly->length;
+}
+
+static IntervalPolynomial *intervalConstant(char *const *vars,
+                                            const unsigned int nvars,
+                                            const Interval *const constant) {
+  unsigned int *exponents =
+      (unsigned int *)calloc(nvars + 1, sizeof(unsigned int));
+  if (exponents == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  IntervalPolynomial *poly = newIntervalPolynomial(vars, nvars);
+  addIntervalTerm(poly, constant, exponents);
+  free(exponents);
+  return poly;
+}
+
+/* Whether the polynomial is a constant, which is then stored. */
+static bool isIntervalConstant(const IntervalPolynomial *poly,
+                               Interval *constant) {
+  *constant = newInterval(0, 0);
+  for (unsigned int term = 0; term < poly->length; ++term) {
+    for (unsigned int it = 0; it < poly->nvars; ++it)
+      if (poly->exponents[term * poly->nvars + it] != 0)
+        return false;
+    *constant = addInterval(constant, &poly->coefficients[term]);
+  }
+  return true;
+}
+
+static IntervalPolynomial *scaleIntervalPolynomial(
+    const IntervalPolynomial *poly, const Interval *const factor) {
+  IntervalPolynomial *scaled = newIntervalPolynomial(poly->vars, poly->nvars);
+  for (unsigned int term = 0; term < poly->length; ++term) {
+    Interval coefficient = mulInterval(&poly->coefficients[term], factor);
+    addIntervalTerm(scaled, &coefficient,
+                    &poly->exponents[term * poly->nvars]);
+  }
+  return scaled;
+}
+
+static IntervalPolynomial *addIntervalPolynomial(
+    const IntervalPolynomial *left, const IntervalPolynomial *right) {
+  IntervalPolynomial *sum = newIntervalPolynomial(left->vars, left->nvars);
+  for (unsigned int term = 0; term < left->length; ++term)
+    addIntervalTerm(sum, &left->coefficients[term],
+                    &left->exponents[term * left->nvars]);
+  for (unsigned int term = 0; term < right->length; ++term)
+    addIntervalTerm(sum, &right->coefficients[term],
+                    &right->exponents[term * right->nvars]);
+  return sum;
+}
+
+static IntervalPolynomial *mulIntervalPolynomial(
+    const IntervalPolynomial *left, const IntervalPolynomial *right) {
+  const unsigned int nvars = left->nvars;
+  unsigned int *exponents =
+      (unsigned int *)calloc(nvars + 1, sizeof(unsigned int));
+  if (exponents == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  IntervalPolynomial *product = newIntervalPolynomial(left->vars, nvars);
+  for (unsigned int i = 0; i < left->length; ++i)
+    for (unsigned int j = 0; j < right->length; ++j) {
+      for (unsigned int it = 0; it < nvars; ++it)
+        exponents[it] = left->exponents[i * nvars + it] +
+                        right->exponents[j * nvars + it];
+      Interval coefficient =
+          mulInterval(&left->coefficients[i], &right->coefficients[j]);
+      addIntervalTerm(product, &coefficient, exponents);
+    }
+
+  /* Clean */
+  free(exponents);
+
+  return product;
+}
+
+/* The interval counterpart of the conversion of toPolynomial, over the same
+  variables, or NULL if the tree is not a polynomial. */
+static IntervalPolynomial *buildIntervalPolynomial(const ExpTree *tree,
+                                                   char *const *vars,
+                                                   const unsigned int nvars) {
+  assert(tree != NULL);
+
+  switch (tree->type) {
+  case EXP_NUM: {
+    Interval constant = strtoInterval(tree->data);
+    return intervalConstant(vars, nvars, &constant);
+  }
+
+  case EXP_VAR: {
+    unsigned int *exponents =
+        (unsigned int *)calloc(nvars + 1, sizeof(unsigned int));
+    if (exponents == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+    for (unsigned int it = 0; it < nvars; ++it)
+      if (strcmp(vars[it], tree->data) == 0)
+        exponents[it] = 1;
+
+    Interval one = newInterval(1, 1);
+    IntervalPolynomial *poly = newIntervalPolynomial(vars, nvars);
+    addIntervalTerm(poly, &one, exponents);
+    free(exponents);
+    return poly;
+  }
+
+  case EXP_NEG: {
+    IntervalPolynomial *operand =
+        buildIntervalPolynomial(tree->left, vars, nvars);
+    if (operand == NULL)
+      return NULL;
+    Interval minusOne = newInterval(-1, -1);
+    IntervalPolynomial *neg = scaleIntervalPolynomial(operand, &minusOne);
+    delIntervalPolynomial(operand);
+    return neg;
+  }
+
+  case EXP_ADD_OP:
+  case EXP_SUB_OP:
+  case EXP_MUL_OP:
+  case EXP_DIV_OP: {
+    IntervalPolynomial *left = buildIntervalPolynomial(tree->left, vars, nvars);
+    IntervalPolynomial *right =
+        (left != NULL) ? buildIntervalPolynomial(tree->right, vars, nvars)
+                       : NULL;
+    if (right == NULL) {
+      if (left != NULL)
+        delIntervalPolynomial(left);
+      return NULL;
+    }
+
+    IntervalPolynomial *result = NULL;
+    Interval constant;
+    if (tree->type == EXP_ADD_OP) {
+      result = addIntervalPolynomial(left, right);
+    } else if (tree->type == EXP_SUB_OP) {
+      Interval minusOne = newInterval(-1, -1);
+      IntervalPolynomial *neg = scaleIntervalPolynomial(right, &minusOne);
+      result = addIntervalPolynomial(left, neg);
+      delIntervalPolynomial(neg);
+    } else if (tree->type == EXP_MUL_OP) {
+      result = mulIntervalPolynomial(left, right);
+    } else if (isIntervalConstant(right, &constant) &&
+               !elemInterval(0, &constant)) {
+      /* Only division by a non-zero constant yields a polynomial. */
+      Interval one = newInterval(1, 1);
+      Interval reciprocal = divInterval(&one, &constant);
+      result = scaleIntervalPolynomial(left, &reciprocal);
+    }
+
+    /* Clean */
+    delIntervalPolynomial(left);
+    delIntervalPolynomial(right);
+
+    return result;
+  }
+
+  case EXP_EXP_OP: {
+    /* Only non-negative integer exponents yield a polynomial. */
+    if (tree->right->type != EXP_NUM)
+      return NULL;
+    double exponent = atof(tree->right->data);
+    if (exponent < 0 || exponent != floor(exponent))
+      return NULL;
+
+    IntervalPolynomial *base = buildIntervalPolynomial(tree->left, vars, nvars);
+    if (base == NULL)
+      return NULL;
+
+    /* Exponentiation by squaring. */
+    Interval one = newInterval(1, 1);
+    IntervalPolynomial *power = intervalConstant(vars, nvars, &one);
+    for (unsigned int n = (unsigned int)exponent; n > 0; n /= 2) {
+      if (n % 2 == 1) {
+        IntervalPolynomial *product = mulIntervalPolynomial(power, base);
+        delIntervalPolynomial(power);
+        power = product;
+      }
+      if (n > 1) {
+        IntervalPolynomial *squared = mulIntervalPolynomial(base, base);
+        delIntervalPolynomial(base);
+        base = squared;
+      }
+    }
+
+    /* Clean */
+    delIntervalPolynomial(base);
+
+    return power;
+  }
+
+  default:
+    return NULL;
+  }
+}
+
+IntervalPolynomial *toIntervalPolynomial(const ExpTree *tree,
+                                         char *const *vars,
+                                         const unsigned int nvars) {
+  assert(tree != NULL);
+  assert(vars != NULL || nvars == 0);
+  return buildIntervalPolynomial(tree, vars, nvars);
+}
+
+static const Interval *findDomain(const Domain *const domains,
+                                  const char *const name) {
+  for (const Domain *dom = domains; dom != NULL; dom = dom->next)
+    if (strcmp(dom->var, name) == 0)
+      return &dom->domain;
+  return NULL;
+}
+
+/* Add (a - c) Int(x^e) to the enclosure, with a the interval and c the
+  double coefficient of the monomial x^e. */
+static bool addCoefficientError(Interval *enclosure, const Interval *exact,
+                                const double approx, char *const *vars,
+                                const unsigned int nvars,
+                                const unsigned int *exponents,
+                                const Domain *const variables) {
+  Interval center = newInterval(approx, approx);
+  Interval error = subInterval(exact, &center);
+  if (error.left == 0 && error.right == 0)
+    return true;
+
+  for (unsigned int it = 0; it < nvars; ++it) {
+    if (exponents[it] == 0)
+      continue;
+    const Interval *domain = findDomain(variables, vars[it]);
+    if (domain == NULL)
+      return false;
+    Interval power = powInterval(domain, exponents[it]);
+    error = mulInterval(&error, &power);
+  }
+  *enclosure = addInterval(enclosure, &error);
+  return true;
+}
+
+/* Add the gap between the interval polynomial and the double polynomial
+  over the same variables to the enclosure, term by term. Returns false if a
+  monomial has a variable without a domain. */
+static bool addPolynomialError(Interval *enclosure, const Polynomial *approx,
+                               const IntervalPolynomial *exact,
+                               const Domain *const variables) {
+  /* Every term of either polynomial contributes its gap, where a term that
+    is missing from the other polynomial has coefficient 0. */
+  const unsigned int nvars = approx->nvars;
+  bool bounded = true;
+  for (unsigned int term = 0; bounded && term < exact->length; ++term) {
+    double coefficient = 0;
+    for (unsigned int other = 0; other < approx->length; ++other)
+      if (memcmp(&approx->exponents[other * nvars],
+                 &exact->exponents[term * nvars],
+                 nvars * sizeof(unsigned int)) == 0)
+        coefficient = approx->coefficients[other];
+    bounded = addCoefficientError(enclosure, &exact->coefficients[term],
+                                  coefficient, approx->vars, nvars,
+                                  &exact->exponents[term * nvars], variables);
+  }
+  for (unsigned int term = 0; bounded && term < approx->length; ++term) {
+    if (findIntervalTerm(exact, &approx->exponents[term * nvars]) >= 0)
+      continue;
+    Interval zero = newInterval(0, 0);
+    bounded = addCoefficientError(enclosure, &zero,
+                                  approx->coefficients[term], approx->vars,
+                                  nvars, &approx->exponents[term * nvars],
+                                  variables);
+  }
+  return bounded;
+}
+
+/* The head-only kernel of collectTM. */
+static TaylorModel *collectTMHead(const TaylorModel *const tm,
+                                  const Domain *const variables) {
+  assert(tm->fun != NULL);
+
+  Polynomial *approx = toPolynomial(tm->exp);
+  IntervalPolynomial *exact =
+      (approx != NULL)
+          ? buildIntervalPolynomial(tm->exp, approx->vars, approx->nvars)
+          : NULL;
+  if (exact == NULL) {
+    if (approx != NULL)
+      delPolynomial(approx);
+    return newTaylorModel(strdup(tm->fun), cpyExpTree(tm->exp),
+                          tm->remainder);
+  }
+
+  Interval remainder = tm->remainder;
+  bool bounded = addPolynomialError(&remainder, approx, exact, variables);
+  ExpTree *collected = bounded ? fromPolynomial(approx) : cpyExpTree(tm->exp);
+  TaylorModel *result = newTaylorModel(strdup(tm->fun), collected,
+                                       bounded ? remainder : tm->remainder);
+
+  /* Clean */
+  delIntervalPolynomial(exact);
+  delPolynomial(approx);
+
+  return result;
+}
+
+TaylorModel *collectTM(const TaylorModel *const list,
+                       const Domain *const variables) {
+  assert(variables != NULL);
+
+  /* Base case: The tail/next of the last element is NULL. */
+  if (list == NULL)
+    return NULL;
+
+  /* Recursive case: The tail of the new element is everything built until now.
+   */
+  return appTMElem(collectTM(list->next, variables),
+                   collectTMHead(list, variables));
+}
+
+/* The head-only kernel of collectPrimitiveTM. */
+static TaylorModel *collectPrimitiveTMHead(const TaylorModel *const tm,
+                                           const char *const intVar,
+                                           const Interval *const domain,
+                                           const Domain *const variables) {
+  assert(tm->fun != NULL);
+
+  /* int_0^v c v^n dv = c / (n + 1) v^(n + 1), in double arithmetic by
+    integratePolynomial, and here in interval arithmetic. */
+  Polynomial *poly = toPolynomial(tm->exp);
+  assert(poly != NULL);
+  Polynomial *approx = integratePolynomial(poly, intVar);
+  IntervalPolynomial *exact =
+      buildIntervalPolynomial(tm->exp, approx->vars, approx->nvars);
+  assert(exact != NULL);
+
+  const unsigned int nvars = approx->nvars;
+  unsigned int index = 0;
+  while (strcmp(approx->vars[index], intVar) != 0)
+    ++index;
+  for (unsigned int term = 0; term < exact->length; ++term) {
+    unsigned int *exponent = &exact->exponents[term * nvars + index];
+    Interval divisor = newInterval(*exponent + 1, *exponent + 1);
+    exact->coefficients[term] =
+        divInterval(&exact->coefficients[term], &divisor);
+    ++*exponent;
+  }
+
+  /* (int_0^v p dv, I * Dv), plus the rounding of the coefficients. */
+  Interval remainder = mulInterval(&tm->remainder, domain);
+  bool bounded = addPolynomialError(&remainder, approx, exact, variables);
+  assert(bounded);
+  TaylorModel *result =
+      newTaylorModel(strdup(tm->fun), fromPolynomial(approx), remainder);
+
+  /* Clean */
+  delIntervalPolynomial(exact);
+  delPolynomial(approx);
+  delPolynomial(poly);
+
+  return result;
+}
+
+TaylorModel *collectPrimitiveTM(const TaylorModel *const list,
+                                const char *const intVar,
+                                const Domain *const variables) {
+  assert(intVar != NULL);
+  assert(variables != NULL);
+
+  /* Base case: The tail/next of the last element is NULL. */
+  if (list == NULL)
+    return NULL;
+
+  const Interval *domain = findDomain(variables, intVar);
+  /* The integration variable needs a domain. */
+  assert(domain != NULL);
+
+  /* Recursive case: The tail of the new element is everything built until now.
+   */
+  return appTMElem(collectPrimitiveTM(list->next, intVar, variables),
+                   collectPrimitiveTMHead(list, intVar, domain, variables));
+}
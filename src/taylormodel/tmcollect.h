@@ -0,0 +1,115 @@
+/**
+ * @file tmcollect.h
+ * @brief Rigorous collection of the terms of Taylor models.
+ * @details @ref collectTerms folds the coefficients of a polynomial in
+ * double arithmetic, so the collected polynomial may differ slightly from
+ * the original one. For a Taylor model, that difference must be moved into
+ * the remainder. Here the coefficients are also folded with interval
+ * arithmetic, and the gap between each interval coefficient and its double
+ * counterpart, times the range of its monomial, is added to the remainder.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_COLLECT_H
+#define TM_COLLECT_H
+
+#include "funexp.h"
+#include "interval.h"
+#include "polynomial.h"
+#include "taylormodel.h"
+#include "variables.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief A polynomial with interval coefficients, over the variables of a
+ * @ref Polynomial.
+ * @details The terms are kept in order of appearance, and no two terms have
+ * the same exponents.
+ */
+typedef struct IntervalPolynomial {
+  /// @brief The names of the variables, borrowed.
+  char *const *vars;
+  /// @brief The number of variables.
+  unsigned int nvars;
+  /// @brief The number of terms (monomials).
+  unsigned int length;
+  /// @brief The number of terms that fit in the allocated arrays.
+  unsigned int capacity;
+  /// @brief The coefficient of each term.
+  Interval *coefficients;
+  /// @brief The exponent vector of each term, term by term.
+  unsigned int *exponents;
+} IntervalPolynomial;
+
+/**
+ * @brief Expand an expression into a polynomial with interval coefficients.
+ * @details The expansion follows @ref toPolynomial, but in interval
+ * arithmetic, so every coefficient encloses the exact coefficient of the
+ * expression, including those that cancel in double arithmetic.
+ * @pre \p tree may **not** be NULL, and \p vars must contain every variable
+ * of \p tree, e.g. those of its @ref toPolynomial conversion.
+ *
+ * @param[in] tree  The expression to expand.
+ * @param[in] vars  The variables, borrowed by the result.
+ * @param[in] nvars The number of variables.
+ * @return IntervalPolynomial* A newly heap-allocated polynomial, or NULL if
+ * \p tree is not a polynomial.
+ */
+IntervalPolynomial *toIntervalPolynomial(const ExpTree *tree,
+                                         char *const *vars,
+                                         const unsigned int nvars);
+
+/**
+ * @brief Deallocate the given polynomial, but not its variables.
+ * @pre \p poly may **not** be NULL.
+ */
+void delIntervalPolynomial(IntervalPolynomial *poly);
+
+/**
+ * @brief Collect the terms of the polynomial part of every Taylor model of
+ * the list.
+ * @details Every polynomial is brought in the canonical form of
+ * @ref collectTerms, and the rounding of its coefficients is enclosed in the
+ * remainder, so the result encloses the same functions as \p list. A
+ * component that is not a polynomial, or that has a variable without a
+ * domain in \p variables, is copied as is.
+ * @pre \p variables may **not** be NULL.
+ *
+ * @param[in] list The Taylor models to collect, or NULL.
+ * @param[in] variables The domains of the variables.
+ * @return TaylorModel* A newly heap-allocated list of Taylor models, in the
+ * order of \p list.
+ */
+TaylorModel *collectTM(const TaylorModel *const list,
+                       const Domain *const variables);
+
+/**
+ * @brief Integrate the polynomial part of every Taylor model of the list from
+ * zero, and collect its terms.
+ * @details The result is \f$ (\int_0^v p \, dv, \; I \cdot D_v) \f$, as
+ * for @ref primitiveTM, but the division of each coefficient by its new
+ * exponent is also done in interval arithmetic, and its rounding is enclosed
+ * in the remainder.
+ * @pre \p intVar and \p variables may **not** be NULL, and \p variables must
+ * contain a domain for every variable of \p list and for \p intVar. The
+ * polynomial parts of \p list must be polynomials.
+ *
+ * @param[in] list      The integrands, or NULL.
+ * @param[in] intVar    The variable w.r.t. which to integrate, e.g. t.
+ * @param[in] variables The domains of the variables.
+ * @return TaylorModel* A newly heap-allocated list of Taylor models, in the
+ * order of \p list.
+ */
+TaylorModel *collectPrimitiveTM(const TaylorModel *const list,
+                                const char *const intVar,
+                                const Domain *const variables);
+
+#endif
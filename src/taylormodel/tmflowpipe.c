@@ -1,13 +1,70 @@
 #include "tmflowpipe.h"
+#include "tmcollect.h"
+#include "trace.h"
+
+/* Extend each running Taylor polynomial in-place with its order i term,
+  1/i! * L^i(g) * t^i, where L^i(g) are the given order i Lie derivatives. */
+static void addTaylorTerms(TaylorModel *polynomials,
+                           const TaylorModel *lieDeriv,
+                           const unsigned int index) {
+  TaylorModel *poly = polynomials;
+  const TaylorModel *deriv = lieDeriv;
+  while (poly != NULL || deriv != NULL) {
+    /* If one becomes NULL while the other does not,
+      then there is a length mismatch. */
+    assert((poly != NULL) == (deriv != NULL));
+
+    /* Ensure each variable's derivative is added to that same variable's
+      running Taylor polynomial. If this assertion fails, the variable
+      ordering in the lists was messed up somehow. */
+    assert(strcmp(poly->fun, deriv->fun) == 0);
+
+    /* Make a copy to ensure the tree is decoupled from the derivative object.
+     */
+    ExpTree *derivExp = cpyExpTree(deriv->exp);
+
+    /* fac(i) = gamma(i+1) */
+    double factorial = tgamma(index + 1);
+    char factorialStr[50];
+    snprintf(factorialStr, sizeof(factorialStr), "%.15g", factorial);
+    char indexStr[50];
+    snprintf(indexStr, sizeof(indexStr), "%u", index);
+
+    /* 1/i! */
+    ExpTree *fac = newExpOp(EXP_DIV_OP, newExpLeaf(EXP_NUM, "1"),
+                            newExpLeaf(EXP_NUM, factorialStr));
+    /* t^i */
+    ExpTree *tPow = newExpOp(EXP_EXP_OP, newExpLeaf(EXP_VAR, VAR_TIME),
+                             newExpLeaf(EXP_NUM, indexStr));
+    /* 1/i! * L^i(g) * t^i   where L^i(g) is the order i Lie derivative of
+     * function g. */
+    ExpTree *polyElement =
+        newExpOp(EXP_MUL_OP, fac, newExpOp(EXP_MUL_OP, derivExp, tPow));
+
+    /* Extend the polynomial in-place!. */
+    poly->exp = newExpOp(EXP_ADD_OP, poly->exp, polyElement);
+
+    poly = poly->next;
+    deriv = deriv->next;
+  }
+}
 
 TaylorModel *computeTaylorPolynomial(ODEList *system, unsigned int order,
                                      unsigned int k) {
+  return computeTaylorPolynomialParallel(system, order, k, NULL);
+}
+
+TaylorModel *computeTaylorPolynomialParallel(ODEList *system,
+                                             unsigned int order,
+                                             unsigned int k,
+                                             ThreadPool *pool) {
   assert(system != NULL);
   assert(order > 0);
   assert(k > 0);
   /* All the polynomial terms exceeding the truncation order
     would just get truncated anyways, so impose an explicit restriction. */
   assert(order <= k);
+  TRACE_BEGIN_ARG(span, "computeTaylorPolynomial", "order", order);
 
   /* The functions to seed each Lie derivation with. */
   TaylorModel *lieDerivativeSeed = initTaylorModel(system);
@@ -16,48 +73,9 @@ TaylorModel *computeTaylorPolynomial(ODEList *system, unsigned int order,
 
   /* Start from i=1; case i=0 would be an order 0 Lie derivative. */
   for (unsigned int index = 1; index <= order; ++index) {
-    TaylorModel *lieDeriv = lieDerivativeK(system, lieDerivativeSeed, index);
-
-    TaylorModel *poly = polynomials;
-    TaylorModel *deriv = lieDeriv;
-    while (poly != NULL || deriv != NULL) {
-      /* If one becomes NULL while the other does not,
-        then there is a length mismatch. */
-      assert((poly != NULL) == (deriv != NULL));
-
-      /* Ensure each variable's derivative is added to that same variable's
-        running Taylor polynomial. If this assertion fails, the variable
-        ordering in the lists was messed up somehow. */
-      assert(strcmp(poly->fun, deriv->fun) == 0);
-
-      /* Make a copy to ensure the tree is decoupled from the derivative object.
-       */
-      ExpTree *derivExp = cpyExpTree(deriv->exp);
-
-      /* fac(i) = gamma(i+1) */
-      double factorial = tgamma(index + 1);
-      char factorialStr[50];
-      snprintf(factorialStr, sizeof(factorialStr), "%.15g", factorial);
-      char indexStr[50];
-      snprintf(indexStr, sizeof(indexStr), "%u", index);
-
-      /* 1/i! */
-      ExpTree *fac = newExpOp(EXP_DIV_OP, newExpLeaf(EXP_NUM, "1"),
-                              newExpLeaf(EXP_NUM, factorialStr));
-      /* t^i */
-      ExpTree *tPow = newExpOp(EXP_EXP_OP, newExpLeaf(EXP_VAR, VAR_TIME),
-                               newExpLeaf(EXP_NUM, indexStr));
-      /* 1/i! * L^i(g) * t^i   where L^i(g) is the order i Lie derivative of
-       * function g. */
-      ExpTree *polyElement =
-          newExpOp(EXP_MUL_OP, fac, newExpOp(EXP_MUL_OP, derivExp, tPow));
-
-      /* Extend the polynomial in-place!. */
-      poly->exp = newExpOp(EXP_ADD_OP, poly->exp, polyElement);
-
-      poly = poly->next;
-      deriv = deriv->next;
-    }
+    TaylorModel *lieDeriv =
+        lieDerivativeKParallel(system, lieDerivativeSeed, index, pool);
+    addTaylorTerms(polynomials, lieDeriv, index);
 
     /* Cleanup */
     delTaylorModel(lieDeriv);
@@ -66,11 +84,17 @@ TaylorModel *computeTaylorPolynomial(ODEList *system, unsigned int order,
   /* Cleanup */
   delTaylorModel(lieDerivativeSeed);
 
+  TRACE_END(span);
   return polynomials;
 }
 
 TaylorModel *lieDerivativeK(ODEList *system, TaylorModel *functions,
                             unsigned int order) {
+  return lieDerivativeKParallel(system, functions, order, NULL);
+}
+
+TaylorModel *lieDerivativeKParallel(ODEList *system, TaylorModel *functions,
+                                    unsigned int order, ThreadPool *pool) {
   assert(system != NULL);
   assert(functions != NULL);
 
@@ -83,54 +107,86 @@ TaylorModel *lieDerivativeK(ODEList *system, TaylorModel *functions,
   /* After pass i of the loop, the polynomial parts of the list of Taylor
     models represent a vector of order i Lie derivatives. So each pass
     raises the order of the Lie derivatives by one, until order k. */
+  TRACE_BEGIN_ARG(span, "lieDerivativeK", "order", order);
   TaylorModel *ithLieDerivative = functions;
   for (unsigned int index = 0; index < order; ++index) {
     TaylorModel *old = ithLieDerivative;
-    ithLieDerivative = lieDerivativeTaylorModel(system, ithLieDerivative);
+    ithLieDerivative =
+        lieDerivativeTaylorModelParallel(system, ithLieDerivative, pool);
 
     /* Cleanup: idx = 0 is the input, other intermediates may be deleted. */
     if (index > 0)
       delTaylorModel(old);
   }
 
+  TRACE_END(span);
   return ithLieDerivative;
 }
 
-TaylorModel *lieDerivativeTaylorModel(ODEList *system, TaylorModel *functions) {
-  assert(system != NULL);
-  assert(functions != NULL);
+/* The shared state of one parallel, per-component flowpipe operation. */
+typedef struct FlowpipeParallelContext {
+  ODEList *system;
+  ODEList **components;
+  TaylorModel *functions;
+  TaylorModel **functionComponents;
+  TaylorModel **results;
+} FlowpipeParallelContext;
 
-  ODEList *ode = system;
-  TaylorModel *function = functions;
-  TaylorModel *derived = NULL;
+static void runLieDerivativeComponent(unsigned int index, void *context) {
+  FlowpipeParallelContext *ctx = (FlowpipeParallelContext *)context;
+  TaylorModel *function = ctx->functionComponents[index];
 
-  /* Derive each of the functions individually w.r.t. the same ODe system. */
-  while (ode != NULL || function != NULL) {
-    /* If only one (XOR) is NULL but not the other, then there is a list length
-      mismatch. Theoretically, they could have different lengths, but in our
-      case their lengths are always the same. This assertion safeguards that
-      loose assumption. */
-    assert((ode != NULL) == (function != NULL));
+  char *fun = strdup(function->fun);
+  ExpTree *lieDeriv = lieDerivative(ctx->system, function->exp);
+  Interval remainder = function->remainder;
 
-    char *fun = strdup(function->fun);
-    ExpTree *lieDeriv = lieDerivative(system, function->exp);
-    Interval remainder = function->remainder;
+  /* Post-process the result. */
+  ExpTree *simplified = simplify(lieDeriv);
+  delExpTree(lieDeriv);
 
-    /* Post-process the result. */
-    ExpTree *simplified = simplify(lieDeriv);
-    delExpTree(lieDeriv);
+  ctx->results[index] = newTaylorModel(fun, simplified, remainder);
+}
 
-    /* The initial tail should be NULL, since the list is extended head-first.
-     */
-    derived = newTMElem(derived, fun, simplified, remainder);
+TaylorModel *lieDerivativeTaylorModel(ODEList *system, TaylorModel *functions) {
+  return lieDerivativeTaylorModelParallel(system, functions, NULL);
+}
 
-    ode = ode->next;
+TaylorModel *lieDerivativeTaylorModelParallel(ODEList *system,
+                                              TaylorModel *functions,
+                                              ThreadPool *pool) {
+  assert(system != NULL);
+  assert(functions != NULL);
+
+  /* Theoretically, the system and functions could have different lengths,
+    but in our case their lengths are always the same. This assertion
+    safeguards that loose assumption. */
+  const unsigned int length = lengthTaylorModel(functions);
+  assert(length == lengthOdeList(system));
+
+  FlowpipeParallelContext ctx;
+  ctx.system = system;
+  ctx.components = NULL;
+  ctx.functions = functions;
+  ctx.functionComponents =
+      (TaylorModel **)malloc(length * sizeof(TaylorModel *));
+  ctx.results = (TaylorModel **)malloc(length * sizeof(TaylorModel *));
+  TaylorModel *function = functions;
+  for (unsigned int index = 0; index < length; ++index) {
+    ctx.functionComponents[index] = function;
     function = function->next;
   }
 
-  /* Reverse to ensure the output functions are
-    ordered the same as the input functions. */
-  return reverseTaylorModel(derived);
+  /* Derive each of the functions individually w.r.t. the same ODE system.
+    The results are linked by index, so the output functions are ordered the
+    same as the input functions. */
+  parallelFor(pool, length, runLieDerivativeComponent, &ctx);
+  TaylorModel *derived = linkTaylorModels(ctx.results, length);
+
+  /* Clean */
+  free(ctx.functionComponents);
+  free(ctx.results);
+
+  return derived;
 }
 
 ExpTree *lieDerivative(ODEList *vectorField, ExpTree *function) {
@@ -239,35 +295,174 @@ TaylorModel *picardOperatorTM(ODEList *vectorField, TaylorModel *functions) {
   return picard;
 }
 
-TaylorModel *substituteTaylorModel(ODEList *system, TaylorModel *functions) {
+TaylorModel *picardStepTM(ODEList *system, TaylorModel *initial,
+                          TaylorModel *functions, const Domain *variables,
+                          unsigned int k) {
   assert(system != NULL);
+  assert(initial != NULL);
   assert(functions != NULL);
+  assert(variables != NULL);
+
+  /* The vector field may depend on time, so time needs a TM as well. */
+  TaylorModel *arguments =
+      newTMElem(cpyTaylorModel(functions), strdup(VAR_TIME),
+                newExpLeaf(EXP_VAR, VAR_TIME), newInterval(0, 0));
+
+  /* f(g_j(t), t) */
+  const unsigned int length = lengthOdeList(system);
+  TaylorModel **components =
+      (TaylorModel **)malloc((length + 1) * sizeof(TaylorModel *));
+  if (components == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  unsigned int index = 0;
+  bool failed = false;
+  for (ODEList *ode = system; ode != NULL; ode = ode->next, ++index) {
+    components[index] =
+        evaluateExpTreeTM(ode->exp, arguments, ode->fun, variables, k);
+    failed = failed || components[index] == NULL;
+  }
+  if (failed) {
+    /* Clean */
+    for (index = 0; index < length; ++index)
+      if (components[index] != NULL)
+        delTaylorModel(components[index]);
+    free(components);
+    delTaylorModel(arguments);
+    return NULL;
+  }
+  TaylorModel *field = linkTaylorModels(components, length);
+
+  /* x0 + int_0^t f(g_j(s), s) ds */
+  TaylorModel *integrated = primitiveTM(field, VAR_TIME, variables, k);
+  TaylorModel *sum = addTM(initial, integrated, variables, k);
+  TaylorModel *next = collectTM(sum, variables);
+
+  /* Clean */
+  free(components);
+  delTaylorModel(arguments);
+  delTaylorModel(field);
+  delTaylorModel(integrated);
+  delTaylorModel(sum);
+
+  return next;
+}
+
+/* Check whether the polynomial parts of both vectors agree. */
+static bool isStablePicardIterate(const TaylorModel *previous,
+                                  const TaylorModel *current) {
+  for (; previous != NULL && current != NULL;
+       previous = previous->next, current = current->next) {
+    Polynomial *left = toPolynomial(previous->exp);
+    Polynomial *right = toPolynomial(current->exp);
+    assert(left != NULL && right != NULL);
+    bool equal = isEqualPolynomial(left, right, PICARD_TOLERANCE);
+
+    /* Clean */
+    delPolynomial(left);
+    delPolynomial(right);
+
+    if (!equal)
+      return false;
+  }
+  return previous == NULL && current == NULL;
+}
+
+TaylorModel *picardIterationTM(ODEList *system, TaylorModel *initial,
+                               const Domain *variables, unsigned int k,
+                               unsigned int maxIterations, PicardStats *stats) {
+  assert(maxIterations > 0);
+  TRACE_BEGIN(span, "picardIterationTM");
+
+  TaylorModel *current = cpyTaylorModel(initial);
+  unsigned int iterations = 0;
+  bool converged = false;
+  while (!converged && iterations < maxIterations) {
+    TaylorModel *next = picardStepTM(system, initial, current, variables, k);
+    converged = next != NULL && isStablePicardIterate(current, next);
+    delTaylorModel(current);
+    current = next;
+    ++iterations;
+
+    /* The vector field could not be evaluated, e.g. a divisor may be 0. */
+    if (current == NULL)
+      break;
+  }
 
+  if (stats != NULL) {
+    stats->iterations = iterations;
+    stats->converged = converged;
+  }
+  span.argName = "iterations";
+  span.arg = iterations;
+  TRACE_END(span);
+  return current;
+}
+
+/* Substitute all functions into a single system component. */
+static TaylorModel *substituteTMHead(ODEList *component,
+                                     TaylorModel *functions) {
   ExpTree *substituted = NULL;
   TaylorModel *function = functions;
   /* Substitute all functions into the current system component. */
   while (function != NULL) {
-    ExpTree *source = substituted ? substituted : system->exp;
+    ExpTree *source = substituted ? substituted : component->exp;
     substituted = substitute(source, function->fun, function->exp);
 
     /* Delete the old/intermediate tree, which always exists after the first
      * iteration. */
-    if (source != system->exp)
+    if (source != component->exp)
       delExpTree(source);
 
     function = function->next;
   }
 
-  char *fun = strdup(system->fun);
+  char *fun = strdup(component->fun);
   Interval remainder = newInterval(0, 0);
-  /* Base case: The tail/next of the last element is NULL. */
-  if (system->next == NULL)
-    return newTMElem(NULL, fun, substituted, remainder);
-  /* Recursive case: The tail of the new element is everything built until now.
-   */
-  else
-    return newTMElem(substituteTaylorModel(system->next, functions), fun,
-                     substituted, remainder);
+  return newTaylorModel(fun, substituted, remainder);
+}
+
+static void runSubstituteComponent(unsigned int index, void *context) {
+  FlowpipeParallelContext *ctx = (FlowpipeParallelContext *)context;
+  ctx->results[index] =
+      substituteTMHead(ctx->components[index], ctx->functions);
+}
+
+TaylorModel *substituteTaylorModel(ODEList *system, TaylorModel *functions) {
+  return substituteTaylorModelParallel(system, functions, NULL);
+}
+
+TaylorModel *substituteTaylorModelParallel(ODEList *system,
+                                           TaylorModel *functions,
+                                           ThreadPool *pool) {
+  assert(system != NULL);
+  assert(functions != NULL);
+
+  const unsigned int length = lengthOdeList(system);
+
+  FlowpipeParallelContext ctx;
+  ctx.system = system;
+  ctx.components = (ODEList **)malloc(length * sizeof(ODEList *));
+  ctx.functions = functions;
+  ctx.functionComponents = NULL;
+  ctx.results = (TaylorModel **)malloc(length * sizeof(TaylorModel *));
+  ODEList *component = system;
+  for (unsigned int index = 0; index < length; ++index) {
+    ctx.components[index] = component;
+    component = component->next;
+  }
+
+  /* Each system component is substituted independently, and the results are
+    linked in the order of the system components. */
+  parallelFor(pool, length, runSubstituteComponent, &ctx);
+  TaylorModel *substituted = linkTaylorModels(ctx.results, length);
+
+  /* Clean */
+  free(ctx.components);
+  free(ctx.results);
+
+  return substituted;
 }
 
 TaylorModel *initTaylorModel(ODEList *system) {
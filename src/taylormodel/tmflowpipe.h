@@ -17,14 +17,29 @@
 #include "interval.h"
 #include "sysode.h"
 #include "taylormodel.h"
+#include "threadpool.h"
 #include "transformations.h"
 #include <assert.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
 /// @brief The time variable; each ODE variable x is defined w.r.t. time as
 ///        \f$ \dot{x} \f$ = \f$ \frac{dx}{dt} \f$.
 #define VAR_TIME "t"
+/// @brief The relative tolerance under which the polynomial parts of two
+///        successive Picard iterates agree, see @ref picardIterationTM.
+#define PICARD_TOLERANCE 1e-12
+
+/**
+ * @brief Statistics of a Picard iteration, see @ref picardIterationTM.
+ */
+typedef struct PicardStats {
+  /// @brief The number of applications of the Picard operator.
+  unsigned int iterations;
+  /// @brief Whether the last two iterates agreed.
+  bool converged;
+} PicardStats;
 
 /**
  * @brief Step 1 of TM integration: compute the vector of Taylor polynomials.
@@ -46,6 +61,18 @@
 TaylorModel *computeTaylorPolynomial(ODEList *system, unsigned int order,
                                      unsigned int k);
 
+/**
+ * @brief Parallel variant of @ref computeTaylorPolynomial.
+ * @details The Lie derivatives of the individual vector components are
+ * distributed over the \p pool, see @ref lieDerivativeTaylorModelParallel.
+ * The output is identical to that of @ref computeTaylorPolynomial.
+ * If \p pool is NULL, then the components are processed serially.
+ */
+TaylorModel *computeTaylorPolynomialParallel(ODEList *system,
+                                             unsigned int order,
+                                             unsigned int k,
+                                             ThreadPool *pool);
+
 /**
  * @brief Compute a **vector** of order k Lie derivatives.
  * @details By definition, higher order Lie derivatives can be computed
@@ -67,6 +94,14 @@ TaylorModel *computeTaylorPolynomial(ODEList *system, unsigned int order,
 TaylorModel *lieDerivativeK(ODEList *system, TaylorModel *functions,
                             unsigned int order);
 
+/**
+ * @brief Parallel variant of @ref lieDerivativeK.
+ * @details Each order is computed via @ref lieDerivativeTaylorModelParallel.
+ * If \p pool is NULL, then the components are processed serially.
+ */
+TaylorModel *lieDerivativeKParallel(ODEList *system, TaylorModel *functions,
+                                    unsigned int order, ThreadPool *pool);
+
 /**
  * @brief Compute a **vector** of first-order Lie derivatives.
  * @details Here \p functions is a vector of Taylor models
@@ -86,6 +121,17 @@ TaylorModel *lieDerivativeK(ODEList *system, TaylorModel *functions,
  */
 TaylorModel *lieDerivativeTaylorModel(ODEList *system, TaylorModel *functions);
 
+/**
+ * @brief Parallel variant of @ref lieDerivativeTaylorModel.
+ * @details The Lie derivatives of the individual \p functions are independent,
+ * so they are distributed over the \p pool. The output is identical to that
+ * of @ref lieDerivativeTaylorModel, including the component order.
+ * If \p pool is NULL, then the components are processed serially.
+ */
+TaylorModel *lieDerivativeTaylorModelParallel(ODEList *system,
+                                              TaylorModel *functions,
+                                              ThreadPool *pool);
+
 /**
  * @brief Compute a single, first-order Lie derivative expression of a single
  * function expression w.r.t. an m-dimensional vector field.
@@ -133,7 +179,8 @@ TaylorModel *picardOperator(ODEList *vectorField, TaylorModel *functions);
  * The TM extension implies that the algebraic operations of the basic
  * picard operator are replaced by the Taylor model arithmetic equivalents.
  * So the TM extension of the picard operator must be evaluated via order k
- * TM arithmetic.
+ * TM arithmetic. See @ref picardStepTM for an implementation on top of TM
+ * arithmetic itself.
  * @pre The ODEs \p vectorField and \p functions may **not** be NULL.
  *
  * @param[in] vectorField The m-dimensional vector field f.
@@ -145,6 +192,67 @@ TaylorModel *picardOperator(ODEList *vectorField, TaylorModel *functions);
  */
 TaylorModel *picardOperatorTM(ODEList *vectorField, TaylorModel *functions);
 
+/**
+ * @brief Apply the Picard operator once, via order k TM arithmetic.
+ * @details Computes \f$ g_{j+1} = x_0 + \int_0^t f(g_j(s), s) ds \f$,
+ * where \p initial holds \f$ x_0 \f$ and \p functions holds \f$ g_j \f$.
+ * Unlike @ref picardOperatorTM, which builds ever larger symbolic trees,
+ * every step is order k TM arithmetic: the vector field is evaluated via
+ * @ref evaluateExpTreeTM, integrated via @ref primitiveTM and added to
+ * \p initial via @ref addTM. The like terms of the resulting polynomial parts
+ * are collected via @ref collectTM, so their size stays bounded by the number
+ * of monomials of order <= k, without losing the rounding of the collected
+ * coefficients.
+ * @pre \p system, \p initial, \p functions and \p variables may **not**
+ * be NULL. \p initial and \p functions must have one component per ODE, in
+ * the order of the \p system.
+ * @pre \p variables must contain a domain for every variable, including the
+ * time variable @ref VAR_TIME.
+ *
+ * @param[in] system    The m-dimensional vector field f.
+ * @param[in] initial   The initial states \f$ x_0 \f$, e.g. see
+ *                      @ref initTaylorModel.
+ * @param[in] functions The current iterate \f$ g_j \f$.
+ * @param[in] variables The mapping of expression variable to interval domain.
+ * @param[in] k         The Taylor polynomial order to adhere to.
+ * @return TaylorModel* A newly heap-allocated vector of Taylor models, the
+ * next iterate \f$ g_{j+1} \f$, or NULL if the vector field cannot be
+ * evaluated over \f$ g_j \f$, see @ref evaluateExpTreeTM.
+ */
+TaylorModel *picardStepTM(ODEList *system, TaylorModel *initial,
+                          TaylorModel *functions, const Domain *variables,
+                          unsigned int k);
+
+/**
+ * @brief Iterate the TM Picard operator until the polynomial parts of
+ * successive iterates agree.
+ * @details Starting from \f$ g_0 = \f$ \p initial, applies
+ * @ref picardStepTM until \f$ g_{j+1} \f$ and \f$ g_j \f$ have equal
+ * polynomial parts (up to @ref PICARD_TOLERANCE), or until \p maxIterations
+ * steps were taken. Every step fixes at least the next order of the Taylor
+ * expansion in t, so the polynomial parts stabilize after at most k + 1
+ * steps, and one more step detects it. This is a cheaper alternative to the
+ * Lie derivatives of @ref computeTaylorPolynomial for high dimensional
+ * systems, as there is no symbolic differentiation and no expression swell.
+ * @post The remainders are those of the TM arithmetic of the last step;
+ * they are **not** validated to enclose the true flow.
+ * @pre See @ref picardStepTM.
+ *
+ * @param[in]  system        The m-dimensional vector field f.
+ * @param[in]  initial       The initial states \f$ x_0 \f$.
+ * @param[in]  variables     The mapping of expression variable to interval
+ *                           domain.
+ * @param[in]  k             The Taylor polynomial order to adhere to.
+ * @param[in]  maxIterations The maximum number of Picard steps, > 0.
+ * @param[out] stats         If not NULL, receives the number of steps and
+ *                           whether the iteration converged.
+ * @return TaylorModel* A newly heap-allocated vector of Taylor models, the
+ * last iterate, or NULL if a step failed.
+ */
+TaylorModel *picardIterationTM(ODEList *system, TaylorModel *initial,
+                               const Domain *variables, unsigned int k,
+                               unsigned int maxIterations, PicardStats *stats);
+
 /**
  * @brief Substitute all of the variables in each ODE by the corresponding
  * functions. This operation is applied elementwise to the ODEs.
@@ -167,6 +275,17 @@ TaylorModel *picardOperatorTM(ODEList *vectorField, TaylorModel *functions);
  */
 TaylorModel *substituteTaylorModel(ODEList *system, TaylorModel *functions);
 
+/**
+ * @brief Parallel variant of @ref substituteTaylorModel.
+ * @details The substitutions into the individual system components are
+ * distributed over the \p pool. The output is identical to that of
+ * @ref substituteTaylorModel, including the component order.
+ * If \p pool is NULL, then the components are processed serially.
+ */
+TaylorModel *substituteTaylorModelParallel(ODEList *system,
+                                           TaylorModel *functions,
+                                           ThreadPool *pool);
+
 /**
  * @brief Construct the identity polynomial list.
  * @details The identity polynomial matches each of the ODEs' variables'
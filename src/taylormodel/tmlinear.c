@@ -0,0 +1,134 @@
+#include "tmlinear.h"
+
+IntervalMatrix *linearFlowMap(const LinearSystem *system,
+                              const Interval *const time,
+                              const unsigned int order) {
+  assert(system != NULL);
+  assert(time != NULL);
+
+  /* The augmented matrix [A b; 0 0] turns the affine system linear. */
+  const unsigned int dim = system->dim;
+  IntervalMatrix *augmented = newIntervalMatrix(dim + 1, dim + 1);
+  for (unsigned int row = 0; row < dim; ++row) {
+    for (unsigned int col = 0; col < dim; ++col)
+      *elemIntervalMatrix(augmented, row, col) =
+          system->matrix[row * dim + col];
+    *elemIntervalMatrix(augmented, row, dim) = system->offset[row];
+  }
+
+  /* The number of time steps, so that ||A|| h <= 1/2 where possible. */
+  Interval start = newInterval(time->left, time->left);
+  Interval end = newInterval(time->right, time->right);
+  Interval duration = subInterval(&end, &start);
+  double steps = ceil(2 * normIntervalMatrix(augmented) * duration.right);
+  steps = fmin(fmax(steps, 1), LINEAR_TIME_STEPS);
+
+  /* The step h = (t1 - t0) / steps is enclosed, and each piece [0, h] ends at
+    or after it, so the last one reaches t1. */
+  Interval count = newInterval(steps, steps);
+  Interval step = divInterval(&duration, &count);
+  Interval piece = newInterval(0, step.right);
+
+  IntervalMatrix *scaled = scaleIntervalMatrix(augmented, &start);
+  IntervalMatrix *current = expIntervalMatrix(scaled, order);
+  delIntervalMatrix(scaled);
+  scaled = scaleIntervalMatrix(augmented, &step);
+  IntervalMatrix *advance = expIntervalMatrix(scaled, order);
+  delIntervalMatrix(scaled);
+  scaled = scaleIntervalMatrix(augmented, &piece);
+  IntervalMatrix *within = expIntervalMatrix(scaled, order);
+  delIntervalMatrix(scaled);
+
+  /* Hull of E * Phi_k over all steps k. */
+  IntervalMatrix *flowMap = mulIntervalMatrix(within, current);
+  for (unsigned int it = 1; it < (unsigned int)steps; ++it) {
+    IntervalMatrix *next = mulIntervalMatrix(advance, current);
+    delIntervalMatrix(current);
+    current = next;
+
+    IntervalMatrix *enclosure = mulIntervalMatrix(within, current);
+    IntervalMatrix *hull = hullIntervalMatrix(flowMap, enclosure);
+    delIntervalMatrix(flowMap);
+    delIntervalMatrix(enclosure);
+    flowMap = hull;
+  }
+
+  /* Clean */
+  delIntervalMatrix(augmented);
+  delIntervalMatrix(current);
+  delIntervalMatrix(advance);
+  delIntervalMatrix(within);
+
+  return flowMap;
+}
+
+/* Split the interval into a representable point coefficient and the
+  interval deviation from that coefficient. */
+static double splitCoefficient(const Interval *coefficient, char *str,
+                               size_t size, Interval *deviation) {
+  dtoa(str, size, intervalMidpoint(coefficient));
+  /* The string may round the midpoint, so use the value it represents. */
+  double point = atof(str);
+  Interval center = newInterval(point, point);
+  *deviation = subInterval(coefficient, &center);
+  return point;
+}
+
+TaylorModel *linearFlowpipe(const LinearSystem *system,
+                            const IntervalMatrix *flowMap, const Domain *box) {
+  assert(system != NULL);
+  assert(flowMap != NULL);
+  assert(box != NULL);
+  assert(flowMap->rows == system->dim + 1);
+
+  const unsigned int dim = system->dim;
+  Interval *domains = (Interval *)malloc((dim + 1) * sizeof(Interval));
+  if (domains == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  for (unsigned int col = 0; col < dim; ++col) {
+    const Domain *dom = box;
+    while (dom != NULL && strcmp(dom->var, system->vars[col]) != 0)
+      dom = dom->next;
+    /* Every state variable needs a domain. */
+    assert(dom != NULL);
+    domains[col] = dom->domain;
+  }
+
+  /* Build the list back to front, so it ends up in the system's order. */
+  TaylorModel *flowpipe = NULL;
+  for (unsigned int row = dim; row > 0; --row) {
+    char str[50];
+    Interval deviation;
+    double constant = splitCoefficient(
+        elemIntervalMatrix(flowMap, row - 1, dim), str, sizeof(str),
+        &deviation);
+    ExpTree *poly = (constant != 0) ? newExpLeaf(EXP_NUM, str) : NULL;
+    Interval remainder = deviation;
+
+    for (unsigned int col = dim; col > 0; --col) {
+      double coefficient = splitCoefficient(
+          elemIntervalMatrix(flowMap, row - 1, col - 1), str, sizeof(str),
+          &deviation);
+      Interval error = mulInterval(&deviation, &domains[col - 1]);
+      remainder = addInterval(&remainder, &error);
+      if (coefficient == 0)
+        continue;
+
+      ExpTree *term = newExpOp(EXP_MUL_OP, newExpLeaf(EXP_NUM, str),
+                               newExpLeaf(EXP_VAR, system->vars[col - 1]));
+      poly = (poly == NULL) ? term : newExpOp(EXP_ADD_OP, term, poly);
+    }
+    if (poly == NULL)
+      poly = newExpLeaf(EXP_NUM, "0");
+
+    flowpipe =
+        newTMElem(flowpipe, strdup(system->vars[row - 1]), poly, remainder);
+  }
+
+  /* Clean */
+  free(domains);
+
+  return flowpipe;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file tmlinear.h
+ * @brief A fast path for affine systems of ODEs: Taylor models of their flow
+ * via an interval enclosure of the matrix exponential.
+ * @details The flow of \f$ \dot{x} = Ax + b \f$ is the affine map
+ * \f$ x(t) = \Phi(t) x(0) + \psi(t) \f$, where
+ * \f$ \begin{pmatrix} \Phi(t) & \psi(t) \\ 0 & 1 \end{pmatrix} =
+ * \exp\left(t \begin{pmatrix} A & b \\ 0 & 0 \end{pmatrix}\right) \f$.
+ * A single interval matrix exponential therefore yields the flow for every
+ * initial state at once, without any symbolic differentiation.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_LINEAR_H
+#define TM_LINEAR_H
+
+#include "interval.h"
+#include "intervalmatrix.h"
+#include "syslineq.h"
+#include "taylormodel.h"
+#include "variables.h"
+
+/// @brief The number of Taylor series terms of the matrix exponential.
+#define LINEAR_EXP_ORDER 12
+/// @brief The maximum number of time steps when enclosing the flow map over
+///        a time domain, see @ref linearFlowMap.
+#define LINEAR_TIME_STEPS 256
+
+/**
+ * @brief Enclose the flow map of an affine system over a time domain.
+ * @details Exponentiating \f$ A \cdot [t_0, t_1] \f$ directly suffers from
+ * the dependency problem, since every interval product treats the time in
+ * both factors as independent. Instead, the time domain is cut into N steps
+ * of length h, small enough for \f$ \|A\| h \le \frac{1}{2} \f$ (up to
+ * @ref LINEAR_TIME_STEPS steps). With the thin maps
+ * \f$ \Phi_k = e^{A(t_0 + kh)} \f$ and the short enclosure
+ * \f$ E = e^{A [0, h]} \f$, the flow map over the time domain is enclosed
+ * by the hull of all \f$ E \Phi_k \f$. The step h is enclosed with
+ * outward rounding and E spans up to its upper bound, so the last piece
+ * reaches \f$ t_1 \f$.
+ * @pre \p system and \p time may **not** be NULL.
+ *
+ * @param[in] system The affine system.
+ * @param[in] time   The time domain, e.g. [0, T].
+ * @param[in] order  The number of Taylor series terms, see
+ *                   @ref expIntervalMatrix.
+ * @return IntervalMatrix* A newly heap-allocated (dim+1) by (dim+1) matrix
+ * that encloses the augmented flow map
+ * \f$ \begin{pmatrix} \Phi(t) & \psi(t) \\ 0 & 1 \end{pmatrix} \f$ for
+ * every t in \p time.
+ */
+IntervalMatrix *linearFlowMap(const LinearSystem *system,
+                              const Interval *const time,
+                              const unsigned int order);
+
+/**
+ * @brief Construct the Taylor models of an affine flow over a box of
+ * initial states.
+ * @details The polynomial part of component i is the affine map
+ * \f$ \sum_j m_{ij} x_j + m_i \f$, with m the midpoints of the flow map.
+ * The remainder encloses the deviation of the flow map from its midpoints
+ * over the \p box, i.e. both the rounding of the exponential and the
+ * variation over the time domain.
+ * @pre All arguments must not be NULL, and \p box must contain a domain for
+ * every state variable of the \p system.
+ *
+ * @param[in] system  The affine system.
+ * @param[in] flowMap The augmented flow map, see @ref linearFlowMap.
+ * @param[in] box     The initial states.
+ * @return TaylorModel* A newly heap-allocated vector of Taylor models, in
+ * the order of the system's state variables.
+ */
+TaylorModel *linearFlowpipe(const LinearSystem *system,
+                            const IntervalMatrix *flowMap, const Domain *box);
+
+#endif
@@ -0,0 +1,334 @@
+#include "tmsplit.h"
+#include "tmcache.h"
+#include "trace.h"
+
+TaylorExpansion *newTaylorExpansion(ODEList *system, unsigned int order,
+                                    unsigned int k, ThreadPool *pool) {
+  assert(system != NULL);
+
+  TaylorExpansion *expansion =
+      (TaylorExpansion *)malloc(sizeof(TaylorExpansion));
+  if (expansion == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  expansion->order = order;
+  expansion->linear = newLinearSystem(system);
+  expansion->polynomials = NULL;
+  expansion->lagrangeTerms = NULL;
+  /* Affine systems need no symbolic expansion at all. */
+  if (expansion->linear != NULL)
+    return expansion;
+
+  /* The symbolic expansion only depends on the system and orders. */
+  TaylorExpansion *cached = loadCachedExpansion(system, order, k);
+  if (cached != NULL) {
+    free(expansion);
+    return cached;
+  }
+
+  TaylorModel *seed = initTaylorModel(system);
+  expansion->polynomials =
+      computeTaylorPolynomialParallel(system, order, k, pool);
+  expansion->lagrangeTerms =
+      lieDerivativeKParallel(system, seed, order + 1, pool);
+  /* Failing to cache the expansion only costs time in later runs. */
+  storeCachedExpansion(system, k, expansion);
+
+  /* Clean */
+  delTaylorModel(seed);
+
+  return expansion;
+}
+
+void delTaylorExpansion(TaylorExpansion *expansion) {
+  assert(expansion != NULL);
+
+  if (expansion->linear != NULL) {
+    delLinearSystem(expansion->linear);
+  } else {
+    delTaylorModel(expansion->polynomials);
+    delTaylorModel(expansion->lagrangeTerms);
+  }
+  free(expansion);
+}
+
+FlowpipeSegment *newFlowpipeSegment(Domain *domain, TaylorModel *flowpipe,
+                                    const unsigned int depth) {
+  assert(domain != NULL);
+  assert(flowpipe != NULL);
+
+  FlowpipeSegment *list = (FlowpipeSegment *)malloc(sizeof(FlowpipeSegment));
+  if (list == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  list->domain = domain;
+  list->flowpipe = flowpipe;
+  list->depth = depth;
+  list->next = NULL;
+  return list;
+}
+
+FlowpipeSegment *appFlowpipeSegmentElem(FlowpipeSegment *tail,
+                                        FlowpipeSegment *head) {
+  assert(head != NULL);
+  assert(head->next == NULL);
+
+  head->next = tail;
+  return head;
+}
+
+FlowpipeSegment *catFlowpipeSegments(FlowpipeSegment *first,
+                                     FlowpipeSegment *second) {
+  if (first == NULL)
+    return second;
+
+  FlowpipeSegment *last = first;
+  while (last->next != NULL)
+    last = last->next;
+  last->next = second;
+  return first;
+}
+
+unsigned int lengthFlowpipeSegment(const FlowpipeSegment *list) {
+  unsigned int length = 0;
+  for (; list != NULL; list = list->next)
+    ++length;
+  return length;
+}
+
+void delFlowpipeSegment(FlowpipeSegment *list) {
+  while (list != NULL) {
+    FlowpipeSegment *next = list->next;
+    delDomain(list->domain);
+    delTaylorModel(list->flowpipe);
+    free(list);
+    list = next;
+  }
+}
+
+void printFlowpipeSegment(const FlowpipeSegment *list, FILE *where) {
+  for (; list != NULL; list = list->next) {
+    printDomain(list->domain, where);
+    fprintf(where, "=> ");
+    printTaylorModel(list->flowpipe, where);
+    fprintf(where, "\n");
+  }
+}
+
+double widestRemainder(const TaylorModel *flowpipe) {
+  assert(flowpipe != NULL);
+
+  double widest = 0;
+  for (; flowpipe != NULL; flowpipe = flowpipe->next) {
+    double width = intervalWidth(&flowpipe->remainder);
+    if (width > widest)
+      widest = width;
+  }
+  return widest;
+}
+
+/* The state shared by all the boxes of one split flowpipe computation. */
+typedef struct SplitContext {
+  /* The Taylor polynomials, shared by all boxes. */
+  const TaylorModel *polynomials;
+  /* The order n+1 Lie derivatives of the state variables. */
+  const TaylorModel *lagrangeTerms;
+  /* T^{n+1} / (n+1)!, the time dependent factor of the remainder. */
+  Interval timeFactor;
+  /* The affine fast path, used instead of the above if set. */
+  const LinearSystem *linear;
+  const IntervalMatrix *flowMap;
+  /* The symbols that index the boxes, and the ID of the time variable. */
+  const SymbolTable *symbols;
+  unsigned int time;
+  double threshold;
+  unsigned int maxDepth;
+  SplitHeuristic heuristic;
+  ThreadPool *pool;
+} SplitContext;
+
+/* One box to process; the result is written back into the task. */
+typedef struct SplitTask {
+  const SplitContext *ctx;
+  IntervalBox *box;
+  unsigned int depth;
+  FlowpipeSegment *result;
+} SplitTask;
+
+/* Copy the shared polynomials and attach the remainders over the box. */
+static TaylorModel *boxFlowpipe(const SplitContext *ctx,
+                                const IntervalBox *box) {
+  TRACE_BEGIN(span, "boxRemainder");
+  if (ctx->linear != NULL) {
+    Domain *domain = fromIntervalBox(box, ctx->symbols);
+    TaylorModel *flowpipe = linearFlowpipe(ctx->linear, ctx->flowMap, domain);
+    delDomain(domain);
+    TRACE_END(span);
+    return flowpipe;
+  }
+
+  TaylorModel *flowpipe = cpyTaylorModel(ctx->polynomials);
+  TaylorModel *tm = flowpipe;
+  const TaylorModel *term = ctx->lagrangeTerms;
+  for (; tm != NULL; tm = tm->next, term = term->next) {
+    assert(term != NULL);
+    assert(strcmp(tm->fun, term->fun) == 0);
+
+    Interval bound = evaluateExpTreeBox(term->exp, ctx->symbols, box);
+    tm->remainder = mulInterval(&bound, &ctx->timeFactor);
+  }
+  assert(term == NULL);
+  TRACE_END(span);
+  return flowpipe;
+}
+
+static double boxRemainder(const SplitContext *ctx, const IntervalBox *box) {
+  TaylorModel *flowpipe = boxFlowpipe(ctx, box);
+  double widest = widestRemainder(flowpipe);
+  delTaylorModel(flowpipe);
+  return widest;
+}
+
+/* Choose the state variable to bisect, or SYMBOL_NOT_FOUND if the box cannot
+  be split any further. */
+static unsigned int splitDimension(const SplitContext *ctx,
+                                   const IntervalBox *box) {
+  unsigned int best = SYMBOL_NOT_FOUND;
+  double bestScore = 0;
+  for (unsigned int dim = 0; dim < box->dim; ++dim) {
+    double width = intervalWidth(&box->data[dim]);
+    if (dim == ctx->time || !(width > 0))
+      continue;
+
+    /* Lower scores are better. */
+    double score;
+    if (ctx->heuristic == SPLIT_WIDEST) {
+      score = -width;
+    } else {
+      IntervalBox *lower = bisectIntervalBox(box, dim, false);
+      IntervalBox *upper = bisectIntervalBox(box, dim, true);
+      score = fmax(boxRemainder(ctx, lower), boxRemainder(ctx, upper));
+      delIntervalBox(lower);
+      delIntervalBox(upper);
+    }
+
+    if (best == SYMBOL_NOT_FOUND || score < bestScore) {
+      best = dim;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+static FlowpipeSegment *splitBox(const SplitContext *ctx, IntervalBox *box,
+                                 unsigned int depth);
+
+static void runSplitTask(unsigned int index, void *context) {
+  SplitTask *tasks = (SplitTask *)context;
+  tasks[index].result =
+      splitBox(tasks[index].ctx, tasks[index].box, tasks[index].depth);
+}
+
+/* Turn the box into a segment, taking ownership of the box. */
+static FlowpipeSegment *boxSegment(const SplitContext *ctx, IntervalBox *box,
+                                   TaylorModel *flowpipe, unsigned int depth) {
+  Domain *domain = fromIntervalBox(box, ctx->symbols);
+  delIntervalBox(box);
+  return newFlowpipeSegment(domain, flowpipe, depth);
+}
+
+/* Compute the segments of the given box, taking ownership of the box. */
+static FlowpipeSegment *splitBox(const SplitContext *ctx, IntervalBox *box,
+                                 unsigned int depth) {
+  TaylorModel *flowpipe = boxFlowpipe(ctx, box);
+  if (depth >= ctx->maxDepth || widestRemainder(flowpipe) <= ctx->threshold)
+    return boxSegment(ctx, box, flowpipe, depth);
+
+  const unsigned int dim = splitDimension(ctx, box);
+  if (dim == SYMBOL_NOT_FOUND)
+    return boxSegment(ctx, box, flowpipe, depth);
+  delTaylorModel(flowpipe);
+
+  /* Both halves are independent tasks; nested tasks are spread over the
+    pool by work stealing. Each half writes its own slot, and the slots are
+    merged in order, which keeps the result deterministic. */
+  SplitTask halves[2] = {
+      {ctx, bisectIntervalBox(box, dim, false), depth + 1, NULL},
+      {ctx, bisectIntervalBox(box, dim, true), depth + 1, NULL},
+  };
+  delIntervalBox(box);
+  parallelFor(ctx->pool, 2, runSplitTask, halves);
+
+  return catFlowpipeSegments(halves[0].result, halves[1].result);
+}
+
+FlowpipeSegment *splitTaylorExpansion(const TaylorExpansion *expansion,
+                                      const Domain *domain, double threshold,
+                                      unsigned int maxDepth,
+                                      SplitHeuristic heuristic,
+                                      ThreadPool *pool) {
+  assert(expansion != NULL);
+  assert(domain != NULL);
+
+  /* The time domain determines the time dependent remainder factor. */
+  const Domain *time = domain;
+  while (time != NULL && strcmp(time->var, VAR_TIME) != 0)
+    time = time->next;
+  assert(time != NULL);
+
+  /* T^{n+1} / (n+1)!, dividing by each factor so it stays enclosed. */
+  Interval timeFactor = powInterval(&time->domain, expansion->order + 1);
+  for (unsigned int index = 2; index <= expansion->order + 1; ++index) {
+    Interval factor = newInterval(index, index);
+    timeFactor = divInterval(&timeFactor, &factor);
+  }
+
+  IntervalMatrix *flowMap = NULL;
+  if (expansion->linear != NULL)
+    flowMap = linearFlowMap(expansion->linear, &time->domain,
+                            LINEAR_EXP_ORDER);
+
+  /* The boxes are dense, indexed by the symbols of the domain. */
+  SymbolTable *symbols = newSymbolTable();
+  IntervalBox *box = toIntervalBox(domain, symbols);
+
+  SplitContext ctx = {
+      expansion->polynomials,
+      expansion->lagrangeTerms,
+      timeFactor,
+      expansion->linear,
+      flowMap,
+      symbols,
+      findSymbol(symbols, VAR_TIME),
+      threshold,
+      maxDepth,
+      heuristic,
+      pool,
+  };
+  FlowpipeSegment *segments = splitBox(&ctx, box, 0);
+
+  /* Clean */
+  if (flowMap != NULL)
+    delIntervalMatrix(flowMap);
+  delSymbolTable(symbols);
+
+  return segments;
+}
+
+FlowpipeSegment *computeSplitFlowpipe(ODEList *system, const Domain *domain,
+                                      unsigned int order, unsigned int k,
+                                      double threshold, unsigned int maxDepth,
+                                      SplitHeuristic heuristic,
+                                      ThreadPool *pool) {
+  TaylorExpansion *expansion = newTaylorExpansion(system, order, k, pool);
+  FlowpipeSegment *segments = splitTaylorExpansion(
+      expansion, domain, threshold, maxDepth, heuristic, pool);
+
+  /* Clean */
+  delTaylorExpansion(expansion);
+
+  return segments;
+}
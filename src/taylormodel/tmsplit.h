@@ -0,0 +1,228 @@
+/**
+ * @file tmsplit.h
+ * @brief Initial set splitting: compute independent flowpipes over
+ * sub-boxes of a wide initial Domain.
+ * @details The remainder of a Taylor model grows quickly with the width of
+ * the initial set. Bisecting the initial box and computing a flowpipe for
+ * each piece separately keeps the individual remainders small. The pieces
+ * are independent of each other, so they are computed in parallel on a
+ * thread pool.
+ *
+ * The Taylor polynomials themselves are symbolic in the state variables, so
+ * they are shared by all pieces; only the remainders depend on the box.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_SPLIT_H
+#define TM_SPLIT_H
+
+#include "interval.h"
+#include "intervalbox.h"
+#include "syslineq.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "threadpool.h"
+#include "tmflowpipe.h"
+#include "tmlinear.h"
+#include "variables.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief The heuristic that picks the dimension along which to bisect
+ * a box whose remainder is too wide.
+ */
+typedef enum SplitHeuristic {
+  /// @brief Bisect the state variable with the widest domain.
+  SPLIT_WIDEST,
+  /// @brief Bisect the state variable whose bisection shrinks the widest
+  ///        remainder the most. This costs two remainder evaluations per
+  ///        state variable, but adapts to the dynamics of the system.
+  SPLIT_SENSITIVE,
+} SplitHeuristic;
+
+/**
+ * @brief A collection of flowpipe pieces, as a linked list.
+ * @details Each segment covers one sub-box of the initial set. Together,
+ * the domains of the segments of a split cover the entire initial set.
+ *
+ * @invariant The members @ref FlowpipeSegment.domain and
+ * @ref FlowpipeSegment.flowpipe may never be NULL.
+ */
+typedef struct FlowpipeSegment {
+  /// @brief The sub-box of the initial set that this segment covers.
+  Domain *domain;
+  /// @brief The Taylor models over @ref FlowpipeSegment.domain.
+  TaylorModel *flowpipe;
+  /// @brief The number of bisections that produced the sub-box.
+  unsigned int depth;
+  /// @brief The next segment of the collection.
+  struct FlowpipeSegment *next;
+} FlowpipeSegment;
+
+/**
+ * @brief The part of a flowpipe computation that does not depend on the
+ * initial set.
+ * @details Computing it is the expensive, symbolic part of the pipeline, so
+ * it pays off to compute it once per system and reuse it for every initial
+ * set of that system.
+ *
+ * Affine systems take a fast path: their flow follows from a matrix
+ * exponential, see @ref linearFlowpipe, so no Lie derivatives are needed.
+ *
+ * @invariant Either @ref TaylorExpansion.linear is set, or the members
+ * @ref TaylorExpansion.polynomials and @ref TaylorExpansion.lagrangeTerms
+ * are, in which case they have the same components in the same order.
+ */
+typedef struct TaylorExpansion {
+  /// @brief The Taylor polynomials of the system, with zero remainders.
+  TaylorModel *polynomials;
+  /// @brief The order n+1 Lie derivatives of the state variables, which
+  ///        bound the truncation error of the order n polynomials.
+  TaylorModel *lagrangeTerms;
+  /// @brief The order n of the Taylor polynomials.
+  unsigned int order;
+  /// @brief The dense form of the system if it is affine, else NULL.
+  LinearSystem *linear;
+} TaylorExpansion;
+
+/**
+ * @brief Compute the Taylor expansion of a system of ODEs.
+ * @pre The ODEs \p system may **not** be NULL.
+ * @pre It must hold that 0 < \p order <= \p k.
+ *
+ * @param[in] system The system of ODEs whose flow to over-approximate.
+ * @param[in] order  The order of the Taylor polynomials.
+ * @param[in] k      The truncation order applied during TM arithmetic.
+ * @param[in] pool   The pool to compute the components on, or NULL.
+ * @return TaylorExpansion* A newly heap-allocated Taylor expansion.
+ */
+TaylorExpansion *newTaylorExpansion(ODEList *system, unsigned int order,
+                                    unsigned int k, ThreadPool *pool);
+
+/**
+ * @brief Deallocate the Taylor expansion.
+ */
+void delTaylorExpansion(TaylorExpansion *expansion);
+
+/**
+ * @brief Create a new, single element list.
+ * @pre Both \p domain and \p flowpipe may **not** be NULL and must be
+ * heap-allocated.
+ * @post Transfers ownership of all heap-allocated arguments to the
+ * newly created FlowpipeSegment instance.
+ *
+ * @param[in] domain   The sub-box of the initial set.
+ * @param[in] flowpipe The Taylor models over the sub-box.
+ * @param[in] depth    The number of bisections that produced the sub-box.
+ * @return FlowpipeSegment* A heap-allocated segment instance.
+ */
+FlowpipeSegment *newFlowpipeSegment(Domain *domain, TaylorModel *flowpipe,
+                                    const unsigned int depth);
+
+/**
+ * @brief Attach the second element as the head of the first list.
+ * @pre The \p head argument must be a single element list (not NULL).
+ * @pre The \p tail argument must be NULL or heap-allocated.
+ * @post Transfers ownership of \p tail to \p head.
+ *
+ * @return FlowpipeSegment* The \p head pointer, with the tail attached.
+ */
+FlowpipeSegment *appFlowpipeSegmentElem(FlowpipeSegment *tail,
+                                        FlowpipeSegment *head);
+
+/**
+ * @brief Append the second list to the end of the first list.
+ * @post Transfers ownership of \p second to \p first.
+ *
+ * @return FlowpipeSegment* The head of the concatenated list.
+ */
+FlowpipeSegment *catFlowpipeSegments(FlowpipeSegment *first,
+                                     FlowpipeSegment *second);
+
+/**
+ * @brief The number of segments in the list.
+ */
+unsigned int lengthFlowpipeSegment(const FlowpipeSegment *list);
+
+/**
+ * @brief Deallocate the entire list, including domains and flowpipes.
+ */
+void delFlowpipeSegment(FlowpipeSegment *list);
+
+/**
+ * @brief Print the list, one segment per line.
+ */
+void printFlowpipeSegment(const FlowpipeSegment *list, FILE *where);
+
+/**
+ * @brief The width of the widest remainder interval of the Taylor models.
+ * @pre \p flowpipe may **not** be NULL.
+ */
+double widestRemainder(const TaylorModel *flowpipe);
+
+/**
+ * @brief Compute flowpipes over the initial set, bisecting it until every
+ * piece has a sufficiently narrow remainder.
+ * @details For each box the remainder of every component is estimated via
+ * the Lagrange form of the truncation error,
+ * \f$ L_f^{n+1}(x_i)(B) \cdot \frac{T^{n+1}}{(n+1)!} \f$,
+ * where \f$ n \f$ is the order of the \p expansion, \f$ B \f$ the box and
+ * \f$ T \f$ the time domain. The Lie derivative is bounded over the box
+ * rather than over an enclosure of the flow, so this is an estimate that
+ * drives the splitting, not a validated remainder. For affine systems the
+ * Taylor models instead follow from an enclosure of the flow map over the
+ * time domain, see @ref linearFlowpipe.
+ *
+ * If the widest remainder exceeds \p threshold, then the box is bisected
+ * along the dimension chosen by the \p heuristic and both halves are
+ * processed recursively as independent tasks on the \p pool. The time
+ * variable @ref VAR_TIME is never split.
+ *
+ * The segments are ordered depth-first, lower half before upper half.
+ * This order only depends on the inputs, so the result is the same
+ * regardless of the pool size, or without a pool altogether.
+ * @pre \p expansion and \p domain may **not** be NULL.
+ * @pre \p domain must contain every state variable as well as
+ * @ref VAR_TIME.
+ *
+ * @param[in] expansion The Taylor expansion of the system of ODEs.
+ * @param[in] domain    The initial set, including the time domain.
+ * @param[in] threshold The widest remainder width a segment may have before
+ *                      it is bisected.
+ * @param[in] maxDepth  The maximum number of bisections of any segment; this
+ *                      bounds the number of segments to 2^maxDepth.
+ * @param[in] heuristic The choice of bisection dimension.
+ * @param[in] pool      The pool to compute the segments on, or NULL.
+ * @return FlowpipeSegment* A newly heap-allocated, ordered collection of
+ * segments that together cover the initial set.
+ */
+FlowpipeSegment *splitTaylorExpansion(const TaylorExpansion *expansion,
+                                      const Domain *domain, double threshold,
+                                      unsigned int maxDepth,
+                                      SplitHeuristic heuristic,
+                                      ThreadPool *pool);
+
+/**
+ * @brief Compute the Taylor expansion of a system of ODEs and split it over
+ * the initial set, see @ref newTaylorExpansion and
+ * @ref splitTaylorExpansion.
+ * @pre The ODEs \p system and \p domain may **not** be NULL.
+ * @pre \p domain must contain every state variable as well as
+ * @ref VAR_TIME.
+ * @pre It must hold that 0 < \p order <= \p k.
+ */
+FlowpipeSegment *computeSplitFlowpipe(ODEList *system, const Domain *domain,
+                                      unsigned int order, unsigned int k,
+                                      double threshold, unsigned int maxDepth,
+                                      SplitHeuristic heuristic,
+                                      ThreadPool *pool);
+
+#endif
@@ -0,0 +1,100 @@
+#include "tmsweep.h"
+#include "transformations.h"
+
+/* The number, as a tree that parses back to exactly the same value. */
+static ExpTree *newValueLeaf(const double value) {
+  char str[50];
+  snprintf(str, sizeof(str), "%.17g", fabs(value));
+  ExpTree *leaf = newExpLeaf(EXP_NUM, str);
+  return (value < 0) ? newExpOp(EXP_NEG, leaf, NULL) : leaf;
+}
+
+/* Bind the parameters of every Taylor model of the list, in place. */
+static void bindTaylorModel(TaylorModel *list, const Valuation *values) {
+  for (; list != NULL; list = list->next) {
+    for (const Valuation *value = values; value != NULL;
+         value = value->next) {
+      ExpTree *leaf = newValueLeaf(value->val);
+      ExpTree *bound = substitute(list->exp, value->var, leaf);
+      delExpTree(leaf);
+      delExpTree(list->exp);
+      list->exp = bound;
+    }
+  }
+}
+
+TaylorExpansion *bindTaylorExpansion(const TaylorExpansion *expansion,
+                                     const Valuation *values) {
+  assert(expansion != NULL);
+  assert(expansion->linear == NULL);
+
+  TaylorExpansion *bound = (TaylorExpansion *)malloc(sizeof(TaylorExpansion));
+  if (bound == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  bound->polynomials = cpyTaylorModel(expansion->polynomials);
+  bound->lagrangeTerms = cpyTaylorModel(expansion->lagrangeTerms);
+  bound->order = expansion->order;
+  bound->linear = NULL;
+  bindTaylorModel(bound->polynomials, values);
+  bindTaylorModel(bound->lagrangeTerms, values);
+  return bound;
+}
+
+/* The shared inputs and the output slots of a sweep. */
+typedef struct SweepContext {
+  const TaylorExpansion *expansion;
+  const Domain *domain;
+  Valuation *const *points;
+  double threshold;
+  unsigned int maxDepth;
+  SplitHeuristic heuristic;
+  ThreadPool *pool;
+  FlowpipeSegment **results;
+} SweepContext;
+
+static void runSweepPoint(unsigned int index, void *context) {
+  SweepContext *sweep = (SweepContext *)context;
+
+  /* An affine system has no parameters to bind. */
+  if (sweep->expansion->linear != NULL) {
+    sweep->results[index] = splitTaylorExpansion(
+        sweep->expansion, sweep->domain, sweep->threshold, sweep->maxDepth,
+        sweep->heuristic, sweep->pool);
+    return;
+  }
+
+  TaylorExpansion *bound =
+      bindTaylorExpansion(sweep->expansion, sweep->points[index]);
+  sweep->results[index] =
+      splitTaylorExpansion(bound, sweep->domain, sweep->threshold,
+                           sweep->maxDepth, sweep->heuristic, sweep->pool);
+
+  /* Clean */
+  delTaylorExpansion(bound);
+}
+
+FlowpipeSegment **sweepTaylorExpansion(const TaylorExpansion *expansion,
+                                       const Domain *domain,
+                                       Valuation *const *points,
+                                       const unsigned int count,
+                                       double threshold, unsigned int maxDepth,
+                                       SplitHeuristic heuristic,
+                                       ThreadPool *pool) {
+  assert(expansion != NULL);
+  assert(domain != NULL);
+  assert(points != NULL || count == 0);
+
+  FlowpipeSegment **results =
+      (FlowpipeSegment **)calloc(count + 1, sizeof(FlowpipeSegment *));
+  if (results == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+
+  SweepContext sweep = {expansion, domain,    points, threshold,
+                        maxDepth,  heuristic, pool,   results};
+  parallelFor(pool, count, runSweepPoint, &sweep);
+  return results;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file tmsweep.h
+ * @brief Parameter sweeps: compute the flowpipes of one parametric system
+ * for many parameter values.
+ * @details A parameter is a variable of the vector field that is neither a
+ * state variable nor time, see @ref parseOdeString. The Lie derivatives
+ * treat it as a constant, so the Taylor expansion of a parametric system is
+ * symbolic in its parameters and only needs to be computed once. Each
+ * sweep point then binds the parameters to numbers in a copy of that
+ * expansion, and splits it over the initial set as usual.
+ *
+ * The sweep points are independent of each other, so they are computed in
+ * parallel on a thread pool.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TM_SWEEP_H
+#define TM_SWEEP_H
+
+#include "sysode.h"
+#include "taylormodel.h"
+#include "threadpool.h"
+#include "tmsplit.h"
+#include "variables.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Bind the parameters of a Taylor expansion to values.
+ * @details Every occurrence of a parameter is replaced by its value.
+ * Variables without a value are left as they are.
+ * @pre \p expansion may **not** be NULL, nor affine. Affine expansions
+ * have no parameters, as parameters make a system non-affine.
+ *
+ * @param[in] expansion The Taylor expansion of a parametric system.
+ * @param[in] values    The values of the parameters, or NULL.
+ * @return TaylorExpansion* A newly heap-allocated Taylor expansion.
+ */
+TaylorExpansion *bindTaylorExpansion(const TaylorExpansion *expansion,
+                                     const Valuation *values);
+
+/**
+ * @brief Compute the flowpipe of a parametric system for each sweep point,
+ * see @ref splitTaylorExpansion.
+ * @details The points are distributed over the \p pool, and the pool is
+ * passed on to split each of them. The result of a point only depends on
+ * the inputs, so it is the same regardless of the pool size.
+ * @pre \p expansion and \p domain may **not** be NULL, nor \p points if
+ * \p count is positive.
+ * @pre \p domain must contain every state variable as well as
+ * @ref VAR_TIME, and every point must bind every parameter.
+ *
+ * @param[in] expansion The Taylor expansion of the parametric system.
+ * @param[in] domain    The initial set, including the time domain.
+ * @param[in] points    The parameter values of each sweep point.
+ * @param[in] count     The number of sweep points.
+ * @param[in] threshold The widest remainder width a segment may have before
+ *                      it is bisected.
+ * @param[in] maxDepth  The maximum number of bisections of any segment.
+ * @param[in] heuristic The choice of bisection dimension.
+ * @param[in] pool      The pool to compute the points on, or NULL.
+ * @return FlowpipeSegment** A newly heap-allocated array of \p count
+ * segment collections, one per point, each of which is heap-allocated too.
+ */
+FlowpipeSegment **sweepTaylorExpansion(const TaylorExpansion *expansion,
+                                       const Domain *domain,
+                                       Valuation *const *points,
+                                       const unsigned int count,
+                                       double threshold, unsigned int maxDepth,
+                                       SplitHeuristic heuristic,
+                                       ThreadPool *pool);
+
+#endif
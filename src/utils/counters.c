@@ -0,0 +1,168 @@
+#include "counters.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The counters of one thread. Only the owner writes them, so relaxed loads
+  and stores suffice: they compile to plain moves, yet concurrent reads are
+  no data races. */
+typedef struct CounterBlock {
+  _Atomic uint64_t counts[COUNTER_COUNT];
+  _Atomic uint64_t nanoseconds[COUNTER_COUNT];
+  struct CounterBlock *next;
+} CounterBlock;
+
+static const char *const counterNames[COUNTER_COUNT] = {
+    "nodesAllocated", "nodesFreed", "addTM",           "mulTM",
+    "divTM",          "powTM",      "intTM",           "truncateTM",
+    "truncatedTerms", "evaluateExpTree",
+};
+
+/* The blocks of the running threads, and the totals of exited threads. */
+static CounterBlock *liveBlocks = NULL;
+static CounterBlock retiredBlock;
+static pthread_mutex_t blocksLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t blockKey;
+static pthread_once_t blockKeyOnce = PTHREAD_ONCE_INIT;
+static _Thread_local CounterBlock *localBlock = NULL;
+
+bool countersEnabled(void) {
+#ifdef ENABLE_COUNTERS
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char *counterName(const Counter counter) {
+  assert(counter < COUNTER_COUNT);
+
+  return counterNames[counter];
+}
+
+static void bump(_Atomic uint64_t *counter, const uint64_t amount) {
+  atomic_store_explicit(
+      counter, atomic_load_explicit(counter, memory_order_relaxed) + amount,
+      memory_order_relaxed);
+}
+
+/* Merge the block of an exiting thread into the retired totals. */
+static void retireBlock(void *data) {
+  CounterBlock *block = (CounterBlock *)data;
+
+  pthread_mutex_lock(&blocksLock);
+  for (unsigned int it = 0; it < COUNTER_COUNT; ++it) {
+    bump(&retiredBlock.counts[it], block->counts[it]);
+    bump(&retiredBlock.nanoseconds[it], block->nanoseconds[it]);
+  }
+  CounterBlock **link = &liveBlocks;
+  while (*link != block)
+    link = &(*link)->next;
+  *link = block->next;
+  pthread_mutex_unlock(&blocksLock);
+
+  free(block);
+}
+
+static void createBlockKey(void) {
+  if (pthread_key_create(&blockKey, retireBlock) != 0) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+static CounterBlock *threadBlock(void) {
+  if (localBlock != NULL)
+    return localBlock;
+
+  pthread_once(&blockKeyOnce, createBlockKey);
+  CounterBlock *block = (CounterBlock *)calloc(1, sizeof(CounterBlock));
+  if (block == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  pthread_mutex_lock(&blocksLock);
+  block->next = liveBlocks;
+  liveBlocks = block;
+  pthread_mutex_unlock(&blocksLock);
+  pthread_setspecific(blockKey, block);
+
+  localBlock = block;
+  return block;
+}
+
+void countEvent(const Counter counter, const uint64_t amount) {
+  assert(counter < COUNTER_COUNT);
+
+  bump(&threadBlock()->counts[counter], amount);
+}
+
+uint64_t counterClock(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+void countTimedEvent(const Counter counter, const uint64_t start) {
+  assert(counter < COUNTER_COUNT);
+
+  const uint64_t elapsed = counterClock() - start;
+  CounterBlock *block = threadBlock();
+  bump(&block->counts[counter], 1);
+  bump(&block->nanoseconds[counter], elapsed);
+}
+
+void readCounters(CounterValue values[COUNTER_COUNT]) {
+  assert(values != NULL);
+
+  memset(values, 0, COUNTER_COUNT * sizeof(CounterValue));
+  pthread_mutex_lock(&blocksLock);
+  const CounterBlock *block = &retiredBlock;
+  for (const CounterBlock *next = liveBlocks; block != NULL;
+       block = next, next = (next != NULL) ? next->next : NULL) {
+    for (unsigned int it = 0; it < COUNTER_COUNT; ++it) {
+      values[it].count +=
+          atomic_load_explicit(&block->counts[it], memory_order_relaxed);
+      values[it].nanoseconds +=
+          atomic_load_explicit(&block->nanoseconds[it], memory_order_relaxed);
+    }
+  }
+  pthread_mutex_unlock(&blocksLock);
+}
+
+void resetCounters(void) {
+  pthread_mutex_lock(&blocksLock);
+  for (unsigned int it = 0; it < COUNTER_COUNT; ++it) {
+    atomic_store_explicit(&retiredBlock.counts[it], 0, memory_order_relaxed);
+    atomic_store_explicit(&retiredBlock.nanoseconds[it], 0,
+                          memory_order_relaxed);
+    for (CounterBlock *block = liveBlocks; block != NULL;
+         block = block->next) {
+      atomic_store_explicit(&block->counts[it], 0, memory_order_relaxed);
+      atomic_store_explicit(&block->nanoseconds[it], 0, memory_order_relaxed);
+    }
+  }
+  pthread_mutex_unlock(&blocksLock);
+}
+
+void printCounters(FILE *where) {
+  assert(where != NULL);
+
+  if (!countersEnabled()) {
+    fprintf(where, "counters disabled, build with ENABLE_COUNTERS\n");
+    return;
+  }
+
+  CounterValue values[COUNTER_COUNT];
+  readCounters(values);
+  for (unsigned int it = 0; it < COUNTER_COUNT; ++it) {
+    fprintf(where, "%-16s %12llu", counterNames[it],
+            (unsigned long long)values[it].count);
+    if (values[it].nanoseconds > 0)
+      fprintf(where, " %12.3f ms", 1e-6 * (double)values[it].nanoseconds);
+    fprintf(where, "\n");
+  }
+}
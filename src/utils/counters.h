@@ -0,0 +1,126 @@
+/**
+ * @file counters.h
+ * @brief Instrumentation counters of the hot paths: expression tree
+ * allocations, Taylor model operations, truncation and evaluation.
+ * @details The counters tell where the time of a slow run goes, e.g. tree
+ * blow-up, remainder bounding or truncation. They are only compiled in if
+ * ENABLE_COUNTERS is defined, see the 'counters' build option. Otherwise the
+ * @ref COUNT_EVENT, @ref COUNT_START and @ref COUNT_STOP macros expand to
+ * nothing, so the hot paths pay nothing, and all counters read as zero.
+ *
+ * Every thread counts into a block of its own, without locks or atomic
+ * read-modify-writes. Reading the counters merges the blocks of all
+ * threads, including those that have exited.
+ *
+ * The time of a Taylor model operation is inclusive: it contains the time
+ * of the operations it calls, e.g. a multiplication contains the time of
+ * its truncation.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief The instrumented events.
+ */
+typedef enum Counter {
+  COUNTER_NODES_ALLOCATED, ///< Expression tree nodes allocated.
+  COUNTER_NODES_FREED,     ///< Expression tree nodes freed.
+  COUNTER_ADD_TM,          ///< Component additions, see @ref addTM.
+  COUNTER_MUL_TM,          ///< Component multiplications, see @ref mulTM.
+  COUNTER_DIV_TM,          ///< Component divisions, see @ref divTM.
+  COUNTER_POW_TM,          ///< Exponentiations, see @ref powTM.
+  COUNTER_INT_TM,          ///< Component integrations, see @ref intTM.
+  COUNTER_TRUNCATE_TM,     ///< Component truncations, see @ref truncateTM.
+  COUNTER_TRUNCATED_TERMS, ///< Terms dropped by @ref truncateTerms.
+  COUNTER_EVALUATE,        ///< Calls of @ref evaluateExpTree.
+  COUNTER_COUNT,           ///< The number of counters.
+} Counter;
+
+/**
+ * @brief The merged value of a counter.
+ */
+typedef struct CounterValue {
+  /// @brief The number of events.
+  uint64_t count;
+  /// @brief The cumulative time of the events in nanoseconds, if they are
+  ///        timed.
+  uint64_t nanoseconds;
+} CounterValue;
+
+#ifdef ENABLE_COUNTERS
+/// @brief Count \p amount events of \p counter.
+#define COUNT_EVENT(counter, amount) countEvent((counter), (amount))
+/// @brief Start timing an event, into the new variable \p start.
+#define COUNT_START(start) const uint64_t start = counterClock()
+/// @brief Count an event of \p counter, timed since \p start.
+#define COUNT_STOP(counter, start) countTimedEvent((counter), (start))
+#else
+#define COUNT_EVENT(counter, amount) ((void)0)
+#define COUNT_START(start) ((void)0)
+#define COUNT_STOP(counter, start) ((void)0)
+#endif
+
+/**
+ * @brief Whether the counters are compiled in.
+ */
+bool countersEnabled(void);
+
+/**
+ * @brief The name of a counter, e.g. "mulTM".
+ * @pre \p counter must be less than @ref COUNTER_COUNT.
+ */
+const char *counterName(const Counter counter);
+
+/**
+ * @brief Count events on the calling thread.
+ * @details Prefer the @ref COUNT_EVENT macro, which compiles away.
+ */
+void countEvent(const Counter counter, const uint64_t amount);
+
+/**
+ * @brief The current time in nanoseconds, to start timing an event.
+ * @details Prefer the @ref COUNT_START macro, which compiles away.
+ */
+uint64_t counterClock(void);
+
+/**
+ * @brief Count one event on the calling thread, with the time since
+ * \p start.
+ * @details Prefer the @ref COUNT_STOP macro, which compiles away.
+ */
+void countTimedEvent(const Counter counter, const uint64_t start);
+
+/**
+ * @brief Read the counters, merged over all threads.
+ * @details Events counted concurrently with the read may or may not be
+ * included.
+ * @pre \p values may **not** be NULL.
+ *
+ * @param[out] values The value of every counter, by @ref Counter.
+ */
+void readCounters(CounterValue values[COUNTER_COUNT]);
+
+/**
+ * @brief Reset all counters of all threads to zero.
+ * @details Not thread-safe w.r.t. counting: events counted concurrently
+ * may survive the reset.
+ */
+void resetCounters(void);
+
+/**
+ * @brief Print the merged counters, one per line, e.g. "mulTM 12 3.4 ms".
+ * @pre \p where may **not** be NULL.
+ */
+void printCounters(FILE *where);
+
+#endif
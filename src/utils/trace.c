@@ -0,0 +1,170 @@
+#include "trace.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TRACE_UNKNOWN 0
+#define TRACE_OFF 1
+#define TRACE_ON 2
+
+/* A closed span. */
+typedef struct TraceEvent {
+  const char *name;
+  const char *argName;
+  long long arg;
+  uint64_t start;
+  uint64_t duration;
+} TraceEvent;
+
+/* The spans recorded by one thread. The owner appends under the lock, which
+  is only ever contended while writing the trace. Blocks outlive their
+  threads, so that their spans are still written. */
+typedef struct TraceBlock {
+  pthread_mutex_t lock;
+  unsigned int tid;
+  TraceEvent *events;
+  size_t length;
+  size_t capacity;
+  struct TraceBlock *next;
+} TraceBlock;
+
+_Atomic int traceState = TRACE_UNKNOWN;
+
+static pthread_once_t traceOnce = PTHREAD_ONCE_INIT;
+static uint64_t traceOrigin;
+static const char *tracePath = NULL;
+static TraceBlock *traceBlocks = NULL;
+static unsigned int traceThreads = 0;
+static pthread_mutex_t blocksLock = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local TraceBlock *localBlock = NULL;
+
+static uint64_t traceClock(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/* Write the trace to the file named by the environment, at exit. */
+static void writeTraceFile(void) {
+  FILE *file = fopen(tracePath, "w");
+  if (file == NULL) {
+    fprintf(stderr, "Cannot write the trace to %s\n", tracePath);
+    return;
+  }
+  writeTrace(file);
+  fclose(file);
+}
+
+static void readTraceEnv(void) {
+  traceOrigin = traceClock();
+  tracePath = getenv(TRACE_ENV);
+  if (tracePath != NULL && tracePath[0] != '\0') {
+    atexit(writeTraceFile);
+    atomic_store(&traceState, TRACE_ON);
+  } else {
+    tracePath = NULL;
+    atomic_store(&traceState, TRACE_OFF);
+  }
+}
+
+bool initTrace(void) {
+  pthread_once(&traceOnce, readTraceEnv);
+  return atomic_load(&traceState) == TRACE_ON;
+}
+
+void setTraceEnabled(const bool enabled) {
+  pthread_once(&traceOnce, readTraceEnv);
+  atomic_store(&traceState, enabled ? TRACE_ON : TRACE_OFF);
+}
+
+static TraceBlock *threadBlock(void) {
+  if (localBlock != NULL)
+    return localBlock;
+
+  TraceBlock *block = (TraceBlock *)calloc(1, sizeof(TraceBlock));
+  if (block == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  pthread_mutex_init(&block->lock, NULL);
+  pthread_mutex_lock(&blocksLock);
+  block->tid = ++traceThreads;
+  block->next = traceBlocks;
+  traceBlocks = block;
+  pthread_mutex_unlock(&blocksLock);
+
+  localBlock = block;
+  return block;
+}
+
+void openTraceSpan(TraceSpan *span) {
+  assert(span != NULL && span->name != NULL);
+
+  span->open = true;
+  span->start = traceClock();
+}
+
+void closeTraceSpan(TraceSpan *span) {
+  assert(span != NULL && span->open);
+
+  const uint64_t end = traceClock();
+  span->open = false;
+
+  TraceBlock *block = threadBlock();
+  pthread_mutex_lock(&block->lock);
+  if (block->length == block->capacity) {
+    block->capacity = (block->capacity > 0) ? 2 * block->capacity : 256;
+    block->events = (TraceEvent *)realloc(
+        block->events, block->capacity * sizeof(TraceEvent));
+    if (block->events == NULL) {
+      fprintf(stderr, "Memory allocation error\n");
+      exit(EXIT_FAILURE);
+    }
+  }
+  TraceEvent *event = &block->events[block->length++];
+  event->name = span->name;
+  event->argName = span->argName;
+  event->arg = span->arg;
+  event->start = span->start;
+  event->duration = end - span->start;
+  pthread_mutex_unlock(&block->lock);
+}
+
+void writeTrace(FILE *where) {
+  assert(where != NULL);
+
+  fprintf(where, "{\"traceEvents\":[");
+  bool first = true;
+  pthread_mutex_lock(&blocksLock);
+  for (TraceBlock *block = traceBlocks; block != NULL; block = block->next) {
+    pthread_mutex_lock(&block->lock);
+    for (size_t it = 0; it < block->length; ++it) {
+      const TraceEvent *event = &block->events[it];
+      /* Timestamps and durations are in microseconds. */
+      fprintf(where,
+              "%s\n{\"name\":\"%s\",\"cat\":\"hybberish\",\"ph\":\"X\","
+              "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u",
+              first ? "" : ",", event->name,
+              1e-3 * (double)(event->start - traceOrigin),
+              1e-3 * (double)event->duration, block->tid);
+      if (event->argName != NULL)
+        fprintf(where, ",\"args\":{\"%s\":%lld}", event->argName, event->arg);
+      fprintf(where, "}");
+      first = false;
+    }
+    pthread_mutex_unlock(&block->lock);
+  }
+  pthread_mutex_unlock(&blocksLock);
+  fprintf(where, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+void clearTrace(void) {
+  pthread_mutex_lock(&blocksLock);
+  for (TraceBlock *block = traceBlocks; block != NULL; block = block->next) {
+    pthread_mutex_lock(&block->lock);
+    block->length = 0;
+    pthread_mutex_unlock(&block->lock);
+  }
+  pthread_mutex_unlock(&blocksLock);
+}
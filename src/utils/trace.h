@@ -0,0 +1,121 @@
+/**
+ * @file trace.h
+ * @brief Scoped trace spans of the pipeline stages, written as Chrome trace
+ * event JSON.
+ * @details A span times one stage, e.g. parsing, a Lie derivative or a Taylor
+ * model operation, on the calling thread. The spans of all threads are
+ * written as "complete" events of the Chrome trace event format, which
+ * Perfetto and about:tracing display as one track per thread.
+ *
+ * Tracing is off unless the environment variable @ref TRACE_ENV names an
+ * output file, e.g. HYBBERISH_TRACE=trace.json. Then every span is recorded
+ * and the file is written when the process exits. When tracing is off, a
+ * span costs a single load and branch.
+ *
+ * Spans belong at the level of whole operations, e.g. one per Taylor model
+ * vector operation, not inside per-component recursion.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/// @brief The environment variable naming the trace output file.
+#define TRACE_ENV "HYBBERISH_TRACE"
+
+/**
+ * @brief An open span.
+ * @details Only the macros and functions of this module should access the
+ * fields.
+ */
+typedef struct TraceSpan {
+  /// @brief The name of the stage, a string literal.
+  const char *name;
+  /// @brief The name of the integer argument, a string literal, or NULL.
+  const char *argName;
+  /// @brief The integer argument, e.g. the order of a Lie derivative.
+  long long arg;
+  /// @brief The start time, in nanoseconds.
+  uint64_t start;
+  /// @brief Whether the span is recorded when it closes.
+  bool open;
+} TraceSpan;
+
+/// @brief Open the span \p span of the stage \p name.
+#define TRACE_BEGIN(span, name) TraceSpan span = traceBegin((name), NULL, 0)
+/// @brief Open the span \p span of the stage \p name, with an integer
+///        argument.
+#define TRACE_BEGIN_ARG(span, name, argName, arg)                              \
+  TraceSpan span = traceBegin((name), (argName), (arg))
+/// @brief Close the span \p span, opened by @ref TRACE_BEGIN.
+#define TRACE_END(span) traceEnd(&(span))
+
+/* Internal: whether tracing is unknown (0), off (1) or on (2). */
+extern _Atomic int traceState;
+
+/* Internal: decide whether to trace, from the environment. */
+bool initTrace(void);
+
+/* Internal: record the opening and closing of a span. */
+void openTraceSpan(TraceSpan *span);
+void closeTraceSpan(TraceSpan *span);
+
+/**
+ * @brief Whether spans are recorded.
+ */
+static inline bool traceEnabled(void) {
+  const int state = atomic_load_explicit(&traceState, memory_order_relaxed);
+  return (state == 0) ? initTrace() : state == 2;
+}
+
+/**
+ * @brief Open a span. Prefer the @ref TRACE_BEGIN macro.
+ * @pre \p name and \p argName must outlive the process' trace, e.g. be
+ * string literals. They are written unescaped.
+ */
+static inline TraceSpan traceBegin(const char *name, const char *argName,
+                                   const long long arg) {
+  TraceSpan span = {name, argName, arg, 0, false};
+  if (traceEnabled())
+    openTraceSpan(&span);
+  return span;
+}
+
+/**
+ * @brief Close a span. Prefer the @ref TRACE_END macro.
+ * @pre Spans must be closed in the reverse order of opening, on the thread
+ * that opened them.
+ */
+static inline void traceEnd(TraceSpan *span) {
+  if (span->open)
+    closeTraceSpan(span);
+}
+
+/**
+ * @brief Turn recording on or off, regardless of the environment.
+ * @details Spans that are open when recording is turned on are not recorded.
+ */
+void setTraceEnabled(const bool enabled);
+
+/**
+ * @brief Write the spans recorded by all threads so far, as Chrome trace
+ * event JSON.
+ * @pre \p where may **not** be NULL.
+ */
+void writeTrace(FILE *where);
+
+/**
+ * @brief Forget the spans recorded by all threads so far.
+ */
+void clearTrace(void);
+
+#endif
@@ -1,4 +1,7 @@
 #include "utils.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 void dtoa(char *const destination, const size_t size, const double value) {
   snprintf(destination, size, "%.15g", value);
@@ -15,3 +18,39 @@ unsigned int atou(const char *const source) {
   assert(integer >= 0);
   return (unsigned int)integer;
 }
+
+/* The size of the mapping of a file of the given size. */
+static size_t mappedSize(const size_t length, const size_t padding) {
+  const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  return (length + padding + page - 1) / page * page;
+}
+
+char *mapFile(const int fd, const size_t padding, size_t *length) {
+  assert(length != NULL);
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+    return NULL;
+  *length = (size_t)info.st_size;
+
+  /* The tail of the last page of a file is zero, but the padding may not
+    fit in it. So reserve zero pages for the whole range first, and map the
+    file over their start. */
+  const size_t size = mappedSize(*length, padding);
+  char *data = (char *)mmap(NULL, size, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (data == MAP_FAILED)
+    return NULL;
+  if (*length > 0 &&
+      mmap(data, *length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+           0) == MAP_FAILED) {
+    munmap(data, size);
+    return NULL;
+  }
+  return data;
+}
+
+void unmapFile(char *data, const size_t length, const size_t padding) {
+  if (data != NULL)
+    munmap(data, mappedSize(length, padding));
+}
@@ -40,3 +40,28 @@ void utoa(char *const destination, const size_t size, const unsigned int value);
  * @return unsigned int
  */
 unsigned int atou(const char *const source);
+
+/**
+ * @brief Map a regular file into memory, followed by zero bytes.
+ * @details The mapping is private and writable: writes are never carried
+ * through to the file, and only the pages that are written to are copied.
+ * The \p padding bytes after the contents are all 0, e.g. to terminate the
+ * contents as a string. Release the mapping with @ref unmapFile.
+ * @pre \p length must **not** be NULL.
+ *
+ * @param[in]  fd      A file descriptor open for reading.
+ * @param[in]  padding The number of zero bytes after the contents.
+ * @param[out] length  The size of the contents, without the padding.
+ * @return char* The mapped contents, or NULL if \p fd is not a regular
+ * file or cannot be mapped.
+ */
+char *mapFile(const int fd, const size_t padding, size_t *length);
+
+/**
+ * @brief Release a mapping of @ref mapFile.
+ *
+ * @param[in] data    The mapped contents.
+ * @param[in] length  The size of the contents, as returned by @ref mapFile.
+ * @param[in] padding The padding, as passed to @ref mapFile.
+ */
+void unmapFile(char *data, const size_t length, const size_t padding);
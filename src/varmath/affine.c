@@ -0,0 +1,247 @@
+#include "affine.h"
+
+/* A form with all coefficients 0; the center and error are left to the
+  caller. */
+static AffineForm *allocAffineForm(const unsigned int length) {
+  AffineForm *form = (AffineForm *)malloc(sizeof(AffineForm));
+  double *coefs = (double *)calloc(length > 0 ? length : 1, sizeof(double));
+  if (form == NULL || coefs == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  form->center = 0;
+  form->length = length;
+  form->coefs = coefs;
+  form->error = 0;
+  return form;
+}
+
+/* x + y, rounded upward; the rounding error is added to the error radius.
+  Must run inside an outward rounding scope. */
+static double sumRounded(const double x, const double y, double *error) {
+  double upper = x + y;
+  double lower = -((-x) - y);
+  *error += upper - lower;
+  return upper;
+}
+
+/* x * y, rounded upward; the rounding error is added to the error radius.
+  Must run inside an outward rounding scope. */
+static double prodRounded(const double x, const double y, double *error) {
+  double upper = x * y;
+  double lower = -((-x) * y);
+  *error += upper - lower;
+  return upper;
+}
+
+/* The total deviation sum |x_i| + e, rounded upward. Must run inside an
+  outward rounding scope. */
+static double radiusAffineForm(const AffineForm *const form) {
+  double radius = form->error;
+  for (unsigned int it = 0; it < form->length; ++it)
+    radius += fabs(form->coefs[it]);
+  return radius;
+}
+
+AffineForm *newAffineForm(const Interval *const range,
+                          const unsigned int length) {
+  assert(range != NULL);
+
+  AffineForm *form = allocAffineForm(length);
+  beginOutwardRounding();
+  form->center = 0.5 * range->left + 0.5 * range->right;
+  form->error = fmax(range->right - form->center, form->center - range->left);
+  endOutwardRounding();
+  return form;
+}
+
+AffineForm *newAffineVariable(const Interval *const domain,
+                              const unsigned int symbol,
+                              const unsigned int length) {
+  assert(symbol < length);
+
+  /* Move the radius from the error to the noise symbol of the variable. */
+  AffineForm *form = newAffineForm(domain, length);
+  form->coefs[symbol] = form->error;
+  form->error = 0;
+  return form;
+}
+
+AffineForm *cpyAffineForm(const AffineForm *const source) {
+  assert(source != NULL);
+
+  AffineForm *form = allocAffineForm(source->length);
+  form->center = source->center;
+  memcpy(form->coefs, source->coefs, source->length * sizeof(double));
+  form->error = source->error;
+  return form;
+}
+
+void delAffineForm(AffineForm *form) {
+  assert(form != NULL);
+  free(form->coefs);
+  free(form);
+}
+
+void printAffineForm(const AffineForm *const form, FILE *where) {
+  assert(form != NULL);
+  assert(where != NULL);
+
+  fprintf(where, "%f", form->center);
+  for (unsigned int it = 0; it < form->length; ++it)
+    if (form->coefs[it] != 0)
+      fprintf(where, " %c %fe%u", form->coefs[it] < 0 ? '-' : '+',
+              fabs(form->coefs[it]), it);
+  fprintf(where, " + [%f, %f]", -form->error, form->error);
+}
+
+Interval rangeAffineForm(const AffineForm *const form) {
+  assert(form != NULL);
+
+  beginOutwardRounding();
+  double radius = radiusAffineForm(form);
+  Interval range = newInterval(-(radius - form->center), form->center + radius);
+  endOutwardRounding();
+  return range;
+}
+
+AffineForm *addAffineForm(const AffineForm *const left,
+                          const AffineForm *const right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->length == right->length);
+
+  /* (a0 + sum ai ei + A) + (b0 + sum bi ei + B)
+  = (a0 + b0) + sum (ai + bi) ei + (A + B) */
+  AffineForm *sum = allocAffineForm(left->length);
+  double error = 0;
+  beginOutwardRounding();
+  sum->center = sumRounded(left->center, right->center, &error);
+  for (unsigned int it = 0; it < left->length; ++it)
+    sum->coefs[it] = sumRounded(left->coefs[it], right->coefs[it], &error);
+  sum->error = error + left->error + right->error;
+  endOutwardRounding();
+  return sum;
+}
+
+AffineForm *subAffineForm(const AffineForm *const left,
+                          const AffineForm *const right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->length == right->length);
+
+  /* (a0 + sum ai ei + A) - (b0 + sum bi ei + B)
+  = (a0 - b0) + sum (ai - bi) ei + (A + B) */
+  AffineForm *difference = allocAffineForm(left->length);
+  double error = 0;
+  beginOutwardRounding();
+  difference->center = sumRounded(left->center, -right->center, &error);
+  for (unsigned int it = 0; it < left->length; ++it)
+    difference->coefs[it] =
+        sumRounded(left->coefs[it], -right->coefs[it], &error);
+  difference->error = error + left->error + right->error;
+  endOutwardRounding();
+  return difference;
+}
+
+AffineForm *negAffineForm(const AffineForm *const source) {
+  assert(source != NULL);
+
+  AffineForm *negated = allocAffineForm(source->length);
+  negated->center = -source->center;
+  for (unsigned int it = 0; it < source->length; ++it)
+    negated->coefs[it] = -source->coefs[it];
+  negated->error = source->error;
+  return negated;
+}
+
+AffineForm *mulAffineForm(const AffineForm *const left,
+                          const AffineForm *const right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->length == right->length);
+
+  /* (a0 + La + A) * (b0 + Lb + B)
+  = a0 b0 + (a0 Lb + b0 La) + (a0 B + b0 A) + (La + A)(Lb + B)
+  where the last term is at most rad(a) * rad(b) in absolute value. */
+  AffineForm *product = allocAffineForm(left->length);
+  double error = 0;
+  beginOutwardRounding();
+  product->center = prodRounded(left->center, right->center, &error);
+  for (unsigned int it = 0; it < left->length; ++it)
+    product->coefs[it] =
+        sumRounded(prodRounded(left->center, right->coefs[it], &error),
+                   prodRounded(right->center, left->coefs[it], &error),
+                   &error);
+  error += fabs(left->center) * right->error;
+  error += fabs(right->center) * left->error;
+  error += radiusAffineForm(left) * radiusAffineForm(right);
+  product->error = error;
+  endOutwardRounding();
+  return product;
+}
+
+AffineForm *divAffineForm(const AffineForm *const left,
+                          const AffineForm *const right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->length == right->length);
+
+  Interval one = newInterval(1, 1);
+  Interval divisor = rangeAffineForm(right);
+  Interval inverse = divInterval(&one, &divisor);
+  AffineForm *reciprocal = newAffineForm(&inverse, left->length);
+  AffineForm *quotient = mulAffineForm(left, reciprocal);
+
+  /* Clean */
+  delAffineForm(reciprocal);
+
+  return quotient;
+}
+
+/* The square of the form, which is never negative:
+  (a0 + L + A)^2 = a0^2 + 2 a0 L + 2 a0 A + (L + A)^2
+  where (L + A)^2 lies in [0, rad^2], so it is centered at rad^2 / 2. */
+static AffineForm *sqrAffineForm(const AffineForm *const source) {
+  AffineForm *square = allocAffineForm(source->length);
+  double error = 0;
+  beginOutwardRounding();
+  double half = 0.5 * (radiusAffineForm(source) * radiusAffineForm(source));
+  square->center =
+      sumRounded(prodRounded(source->center, source->center, &error), half,
+                 &error);
+  for (unsigned int it = 0; it < source->length; ++it)
+    square->coefs[it] =
+        prodRounded(2 * source->center, source->coefs[it], &error);
+  error += fabs(2 * source->center) * source->error;
+  square->error = error + half;
+  endOutwardRounding();
+  return square;
+}
+
+AffineForm *pow2AffineForm(const AffineForm *const source,
+                           const unsigned int exponent) {
+  assert(source != NULL);
+
+  /* Exponentiation by squaring, so that every even power is a square. */
+  Interval one = newInterval(1, 1);
+  AffineForm *result = newAffineForm(&one, source->length);
+  AffineForm *base = cpyAffineForm(source);
+  for (unsigned int it = exponent; it > 0; it /= 2) {
+    if (it % 2 == 1) {
+      AffineForm *product = mulAffineForm(result, base);
+      delAffineForm(result);
+      result = product;
+    }
+    if (it > 1) {
+      AffineForm *square = sqrAffineForm(base);
+      delAffineForm(base);
+      base = square;
+    }
+  }
+
+  /* Clean */
+  delAffineForm(base);
+
+  return result;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file affine.h
+ * @brief Affine arithmetic, a range bounder that tracks linear dependencies.
+ * @details Interval arithmetic forgets where a value came from: x - x over
+ * [-1, 1] evaluates to [-2, 2] instead of [0, 0]. An @ref AffineForm
+ * represents a value as
+ * \f$ x_0 + \sum_i x_i \varepsilon_i + [-e, e] \f$, with one noise symbol
+ * \f$ \varepsilon_i \in [-1, 1] \f$ per input variable. Linear operations
+ * are exact on forms, so correlated terms cancel. Nonlinear parts and
+ * rounding errors are bounded into the error radius e.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef AFFINE_H
+#define AFFINE_H
+
+#include "interval.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief An affine form
+ * \f$ x_0 + \sum_{i < length} x_i \varepsilon_i + [-e, e] \f$.
+ * @details All operations round outward, so the form encloses every value
+ * of the exact computation, see @ref beginOutwardRounding.
+ *
+ * @invariant The error radius is non-negative.
+ */
+typedef struct AffineForm {
+  /// @brief The central value \f$ x_0 \f$.
+  double center;
+  /// @brief The number of noise symbols.
+  unsigned int length;
+  /// @brief The partial deviation \f$ x_i \f$ of each noise symbol.
+  double *coefs;
+  /// @brief The radius e of the accumulated nonlinear and rounding error.
+  double error;
+} AffineForm;
+
+/**
+ * @brief Create a form that encloses the interval, without any dependency.
+ * @details Constants, and ranges that are bounded by other means, enter an
+ * affine computation this way.
+ * @pre \p range may **not** be NULL.
+ *
+ * @param[in] range  The interval to enclose.
+ * @param[in] length The number of noise symbols.
+ * @return AffineForm* A heap-allocated form with all coefficients 0.
+ */
+AffineForm *newAffineForm(const Interval *const range,
+                          const unsigned int length);
+
+/**
+ * @brief Create the form of an input variable with the given domain.
+ * @details The variable depends on its own noise symbol only:
+ * \f$ mid(D) + rad(D) \varepsilon_{symbol} \f$.
+ * @pre \p domain may **not** be NULL and \p symbol must be less than
+ * \p length.
+ *
+ * @param[in] domain The domain of the variable.
+ * @param[in] symbol The noise symbol of the variable.
+ * @param[in] length The number of noise symbols.
+ * @return AffineForm* A heap-allocated form.
+ */
+AffineForm *newAffineVariable(const Interval *const domain,
+                              const unsigned int symbol,
+                              const unsigned int length);
+
+/**
+ * @brief Create a copy of the given form.
+ * @pre \p source may **not** be NULL.
+ */
+AffineForm *cpyAffineForm(const AffineForm *const source);
+
+/**
+ * @brief Deallocate the given form.
+ * @pre \p form may **not** be NULL.
+ */
+void delAffineForm(AffineForm *form);
+
+/**
+ * @brief Print the form, e.g. "1 + 0.5e0 - 2e1 + [-0.1, 0.1]".
+ * @pre Both arguments must not be NULL.
+ */
+void printAffineForm(const AffineForm *const form, FILE *where);
+
+/**
+ * @brief The range of the form, i.e. the interval of all values it can take.
+ * @pre \p form may **not** be NULL.
+ *
+ * @return Interval \f$ x_0 \pm (\sum_i |x_i| + e) \f$
+ */
+Interval rangeAffineForm(const AffineForm *const form);
+
+/**
+ * @brief Affine form addition, exact up to rounding.
+ * @pre Both forms must not be NULL and have the same length.
+ *
+ * @return AffineForm* A heap-allocated form for \p left + \p right.
+ */
+AffineForm *addAffineForm(const AffineForm *const left,
+                          const AffineForm *const right);
+
+/**
+ * @brief Affine form subtraction, exact up to rounding.
+ * @pre Both forms must not be NULL and have the same length.
+ *
+ * @return AffineForm* A heap-allocated form for \p left - \p right.
+ */
+AffineForm *subAffineForm(const AffineForm *const left,
+                          const AffineForm *const right);
+
+/**
+ * @brief Affine form negation, which is exact.
+ * @pre \p source may **not** be NULL.
+ *
+ * @return AffineForm* A heap-allocated form for - \p source.
+ */
+AffineForm *negAffineForm(const AffineForm *const source);
+
+/**
+ * @brief Affine form multiplication.
+ * @details The product of the linear parts is kept, the product of the
+ * deviations \f$ rad(left) \cdot rad(right) \f$ goes into the error.
+ * @pre Both forms must not be NULL and have the same length.
+ *
+ * @return AffineForm* A heap-allocated form for \p left * \p right.
+ */
+AffineForm *mulAffineForm(const AffineForm *const left,
+                          const AffineForm *const right);
+
+/**
+ * @brief Affine form division.
+ * @details The divisor is bounded by its range, so only the dependencies of
+ * the dividend are kept: \p left * (1 / rangeAffineForm(\p right)).
+ * @pre Both forms must not be NULL and have the same length, and the range
+ * of \p right must **not** contain zero (0).
+ *
+ * @return AffineForm* A heap-allocated form for \p left / \p right.
+ */
+AffineForm *divAffineForm(const AffineForm *const left,
+                          const AffineForm *const right);
+
+/**
+ * @brief Raise the form to a natural power.
+ * @details Squares are bounded as such, i.e. they are never negative, so
+ * even powers of a symmetric form do not lose their sign.
+ * @pre \p source may **not** be NULL.
+ *
+ * @param[in] source   The base.
+ * @param[in] exponent The exponent.
+ * @return AffineForm* A heap-allocated form for \p source ^ \p exponent.
+ */
+AffineForm *pow2AffineForm(const AffineForm *const source,
+                           const unsigned int exponent);
+
+#endif
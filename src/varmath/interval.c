@@ -1,4 +1,63 @@
 #include "interval.h"
+#include "intervalsimd.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* The rounding mode is thread-local, so the scopes are as well. */
+static _Thread_local unsigned int roundingDepth = 0;
+static _Thread_local int previousRounding = FE_TONEAREST;
+
+void beginOutwardRounding(void) {
+  if (roundingDepth++ == 0) {
+    previousRounding = fegetround();
+    fesetround(FE_UPWARD);
+  }
+}
+
+void endOutwardRounding(void) {
+  assert(roundingDepth > 0);
+  if (--roundingDepth == 0)
+    fesetround(previousRounding);
+}
+
+bool isOutwardRounding(void) { return roundingDepth > 0; }
+
+const char *intervalKernels(void) {
+#if defined(INTERVAL_SIMD_AVX2)
+  return "avx2";
+#elif defined(INTERVAL_SIMD_SSE2)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+
+Interval strtoInterval(const char *const str) {
+  assert(str != NULL);
+
+  /* strtod honors the rounding mode: parse x upward for the upper bound and
+    -x upward for the negated lower bound. */
+  const bool negative = (str[0] == '-');
+  const char *magnitude = negative ? str + 1 : str;
+  char *negated = (char *)malloc(strlen(magnitude) + 2);
+  if (negated == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  negated[0] = '-';
+  strcpy(negated + 1, magnitude);
+
+  beginOutwardRounding();
+  double upper = strtod(magnitude, NULL);
+  double lower = -strtod(negated, NULL);
+  endOutwardRounding();
+  free(negated);
+
+  /* Parsed |x|; mirror the bounds for negative numbers. */
+  if (negative)
+    return newInterval(-upper, -lower);
+  return newInterval(lower, upper);
+}
 
 Interval newInterval(const double left, const double right) {
   assert(left <= right);
@@ -19,14 +78,38 @@ Interval addInterval(const Interval *const left, const Interval *const right) {
   /* [a, b] + [c, d] = [a + c, b + d] */
   assert(left != NULL);
   assert(right != NULL);
-  return newInterval(left->left + right->left, left->right + right->right);
+  beginOutwardRounding();
+#ifndef INTERVAL_SIMD_SCALAR
+  /* [-a, b] + [-c, d], with the lower lane negated back */
+  __m128d x = loadNegLower(left);
+  __m128d y = loadNegLower(right);
+  Interval sum = storeInterval(_mm_xor_pd(_mm_add_pd(x, y), LOWER_SIGN));
+#else
+  Interval sum = newInterval(-(-left->left - right->left),
+                             left->right + right->right);
+#endif
+  endOutwardRounding();
+  return sum;
 }
 
 Interval subInterval(const Interval *const left, const Interval *const right) {
   /* [a, b] - [c, d] = [a - d, b - c] */
   assert(left != NULL);
   assert(right != NULL);
-  return newInterval(left->left - right->right, left->right - right->left);
+  beginOutwardRounding();
+#ifndef INTERVAL_SIMD_SCALAR
+  /* [-a, b] + [d, -c], with the lower lane negated back */
+  __m128d x = loadNegLower(left);
+  __m128d y = loadInterval(right);
+  y = _mm_xor_pd(_mm_shuffle_pd(y, y, 1), UPPER_SIGN);
+  Interval difference =
+      storeInterval(_mm_xor_pd(_mm_add_pd(x, y), LOWER_SIGN));
+#else
+  Interval difference = newInterval(-(right->right - left->left),
+                                    left->right - right->left);
+#endif
+  endOutwardRounding();
+  return difference;
 }
 
 Interval mulInterval(const Interval *const left, const Interval *const right) {
@@ -34,13 +117,46 @@ Interval mulInterval(const Interval *const left, const Interval *const right) {
                          max{a*c, a*d, b*c, b*d} ] */
   assert(left != NULL);
   assert(right != NULL);
+  beginOutwardRounding();
+  /* Products rounded up, and rounded down via -((-x) * y). */
+#if defined(INTERVAL_SIMD_AVX2)
+  /* [a, b, a, b] * [c, c, d, d] */
+  __m128d ab = loadInterval(left);
+  __m256d x = _mm256_insertf128_pd(_mm256_castpd128_pd256(ab), ab, 1);
+  __m256d y = _mm256_set_pd(right->right, right->right, right->left,
+                            right->left);
+  __m256d up = _mm256_mul_pd(x, y);
+  __m256d down = _mm256_mul_pd(_mm256_xor_pd(x, _mm256_set1_pd(-0.)), y);
+  Interval product = reduceBounds(
+      _mm_max_pd(_mm256_castpd256_pd128(down),
+                 _mm256_extractf128_pd(down, 1)),
+      _mm_max_pd(_mm256_castpd256_pd128(up), _mm256_extractf128_pd(up, 1)));
+#elif defined(INTERVAL_SIMD_SSE2)
+  /* [a, b] * [c, c] and [a, b] * [d, d] */
+  __m128d x = loadInterval(left);
+  __m128d negX = _mm_xor_pd(x, _mm_set1_pd(-0.));
+  __m128d c = _mm_set1_pd(right->left);
+  __m128d d = _mm_set1_pd(right->right);
+  Interval product =
+      reduceBounds(_mm_max_pd(_mm_mul_pd(negX, c), _mm_mul_pd(negX, d)),
+                   _mm_max_pd(_mm_mul_pd(x, c), _mm_mul_pd(x, d)));
+#else
   double ac, ad, bc, bd;
   ac = left->left * right->left;
   ad = left->left * right->right;
   bc = left->right * right->left;
   bd = left->right * right->right;
-  return newInterval(fmin(ac, fmin(ad, fmin(bc, bd))),
-                     fmax(ac, fmax(ad, fmax(bc, bd))));
+  double acDown, adDown, bcDown, bdDown;
+  acDown = -((-left->left) * right->left);
+  adDown = -((-left->left) * right->right);
+  bcDown = -((-left->right) * right->left);
+  bdDown = -((-left->right) * right->right);
+  Interval product =
+      newInterval(fmin(acDown, fmin(adDown, fmin(bcDown, bdDown))),
+                  fmax(ac, fmax(ad, fmax(bc, bd))));
+#endif
+  endOutwardRounding();
+  return product;
 }
 
 Interval divInterval(const Interval *const left, const Interval *const right) {
@@ -49,9 +165,19 @@ Interval divInterval(const Interval *const left, const Interval *const right) {
   assert(right != NULL);
   /* not (c <= 0 <= d), i.e. 0 not in [c, d] */
   assert(!(right->left <= 0 && 0 <= right->right));
-  Interval invertedRight = newInterval(1. / right->right, 1. / right->left);
-
-  return mulInterval(left, &invertedRight);
+  beginOutwardRounding();
+#ifndef INTERVAL_SIMD_SCALAR
+  /* [-1, 1] / [d, c], with the lower lane negated back */
+  __m128d y = loadInterval(right);
+  Interval invertedRight = storeInterval(_mm_xor_pd(
+      _mm_div_pd(_mm_set_pd(1., -1.), _mm_shuffle_pd(y, y, 1)), LOWER_SIGN));
+#else
+  Interval invertedRight =
+      newInterval(-((-1.) / right->right), 1. / right->left);
+#endif
+  Interval quotient = mulInterval(left, &invertedRight);
+  endOutwardRounding();
+  return quotient;
 }
 
 Interval negInterval(const Interval *const source) {
@@ -64,7 +190,152 @@ Interval sqrtInterval(const Interval *const source) {
   /* sqrt([a, b]) = [sqrt(a), sqrt(b)] */
   assert(source != NULL);
   assert(0 <= source->left && source->left <= source->right);
-  return newInterval(sqrtl(source->left), sqrtl(source->right));
+  beginOutwardRounding();
+  /* sqrt is correctly rounded, so upward sqrt(a) is the smallest double
+    >= the exact root; unless it is exact, its predecessor is below it. */
+  double lower = sqrt(source->left);
+  if (fma(lower, lower, -source->left) > 0)
+    lower = nextafter(lower, 0);
+  Interval root = newInterval(lower, sqrt(source->right));
+  endOutwardRounding();
+  return root;
+}
+
+/* Enclosures of pi and pi/2; the lower bounds are the doubles nearest to
+  them, which are below the exact values. */
+static const Interval PI = {0x1.921fb54442d18p+1, 0x1.921fb54442d19p+1};
+static const Interval HALF_PI = {0x1.921fb54442d18p+0, 0x1.921fb54442d19p+0};
+
+/* Widen the value of an elementary function down or up by its error. */
+static double elementaryDown(double value) {
+  for (unsigned int it = 0; it < ELEMENTARY_ULPS; ++it)
+    value = nextafter(value, -INFINITY);
+  return value;
+}
+
+static double elementaryUp(double value) {
+  for (unsigned int it = 0; it < ELEMENTARY_ULPS; ++it)
+    value = nextafter(value, INFINITY);
+  return value;
+}
+
+/* Evaluate a C library function in round-to-nearest, the only mode its error
+  bounds are documented for, also inside an outward rounding scope. */
+static double elementaryNearest(double (*fun)(double), const double x) {
+  const int rounding = fegetround();
+  if (rounding != FE_TONEAREST)
+    fesetround(FE_TONEAREST);
+  const double value = fun(x);
+  if (rounding != FE_TONEAREST)
+    fesetround(rounding);
+  return value;
+}
+
+/* The enclosure of a monotonically increasing function over the interval,
+  within the given range. */
+static Interval increasingInterval(double (*fun)(double),
+                                   const Interval *const source,
+                                   const double low, const double high) {
+  double lower =
+      fmax(elementaryDown(elementaryNearest(fun, source->left)), low);
+  double upper =
+      fmin(elementaryUp(elementaryNearest(fun, source->right)), high);
+  return newInterval(lower, upper);
+}
+
+/* The enclosure of sin or cos over the interval, where the function has its
+  maxima at offset + 2k pi and its minima at offset + (2k+1) pi. */
+static Interval periodicInterval(double (*fun)(double),
+                                 const Interval *const source,
+                                 const Interval *const offset) {
+  /* A full period covers the whole range. */
+  if (!(intervalWidth(source) < 2 * PI.left))
+    return newInterval(-1, 1);
+
+  /* The extrema offset + m pi with a <= offset + m pi <= b. The index
+    enclosures make this a superset, which only widens the result. */
+  Interval left = newInterval(source->left, source->left);
+  Interval right = newInterval(source->right, source->right);
+  Interval shifted = subInterval(&left, offset);
+  Interval first = divInterval(&shifted, &PI);
+  shifted = subInterval(&right, offset);
+  Interval last = divInterval(&shifted, &PI);
+  const double firstIndex = ceil(first.left);
+  const double lastIndex = floor(last.right);
+
+  /* Two consecutive extrema are a maximum and a minimum. */
+  if (firstIndex < lastIndex)
+    return newInterval(-1, 1);
+
+  double valueLeft = elementaryNearest(fun, source->left);
+  double valueRight = elementaryNearest(fun, source->right);
+  double lower = elementaryDown(fmin(valueLeft, valueRight));
+  double upper = elementaryUp(fmax(valueLeft, valueRight));
+  if (firstIndex == lastIndex) {
+    if (fmod(firstIndex, 2) == 0)
+      upper = 1;
+    else
+      lower = -1;
+  }
+  return newInterval(fmax(lower, -1), fmin(upper, 1));
+}
+
+Interval sinInterval(const Interval *const source) {
+  assert(source != NULL);
+  /* sin has its maxima at pi/2 + 2k pi */
+  return periodicInterval(sin, source, &HALF_PI);
+}
+
+Interval cosInterval(const Interval *const source) {
+  assert(source != NULL);
+  /* cos has its maxima at 2k pi */
+  Interval zero = newInterval(0, 0);
+  return periodicInterval(cos, source, &zero);
+}
+
+Interval expInterval(const Interval *const source) {
+  assert(source != NULL);
+  return increasingInterval(exp, source, 0, INFINITY);
+}
+
+Interval logInterval(const Interval *const source) {
+  assert(source != NULL);
+  assert(source->left > 0);
+  return increasingInterval(log, source, -INFINITY, INFINITY);
+}
+
+Interval atanInterval(const Interval *const source) {
+  assert(source != NULL);
+  return increasingInterval(atan, source, -HALF_PI.right, HALF_PI.right);
+}
+
+Interval tanhInterval(const Interval *const source) {
+  assert(source != NULL);
+  return increasingInterval(tanh, source, -1, 1);
+}
+
+/* x^n for x >= 0, rounded up; requires upward rounding. */
+static double powUp(const double x, const unsigned int n) {
+  double result = 1;
+  double square = x;
+  for (unsigned int it = n; it > 0; it /= 2) {
+    if (it % 2 == 1)
+      result *= square;
+    square *= square;
+  }
+  return result;
+}
+
+/* x^n for x >= 0, rounded down; requires upward rounding. */
+static double powDown(const double x, const unsigned int n) {
+  double result = 1;
+  double square = x;
+  for (unsigned int it = n; it > 0; it /= 2) {
+    if (it % 2 == 1)
+      result = -((-result) * square);
+    square = -((-square) * square);
+  }
+  return result;
 }
 
 Interval powInterval(const Interval *const source,
@@ -77,26 +348,37 @@ Interval powInterval(const Interval *const source,
 
   /* Note: this algorithm may produce more accurate results (more strict
     bounds) than simply applying interval multiplication multiple times.
-    Note: finding [a, b]^n means computing x^n for all x in [a, b]. */
-  double an, bn;
-  an = pow(source->left, exponent);
-  bn = pow(source->right, exponent);
+    Note: finding [a, b]^n means computing x^n for all x in [a, b].
+    Powers are of magnitudes, so that they can be rounded in either
+    direction; the signs are restored per case. */
+  beginOutwardRounding();
+  const double absA = fabs(source->left);
+  const double absB = fabs(source->right);
+  Interval power;
 
   /* CASES: [a, b]^n for n is ODD, so for x in [a, b], x^n retains x's sign */
-  if ((exponent % 2) == 1)
-    return newInterval(an, bn);
-
+  if ((exponent % 2) == 1) {
+    double an = (source->left >= 0) ? powDown(absA, exponent)
+                                    : -powUp(absA, exponent);
+    double bn = (source->right >= 0) ? powUp(absB, exponent)
+                                     : -powDown(absB, exponent);
+    power = newInterval(an, bn);
+  }
   /* CASES: [a, b]^n for n is EVEN, so for x in [a, b], x^n is positive */
   /* 0 <= a <= b, so a^n <= b^n */
-  if (source->left >= 0)
-    return newInterval(an, bn);
+  else if (source->left >= 0)
+    power = newInterval(powDown(absA, exponent), powUp(absB, exponent));
   /* a <= b < 0, so b^n <= a^n */
-  if (source->right < 0)
-    return newInterval(bn, an);
+  else if (source->right < 0)
+    power = newInterval(powDown(absB, exponent), powUp(absA, exponent));
   /* a < 0 <= b, so [a, 0]^n = [0, a^n] and [0, b]^n = [0, b^n].
     Notice that the input negative sub-interval becomes positive,
     hence the 0 lower bound in the output. */
-  return newInterval(0, fmax(an, bn));
+  else
+    power = newInterval(0, powUp(fmax(absA, absB), exponent));
+
+  endOutwardRounding();
+  return power;
 }
 
 Interval pow2Interval(const Interval *const source,
@@ -108,9 +390,11 @@ Interval pow2Interval(const Interval *const source,
 
   Interval result = *source;
   /* Multiplications only happen from exponent > 1 onwards. */
+  beginOutwardRounding();
   for (unsigned int it = 1; it < exponent; ++it) {
     result = mulInterval(source, &result);
   }
+  endOutwardRounding();
   return result;
 }
 
@@ -14,6 +14,7 @@
 #define INTERVAL_H
 
 #include <assert.h>
+#include <fenv.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -41,6 +42,69 @@ typedef struct Interval {
   double right;
 } Interval;
 
+/**
+ * @brief Enter an outward rounding scope on the calling thread.
+ * @details All interval arithmetic operations round outward, i.e. lower
+ * bounds down and upper bounds up, so that the result is guaranteed to
+ * contain the exact result. They do so in the upward rounding mode: upper
+ * bounds are computed directly, lower bounds via negation, e.g. the lower
+ * bound of a product is \f$ -((-a) \cdot b) \f$.
+ *
+ * Switching the rounding mode is expensive compared to a single operation.
+ * An operation outside any scope switches to upward rounding and back on its
+ * own, while an operation inside a scope does not switch at all. So wrap
+ * hot loops and whole evaluations in a scope:
+ * @code
+ * beginOutwardRounding();
+ * ... many interval operations ...
+ * endOutwardRounding();
+ * @endcode
+ * Scopes nest; only the outermost one switches the rounding mode. The
+ * rounding mode is per thread, and so are the scopes.
+ * @warning Inside a scope, **all** floating-point operations of the thread
+ * round upward, not just interval arithmetic. Keep non-interval
+ * computations, e.g. symbolic coefficient arithmetic, outside of scopes.
+ * @post Must be matched by a call to @ref endOutwardRounding.
+ */
+void beginOutwardRounding(void);
+
+/**
+ * @brief Leave an outward rounding scope, see @ref beginOutwardRounding.
+ * @details Leaving the outermost scope restores the rounding mode that was
+ * active when it was entered.
+ * @pre The calling thread must be inside a scope.
+ */
+void endOutwardRounding(void);
+
+/**
+ * @brief Check whether the calling thread is inside an outward rounding
+ * scope, see @ref beginOutwardRounding.
+ */
+bool isOutwardRounding(void);
+
+/**
+ * @brief The name of the kernels that implement the basic operations.
+ * @details Addition, subtraction, multiplication and division have
+ * branchless vector kernels that process both bounds at once, packed in one
+ * register. The kernels are selected at build time by the 'simd' option:
+ * "avx2", "sse2" or the portable "scalar" fallback. All kernels round the
+ * same way, so they compute identical results.
+ *
+ * @return const char* The name of the selected kernels.
+ */
+const char *intervalKernels(void);
+
+/**
+ * @brief The tightest interval that contains the given decimal number.
+ * @details Most decimals, e.g. 0.1, are not representable as a double.
+ * The bounds are the closest doubles below and above the decimal.
+ * @pre \p str may **not** be NULL and must be a valid decimal.
+ *
+ * @param[in] str The decimal number, as a string.
+ * @return Interval The enclosure of the number.
+ */
+Interval strtoInterval(const char *const str);
+
 /**
  * @brief Construct a new interval that respects the bounds invariant.
  * @see Interval For the bounds invariant description.
@@ -62,6 +126,8 @@ void printInterval(const Interval *const source, FILE *where);
 /**
  * @brief Binary interval addition.
  * @details Interval addition **is** commutative: I1 + I2 = I2 + I1.
+ * Like all interval arithmetic operations, the result is rounded outward,
+ * see @ref beginOutwardRounding.
  *
  * @param[in] left  The left operand.
  * @param[in] right The right operand.
@@ -121,6 +187,79 @@ Interval negInterval(const Interval *const source);
  */
 Interval sqrtInterval(const Interval *const source);
 
+/// @brief The number of ulps by which elementary functions are widened.
+/// @details A safety margin above the worst-case errors the C library
+/// documents for these functions in round-to-nearest. They are always
+/// evaluated in that mode, also inside an outward rounding scope, and then
+/// widened.
+#define ELEMENTARY_ULPS 4
+
+/**
+ * @brief Unary interval sine.
+ * @details sin is evaluated at the bounds only; the range also includes 1
+ * (resp. -1) if the interval contains a maximum \f$ \frac{\pi}{2} + 2k\pi
+ * \f$ (resp. a minimum \f$ -\frac{\pi}{2} + 2k\pi \f$). Whether it does is
+ * decided by an enclosure of \f$ \pi \f$, so the reduction is rigorous even
+ * for large arguments. Results are widened by @ref ELEMENTARY_ULPS and
+ * clamped to [-1, 1].
+ *
+ * @param[in] source The operand, in radians.
+ * @return sin( \p source )
+ */
+Interval sinInterval(const Interval *const source);
+
+/**
+ * @brief Unary interval cosine.
+ * @details Like @ref sinInterval, with the maxima at \f$ 2k\pi \f$ and the
+ * minima at \f$ (2k+1)\pi \f$.
+ *
+ * @param[in] source The operand, in radians.
+ * @return cos( \p source )
+ */
+Interval cosInterval(const Interval *const source);
+
+/**
+ * @brief Unary interval exponential.
+ * @details exp is increasing, so exp([a, b]) = [exp(a), exp(b)], widened by
+ * @ref ELEMENTARY_ULPS and with a non-negative lower bound.
+ *
+ * @param[in] source The operand.
+ * @return exp( \p source )
+ */
+Interval expInterval(const Interval *const source);
+
+/**
+ * @brief Unary interval natural logarithm.
+ * @details log is increasing, so log([a, b]) = [log(a), log(b)], widened by
+ * @ref ELEMENTARY_ULPS.
+ * @pre The interval's lower bound must be greater than 0.
+ *
+ * @param[in] source The operand.
+ * @return log( \p source )
+ */
+Interval logInterval(const Interval *const source);
+
+/**
+ * @brief Unary interval arc tangent.
+ * @details atan is increasing, so atan([a, b]) = [atan(a), atan(b)], widened
+ * by @ref ELEMENTARY_ULPS and clamped to an enclosure of
+ * \f$ [-\frac{\pi}{2}, \frac{\pi}{2}] \f$.
+ *
+ * @param[in] source The operand.
+ * @return atan( \p source )
+ */
+Interval atanInterval(const Interval *const source);
+
+/**
+ * @brief Unary interval hyperbolic tangent.
+ * @details tanh is increasing, so tanh([a, b]) = [tanh(a), tanh(b)], widened
+ * by @ref ELEMENTARY_ULPS and clamped to [-1, 1].
+ *
+ * @param[in] source The operand.
+ * @return tanh( \p source )
+ */
+Interval tanhInterval(const Interval *const source);
+
 /**
  * @brief Binary interval exponentiation using a ***smart*** algorithm.
  * @details The smart algorithm takes into account that the exponentiation can
@@ -0,0 +1,290 @@
+#include "intervalbox.h"
+#include "intervalsimd.h"
+
+/* The FNV-1a hash of a name. */
+static unsigned int hashSymbol(const char *name) {
+  unsigned int hash = 2166136261u;
+  for (; *name != '\0'; ++name) {
+    hash ^= (unsigned char)*name;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/* The slot that holds the name, or the empty slot where it belongs. */
+static unsigned int probeSymbol(const SymbolTable *table, const char *name) {
+  const unsigned int mask = table->capacity - 1;
+  unsigned int slot = hashSymbol(name) & mask;
+  while (table->slots[slot] != 0 &&
+         strcmp(table->names[table->slots[slot] - 1], name) != 0)
+    slot = (slot + 1) & mask;
+  return slot;
+}
+
+/* Allocate the arrays for the given capacity and re-index all names. */
+static void resizeSymbolTable(SymbolTable *table, unsigned int capacity) {
+  char **names = (char **)realloc(table->names, capacity * sizeof(char *));
+  unsigned int *slots = (unsigned int *)calloc(capacity, sizeof(unsigned int));
+  if (names == NULL || slots == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  free(table->slots);
+  table->names = names;
+  table->slots = slots;
+  table->capacity = capacity;
+
+  for (unsigned int id = 0; id < table->length; ++id)
+    table->slots[probeSymbol(table, table->names[id])] = id + 1;
+}
+
+SymbolTable *newSymbolTable(void) {
+  SymbolTable *table = (SymbolTable *)malloc(sizeof(SymbolTable));
+  if (table == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  table->length = 0;
+  table->capacity = 0;
+  table->names = NULL;
+  table->slots = NULL;
+  resizeSymbolTable(table, 16);
+  return table;
+}
+
+void delSymbolTable(SymbolTable *table) {
+  assert(table != NULL);
+  for (unsigned int id = 0; id < table->length; ++id)
+    free(table->names[id]);
+  free(table->names);
+  free(table->slots);
+  free(table);
+}
+
+unsigned int internSymbol(SymbolTable *table, const char *name) {
+  assert(table != NULL);
+  assert(name != NULL);
+
+  unsigned int slot = probeSymbol(table, name);
+  if (table->slots[slot] != 0)
+    return table->slots[slot] - 1;
+
+  /* Keep the index at most half full, so probe sequences stay short. */
+  if (2 * (table->length + 1) > table->capacity) {
+    resizeSymbolTable(table, 2 * table->capacity);
+    slot = probeSymbol(table, name);
+  }
+
+  const unsigned int id = table->length++;
+  table->names[id] = strdup(name);
+  table->slots[slot] = id + 1;
+  return id;
+}
+
+unsigned int findSymbol(const SymbolTable *table, const char *name) {
+  assert(table != NULL);
+  assert(name != NULL);
+
+  unsigned int slot = probeSymbol(table, name);
+  return (table->slots[slot] != 0) ? table->slots[slot] - 1
+                                   : SYMBOL_NOT_FOUND;
+}
+
+const char *symbolName(const SymbolTable *table, const unsigned int id) {
+  assert(table != NULL);
+  assert(id < table->length);
+  return table->names[id];
+}
+
+IntervalBox *newIntervalBox(const unsigned int dim) {
+  IntervalBox *box = (IntervalBox *)malloc(sizeof(IntervalBox));
+  Interval *data = (Interval *)calloc(dim > 0 ? dim : 1, sizeof(Interval));
+  if (box == NULL || data == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  box->dim = dim;
+  box->data = data;
+  return box;
+}
+
+IntervalBox *cpyIntervalBox(const IntervalBox *source) {
+  assert(source != NULL);
+  IntervalBox *box = newIntervalBox(source->dim);
+  memcpy(box->data, source->data, source->dim * sizeof(Interval));
+  return box;
+}
+
+void delIntervalBox(IntervalBox *box) {
+  assert(box != NULL);
+  free(box->data);
+  free(box);
+}
+
+void printIntervalBox(const IntervalBox *box, const SymbolTable *symbols,
+                      FILE *where) {
+  assert(box != NULL);
+  assert(symbols != NULL);
+  assert(where != NULL);
+
+  for (unsigned int it = 0; it < box->dim; ++it) {
+    fprintf(where, "%s in ", symbolName(symbols, it));
+    printInterval(&box->data[it], where);
+    fprintf(where, "; ");
+  }
+}
+
+IntervalBox *toIntervalBox(const Domain *list, SymbolTable *symbols) {
+  assert(symbols != NULL);
+
+  for (const Domain *dom = list; dom != NULL; dom = dom->next)
+    internSymbol(symbols, dom->var);
+
+  IntervalBox *box = newIntervalBox(symbols->length);
+  for (const Domain *dom = list; dom != NULL; dom = dom->next)
+    box->data[findSymbol(symbols, dom->var)] = dom->domain;
+  return box;
+}
+
+Domain *fromIntervalBox(const IntervalBox *box, const SymbolTable *symbols) {
+  assert(box != NULL);
+  assert(symbols != NULL);
+  assert(box->dim <= symbols->length);
+
+  /* Build the list back to front, so it ends up in symbol ID order. */
+  Domain *list = NULL;
+  for (unsigned int it = box->dim; it > 0; --it)
+    list = newDomainElem(list, strdup(symbolName(symbols, it - 1)),
+                         box->data[it - 1]);
+  return list;
+}
+
+IntervalBox *hullIntervalBox(const IntervalBox *left,
+                             const IntervalBox *right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->dim == right->dim);
+
+  IntervalBox *hull = newIntervalBox(left->dim);
+  for (unsigned int it = 0; it < left->dim; ++it) {
+#ifndef INTERVAL_SIMD_SCALAR
+    /* max([-a, b], [-c, d]) = [-min(a, c), max(b, d)] */
+    __m128d bounds = _mm_max_pd(loadNegLower(&left->data[it]),
+                                loadNegLower(&right->data[it]));
+    hull->data[it] = storeInterval(_mm_xor_pd(bounds, LOWER_SIGN));
+#else
+    hull->data[it] =
+        newInterval(fmin(left->data[it].left, right->data[it].left),
+                    fmax(left->data[it].right, right->data[it].right));
+#endif
+  }
+  return hull;
+}
+
+IntervalBox *intersectIntervalBox(const IntervalBox *left,
+                                  const IntervalBox *right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->dim == right->dim);
+
+  /* Compute the bounds of every dimension first, then check them all. */
+  double *bounds = (double *)malloc(2 * (left->dim + 1) * sizeof(double));
+  if (bounds == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  bool empty = false;
+  for (unsigned int it = 0; it < left->dim; ++it) {
+#ifndef INTERVAL_SIMD_SCALAR
+    /* min([-a, b], [-c, d]) = [-max(a, c), min(b, d)] */
+    __m128d meet = _mm_min_pd(loadNegLower(&left->data[it]),
+                              loadNegLower(&right->data[it]));
+    _mm_storeu_pd(&bounds[2 * it], _mm_xor_pd(meet, LOWER_SIGN));
+#else
+    bounds[2 * it] = fmax(left->data[it].left, right->data[it].left);
+    bounds[2 * it + 1] = fmin(left->data[it].right, right->data[it].right);
+#endif
+    empty |= bounds[2 * it] > bounds[2 * it + 1];
+  }
+
+  IntervalBox *meet = NULL;
+  if (!empty) {
+    meet = newIntervalBox(left->dim);
+    for (unsigned int it = 0; it < left->dim; ++it)
+      meet->data[it] = newInterval(bounds[2 * it], bounds[2 * it + 1]);
+  }
+
+  /* Clean */
+  free(bounds);
+
+  return meet;
+}
+
+double widthIntervalBox(const IntervalBox *box, unsigned int *widest) {
+  assert(box != NULL);
+
+  double width = 0;
+  unsigned int index = 0;
+  for (unsigned int it = 0; it < box->dim; ++it) {
+    double current = box->data[it].right - box->data[it].left;
+    if (current > width) {
+      width = current;
+      index = it;
+    }
+  }
+  if (widest != NULL)
+    *widest = index;
+  return width;
+}
+
+void midpointIntervalBox(const IntervalBox *box, double *point) {
+  assert(box != NULL);
+  assert(point != NULL);
+
+  /* A plain loop over the packed bounds, which compilers vectorize. */
+  const Interval *data = box->data;
+  for (unsigned int it = 0; it < box->dim; ++it)
+    point[it] = 0.5 * data[it].left + 0.5 * data[it].right;
+}
+
+IntervalBox *bisectIntervalBox(const IntervalBox *box, const unsigned int dim,
+                               const bool upper) {
+  assert(box != NULL);
+  assert(dim < box->dim);
+
+  IntervalBox *half = cpyIntervalBox(box);
+  double mid = intervalMidpoint(&box->data[dim]);
+  half->data[dim] = upper ? newInterval(mid, box->data[dim].right)
+                          : newInterval(box->data[dim].left, mid);
+  return half;
+}
+
+bool subeqIntervalBox(const IntervalBox *left, const IntervalBox *right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->dim == right->dim);
+
+#ifndef INTERVAL_SIMD_SCALAR
+  /* [a, b] subseteq [c, d] iff. [-a, b] <= [-c, d] in both lanes. */
+  __m128d inside = _mm_castsi128_pd(_mm_set1_epi32(-1));
+  for (unsigned int it = 0; it < left->dim; ++it)
+    inside = _mm_and_pd(inside, _mm_cmple_pd(loadNegLower(&left->data[it]),
+                                             loadNegLower(&right->data[it])));
+  return _mm_movemask_pd(inside) == 3;
+#else
+  bool inside = true;
+  for (unsigned int it = 0; it < left->dim; ++it)
+    inside &= subeqInterval(&left->data[it], &right->data[it]);
+  return inside;
+#endif
+}
+
+bool elemIntervalBox(const double *point, const IntervalBox *box) {
+  assert(point != NULL);
+  assert(box != NULL);
+
+  bool inside = true;
+  for (unsigned int it = 0; it < box->dim; ++it)
+    inside &= elemInterval(point[it], &box->data[it]);
+  return inside;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file intervalbox.h
+ * @brief Dense interval vectors (boxes), indexed by interned symbol IDs.
+ * @details A @ref Domain is a linked list of heap-allocated names, so every
+ * variable lookup walks the list and compares strings. An @ref IntervalBox
+ * stores the domains contiguously instead, one per symbol ID, and a
+ * @ref SymbolTable maps each variable name to its ID once, up front. Box
+ * operations then run over a flat array of packed intervals, which the
+ * vector kernels of interval arithmetic process directly.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef INTERVAL_BOX_H
+#define INTERVAL_BOX_H
+
+#include "interval.h"
+#include "variables.h"
+#include <assert.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief The ID @ref findSymbol returns for unknown names.
+#define SYMBOL_NOT_FOUND UINT_MAX
+
+/**
+ * @brief A table that interns variable names as dense IDs 0, 1, 2, ...
+ * @details IDs are assigned in order of first interning and never change.
+ * Lookups hash the name into an open addressing index.
+ *
+ * @invariant No two entries have the same name, and the index is at most
+ * half full.
+ */
+typedef struct SymbolTable {
+  /// @brief The number of symbols, i.e. the next ID to assign.
+  unsigned int length;
+  /// @brief The number of index slots, a power of two.
+  unsigned int capacity;
+  /// @brief The name of each symbol, by ID.
+  char **names;
+  /// @brief The hash index: ID + 1 per slot, or 0 for an empty slot.
+  unsigned int *slots;
+} SymbolTable;
+
+/**
+ * @brief Create a new, empty symbol table.
+ *
+ * @return SymbolTable* A heap-allocated symbol table.
+ */
+SymbolTable *newSymbolTable(void);
+
+/**
+ * @brief Deallocate the given symbol table, including all names.
+ * @pre \p table may **not** be NULL.
+ */
+void delSymbolTable(SymbolTable *table);
+
+/**
+ * @brief Get the ID of a name, assigning the next free ID if it is new.
+ * @pre Neither argument may be NULL.
+ * @post The table stores its own copy of \p name.
+ *
+ * @param[in,out] table The symbol table.
+ * @param[in]     name  The variable name.
+ * @return unsigned int The ID of the name.
+ */
+unsigned int internSymbol(SymbolTable *table, const char *name);
+
+/**
+ * @brief Get the ID of a name, without adding it.
+ * @pre Neither argument may be NULL.
+ *
+ * @return unsigned int The ID of the name, or @ref SYMBOL_NOT_FOUND.
+ */
+unsigned int findSymbol(const SymbolTable *table, const char *name);
+
+/**
+ * @brief Get the name of a symbol ID.
+ * @pre \p id must be less than the table's length.
+ */
+const char *symbolName(const SymbolTable *table, const unsigned int id);
+
+/**
+ * @brief A box \f$ I_0 \times I_1 \times \ldots \f$ of intervals, with
+ * \f$ I_i \f$ the domain of the symbol with ID i.
+ */
+typedef struct IntervalBox {
+  /// @brief The number of dimensions.
+  unsigned int dim;
+  /// @brief The interval of each dimension, contiguous.
+  Interval *data;
+} IntervalBox;
+
+/**
+ * @brief Create a new box with every dimension [0, 0].
+ *
+ * @param[in] dim The number of dimensions.
+ * @return IntervalBox* A heap-allocated box.
+ */
+IntervalBox *newIntervalBox(const unsigned int dim);
+
+/**
+ * @brief Create a copy of the given box.
+ * @pre \p source may **not** be NULL.
+ */
+IntervalBox *cpyIntervalBox(const IntervalBox *source);
+
+/**
+ * @brief Deallocate the given box.
+ * @pre \p box may **not** be NULL.
+ */
+void delIntervalBox(IntervalBox *box);
+
+/**
+ * @brief Print the box as a domain, e.g. "x in [0, 1]; y in [1, 2]; ".
+ * @pre All arguments must not be NULL, and \p symbols must name every
+ * dimension.
+ */
+void printIntervalBox(const IntervalBox *box, const SymbolTable *symbols,
+                      FILE *where);
+
+/**
+ * @brief Convert a domain list to a box.
+ * @details Every variable of the \p list is interned in \p symbols. The box
+ * has a dimension for every symbol of the table; symbols that are not in the
+ * \p list get the domain [0, 0].
+ * @pre \p symbols may **not** be NULL.
+ *
+ * @param[in]     list    The domain list.
+ * @param[in,out] symbols The symbol table to index the box by.
+ * @return IntervalBox* A heap-allocated box.
+ */
+IntervalBox *toIntervalBox(const Domain *list, SymbolTable *symbols);
+
+/**
+ * @brief Convert a box back to a domain list, in symbol ID order.
+ * @pre All arguments must not be NULL, and \p symbols must name every
+ * dimension.
+ *
+ * @return Domain* A heap-allocated domain list.
+ */
+Domain *fromIntervalBox(const IntervalBox *box, const SymbolTable *symbols);
+
+/**
+ * @brief The interval hull, i.e. the smallest box containing both boxes.
+ * @pre Both boxes must not be NULL and have the same dimension.
+ *
+ * @return IntervalBox* A heap-allocated box.
+ */
+IntervalBox *hullIntervalBox(const IntervalBox *left,
+                             const IntervalBox *right);
+
+/**
+ * @brief The intersection of two boxes.
+ * @pre Both boxes must not be NULL and have the same dimension.
+ *
+ * @return IntervalBox* A heap-allocated box, or NULL if the boxes are
+ * disjoint.
+ */
+IntervalBox *intersectIntervalBox(const IntervalBox *left,
+                                  const IntervalBox *right);
+
+/**
+ * @brief The width of the box, i.e. the width of its widest dimension.
+ * @pre \p box may **not** be NULL.
+ *
+ * @param[in]  box    The box.
+ * @param[out] widest The widest dimension, the first one on ties. Ignored
+ *                    if NULL.
+ * @return double The width, 0 for a box without dimensions.
+ */
+double widthIntervalBox(const IntervalBox *box, unsigned int *widest);
+
+/**
+ * @brief The midpoint of every dimension of the box.
+ * @pre Both arguments must not be NULL.
+ *
+ * @param[in]  box   The box.
+ * @param[out] point An array of dim doubles, receives the midpoint.
+ */
+void midpointIntervalBox(const IntervalBox *box, double *point);
+
+/**
+ * @brief Copy the box, keeping only the lower or upper half of one
+ * dimension.
+ * @pre \p box may **not** be NULL and \p dim must be less than its
+ * dimension.
+ *
+ * @param[in] box   The box to bisect.
+ * @param[in] dim   The dimension to bisect.
+ * @param[in] upper True for the upper half, false for the lower half.
+ * @return IntervalBox* A heap-allocated box.
+ */
+IntervalBox *bisectIntervalBox(const IntervalBox *box, const unsigned int dim,
+                               const bool upper);
+
+/**
+ * @brief Check whether the left box is a subset of the right box.
+ * @pre Both boxes must not be NULL and have the same dimension.
+ */
+bool subeqIntervalBox(const IntervalBox *left, const IntervalBox *right);
+
+/**
+ * @brief Check whether the point lies in the box.
+ * @pre Both arguments must not be NULL.
+ *
+ * @param[in] point An array of dim doubles.
+ * @param[in] box   The box.
+ */
+bool elemIntervalBox(const double *point, const IntervalBox *box);
+
+#endif
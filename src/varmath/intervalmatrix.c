@@ -0,0 +1,201 @@
+#include "intervalmatrix.h"
+
+IntervalMatrix *newIntervalMatrix(const unsigned int rows,
+                                  const unsigned int cols) {
+  IntervalMatrix *matrix = (IntervalMatrix *)malloc(sizeof(IntervalMatrix));
+  Interval *data =
+      (Interval *)calloc((size_t)rows * cols + 1, sizeof(Interval));
+  if (matrix == NULL || data == NULL) {
+    fprintf(stderr, "Memory allocation error\n");
+    exit(EXIT_FAILURE);
+  }
+  matrix->rows = rows;
+  matrix->cols = cols;
+  matrix->data = data;
+  for (unsigned int it = 0; it < rows * cols; ++it)
+    matrix->data[it] = newInterval(0, 0);
+  return matrix;
+}
+
+IntervalMatrix *identityIntervalMatrix(const unsigned int n) {
+  IntervalMatrix *matrix = newIntervalMatrix(n, n);
+  for (unsigned int it = 0; it < n; ++it)
+    *elemIntervalMatrix(matrix, it, it) = newInterval(1, 1);
+  return matrix;
+}
+
+IntervalMatrix *cpyIntervalMatrix(const IntervalMatrix *const source) {
+  assert(source != NULL);
+
+  IntervalMatrix *copy = newIntervalMatrix(source->rows, source->cols);
+  for (unsigned int it = 0; it < source->rows * source->cols; ++it)
+    copy->data[it] = source->data[it];
+  return copy;
+}
+
+void delIntervalMatrix(IntervalMatrix *matrix) {
+  assert(matrix != NULL);
+
+  free(matrix->data);
+  free(matrix);
+}
+
+void printIntervalMatrix(const IntervalMatrix *const matrix, FILE *where) {
+  assert(matrix != NULL);
+
+  for (unsigned int row = 0; row < matrix->rows; ++row) {
+    for (unsigned int col = 0; col < matrix->cols; ++col) {
+      printInterval(elemIntervalMatrix(matrix, row, col), where);
+      fprintf(where, (col + 1 < matrix->cols) ? " " : "\n");
+    }
+  }
+}
+
+Interval *elemIntervalMatrix(const IntervalMatrix *const matrix,
+                             const unsigned int row, const unsigned int col) {
+  assert(matrix != NULL);
+  assert(row < matrix->rows);
+  assert(col < matrix->cols);
+
+  return &matrix->data[row * matrix->cols + col];
+}
+
+IntervalMatrix *addIntervalMatrix(const IntervalMatrix *const left,
+                                  const IntervalMatrix *const right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->rows == right->rows);
+  assert(left->cols == right->cols);
+
+  IntervalMatrix *sum = newIntervalMatrix(left->rows, left->cols);
+  for (unsigned int it = 0; it < left->rows * left->cols; ++it)
+    sum->data[it] = addInterval(&left->data[it], &right->data[it]);
+  return sum;
+}
+
+IntervalMatrix *mulIntervalMatrix(const IntervalMatrix *const left,
+                                  const IntervalMatrix *const right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->cols == right->rows);
+
+  IntervalMatrix *product = newIntervalMatrix(left->rows, right->cols);
+  for (unsigned int row = 0; row < left->rows; ++row) {
+    for (unsigned int col = 0; col < right->cols; ++col) {
+      Interval sum = newInterval(0, 0);
+      for (unsigned int it = 0; it < left->cols; ++it) {
+        Interval term = mulInterval(elemIntervalMatrix(left, row, it),
+                                    elemIntervalMatrix(right, it, col));
+        sum = addInterval(&sum, &term);
+      }
+      *elemIntervalMatrix(product, row, col) = sum;
+    }
+  }
+  return product;
+}
+
+IntervalMatrix *scaleIntervalMatrix(const IntervalMatrix *const matrix,
+                                    const Interval *const scalar) {
+  assert(matrix != NULL);
+  assert(scalar != NULL);
+
+  IntervalMatrix *scaled = newIntervalMatrix(matrix->rows, matrix->cols);
+  for (unsigned int it = 0; it < matrix->rows * matrix->cols; ++it)
+    scaled->data[it] = mulInterval(scalar, &matrix->data[it]);
+  return scaled;
+}
+
+IntervalMatrix *hullIntervalMatrix(const IntervalMatrix *const left,
+                                   const IntervalMatrix *const right) {
+  assert(left != NULL);
+  assert(right != NULL);
+  assert(left->rows == right->rows);
+  assert(left->cols == right->cols);
+
+  IntervalMatrix *hull = newIntervalMatrix(left->rows, left->cols);
+  for (unsigned int it = 0; it < left->rows * left->cols; ++it)
+    hull->data[it] =
+        newInterval(fmin(left->data[it].left, right->data[it].left),
+                    fmax(left->data[it].right, right->data[it].right));
+  return hull;
+}
+
+double normIntervalMatrix(const IntervalMatrix *const matrix) {
+  assert(matrix != NULL);
+
+  /* Sum upward, so the norm is never underestimated. */
+  beginOutwardRounding();
+  double norm = 0;
+  for (unsigned int row = 0; row < matrix->rows; ++row) {
+    double sum = 0;
+    for (unsigned int col = 0; col < matrix->cols; ++col)
+      sum += intervalMagnitude(elemIntervalMatrix(matrix, row, col));
+    norm = fmax(norm, sum);
+  }
+  endOutwardRounding();
+  return norm;
+}
+
+IntervalMatrix *expIntervalMatrix(const IntervalMatrix *const matrix,
+                                  const unsigned int order) {
+  assert(matrix != NULL);
+  assert(matrix->rows == matrix->cols);
+  assert(order > 0);
+
+  beginOutwardRounding();
+
+  /* Scale the matrix down until its norm is at most 1/2; powers of two
+    scale exactly. */
+  unsigned int squarings = 0;
+  double norm = normIntervalMatrix(matrix);
+  while (norm > 0.5) {
+    norm /= 2;
+    ++squarings;
+  }
+  const double factor = ldexp(1, -(int)squarings);
+  Interval scale = newInterval(factor, factor);
+  IntervalMatrix *scaled = scaleIntervalMatrix(matrix, &scale);
+
+  /* Taylor series: I + M + M^2/2! + ... + M^K/K!, evaluated as
+    I + M(I + M/2(I + ... (I + M/K))) to keep the terms small. */
+  const unsigned int n = matrix->rows;
+  IntervalMatrix *sum = identityIntervalMatrix(n);
+  for (unsigned int index = order; index > 0; --index) {
+    /* 1/K is rarely representable, so enclose it. */
+    Interval inverse = newInterval(-(-1. / index), 1. / index);
+    IntervalMatrix *term = scaleIntervalMatrix(scaled, &inverse);
+    IntervalMatrix *product = mulIntervalMatrix(term, sum);
+    IntervalMatrix *identity = identityIntervalMatrix(n);
+    delIntervalMatrix(sum);
+    sum = addIntervalMatrix(identity, product);
+
+    /* Clean */
+    delIntervalMatrix(term);
+    delIntervalMatrix(product);
+    delIntervalMatrix(identity);
+  }
+
+  /* The truncated tail of the series is bounded by a geometric series,
+    since ||M|| <= 1/2 < K + 2. Every step rounds the bound up. */
+  double remainder = 1;
+  for (unsigned int index = 1; index <= order + 1; ++index)
+    remainder = remainder * norm / index;
+  remainder /= -(norm / (order + 2) - 1);
+  Interval error = newInterval(-remainder, remainder);
+  for (unsigned int it = 0; it < n * n; ++it)
+    sum->data[it] = addInterval(&sum->data[it], &error);
+
+  /* Undo the scaling: e^M = (e^{M / 2^s})^{2^s}. */
+  for (unsigned int it = 0; it < squarings; ++it) {
+    IntervalMatrix *squared = mulIntervalMatrix(sum, sum);
+    delIntervalMatrix(sum);
+    sum = squared;
+  }
+
+  endOutwardRounding();
+
+  /* Clean */
+  delIntervalMatrix(scaled);
+
+  return sum;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file intervalmatrix.h
+ * @brief Dense interval matrices and an interval enclosure of the matrix
+ * exponential.
+ * @details The matrix exponential is what makes linear ODE systems cheap:
+ * the flow of \f$ \dot{x} = Ax \f$ is \f$ x(t) = e^{At} x(0) \f$, so a single
+ * interval enclosure of \f$ e^{At} \f$ replaces the symbolic Lie derivatives
+ * of the general Taylor model pipeline.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef INTERVAL_MATRIX_H
+#define INTERVAL_MATRIX_H
+
+#include "interval.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief A dense, row-major matrix of intervals.
+ *
+ * @invariant The member @ref IntervalMatrix.data holds exactly
+ * rows * cols elements.
+ */
+typedef struct IntervalMatrix {
+  /// @brief The number of rows.
+  unsigned int rows;
+  /// @brief The number of columns.
+  unsigned int cols;
+  /// @brief The elements, row by row.
+  Interval *data;
+} IntervalMatrix;
+
+/**
+ * @brief Create a new matrix with all elements [0, 0].
+ *
+ * @param[in] rows The number of rows.
+ * @param[in] cols The number of columns.
+ * @return IntervalMatrix* A heap-allocated zero matrix.
+ */
+IntervalMatrix *newIntervalMatrix(const unsigned int rows,
+                                  const unsigned int cols);
+
+/**
+ * @brief Create a new n by n identity matrix.
+ */
+IntervalMatrix *identityIntervalMatrix(const unsigned int n);
+
+/**
+ * @brief Create a copy of the given matrix.
+ * @pre \p source may **not** be NULL.
+ */
+IntervalMatrix *cpyIntervalMatrix(const IntervalMatrix *const source);
+
+/**
+ * @brief Deallocate the given matrix.
+ * @pre \p matrix may **not** be NULL.
+ */
+void delIntervalMatrix(IntervalMatrix *matrix);
+
+/**
+ * @brief Print the matrix, one row per line.
+ */
+void printIntervalMatrix(const IntervalMatrix *const matrix, FILE *where);
+
+/**
+ * @brief Access the element at the given row and column.
+ * @pre The row and column must be within the bounds of the matrix.
+ *
+ * @return Interval* A pointer into the matrix, which may be written to.
+ */
+Interval *elemIntervalMatrix(const IntervalMatrix *const matrix,
+                             const unsigned int row, const unsigned int col);
+
+/**
+ * @brief Binary interval matrix addition.
+ * @pre Both operands must have the same dimensions.
+ *
+ * @return IntervalMatrix* A newly heap-allocated matrix, \p left + \p right.
+ */
+IntervalMatrix *addIntervalMatrix(const IntervalMatrix *const left,
+                                  const IntervalMatrix *const right);
+
+/**
+ * @brief Binary interval matrix multiplication.
+ * @pre The number of columns of \p left must equal the number of rows of
+ * \p right.
+ *
+ * @return IntervalMatrix* A newly heap-allocated matrix, \p left * \p right.
+ */
+IntervalMatrix *mulIntervalMatrix(const IntervalMatrix *const left,
+                                  const IntervalMatrix *const right);
+
+/**
+ * @brief Multiply every element of the matrix by an interval scalar.
+ *
+ * @return IntervalMatrix* A newly heap-allocated matrix,
+ * \p scalar * \p matrix.
+ */
+IntervalMatrix *scaleIntervalMatrix(const IntervalMatrix *const matrix,
+                                    const Interval *const scalar);
+
+/**
+ * @brief The elementwise interval hull of two matrices, i.e. the smallest
+ * interval matrix that contains both.
+ * @pre Both operands must have the same dimensions.
+ *
+ * @return IntervalMatrix* A newly heap-allocated hull matrix.
+ */
+IntervalMatrix *hullIntervalMatrix(const IntervalMatrix *const left,
+                                   const IntervalMatrix *const right);
+
+/**
+ * @brief The infinity norm of the matrix, i.e. the largest row sum of
+ * element magnitudes.
+ * @details Every matrix contained in the interval matrix has a norm of at
+ * most this value.
+ */
+double normIntervalMatrix(const IntervalMatrix *const matrix);
+
+/**
+ * @brief Enclose the exponential of every matrix contained in the given
+ * square interval matrix.
+ * @details Scaling and squaring: first the matrix M is scaled by
+ * \f$ 2^{-s} \f$ until \f$ \|M 2^{-s}\| \le \frac{1}{2} \f$. Then the
+ * exponential of the scaled matrix is enclosed by its Taylor series up to
+ * \p order, plus the remainder bound
+ * \f$ \frac{\|M\|^{K+1}}{(K+1)!} \frac{1}{1 - \|M\| / (K+2)} \f$ on every
+ * element, where K is the \p order. Finally, the enclosure is squared s
+ * times, since \f$ e^M = (e^{M 2^{-s}})^{2^s} \f$.
+ *
+ * The input may contain intervals, e.g. \f$ A \cdot [0, T] \f$, in which
+ * case the result encloses \f$ e^{At} \f$ for all t in [0, T].
+ * @pre \p matrix must be square and not NULL.
+ * @pre \p order must be > 0.
+ *
+ * @param[in] matrix The matrix M to exponentiate.
+ * @param[in] order  The number of terms K of the Taylor series.
+ * @return IntervalMatrix* A newly heap-allocated enclosure of \f$ e^M \f$.
+ */
+IntervalMatrix *expIntervalMatrix(const IntervalMatrix *const matrix,
+                                  const unsigned int order);
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file intervalsimd.h
+ * @brief Private helpers of the vector kernels of interval arithmetic.
+ * @details The kernels keep an interval [a, b] packed in one register. Most
+ * of them carry the lower bound negated, as [-a, b], so that a single
+ * upward-rounded operation, max or min serves both bounds at once.
+ *
+ * The kernels are selected at build time by the 'simd' option: the widest
+ * vector extension the compiler targets, unless INTERVAL_SIMD_NONE is
+ * defined. Exactly one of INTERVAL_SIMD_AVX2, INTERVAL_SIMD_SSE2 or
+ * INTERVAL_SIMD_SCALAR is defined after inclusion.
+ * @note Only for the implementation files of this module; not installed.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef INTERVAL_SIMD_H
+#define INTERVAL_SIMD_H
+
+#include "interval.h"
+
+#if !defined(INTERVAL_SIMD_NONE) && defined(__AVX2__)
+#define INTERVAL_SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(INTERVAL_SIMD_NONE) && defined(__SSE2__)
+#define INTERVAL_SIMD_SSE2
+#include <emmintrin.h>
+#else
+#define INTERVAL_SIMD_SCALAR
+#endif
+
+#ifndef INTERVAL_SIMD_SCALAR
+/* The vector kernels load an interval as the packed pair [a, b]. */
+_Static_assert(sizeof(Interval) == 2 * sizeof(double),
+               "Interval must be a packed pair of doubles");
+
+/* Negate the lower (resp. upper) lane by flipping its sign bit. */
+#define LOWER_SIGN _mm_set_pd(0., -0.)
+#define UPPER_SIGN _mm_set_pd(-0., 0.)
+
+static inline __m128d loadInterval(const Interval *const source) {
+  return _mm_loadu_pd(&source->left);
+}
+
+static inline Interval storeInterval(const __m128d bounds) {
+  double result[2];
+  _mm_storeu_pd(result, bounds);
+  return newInterval(result[0], result[1]);
+}
+
+/* The interval [a, b] as [-a, b]. */
+static inline __m128d loadNegLower(const Interval *const source) {
+  return _mm_xor_pd(loadInterval(source), LOWER_SIGN);
+}
+
+/* The interval [-max(down), max(up)] of the negated lower bound candidates
+  down and the upper bound candidates up, without any branches. */
+static inline Interval reduceBounds(const __m128d down, const __m128d up) {
+  __m128d low = _mm_unpacklo_pd(down, up);
+  __m128d high = _mm_unpackhi_pd(down, up);
+  return storeInterval(_mm_xor_pd(_mm_max_pd(low, high), LOWER_SIGN));
+}
+#endif
+
+#endif
@@ -23,6 +23,16 @@ Domain *newDomainElem(Domain *tail, char *var, const Interval domain) {
   return appDomainElem(tail, head);
 }
 
+Domain *cpyDomain(const Domain *list) {
+  /* Base case: The tail/next of the last element is NULL. */
+  if (list == NULL)
+    return NULL;
+
+  /* Recursive case: The tail of the new element is everything built until now.
+   */
+  return newDomainElem(cpyDomain(list->next), strdup(list->var), list->domain);
+}
+
 void delDomain(Domain *list) {
   if (list->next != NULL)
     delDomain(list->next);
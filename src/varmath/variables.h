@@ -20,6 +20,7 @@
 
 #include "interval.h"
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * @brief A class representing a vector of variables, each restricted
@@ -86,6 +87,14 @@ Domain *appDomainElem(Domain *tail, Domain *head);
  */
 Domain *newDomainElem(Domain *tail, char *var, const Interval domain);
 
+/**
+ * @brief Create a copy of the entire, given list.
+ *
+ * @param[in] list The list to copy.
+ * @return Domain* A heap-allocated copy of the list.
+ */
+Domain *cpyDomain(const Domain *list);
+
 /**
  * @brief Deallocate the given list.
  * @pre The given list must not be NULL.
@@ -0,0 +1,120 @@
+#include "affine.h"
+#include "interval.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Print the form and its range, and check that the range is within
+  [left, right] and contains [inner, outer]. */
+void testAffineRange(const AffineForm *form, double left, double right,
+                     double inner, double outer) {
+  Interval range = rangeAffineForm(form);
+  printAffineForm(form, stdout);
+  printf("\nRange: ");
+  printInterval(&range, stdout);
+  printf("\n");
+  fflush(stdout);
+  assert(left <= range.left && range.right <= right);
+  assert(range.left <= inner && outer <= range.right);
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  /* Test the construction of forms. */
+  {
+    printf("\n=== Affine forms ===\n");
+    fflush(stdout);
+
+    Interval domain = newInterval(1, 3);
+    AffineForm *x = newAffineVariable(&domain, 0, 2);
+    assert(x->center == 2 && x->coefs[0] == 1 && x->coefs[1] == 0);
+    assert(x->error == 0);
+    testAffineRange(x, 1, 3, 1, 3);
+
+    AffineForm *constant = newAffineForm(&domain, 2);
+    assert(constant->coefs[0] == 0 && constant->error == 1);
+    AffineForm *copy = cpyAffineForm(constant);
+    testAffineRange(copy, 1, 3, 1, 3);
+
+    /* Clean */
+    delAffineForm(copy);
+    delAffineForm(constant);
+    delAffineForm(x);
+  }
+
+  /* Test that dependencies cancel. */
+  {
+    printf("\n=== Affine arithmetic ===\n");
+    fflush(stdout);
+
+    Interval domainX = newInterval(-1, 1);
+    Interval domainY = newInterval(2, 4);
+    AffineForm *x = newAffineVariable(&domainX, 0, 2);
+    AffineForm *y = newAffineVariable(&domainY, 1, 2);
+
+    /* x - x = 0 */
+    AffineForm *zero = subAffineForm(x, x);
+    testAffineRange(zero, 0, 0, 0, 0);
+
+    /* (x + y) - x = y */
+    AffineForm *sum = addAffineForm(x, y);
+    AffineForm *difference = subAffineForm(sum, x);
+    testAffineRange(difference, 2, 4, 2, 4);
+
+    /* -x + x = 0 */
+    AffineForm *negated = negAffineForm(x);
+    AffineForm *cancelled = addAffineForm(negated, x);
+    testAffineRange(cancelled, 0, 0, 0, 0);
+
+    /* x * y in [-4, 4]; affine forms bound it by [-5, 5] */
+    AffineForm *product = mulAffineForm(x, y);
+    testAffineRange(product, -5, 5, -4, 4);
+
+    /* x^2 is never negative, x^3 is odd */
+    AffineForm *square = pow2AffineForm(x, 2);
+    testAffineRange(square, 0, 1, 0, 1);
+    AffineForm *cube = pow2AffineForm(x, 3);
+    testAffineRange(cube, -2, 2, -1, 1);
+    AffineForm *one = pow2AffineForm(x, 0);
+    testAffineRange(one, 1, 1, 1, 1);
+
+    /* x / y in [-0.5, 0.5] */
+    AffineForm *quotient = divAffineForm(x, y);
+    testAffineRange(quotient, -0.5, 0.5, -0.5, 0.5);
+
+    /* Rounding errors go into the error radius: 0.1 + 0.2 */
+    Interval tenth = strtoInterval("0.1");
+    Interval fifth = strtoInterval("0.2");
+    Interval expected = strtoInterval("0.3");
+    AffineForm *a = newAffineForm(&tenth, 2);
+    AffineForm *b = newAffineForm(&fifth, 2);
+    AffineForm *c = addAffineForm(a, b);
+    Interval range = rangeAffineForm(c);
+    assert(range.left <= expected.left && expected.right <= range.right);
+    assert(range.right - range.left < 1e-15);
+
+    /* Clean */
+    delAffineForm(a);
+    delAffineForm(b);
+    delAffineForm(c);
+    delAffineForm(quotient);
+    delAffineForm(one);
+    delAffineForm(cube);
+    delAffineForm(square);
+    delAffineForm(product);
+    delAffineForm(cancelled);
+    delAffineForm(negated);
+    delAffineForm(difference);
+    delAffineForm(sum);
+    delAffineForm(zero);
+    delAffineForm(y);
+    delAffineForm(x);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+#include "batch.h"
+#include "threadpool.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Read an entire file into a newly heap-allocated string. */
+char *readFile(const char *path) {
+  FILE *file = fopen(path, "r");
+  assert(file != NULL);
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  char *content = (char *)calloc(size + 1, 1);
+  assert(content != NULL);
+  assert(fread(content, 1, size, file) == (size_t)size);
+  fclose(file);
+  return content;
+}
+
+/* Parse a job list given as a string. */
+int parseJobString(const char *list, BatchJob **jobs) {
+  FILE *input = tmpfile();
+  assert(input != NULL);
+  fputs(list, input);
+  rewind(input);
+  int code = parseBatchJobs(input, jobs);
+  fclose(input);
+  return code;
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  char dir[] = "/tmp/batch_testXXXXXX";
+  assert(mkdtemp(dir) != NULL);
+  char list[2048];
+  snprintf(list, sizeof(list),
+           "# system | initial set | horizon | output\n"
+           "x' = 1 + y; y' = x^2; | x in [-1, 1]; y in [-0.5, 0.5]; | 0.1 "
+           "| %s/a.txt\n"
+           "\n"
+           "x'=1+y;y'=x^2; | x in [0, 1]; y in [0, 0.5]; | 0.2 | %s/b.txt\n"
+           "x' = y; y' = x; | x in [0, 1]; y in [0, 1]; | 0.1 | %s/c.txt\n"
+           "x' = ; | x in [0, 1]; | 0.1 | %s/d.txt\n"
+           "x' = y; y' = x; | x in [0, 1]; | 0.1 | %s/e.txt\n",
+           dir, dir, dir, dir, dir);
+  BatchOptions options = {3, 3, 1e-3, 4, SPLIT_WIDEST};
+  ThreadPool *pool = newThreadPool(4);
+
+  /* Test reading a job list. */
+  {
+    printf("\n=== Parse job list ===\n");
+    fflush(stdout);
+
+    BatchJob *jobs;
+    assert(parseJobString(list, &jobs) == 0);
+    assert(lengthBatchJob(jobs) == 5);
+    assert(strcmp(jobs->system, "x' = 1 + y; y' = x^2;") == 0);
+    assert(strcmp(jobs->initial, "x in [-1, 1]; y in [-0.5, 0.5];") == 0);
+    assert(jobs->horizon == 0.1);
+    assert(jobs->status == BATCH_PENDING);
+    printBatchJob(jobs, stdout);
+    delBatchJob(jobs);
+
+    /* The output is optional, the horizon is not. */
+    assert(parseJobString("x' = y; | x in [0, 1]; | 1\n", &jobs) == 0);
+    assert(strcmp(jobs->output, "job1.txt") == 0);
+    delBatchJob(jobs);
+    assert(parseJobString("x' = y; | x in [0, 1];\n", &jobs) != 0);
+    assert(jobs == NULL);
+    assert(parseJobString("x' = y; | x in [0, 1]; | soon\n", &jobs) != 0);
+    assert(jobs == NULL);
+
+    /* Jobs may not share an output, be it given or by default. */
+    assert(parseJobString("x' = y; | x in [0, 1]; | 1 | out.txt\n"
+                          "x' = x; | x in [0, 1]; | 1 | out.txt\n",
+                          &jobs) != 0);
+    assert(jobs == NULL);
+    assert(parseJobString("x' = y; | x in [0, 1]; | 1 | job2.txt\n"
+                          "x' = x; | x in [0, 1]; | 1\n",
+                          &jobs) != 0);
+    assert(jobs == NULL);
+  }
+
+  /* Test running the batch: identical systems share an index, invalid jobs
+    fail without affecting the others, and the output does not depend on the
+    pool. */
+  {
+    printf("\n=== Run batch ===\n");
+    fflush(stdout);
+
+    BatchJob *jobs;
+    assert(parseJobString(list, &jobs) == 0);
+    unsigned int failed = runBatch(jobs, &options, NULL);
+    printBatchJob(jobs, stdout);
+    assert(failed == 2);
+
+    BatchJob *a = jobs, *b = a->next, *c = b->next, *d = c->next,
+             *e = d->next;
+    assert(a->status == BATCH_DONE);
+    assert(b->status == BATCH_DONE);
+    assert(c->status == BATCH_DONE);
+    assert(d->status == BATCH_INVALID);
+    assert(e->status == BATCH_INVALID);
+    assert(a->systemIndex == b->systemIndex);
+    assert(a->systemIndex != c->systemIndex);
+
+    char *serial = readFile(a->output);
+    printf("%s", serial);
+    assert(strncmp(serial, "# system: ", 10) == 0);
+    assert(strstr(serial, "t in [0.000000, 0.100000]") != NULL);
+
+    failed = runBatch(jobs, &options, pool);
+    assert(failed == 2);
+    char *parallel = readFile(a->output);
+    assert(strcmp(serial, parallel) == 0);
+
+    /* Clean */
+    for (BatchJob *job = jobs; job != NULL; job = job->next)
+      remove(job->output);
+    free(serial);
+    free(parallel);
+    delBatchJob(jobs);
+  }
+
+  /* Test that a variable or parameter of the vector field without a domain
+    makes the job invalid, instead of failing during evaluation. */
+  {
+    printf("\n=== Free variables ===\n");
+    fflush(stdout);
+
+    snprintf(list, sizeof(list),
+             "x' = mu * x; | x in [0, 1]; | 0.1 | %s/f.txt\n"
+             "param mu; x' = mu * x; | x in [0, 1]; | 0.1 | %s/g.txt\n"
+             "param mu; x' = mu * x; | x in [0, 1]; mu in [1, 2]; | 0.1 "
+             "| %s/h.txt\n",
+             dir, dir, dir);
+    BatchJob *jobs;
+    assert(parseJobString(list, &jobs) == 0);
+    unsigned int failed = runBatch(jobs, &options, pool);
+    printBatchJob(jobs, stdout);
+    assert(failed == 2);
+    assert(jobs->status == BATCH_INVALID);
+    assert(jobs->next->status == BATCH_INVALID);
+    assert(jobs->next->next->status == BATCH_DONE);
+
+    /* Clean */
+    remove(jobs->next->next->output);
+    delBatchJob(jobs);
+  }
+
+  /* Clean */
+  remove(dir);
+  delThreadPool(pool);
+
+  return 0;
+}
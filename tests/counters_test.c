@@ -0,0 +1,127 @@
+#include "counters.h"
+#include "funexp.h"
+#include "taylormodel.h"
+#include "threadpool.h"
+#include "transformations.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define THREADS 4
+#define TASKS 64
+#define TREES_PER_TASK 100
+
+/* Allocate and free a few trees of three nodes. */
+void allocateTrees(unsigned int index, void *context) {
+  (void)index;
+  (void)context;
+
+  for (unsigned int it = 0; it < TREES_PER_TASK; ++it)
+    delExpTree(newExpOp(EXP_ADD_OP, newExpLeaf(EXP_VAR, "x"),
+                        newExpLeaf(EXP_NUM, "1")));
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  CounterValue values[COUNTER_COUNT];
+
+  /* Test that every counter has a distinct name. */
+  {
+    printf("\n=== Names ===\n");
+    fflush(stdout);
+
+    for (unsigned int i = 0; i < COUNTER_COUNT; ++i)
+      for (unsigned int j = i + 1; j < COUNTER_COUNT; ++j)
+        assert(strcmp(counterName(i), counterName(j)) != 0);
+    assert(strcmp(counterName(COUNTER_MUL_TM), "mulTM") == 0);
+  }
+
+  /* Test that node allocations are counted, and merged over threads. */
+  {
+    printf("\n=== Allocations ===\n");
+    fflush(stdout);
+
+    resetCounters();
+    ExpTree *tree = newExpOp(EXP_MUL_OP, newExpLeaf(EXP_VAR, "x"),
+                             newExpLeaf(EXP_VAR, "y"));
+    ExpTree *copy = cpyExpTree(tree);
+    delExpTree(tree);
+    readCounters(values);
+    if (countersEnabled()) {
+      assert(values[COUNTER_NODES_ALLOCATED].count == 6);
+      assert(values[COUNTER_NODES_FREED].count == 3);
+    }
+    delExpTree(copy);
+
+    ThreadPool *pool = newThreadPool(THREADS);
+    resetCounters();
+    parallelFor(pool, TASKS, allocateTrees, NULL);
+    readCounters(values);
+    if (countersEnabled()) {
+      assert(values[COUNTER_NODES_ALLOCATED].count ==
+             3 * TASKS * TREES_PER_TASK);
+      assert(values[COUNTER_NODES_FREED].count == 3 * TASKS * TREES_PER_TASK);
+    }
+
+    /* The counts of exited threads are kept. */
+    delThreadPool(pool);
+    readCounters(values);
+    if (countersEnabled())
+      assert(values[COUNTER_NODES_ALLOCATED].count ==
+             3 * TASKS * TREES_PER_TASK);
+  }
+
+  /* Test that TM operations, truncation and evaluation are counted. */
+  {
+    printf("\n=== Taylor models ===\n");
+    fflush(stdout);
+
+    Domain *domain = newDomainElem(NULL, strdup("x"), newInterval(-1, 1));
+    TaylorModel *left =
+        newTMElem(newTaylorModel(strdup("y"), newExpLeaf(EXP_VAR, "x"),
+                                 newInterval(0, 0)),
+                  strdup("x"), newExpLeaf(EXP_VAR, "x"), newInterval(0, 0));
+
+    resetCounters();
+    TaylorModel *product = mulTM(left, left, domain, 1);
+    TaylorModel *sum = addTM(product, left, domain, 1);
+    readCounters(values);
+    printCounters(stdout);
+    if (countersEnabled()) {
+      assert(values[COUNTER_MUL_TM].count == 2);
+      assert(values[COUNTER_ADD_TM].count == 2);
+      /* Both operations truncate each component once. */
+      assert(values[COUNTER_TRUNCATE_TM].count == 4);
+      /* x * x is dropped at order 1, in both components. */
+      assert(values[COUNTER_TRUNCATED_TERMS].count >= 2);
+      assert(values[COUNTER_EVALUATE].count > 0);
+      assert(values[COUNTER_MUL_TM].nanoseconds > 0);
+    } else {
+      for (unsigned int it = 0; it < COUNTER_COUNT; ++it)
+        assert(values[it].count == 0 && values[it].nanoseconds == 0);
+    }
+
+    /* Clean */
+    delTaylorModel(sum);
+    delTaylorModel(product);
+    delTaylorModel(left);
+    delDomain(domain);
+  }
+
+  /* Test that a reset zeroes all counters. */
+  {
+    printf("\n=== Reset ===\n");
+    fflush(stdout);
+
+    resetCounters();
+    readCounters(values);
+    for (unsigned int it = 0; it < COUNTER_COUNT; ++it)
+      assert(values[it].count == 0 && values[it].nanoseconds == 0);
+  }
+
+  return EXIT_SUCCESS;
+}
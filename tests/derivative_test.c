@@ -218,5 +218,33 @@ int main(int argc, char *argv[]) {
     delExpTree(sqrt_x_cubed);
   }
 
+  /* Test derivative of -(x / y) */
+  {
+    ExpTree *x = newExpLeaf(EXP_VAR, "x");
+    ExpTree *y = newExpLeaf(EXP_VAR, "y");
+    ExpTree *neg_div = newExpOp(EXP_NEG, newExpOp(EXP_DIV_OP, x, y), NULL);
+    test_derivative(neg_div, "x", "-(((1 * y) - (x * 0)) / (y^2))");
+    test_derivative(neg_div, "y", "-(((0 * y) - (x * 1)) / (y^2))");
+    delExpTree(neg_div);
+  }
+
+  /* Test derivatives of exp, log, atan and tanh */
+  {
+    ExpTree *x = newExpLeaf(EXP_VAR, "x");
+    ExpTree *fun = newExpTree(EXP_FUN, strdup("exp"), cpyExpTree(x), NULL);
+    test_derivative(fun, "x", "(exp(x) * 1)");
+    delExpTree(fun);
+    fun = newExpTree(EXP_FUN, strdup("log"), cpyExpTree(x), NULL);
+    test_derivative(fun, "x", "(1 / x)");
+    delExpTree(fun);
+    fun = newExpTree(EXP_FUN, strdup("atan"), cpyExpTree(x), NULL);
+    test_derivative(fun, "x", "(1 / (1 + (x^2)))");
+    delExpTree(fun);
+    fun = newExpTree(EXP_FUN, strdup("tanh"), cpyExpTree(x), NULL);
+    test_derivative(fun, "x", "((1 - (tanh(x)^2)) * 1)");
+    delExpTree(fun);
+    delExpTree(x);
+  }
+
   return 0;
 }
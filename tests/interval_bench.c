@@ -0,0 +1,134 @@
+#include "interval.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define OPERANDS 4096
+#define REPEATS 200
+
+typedef Interval (*IntervalOp)(const Interval *const, const Interval *const);
+
+/* The scalar reference kernels, which round like the library kernels. */
+Interval refAdd(const Interval *const left, const Interval *const right) {
+  beginOutwardRounding();
+  Interval sum = newInterval(-(-left->left - right->left),
+                             left->right + right->right);
+  endOutwardRounding();
+  return sum;
+}
+
+Interval refSub(const Interval *const left, const Interval *const right) {
+  beginOutwardRounding();
+  Interval difference = newInterval(-(right->right - left->left),
+                                    left->right - right->left);
+  endOutwardRounding();
+  return difference;
+}
+
+Interval refMul(const Interval *const left, const Interval *const right) {
+  beginOutwardRounding();
+  double lower = fmin(
+      fmin(-((-left->left) * right->left), -((-left->left) * right->right)),
+      fmin(-((-left->right) * right->left), -((-left->right) * right->right)));
+  double upper = fmax(fmax(left->left * right->left, left->left * right->right),
+                      fmax(left->right * right->left,
+                           left->right * right->right));
+  Interval product = newInterval(lower, upper);
+  endOutwardRounding();
+  return product;
+}
+
+Interval refDiv(const Interval *const left, const Interval *const right) {
+  beginOutwardRounding();
+  Interval inverted = newInterval(-((-1.) / right->right), 1. / right->left);
+  Interval quotient = refMul(left, &inverted);
+  endOutwardRounding();
+  return quotient;
+}
+
+/* A random interval in [-10, 10] that does not contain 0 if positive. */
+Interval randomInterval(bool positive) {
+  double a = 20. * rand() / RAND_MAX - 10.;
+  double b = 20. * rand() / RAND_MAX - 10.;
+  if (positive) {
+    a = fabs(a) + 0.5;
+    b = fabs(b) + 0.5;
+  }
+  return newInterval(fmin(a, b), fmax(a, b));
+}
+
+/* The average time of one operation in nanoseconds. */
+double timeOp(volatile IntervalOp op, const Interval *left,
+              const Interval *right, Interval *result) {
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  beginOutwardRounding();
+  for (unsigned int repeat = 0; repeat < REPEATS; ++repeat)
+    for (unsigned int it = 0; it < OPERANDS; ++it)
+      result[it] = op(&left[it], &right[it]);
+  endOutwardRounding();
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double elapsed =
+      (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+  return elapsed / ((double)REPEATS * OPERANDS);
+}
+
+/* Time the kernel against the reference and check that they agree. */
+void benchOp(const char *name, IntervalOp kernel, IntervalOp reference,
+             const Interval *left, const Interval *right) {
+  Interval *expected = (Interval *)malloc(OPERANDS * sizeof(Interval));
+  Interval *actual = (Interval *)malloc(OPERANDS * sizeof(Interval));
+  assert(expected != NULL && actual != NULL);
+
+  double referenceTime = timeOp(reference, left, right, expected);
+  double kernelTime = timeOp(kernel, left, right, actual);
+  printf("%s: scalar %.2f ns, %s %.2f ns, speedup %.2fx\n", name,
+         referenceTime, intervalKernels(), kernelTime,
+         referenceTime / kernelTime);
+  fflush(stdout);
+
+  for (unsigned int it = 0; it < OPERANDS; ++it)
+    assert(actual[it].left == expected[it].left &&
+           actual[it].right == expected[it].right);
+
+  /* Clean */
+  free(expected);
+  free(actual);
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  printf("\n=== Interval kernels: %s ===\n", intervalKernels());
+  fflush(stdout);
+
+  srand(42);
+  Interval *left = (Interval *)malloc(OPERANDS * sizeof(Interval));
+  Interval *right = (Interval *)malloc(OPERANDS * sizeof(Interval));
+  Interval *divisors = (Interval *)malloc(OPERANDS * sizeof(Interval));
+  assert(left != NULL && right != NULL && divisors != NULL);
+  for (unsigned int it = 0; it < OPERANDS; ++it) {
+    left[it] = randomInterval(false);
+    right[it] = randomInterval(false);
+    divisors[it] = randomInterval(true);
+    if (it % 2 == 0)
+      divisors[it] = negInterval(&divisors[it]);
+  }
+
+  benchOp("add", addInterval, refAdd, left, right);
+  benchOp("sub", subInterval, refSub, left, right);
+  benchOp("mul", mulInterval, refMul, left, right);
+  benchOp("div", divInterval, refDiv, left, divisors);
+
+  /* Clean */
+  free(left);
+  free(right);
+  free(divisors);
+
+  return EXIT_SUCCESS;
+}
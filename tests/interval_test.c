@@ -438,4 +438,134 @@ int main(int argc, char *argv[]) {
     testString(&iPos, "[1.000000, 2.000000]");
     testString(&iDegen, "[12.000000, 12.000000]");
   }
+
+  /* Test outward rounding. */
+  {
+    printf("\n=== Outward rounding ===\n");
+    fflush(stdout);
+
+    /* 0.1 is not representable, so its enclosure has width one ulp. */
+    Interval tenth = strtoInterval("0.1");
+    printInterval(&tenth, stdout);
+    printf("\n");
+    assert(tenth.left < tenth.right);
+    assert(nextafter(tenth.left, 1) == tenth.right);
+    assert(tenth.left <= 0.1 && 0.1 <= tenth.right);
+    Interval negTenth = strtoInterval("-0.1");
+    assert(negTenth.left == -tenth.right && negTenth.right == -tenth.left);
+    Interval two = strtoInterval("2");
+    assert(two.left == 2 && two.right == 2);
+
+    /* [0.1] + [0.2] encloses 0.3, which round-to-nearest misses. */
+    Interval fifth = strtoInterval("0.2");
+    Interval sum = addInterval(&tenth, &fifth);
+    Interval third = strtoInterval("0.3");
+    assert(sum.left <= third.left && third.right <= sum.right);
+    Interval diff = subInterval(&sum, &fifth);
+    assert(diff.left <= tenth.left && tenth.right <= diff.right);
+
+    /* 1/3 is not representable either. */
+    Interval one = newInterval(1, 1);
+    Interval three = newInterval(3, 3);
+    Interval quotient = divInterval(&one, &three);
+    assert(quotient.left < quotient.right);
+    Interval product = mulInterval(&quotient, &three);
+    assert(product.left <= 1 && 1 <= product.right);
+    Interval root = sqrtInterval(&two);
+    assert(root.left < root.right);
+    assert(root.left * root.left <= 2 && 2 <= root.right * root.right);
+
+    /* Scopes nest and restore the caller's rounding mode. */
+    assert(!isOutwardRounding());
+    beginOutwardRounding();
+    beginOutwardRounding();
+    assert(isOutwardRounding());
+    Interval inner = addInterval(&tenth, &fifth);
+    endOutwardRounding();
+    assert(isOutwardRounding());
+    assert(fegetround() == FE_UPWARD);
+    endOutwardRounding();
+    assert(!isOutwardRounding());
+    assert(fegetround() == FE_TONEAREST);
+    assert(inner.left == sum.left && inner.right == sum.right);
+  }
+
+  /* Test the elementary functions. */
+  {
+    printf("\n=== Elementary functions ===\n");
+    fflush(stdout);
+
+    /* Monotone functions enclose their values at the bounds. */
+    Interval x = newInterval(-0.5, 2);
+    Interval res = expInterval(&x);
+    assert(res.left < exp(-0.5) && exp(2) < res.right);
+    testInterval(&res, exp(-0.5), exp(2), 1e-6);
+    res = atanInterval(&x);
+    testInterval(&res, atan(-0.5), atan(2), 1e-6);
+    res = tanhInterval(&x);
+    testInterval(&res, tanh(-0.5), tanh(2), 1e-6);
+    x = newInterval(0.5, 2);
+    res = logInterval(&x);
+    assert(res.left < log(0.5) && log(2) < res.right);
+    testInterval(&res, log(0.5), log(2), 1e-6);
+
+    /* The ranges are clamped. */
+    x = newInterval(-1000, 1000);
+    res = tanhInterval(&x);
+    assert(res.left == -1 && res.right == 1);
+    res = expInterval(&x);
+    assert(res.left == 0);
+
+    /* sin on [0, 1] is increasing; [0, 2] contains the maximum at pi/2,
+      [1, 5] the minimum at 3 pi/2 as well. */
+    x = newInterval(0, 1);
+    res = sinInterval(&x);
+    assert(res.left <= 0 && sin(1) < res.right && res.right < 1);
+    testInterval(&res, 0, sin(1), 1e-6);
+    x = newInterval(0, 2);
+    res = sinInterval(&x);
+    testInterval(&res, 0, 1, 1e-6);
+    assert(res.right == 1);
+    x = newInterval(1, 5);
+    res = sinInterval(&x);
+    testInterval(&res, -1, 1, 1e-6);
+
+    /* cos on [1, 3] is decreasing; [3, 4] contains the minimum at pi. */
+    x = newInterval(1, 3);
+    res = cosInterval(&x);
+    testInterval(&res, cos(3), cos(1), 1e-6);
+    x = newInterval(3, 4);
+    res = cosInterval(&x);
+    testInterval(&res, -1, cos(4), 1e-6);
+    assert(res.left == -1);
+
+    /* Argument reduction works far from the origin: 2^20 pi is a maximum
+      of cos, and a point next to it is not in the interval. */
+    double far = ldexp(M_PI, 20);
+    x = newInterval(far + 0.5, far + 1);
+    res = cosInterval(&x);
+    testInterval(&res, cos(far + 1), cos(far + 0.5), 1e-6);
+    x = newInterval(far - 0.5, far + 0.5);
+    res = cosInterval(&x);
+    assert(res.right == 1);
+
+    /* A full period covers the whole range. */
+    x = newInterval(-10, 10);
+    res = cosInterval(&x);
+    assert(res.left == -1 && res.right == 1);
+
+    /* The C library is evaluated in round-to-nearest also inside an outward
+      rounding scope, which is left as it was. */
+    x = newInterval(0.5, 1.5);
+    Interval nearest[4] = {sinInterval(&x), cosInterval(&x), expInterval(&x),
+                           logInterval(&x)};
+    beginOutwardRounding();
+    Interval upward[4] = {sinInterval(&x), cosInterval(&x), expInterval(&x),
+                          logInterval(&x)};
+    assert(fegetround() == FE_UPWARD);
+    endOutwardRounding();
+    for (unsigned int it = 0; it < 4; ++it)
+      assert(nearest[it].left == upward[it].left &&
+             nearest[it].right == upward[it].right);
+  }
 }
@@ -0,0 +1,135 @@
+#include "funexp.h"
+#include "interval.h"
+#include "intervalbox.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "variables.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Check that the interval equals [left, right] exactly. */
+void testInterval(const Interval *actual, double left, double right) {
+  printf("Expect: [%f, %f]\n", left, right);
+  printf("Actual: ");
+  printInterval(actual, stdout);
+  printf("\n");
+  fflush(stdout);
+  assert(actual->left == left && actual->right == right);
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  /* Test symbol interning. */
+  {
+    printf("\n=== Symbols ===\n");
+    fflush(stdout);
+
+    SymbolTable *symbols = newSymbolTable();
+    assert(internSymbol(symbols, "x") == 0);
+    assert(internSymbol(symbols, "y") == 1);
+    assert(internSymbol(symbols, "x") == 0);
+    assert(findSymbol(symbols, "y") == 1);
+    assert(findSymbol(symbols, "z") == SYMBOL_NOT_FOUND);
+    assert(strcmp(symbolName(symbols, 1), "y") == 0);
+
+    /* Growing the index keeps all IDs. */
+    char name[16];
+    for (unsigned int it = 0; it < 100; ++it) {
+      snprintf(name, sizeof(name), "v%u", it);
+      assert(internSymbol(symbols, name) == it + 2);
+    }
+    for (unsigned int it = 0; it < 100; ++it) {
+      snprintf(name, sizeof(name), "v%u", it);
+      assert(findSymbol(symbols, name) == it + 2);
+    }
+    assert(symbols->length == 102);
+    assert(findSymbol(symbols, "x") == 0);
+
+    delSymbolTable(symbols);
+  }
+
+  /* Test the box operations. */
+  {
+    printf("\n=== Boxes ===\n");
+    fflush(stdout);
+
+    Domain *domain = newDomainElem(NULL, strdup("y"), newInterval(1, 2));
+    domain = newDomainElem(domain, strdup("x"), newInterval(-1, 1));
+    SymbolTable *symbols = newSymbolTable();
+    IntervalBox *box = toIntervalBox(domain, symbols);
+    printIntervalBox(box, symbols, stdout);
+    printf("\n");
+    assert(box->dim == 2);
+    assert(findSymbol(symbols, "x") == 0);
+    testInterval(&box->data[1], 1, 2);
+
+    /* Back to a domain, in the same order. */
+    Domain *back = fromIntervalBox(box, symbols);
+    assert(strcmp(back->var, "x") == 0 && strcmp(back->next->var, "y") == 0);
+    testInterval(&back->next->domain, 1, 2);
+    delDomain(back);
+
+    IntervalBox *other = newIntervalBox(2);
+    other->data[0] = newInterval(0, 3);
+    other->data[1] = newInterval(1.5, 4);
+
+    IntervalBox *hull = hullIntervalBox(box, other);
+    testInterval(&hull->data[0], -1, 3);
+    testInterval(&hull->data[1], 1, 4);
+    assert(subeqIntervalBox(box, hull) && subeqIntervalBox(other, hull));
+    assert(!subeqIntervalBox(hull, box));
+
+    IntervalBox *meet = intersectIntervalBox(box, other);
+    assert(meet != NULL);
+    testInterval(&meet->data[0], 0, 1);
+    testInterval(&meet->data[1], 1.5, 2);
+    assert(subeqIntervalBox(meet, box) && subeqIntervalBox(meet, other));
+
+    other->data[1] = newInterval(2.5, 3);
+    assert(intersectIntervalBox(box, other) == NULL);
+
+    unsigned int widest;
+    assert(widthIntervalBox(hull, &widest) == 4 && widest == 0);
+    double point[2];
+    midpointIntervalBox(hull, point);
+    assert(point[0] == 1 && point[1] == 2.5);
+    assert(elemIntervalBox(point, hull));
+    assert(!elemIntervalBox(point, box));
+
+    IntervalBox *lower = bisectIntervalBox(hull, 0, false);
+    IntervalBox *upper = bisectIntervalBox(hull, 0, true);
+    testInterval(&lower->data[0], -1, 1);
+    testInterval(&upper->data[0], 1, 3);
+    testInterval(&upper->data[1], 1, 4);
+    IntervalBox *whole = hullIntervalBox(lower, upper);
+    assert(subeqIntervalBox(whole, hull) && subeqIntervalBox(hull, whole));
+
+    /* Evaluating over the box agrees with evaluating over the domain. */
+    ExpTree *exp = newExpOp(EXP_MUL_OP, var("y"),
+                            newExpOp(EXP_ADD_OP, var("x"), num("0.5")));
+    Interval expected = evaluateExpTree(exp, domain);
+    Interval actual = evaluateExpTreeBox(exp, symbols, box);
+    testInterval(&actual, expected.left, expected.right);
+    testInterval(&actual, -1, 3);
+    delExpTree(exp);
+
+    /* Clean */
+    delIntervalBox(whole);
+    delIntervalBox(lower);
+    delIntervalBox(upper);
+    delIntervalBox(meet);
+    delIntervalBox(hull);
+    delIntervalBox(other);
+    delIntervalBox(box);
+    delSymbolTable(symbols);
+    delDomain(domain);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+#include "funexp.h"
+#include "intervalmatrix.h"
+#include "syslineq.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "tmlinear.h"
+#include "tmsplit.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The enclosures are rigorous, but the expected values come from libm,
+  which may be an ulp off. */
+#define TOLERANCE 1e-15
+
+void testContains(const Interval *actual, double expected) {
+  printf("expect: %.15g in ", expected);
+  printInterval(actual, stdout);
+  printf("\n");
+  fflush(stdout);
+  double slack = TOLERANCE * fmax(1, fabs(expected));
+  assert(actual->left - slack <= expected && expected <= actual->right + slack);
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  /* Test affine system detection and the dense form. */
+  {
+    printf("\n=== Affine systems ===\n");
+    fflush(stdout);
+
+    /* x' = 2 * (x - y) + 1; y' = -x / 2 */
+    ODEList *sys = newOdeElem(
+        NULL, strdup("y"),
+        newExpOp(EXP_DIV_OP, newExpOp(EXP_NEG, var("x"), NULL), num("2")));
+    sys = newOdeElem(
+        sys, strdup("x"),
+        newExpOp(EXP_ADD_OP,
+                 newExpOp(EXP_MUL_OP, num("2"),
+                          newExpOp(EXP_SUB_OP, var("x"), var("y"))),
+                 num("1")));
+    LinearSystem *linear = newLinearSystem(sys);
+    assert(linear != NULL);
+    printLinearSystem(linear, stdout);
+    assert(linear->dim == 2);
+    assert(strcmp(linear->vars[0], "x") == 0);
+    assert(linear->matrix[0].left == 2 && linear->matrix[0].right == 2);
+    assert(linear->matrix[1].left == -2 && linear->matrix[1].right == -2);
+    assert(linear->matrix[2].left == -0.5 && linear->matrix[2].right == -0.5);
+    assert(linear->matrix[3].left == 0 && linear->matrix[3].right == 0);
+    assert(linear->offset[0].left == 1 && linear->offset[0].right == 1);
+    assert(linear->offset[1].left == 0 && linear->offset[1].right == 0);
+    delLinearSystem(linear);
+    delOdeList(sys);
+
+    /* x' = 2^3 * x */
+    sys = newOdeElem(NULL, strdup("x"),
+                     newExpOp(EXP_MUL_OP,
+                              newExpOp(EXP_EXP_OP, num("2"), num("3")),
+                              var("x")));
+    linear = newLinearSystem(sys);
+    assert(linear != NULL);
+    assert(linear->matrix[0].left == 8 && linear->matrix[0].right == 8);
+    delLinearSystem(linear);
+    delOdeList(sys);
+
+    /* x' = 0.1 * x + x / 3, whose coefficient is not representable */
+    sys = newOdeElem(NULL, strdup("x"),
+                     newExpOp(EXP_ADD_OP,
+                              newExpOp(EXP_MUL_OP, num("0.1"), var("x")),
+                              newExpOp(EXP_DIV_OP, var("x"), num("3"))));
+    linear = newLinearSystem(sys);
+    assert(linear != NULL);
+    printLinearSystem(linear, stdout);
+    assert(linear->matrix[0].left < linear->matrix[0].right);
+    assert(linear->matrix[0].left <= 0.1 + 1.0 / 3);
+    assert(0.1 + 1.0 / 3 <= linear->matrix[0].right);
+    delLinearSystem(linear);
+    delOdeList(sys);
+
+    /* Products of states, powers of states and time are not affine. */
+    sys = newOdeElem(NULL, strdup("x"),
+                     newExpOp(EXP_MUL_OP, var("x"), var("x")));
+    assert(!isAffineOdeList(sys));
+    delOdeList(sys);
+    sys = newOdeElem(NULL, strdup("x"),
+                     newExpOp(EXP_EXP_OP, var("x"), num("2")));
+    assert(!isAffineOdeList(sys));
+    delOdeList(sys);
+    sys = newOdeElem(NULL, strdup("x"), var("t"));
+    assert(!isAffineOdeList(sys));
+    delOdeList(sys);
+  }
+
+  /* Test the interval matrix exponential against closed forms. */
+  {
+    printf("\n=== Matrix exponential ===\n");
+    fflush(stdout);
+
+    /* A rotation: exp([0 1; -1 0]) = [cos 1, sin 1; -sin 1, cos 1] */
+    IntervalMatrix *rotation = newIntervalMatrix(2, 2);
+    *elemIntervalMatrix(rotation, 0, 1) = newInterval(1, 1);
+    *elemIntervalMatrix(rotation, 1, 0) = newInterval(-1, -1);
+    IntervalMatrix *flow = expIntervalMatrix(rotation, LINEAR_EXP_ORDER);
+    printIntervalMatrix(flow, stdout);
+    testContains(elemIntervalMatrix(flow, 0, 0), cos(1));
+    testContains(elemIntervalMatrix(flow, 0, 1), sin(1));
+    testContains(elemIntervalMatrix(flow, 1, 0), -sin(1));
+    testContains(elemIntervalMatrix(flow, 1, 1), cos(1));
+    for (unsigned int it = 0; it < 4; ++it)
+      assert(intervalWidth(&flow->data[it]) < 1e-9);
+    delIntervalMatrix(flow);
+
+    /* A large norm needs many squarings: exp(diag(-1, 2) * [0, 3]). */
+    IntervalMatrix *diagonal = newIntervalMatrix(2, 2);
+    *elemIntervalMatrix(diagonal, 0, 0) = newInterval(-1, -1);
+    *elemIntervalMatrix(diagonal, 1, 1) = newInterval(2, 2);
+    Interval time = newInterval(0, 3);
+    IntervalMatrix *scaled = scaleIntervalMatrix(diagonal, &time);
+    flow = expIntervalMatrix(scaled, LINEAR_EXP_ORDER);
+    printIntervalMatrix(flow, stdout);
+    for (double t = 0; t <= 3; t += 0.5) {
+      testContains(elemIntervalMatrix(flow, 0, 0), exp(-t));
+      testContains(elemIntervalMatrix(flow, 1, 1), exp(2 * t));
+    }
+    testContains(elemIntervalMatrix(flow, 0, 1), 0);
+
+    /* Clean */
+    delIntervalMatrix(flow);
+    delIntervalMatrix(scaled);
+    delIntervalMatrix(diagonal);
+    delIntervalMatrix(rotation);
+  }
+
+  /* Test that the flow map covers the whole time domain, even though the
+    step is not representable. */
+  {
+    printf("\n=== Flow map ===\n");
+    fflush(stdout);
+
+    /* x' = 1, so x(t) = x0 + t, cut into 3 steps */
+    ODEList *sys = newOdeElem(NULL, strdup("x"), num("1"));
+    LinearSystem *linear = newLinearSystem(sys);
+    Interval time = newInterval(0, 1.1);
+    IntervalMatrix *flowMap = linearFlowMap(linear, &time, LINEAR_EXP_ORDER);
+    const Interval *offset = elemIntervalMatrix(flowMap, 0, 1);
+    printInterval(offset, stdout);
+    printf("\n");
+    assert(offset->left <= 0 && 1.1 <= offset->right);
+
+    /* Clean */
+    delIntervalMatrix(flowMap);
+    delLinearSystem(linear);
+    delOdeList(sys);
+  }
+
+  /* Test that the fast path encloses the true flow of an affine system. */
+  {
+    printf("\n=== Affine flowpipe ===\n");
+    fflush(stdout);
+
+    /* x' = 1 - x, so x(t) = 1 + (x0 - 1) e^{-t} */
+    ODEList *sys = newOdeElem(NULL, strdup("x"),
+                              newExpOp(EXP_SUB_OP, num("1"), var("x")));
+    Domain *domain = newDomainElem(NULL, strdup("t"), newInterval(0, 1));
+    domain = newDomainElem(domain, strdup("x"), newInterval(1, 2));
+    FlowpipeSegment *segments =
+        computeSplitFlowpipe(sys, domain, 3, 3, 1e9, 0, SPLIT_WIDEST, NULL);
+    printFlowpipeSegment(segments, stdout);
+    assert(lengthFlowpipeSegment(segments) == 1);
+
+    const TaylorModel *tm = segments->flowpipe;
+    for (double x0 = 1; x0 <= 2; x0 += 0.25) {
+      Valuation *values = newValuationElem(NULL, strdup("x"), x0);
+      double poly = evaluateExpTreeReal(tm->exp, values);
+      Interval enclosure = newInterval(poly + tm->remainder.left,
+                                       poly + tm->remainder.right);
+      for (double t = 0; t <= 1; t += 0.25)
+        testContains(&enclosure, 1 + (x0 - 1) * exp(-t));
+      delValuation(values);
+    }
+
+    /* Clean */
+    delFlowpipeSegment(segments);
+    delDomain(domain);
+    delOdeList(sys);
+  }
+
+  return 0;
+}
@@ -1,9 +1,37 @@
 #include "odeparse.h"
 #include "sysode.h"
+#include "threadpool.h"
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#define PARSE_TASKS 64
+
+/* The output of one concurrent parse. */
+typedef struct ParseResult {
+  int code;
+  char buffer[100];
+} ParseResult;
+
+/* Parse with a parser of its own, and print the result. */
+static void runParse(unsigned int index, void *context) {
+  ParseResult *results = (ParseResult *)context;
+  const char *str = (index % 2 == 0) ? "x' = x * y; y' = -x;"
+                                     : "a' = 2 * b;\nb' = a ^ 3;";
+  OdeParser *parser = newOdeParser();
+  ODEList *list = NULL;
+  results[index].code = parseOdeStringWith(parser, str, &list);
+  FILE *stream = fmemopen(results[index].buffer, 100, "w");
+  assert(stream != NULL);
+  printOdeList(list, stream);
+  fclose(stream);
+
+  /* clean */
+  delOdeList(list);
+  delOdeParser(parser);
+}
 
 int main(int argc, char *argv[]) {
   /* to avoid silly warnings about unused parameters */
@@ -38,5 +66,175 @@ int main(int argc, char *argv[]) {
     delOdeList(list);
   }
 
+  /* Test that a parser can be reused, and that it reports the line of a
+    syntax error. */
+  {
+    OdeParser *parser = newOdeParser();
+    ODEList *list = NULL;
+    int res = parseOdeStringWith(parser, "x' = 1;\ny' = ;", &list);
+    printf("error line = %d\n", odeParserErrorLine(parser));
+    fflush(stdout);
+    assert(res != 0);
+    assert(odeParserErrorLine(parser) == 2);
+
+    /* The line numbers restart for every input. */
+    res = parseOdeStringWith(parser, "x' = ;", &list);
+    assert(res != 0);
+    assert(odeParserErrorLine(parser) == 1);
+
+    res = parseOdeStringWith(parser, "x' = 1;", &list);
+    assert(res == 0);
+    assert(odeParserErrorLine(parser) == 0);
+    assert(list != NULL && strcmp(list->fun, "x") == 0);
+
+    /* clean */
+    delOdeList(list);
+    delOdeParser(parser);
+  }
+
+  /* Test that parsers may run concurrently. */
+  {
+    ThreadPool *pool = newThreadPool(4);
+    ParseResult results[PARSE_TASKS];
+    parallelFor(pool, PARSE_TASKS, runParse, results);
+    for (unsigned int it = 0; it < PARSE_TASKS; ++it) {
+      const char *msg = (it % 2 == 0) ? "y' = -x; x' = (x * y); "
+                                      : "b' = (a^3); a' = (2 * b); ";
+      assert(results[it].code == 0);
+      assert(strcmp(results[it].buffer, msg) == 0);
+    }
+    printf("%d concurrent parses agree\n", PARSE_TASKS);
+
+    /* clean */
+    delThreadPool(pool);
+  }
+
+  /* Test parsing from a stream, a mapped file and a pipe. */
+  {
+    const char str[] = "x' = x * y;\ny' = -x;";
+    const char msg[] = "y' = -x; x' = (x * y); ";
+    OdeParser *parser = newOdeParser();
+    char buffer[100];
+
+    /* The size of the file is a multiple of the page size, so the NUL
+      bytes that the scanner requires lie beyond the last page. */
+    const long page = sysconf(_SC_PAGESIZE);
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    fputs(str, file);
+    for (long it = (long)strlen(str); it < page; ++it)
+      fputc(' ', file);
+    fflush(file);
+
+    for (unsigned int mode = 0; mode < 3; ++mode) {
+      ODEList *list = NULL;
+      int res;
+      if (mode == 0) {
+        rewind(file);
+        res = parseOdeFileWith(parser, file, &list);
+      } else if (mode == 1) {
+        res = parseOdeFdWith(parser, fileno(file), &list);
+      } else {
+        int ends[2];
+        assert(pipe(ends) == 0);
+        assert(write(ends[1], str, strlen(str)) == (ssize_t)strlen(str));
+        close(ends[1]);
+        res = parseOdeFdWith(parser, ends[0], &list);
+        close(ends[0]);
+      }
+      assert(res == 0);
+
+      FILE *stream = fmemopen(buffer, 100, "w");
+      assert(stream != NULL);
+      printOdeList(list, stream);
+      fclose(stream);
+      printf("mode %u: |%s|\n", mode, buffer);
+      fflush(stdout);
+      assert(strcmp(buffer, msg) == 0);
+
+      /* clean */
+      delOdeList(list);
+    }
+
+    /* An empty file contains no system. */
+    FILE *empty = tmpfile();
+    assert(empty != NULL);
+    ODEList *list = NULL;
+    assert(parseOdeFdWith(parser, fileno(empty), &list) != 0);
+
+    /* clean */
+    fclose(empty);
+    fclose(file);
+    delOdeParser(parser);
+  }
+
+  /* Test that a parser can normalize the vector fields: constants are
+    folded and products expanded, unless the expansion blows up. */
+  {
+    const char str[] =
+        "x' = (a + b) * c - 2 * 3; y' = sin(-(1 + 1) * x); z' = (x + y)^10;";
+    const char msg[] = "z' = ((x + y)^10); y' = sin(-(2 * x)); "
+                       "x' = ((-6 + (a * c)) + (b * c)); ";
+    OdeParser *parser = newOdeParser();
+    setOdeParserNormalize(parser, true);
+    ODEList *list = NULL;
+    int res = parseOdeStringWith(parser, str, &list);
+    assert(res == 0);
+
+    char buffer[200];
+    FILE *stream = fmemopen(buffer, 200, "w");
+    assert(stream != NULL);
+    printOdeList(list, stream);
+    fclose(stream);
+    printf("expect: |%s|\n", msg);
+    printf("actual: |%s|\n", buffer);
+    fflush(stdout);
+    assert(strcmp(buffer, msg) == 0);
+
+    /* Normalization is idempotent, up to the order of the list. */
+    ODEList *again = NULL;
+    assert(parseOdeStringWith(parser, buffer, &again) == 0);
+    for (ODEList *it = again; it != NULL; it = it->next) {
+      ODEList *match = list;
+      while (strcmp(match->fun, it->fun) != 0)
+        match = match->next;
+      assert(isEqual(match->exp, it->exp));
+    }
+
+    /* clean */
+    delOdeList(again);
+    delOdeList(list);
+    delOdeParser(parser);
+  }
+
+  /* Test that normalization only folds exact results, so the system stays
+    the one that was written, and that large expansions stop early. */
+  {
+    const char str[] = "x' = x / 3 + 0.1 * 3 * x; y' = x / 4 + 0.5 * 3 * y; "
+                       "z' = (x + y + z + w)^40;";
+    const char msg[] = "z' = ((((w + x) + y) + z)^40); "
+                       "y' = ((0.25 * x) + (1.5 * y)); "
+                       "x' = ((x / 3) + ((0.1 * 3) * x)); ";
+    OdeParser *parser = newOdeParser();
+    setOdeParserNormalize(parser, true);
+    ODEList *list = NULL;
+    int res = parseOdeStringWith(parser, str, &list);
+    assert(res == 0);
+
+    char buffer[200];
+    FILE *stream = fmemopen(buffer, 200, "w");
+    assert(stream != NULL);
+    printOdeList(list, stream);
+    fclose(stream);
+    printf("expect: |%s|\n", msg);
+    printf("actual: |%s|\n", buffer);
+    fflush(stdout);
+    assert(strcmp(buffer, msg) == 0);
+
+    /* Clean */
+    delOdeList(list);
+    delOdeParser(parser);
+  }
+
   return 0;
 }
@@ -0,0 +1,229 @@
+#include "funexp.h"
+#include "polynomial.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "tmflowpipe.h"
+#include "variables.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Check that the expression collects to the expected canonical form. */
+void testCollect(ExpTree *exp, const char *expected) {
+  char *actual = NULL;
+  size_t size = 0;
+  FILE *stream = open_memstream(&actual, &size);
+  ExpTree *collected = collectTerms(exp);
+  printExpTree(collected, stream);
+  fclose(stream);
+
+  printf("collect: ");
+  printExpTree(exp, stdout);
+  printf(" => %s\n", actual);
+  fflush(stdout);
+  assert(strcmp(actual, expected) == 0);
+
+  /* Clean */
+  free(actual);
+  delExpTree(collected);
+  delExpTree(exp);
+}
+
+/* Check that the polynomial part of the TM equals the expected tree. */
+void testEqualPolynomial(const ExpTree *actual, const ExpTree *expected) {
+  Polynomial *left = toPolynomial(actual);
+  Polynomial *right = toPolynomial(expected);
+  assert(left != NULL && right != NULL);
+  printf("expect: ");
+  printPolynomial(left, stdout);
+  printf(" == ");
+  printPolynomial(right, stdout);
+  printf("\n");
+  fflush(stdout);
+  assert(isEqualPolynomial(left, right, 1e-12));
+  delPolynomial(left);
+  delPolynomial(right);
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  /* Test the canonical polynomial form. */
+  {
+    printf("\n=== Polynomials ===\n");
+    fflush(stdout);
+
+    /* (x + 2y) * (x - t)^2 */
+    testCollect(newExpOp(EXP_MUL_OP,
+                         newExpOp(EXP_ADD_OP, var("x"),
+                                  newExpOp(EXP_MUL_OP, num("2"), var("y"))),
+                         newExpOp(EXP_EXP_OP,
+                                  newExpOp(EXP_SUB_OP, var("x"), var("t")),
+                                  num("2"))),
+                "(((((((t^2) * x) + ((2 * (t^2)) * y)) - ((2 * t) * (x^2))) - "
+                "(((4 * t) * x) * y)) + (x^3)) + ((2 * (x^2)) * y))");
+
+    /* x * (x + y) - (y * x + x^2) = 0 */
+    testCollect(newExpOp(EXP_SUB_OP,
+                         newExpOp(EXP_MUL_OP, var("x"),
+                                  newExpOp(EXP_ADD_OP, var("x"), var("y"))),
+                         newExpOp(EXP_ADD_OP,
+                                  newExpOp(EXP_MUL_OP, var("y"), var("x")),
+                                  newExpOp(EXP_EXP_OP, var("x"), num("2")))),
+                "0");
+
+    /* -(1 / 4) + x / 2 */
+    testCollect(newExpOp(EXP_ADD_OP,
+                         newExpOp(EXP_NEG,
+                                  newExpOp(EXP_DIV_OP, num("1"), num("4")),
+                                  NULL),
+                         newExpOp(EXP_DIV_OP, var("x"), num("2"))),
+                "(-0.25 + (0.5 * x))");
+
+    /* Division by a variable and functions are not polynomials. */
+    ExpTree *exp = newExpOp(EXP_DIV_OP, num("1"), var("x"));
+    assert(toPolynomial(exp) == NULL);
+    delExpTree(exp);
+    exp = newExpTree(EXP_FUN, strdup("sin"), var("x"), NULL);
+    assert(toPolynomial(exp) == NULL);
+    delExpTree(exp);
+
+    /* int_0^t (3 t^2 x + 1) dt = t^3 x + t */
+    exp = newExpOp(EXP_ADD_OP,
+                   newExpOp(EXP_MUL_OP,
+                            newExpOp(EXP_MUL_OP, num("3"),
+                                     newExpOp(EXP_EXP_OP, var("t"), num("2"))),
+                            var("x")),
+                   num("1"));
+    Polynomial *poly = toPolynomial(exp);
+    Polynomial *integrated = integratePolynomial(poly, "t");
+    ExpTree *expected =
+        newExpOp(EXP_ADD_OP, var("t"),
+                 newExpOp(EXP_MUL_OP, newExpOp(EXP_EXP_OP, var("t"), num("3")),
+                          var("x")));
+    ExpTree *actual = fromPolynomial(integrated);
+    testEqualPolynomial(actual, expected);
+    assert(degreePolynomial(integrated) == 4);
+    delExpTree(actual);
+    delPolynomial(poly);
+    delPolynomial(integrated);
+    delExpTree(expected);
+    delExpTree(exp);
+  }
+
+  /* Test the TM Picard iteration on x' = x, whose flow is x e^t. */
+  {
+    printf("\n=== Picard iteration: exponential ===\n");
+    fflush(stdout);
+
+    ODEList *sys = newOdeElem(NULL, strdup("x"), var("x"));
+    Domain *domain = newDomainElem(NULL, strdup("t"), newInterval(0, 0.1));
+    domain = newDomainElem(domain, strdup("x"), newInterval(1, 1.1));
+    TaylorModel *initial = initTaylorModel(sys);
+    const unsigned int k = 5;
+
+    PicardStats stats;
+    TaylorModel *flow = picardIterationTM(sys, initial, domain, k, 20, &stats);
+    printTaylorModel(flow, stdout);
+    printf("iterations: %u\n", stats.iterations);
+    fflush(stdout);
+    assert(stats.converged);
+    assert(stats.iterations <= k + 2);
+
+    /* x (1 + t + t^2/2 + t^3/6 + t^4/24), all terms of degree <= k */
+    Polynomial *poly = toPolynomial(flow->exp);
+    assert(degreePolynomial(poly) == k);
+    assert(poly->length == k);
+    for (unsigned int it = 0; it < poly->length; ++it)
+      assert(fabs(poly->coefficients[it] - 1 / tgamma(it + 1)) < 1e-15);
+    delPolynomial(poly);
+
+    /* The remainder encloses the dropped term x t^5 / 5! of the last step,
+      and the rounding of the collected coefficients; it is not validated
+      against the tail of the series. */
+    printf("remainder: [%.15g, %.15g]\n", flow->remainder.left,
+           flow->remainder.right);
+    assert(flow->remainder.left <= 0 && flow->remainder.left > -1e-15);
+    assert(fabs(flow->remainder.right - 1.1 * pow(0.1, 5) / 120) < 1e-15);
+
+    /* Limiting the iterations stops before convergence. */
+    TaylorModel *partial =
+        picardIterationTM(sys, initial, domain, k, 2, &stats);
+    assert(stats.iterations == 2 && !stats.converged);
+    delTaylorModel(partial);
+
+    delTaylorModel(flow);
+    delTaylorModel(initial);
+    delDomain(domain);
+    delOdeList(sys);
+  }
+
+  /* Test a non-linear system against the Lie derivatives. */
+  {
+    printf("\n=== Picard iteration: non-linear ===\n");
+    fflush(stdout);
+
+    /* x' = y; y' = 1 + x^2 y */
+    ODEList *sys = newOdeElem(
+        NULL, strdup("y"),
+        newExpOp(EXP_ADD_OP, num("1"),
+                 newExpOp(EXP_MUL_OP, newExpOp(EXP_EXP_OP, var("x"), num("2")),
+                          var("y"))));
+    sys = newOdeElem(sys, strdup("x"), var("y"));
+    Domain *domain = newDomainElem(NULL, strdup("t"), newInterval(0, 0.05));
+    domain = newDomainElem(domain, strdup("y"), newInterval(-0.1, 0.1));
+    domain = newDomainElem(domain, strdup("x"), newInterval(0.9, 1));
+    TaylorModel *initial = initTaylorModel(sys);
+    const unsigned int k = 4;
+
+    PicardStats stats;
+    TaylorModel *flow = picardIterationTM(sys, initial, domain, k, 20, &stats);
+    printTaylorModel(flow, stdout);
+    printf("iterations: %u\n", stats.iterations);
+    fflush(stdout);
+    assert(stats.converged);
+    assert(stats.iterations <= k + 2);
+
+    /* One more step does not change the polynomial parts. */
+    TaylorModel *again = picardStepTM(sys, initial, flow, domain, k);
+    for (TaylorModel *left = flow, *right = again; left != NULL;
+         left = left->next, right = right->next)
+      testEqualPolynomial(left->exp, right->exp);
+    delTaylorModel(again);
+
+    /* The Taylor expansion in t, truncated to total degree k. */
+    TaylorModel *taylor = computeTaylorPolynomial(sys, k, k);
+    for (TaylorModel *left = flow, *right = taylor; left != NULL;
+         left = left->next, right = right->next) {
+      Polynomial *poly = toPolynomial(right->exp);
+      Polynomial *truncated = cpyPolynomial(poly);
+      truncated->length = 0;
+      for (unsigned int it = 0; it < poly->length; ++it) {
+        unsigned int degree = 0;
+        for (unsigned int v = 0; v < poly->nvars; ++v)
+          degree += poly->exponents[it * poly->nvars + v];
+        if (degree > k)
+          break;
+        truncated->length = it + 1;
+      }
+      ExpTree *expected = fromPolynomial(truncated);
+      testEqualPolynomial(left->exp, expected);
+      delExpTree(expected);
+      delPolynomial(poly);
+      delPolynomial(truncated);
+    }
+    delTaylorModel(taylor);
+
+    delTaylorModel(flow);
+    delTaylorModel(initial);
+    delDomain(domain);
+    delOdeList(sys);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -236,6 +236,55 @@ int main(int argc, char *argv[]) {
     delExpTree(exp);
   }
 
+  /* Test expression tree affine evaluation. */
+  {
+    printf("\n=== Affine evaluation ===\n");
+    fflush(stdout);
+
+    /* (x + y) * (x + y) - x * (x + 2y) = y^2 */
+    ExpTree *xPy = newExpOp(EXP_ADD_OP, cpyExpTree(x), cpyExpTree(y));
+    ExpTree *square = newExpOp(EXP_MUL_OP, xPy, cpyExpTree(xPy));
+    ExpTree *twoY = newExpOp(EXP_MUL_OP, cpyExpTree(two), cpyExpTree(y));
+    ExpTree *xP2y = newExpOp(EXP_ADD_OP, cpyExpTree(x), twoY);
+    ExpTree *prod = newExpOp(EXP_MUL_OP, cpyExpTree(x), xP2y);
+    ExpTree *exp = newExpOp(EXP_SUB_OP, square, prod);
+
+    /*
+      Fill in x in [1, 2] and y in [3, 4]. Interval arithmetic gives
+      [16, 36] - [1, 2] * [7, 10] = [-4, 29], but the linear terms cancel in
+      affine arithmetic:
+      (5 + 0.5e0 + 0.5e1)^2 - (1.5 + 0.5e0) * (8.5 + 0.5e0 + e1)
+      = (25 + 5e0 + 5e1 + [-1, 1]) - (12.75 + 5e0 + 1.5e1 + [-0.75, 0.75])
+      = 12.25 + 3.5e1 + [-1.75, 1.75]
+      = [7, 17.5]
+    */
+    Interval res = evaluateExpTree(exp, domains);
+    testInterval(&res, -4.0, 29.0, 0.001);
+    res = evaluateExpTreeAffine(exp, domains);
+    testInterval(&res, 7.0, 17.5, 0.001);
+
+    /* The TM range bounder: truncating x * y - x * y at order 1 moves both
+      terms into the remainder. Their linear parts cancel, only the
+      nonlinear errors [-0.25, 0.25] of the products remain. */
+    ExpTree *xy = newExpOp(EXP_MUL_OP, cpyExpTree(x), cpyExpTree(y));
+    TaylorModel *tm = newTaylorModel(
+        strdup("x"), newExpOp(EXP_SUB_OP, xy, cpyExpTree(xy)),
+        newInterval(0, 0));
+    assert(getRangeBounder() == RANGE_BOUNDER_INTERVAL);
+    TaylorModel *truncated = truncateTM(tm, domains, 1);
+    testInterval(&truncated->remainder, -5.0, 5.0, 0.001);
+    delTaylorModel(truncated);
+    setRangeBounder(RANGE_BOUNDER_AFFINE);
+    truncated = truncateTM(tm, domains, 1);
+    testInterval(&truncated->remainder, -0.5, 0.5, 0.001);
+    setRangeBounder(RANGE_BOUNDER_INTERVAL);
+
+    /* Clean */
+    delTaylorModel(truncated);
+    delTaylorModel(tm);
+    delExpTree(exp);
+  }
+
   /* Test expression tree real evaluation. */
   {
     printf("\n=== Real evaluation ===\n");
@@ -279,6 +328,47 @@ int main(int argc, char *argv[]) {
     delValuation(values);
   }
 
+  /* Test evaluation of elementary functions. */
+  {
+    printf("\n=== Elementary function evaluation ===\n");
+    fflush(stdout);
+
+    /* sin(x) * exp(y) + atan(tanh(z)) - log(x) * cos(z) */
+    ExpTree *sinX = newExpTree(EXP_FUN, strdup("sin"), cpyExpTree(x), NULL);
+    ExpTree *expY = newExpTree(EXP_FUN, strdup("exp"), cpyExpTree(y), NULL);
+    ExpTree *tanhZ = newExpTree(EXP_FUN, strdup("tanh"), cpyExpTree(z), NULL);
+    ExpTree *atanTanhZ = newExpTree(EXP_FUN, strdup("atan"), tanhZ, NULL);
+    ExpTree *logX = newExpTree(EXP_FUN, strdup("log"), cpyExpTree(x), NULL);
+    ExpTree *cosZ = newExpTree(EXP_FUN, strdup("cos"), cpyExpTree(z), NULL);
+    ExpTree *fun = newExpOp(
+        EXP_SUB_OP,
+        newExpOp(EXP_ADD_OP, newExpOp(EXP_MUL_OP, sinX, expY), atanTanhZ),
+        newExpOp(EXP_MUL_OP, logX, cosZ));
+
+    Valuation *values = newValuation(strdup("z"), 4.);
+    values = appValuationElem(values, newValuation(strdup("y"), 3.));
+    values = appValuationElem(values, newValuation(strdup("x"), 2.));
+    double res = evaluateExpTreeReal(fun, values);
+    double expected = sin(2.) * exp(3.) + atan(tanh(4.)) - log(2.) * cos(4.);
+    testReal(res, expected, 1e-12);
+
+    /* The enclosure over the point box contains the real value. */
+    Interval enclosure = evaluateExpTree(fun, domains);
+    printInterval(&enclosure, stdout);
+    printf("\n");
+    Domain *point = newDomainElem(NULL, strdup("z"), newInterval(4., 4.));
+    point = newDomainElem(point, strdup("y"), newInterval(3., 3.));
+    point = newDomainElem(point, strdup("x"), newInterval(2., 2.));
+    enclosure = evaluateExpTree(fun, point);
+    assert(enclosure.left <= expected && expected <= enclosure.right);
+    assert(intervalWidth(&enclosure) < 1e-12);
+
+    /* Clean */
+    delDomain(point);
+    delExpTree(fun);
+    delValuation(values);
+  }
+
   /* Test order k Taylor model arithmetic. Simply construct some
     taylor models and then apply different TM operators. Then
     verify the results. */
@@ -560,34 +650,68 @@ int main(int argc, char *argv[]) {
     printf("### Taylor model binary DIV (/); TM order k = %i ###\n", tmOrder);
     fflush(stdout);
 
-    /* Test two cases, where we express the expected results as follows:
-          "TM arithmetic result" => "truncated TM arithmetic result"
-
-      1) Terms do NOT get truncated for the first TM element
-          x / x  =>  x / x
-      2) Terms DO get truncated for the second TM element:
-          (x / y^2) + x^3  =>  (x / y^2) + 0
-    */
+    /* (x + y, I11) / (x, I21), where the denominator's range
+      [1, 2] + [-0.2, 0.2] does not contain 0. The quotient must enclose
+      (x + y + r1) / (x + r2) for every point of the domain and every
+      r1 in I11, r2 in I21. */
     {
-
-      ExpTree *random = cpyExpTree(x);
-
-      /* Compose the Taylor model expected as output. */
-      TaylorModel *expected =
-          newTMElem(NULL, strdup(tm1->next->fun), random, newInterval(0, 0));
-
-      // TODO: Implement test properly !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-
-      /* Compute and test results. */
-      printf("@@@ B\n");
+      TaylorModel *numerator = cpyTaylorModelHead(tm1);
+      TaylorModel *denominator = cpyTaylorModelHead(tm2);
+      TaylorModel *binop = divTM(numerator, denominator, domains, tmOrder);
+      printTaylorModel(binop, stdout);
+      printf("\n");
+      fflush(stdout);
+      assert(binop->next == NULL);
+
+      const double xs[] = {1, 1.5, 2};
+      const double ys[] = {3, 4};
+      for (unsigned int i = 0; i < 3; ++i) {
+        for (unsigned int j = 0; j < 2; ++j) {
+          Valuation *values = newValuation(strdup("z"), 0);
+          values = appValuationElem(values, newValuation(strdup("y"), ys[j]));
+          values = appValuationElem(values, newValuation(strdup("x"), xs[i]));
+          double poly = evaluateExpTreeReal(binop->exp, values);
+          for (int r1 = -1; r1 <= 1; r1 += 2) {
+            for (int r2 = -1; r2 <= 1; r2 += 2) {
+              double quotient =
+                  (xs[i] + ys[j] + 0.1 * r1) / (xs[i] + 0.2 * r2);
+              assert(poly + binop->remainder.left - 1e-12 <= quotient);
+              assert(quotient <= poly + binop->remainder.right + 1e-12);
+            }
+          }
+          delValuation(values);
+        }
+      }
+
+      /* Over a small box around the origin, the truncated terms are small,
+        and so is the remainder: (x + y) / (2 + x). */
+      Domain *small = newDomainElem(NULL, strdup("z"), newInterval(0, 0));
+      small = newDomainElem(small, strdup("y"), newInterval(-0.1, 0.1));
+      small = newDomainElem(small, strdup("x"), newInterval(-0.1, 0.1));
+      numerator->remainder = newInterval(0, 0);
+      TaylorModel *shifted = newTaylorModel(
+          strdup("x"), newExpOp(EXP_ADD_OP, cpyExpTree(two), cpyExpTree(x)),
+          newInterval(0, 0));
+      TaylorModel *narrow = divTM(numerator, shifted, small, tmOrder);
+      printTaylorModel(narrow, stdout);
+      printf("\n");
       fflush(stdout);
-      // TaylorModel *binop = divTM(tm1, tm2, domains, tmOrder);
-      // printf("@@@ E "); printTaylorModel(binop, stdout); printf("\n");
-      // fflush(stdout); testTaylorModel(binop, expected, epsilon);
-      // delTaylorModel(binop);
+      assert(intervalWidth(&narrow->remainder) < 1e-5);
+      Valuation *values = newValuation(strdup("z"), 0);
+      values = appValuationElem(values, newValuation(strdup("y"), 0.05));
+      values = appValuationElem(values, newValuation(strdup("x"), -0.1));
+      double poly = evaluateExpTreeReal(narrow->exp, values);
+      assert(poly + narrow->remainder.left - 1e-12 <= -0.05 / 1.9);
+      assert(-0.05 / 1.9 <= poly + narrow->remainder.right + 1e-12);
 
       /* Clean */
-      delTaylorModel(expected);
+      delValuation(values);
+      delDomain(small);
+      delTaylorModel(shifted);
+      delTaylorModel(narrow);
+      delTaylorModel(numerator);
+      delTaylorModel(denominator);
+      delTaylorModel(binop);
     }
   }
 
@@ -0,0 +1,50 @@
+/**
+ * @file testhelpers.h
+ * @brief Helpers shared by the tests: short constructors of expression trees
+ * and checks of range enclosures.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TEST_HELPERS_H
+#define TEST_HELPERS_H
+
+#include "funexp.h"
+#include "interval.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+static inline ExpTree *var(const char *name) {
+  return newExpLeaf(EXP_VAR, name);
+}
+
+static inline ExpTree *num(const char *value) {
+  return newExpLeaf(EXP_NUM, value);
+}
+
+static inline ExpTree *power(ExpTree *base, const char *exponent) {
+  return newExpOp(EXP_EXP_OP, base, num(exponent));
+}
+
+static inline ExpTree *fun(const char *name, ExpTree *arg) {
+  return newExpTree(EXP_FUN, strdup(name), arg, NULL);
+}
+
+/* Check that the enclosure contains the exact range [left, right], and
+  overestimates it by at most slack on either side. */
+static inline void testRange(const Interval *actual, double left, double right,
+                             double slack) {
+  printf("Expect: [%f, %f]\n", left, right);
+  printf("Actual: ");
+  printInterval(actual, stdout);
+  printf("\n");
+  fflush(stdout);
+  assert(actual->left <= left && right <= actual->right);
+  assert(left - slack <= actual->left && actual->right <= right + slack);
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include "threadpool.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Square the index into the output slot belonging to the index. */
+void squareBody(unsigned int index, void *context) {
+  unsigned long *out = (unsigned long *)context;
+  out[index] = (unsigned long)index * index;
+}
+
+/* Each outer iteration runs its own inner parallel loop on the same pool. */
+typedef struct NestedContext {
+  ThreadPool *pool;
+  unsigned long (*out)[16];
+} NestedContext;
+
+void nestedBody(unsigned int index, void *context) {
+  NestedContext *ctx = (NestedContext *)context;
+  parallelFor(ctx->pool, 16, squareBody, ctx->out[index]);
+}
+
+/* Count task executions; the pool waits for all of them. */
+void incrementTask(void *arg) {
+  __atomic_fetch_add((unsigned int *)arg, 1, __ATOMIC_SEQ_CST);
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  ThreadPool *pool = newThreadPool(4);
+  assert(threadPoolSize(pool) == 4);
+
+  /* Test fire-and-forget submission. */
+  {
+    printf("\n=== Submit and wait ===\n");
+    fflush(stdout);
+
+    unsigned int counter = 0;
+    for (unsigned int it = 0; it < 1000; ++it)
+      submitThreadPool(pool, incrementTask, &counter);
+    waitThreadPool(pool);
+    printf("Expect: %u\n", 1000);
+    printf("Actual:    %u\n", counter);
+    fflush(stdout);
+    assert(counter == 1000);
+  }
+
+  /* Test that each iteration of a parallel loop writes its own slot. */
+  {
+    printf("\n=== Parallel for ===\n");
+    fflush(stdout);
+
+    unsigned long out[257];
+    memset(out, 0, sizeof(out));
+    parallelFor(pool, 257, squareBody, out);
+    for (unsigned int it = 0; it < 257; ++it)
+      assert(out[it] == (unsigned long)it * it);
+
+    /* Serial fallback without a pool. */
+    memset(out, 0, sizeof(out));
+    parallelFor(NULL, 257, squareBody, out);
+    for (unsigned int it = 0; it < 257; ++it)
+      assert(out[it] == (unsigned long)it * it);
+  }
+
+  /* Test nested parallel loops; these would deadlock if waiting threads did
+    not help execute queued work. */
+  {
+    printf("\n=== Nested parallel for ===\n");
+    fflush(stdout);
+
+    unsigned long out[32][16];
+    memset(out, 0, sizeof(out));
+    NestedContext ctx = {pool, out};
+    parallelFor(pool, 32, nestedBody, &ctx);
+    for (unsigned int it = 0; it < 32; ++it)
+      for (unsigned int jt = 0; jt < 16; ++jt)
+        assert(out[it][jt] == (unsigned long)jt * jt);
+  }
+
+  /* Clean */
+  delThreadPool(pool);
+
+  /* A default-sized pool has at least one worker. */
+  pool = newThreadPool(0);
+  assert(threadPoolSize(pool) >= 1);
+  delThreadPool(pool);
+
+  return 0;
+}
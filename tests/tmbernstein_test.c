@@ -0,0 +1,178 @@
+#include "funexp.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "tmbernstein.h"
+#include "variables.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  Domain *domains = newDomainElem(NULL, strdup("y"), newInterval(2, 3));
+  domains = newDomainElem(domains, strdup("x"), newInterval(0, 1));
+
+  /* Test the range enclosure of Bernstein forms. */
+  {
+    printf("\n=== Bernstein forms ===\n");
+    fflush(stdout);
+
+    /* x^2 - x over [0, 1]: interval evaluation gives [-1, 1]. The
+      Bernstein coefficients are 0, -0.5 and 0, so the minimum -0.25 is only
+      found by subdivision. */
+    ExpTree *exp = newExpOp(EXP_SUB_OP, power(var("x"), "2"), var("x"));
+    Interval range = evaluateExpTree(exp, domains);
+    testRange(&range, -1, 1, 0);
+    Polynomial *poly = toPolynomial(exp);
+    BernsteinForm *form = newBernsteinForm(poly, domains);
+    assert(form->nvars == 1 && form->degrees[0] == 2 && form->length == 3);
+    assert(form->coefs[1].left <= -0.5 && -0.5 <= form->coefs[1].right);
+    range = rangeBernsteinForm(form, 0);
+    testRange(&range, -0.5, 0, 1e-12);
+    range = rangeBernsteinForm(form, BERNSTEIN_MAX_DEPTH);
+    testRange(&range, -0.25, 0, 1e-3);
+    delBernsteinForm(form);
+    delPolynomial(poly);
+    delExpTree(exp);
+
+    /* 3x - 2y is monotone, so its extremes are at vertices. */
+    exp = newExpOp(EXP_SUB_OP, newExpOp(EXP_MUL_OP, num("3"), var("x")),
+                   newExpOp(EXP_MUL_OP, num("2"), var("y")));
+    poly = toPolynomial(exp);
+    form = newBernsteinForm(poly, domains);
+    range = rangeBernsteinForm(form, BERNSTEIN_MAX_DEPTH);
+    testRange(&range, -6, -1, 1e-12);
+    delBernsteinForm(form);
+    delPolynomial(poly);
+    delExpTree(exp);
+
+    /* (x + y)^2 - 2xy = x^2 + y^2, over x in [-1, 1] and y in [2, 3] */
+    Domain *wide = newDomainElem(NULL, strdup("y"), newInterval(2, 3));
+    wide = newDomainElem(wide, strdup("x"), newInterval(-1, 1));
+    exp = newExpOp(EXP_SUB_OP, power(newExpOp(EXP_ADD_OP, var("x"), var("y")),
+                                     "2"),
+                   newExpOp(EXP_MUL_OP, num("2"),
+                            newExpOp(EXP_MUL_OP, var("x"), var("y"))));
+    range = evaluateExpTree(exp, wide);
+    testRange(&range, -5, 22, 0);
+    range = evaluateExpTreeBernstein(exp, wide);
+    testRange(&range, 4, 10, 0.1);
+    delExpTree(exp);
+    delDomain(wide);
+  }
+
+  /* Test the cache of Bernstein forms. */
+  {
+    printf("\n=== Bernstein cache ===\n");
+    fflush(stdout);
+
+    clearBernsteinCache();
+    unsigned int hits, misses;
+    ExpTree *exp = newExpOp(EXP_MUL_OP, var("x"),
+                            newExpOp(EXP_SUB_OP, var("y"), var("x")));
+    Interval first = evaluateExpTreeBernstein(exp, domains);
+    bernsteinCacheStats(&hits, &misses);
+    assert(hits == 0 && misses == 1);
+
+    /* The same polynomial in another shape hits the cache. */
+    ExpTree *expanded =
+        newExpOp(EXP_SUB_OP, newExpOp(EXP_MUL_OP, var("y"), var("x")),
+                 power(var("x"), "2"));
+    Interval second = evaluateExpTreeBernstein(expanded, domains);
+    bernsteinCacheStats(&hits, &misses);
+    assert(hits == 1 && misses == 1);
+    assert(first.left == second.left && first.right == second.right);
+    testRange(&second, 0, 2, 1e-3);
+
+    /* Another box misses. */
+    Domain *other = newDomainElem(NULL, strdup("y"), newInterval(2, 4));
+    other = newDomainElem(other, strdup("x"), newInterval(0, 1));
+    Interval third = evaluateExpTreeBernstein(exp, other);
+    bernsteinCacheStats(&hits, &misses);
+    assert(hits == 1 && misses == 2);
+    testRange(&third, 0, 3, 1e-3);
+    delDomain(other);
+
+    /* Functions fall back to interval evaluation, uncached. */
+    ExpTree *sine = newExpTree(EXP_FUN, strdup("sin"), var("x"), NULL);
+    Interval expected = evaluateExpTree(sine, domains);
+    Interval actual = evaluateExpTreeBernstein(sine, domains);
+    assert(expected.left == actual.left && expected.right == actual.right);
+    bernsteinCacheStats(&hits, &misses);
+    assert(hits == 1 && misses == 2);
+
+    clearBernsteinCache();
+    bernsteinCacheStats(&hits, &misses);
+    assert(hits == 0 && misses == 0);
+
+    /* Clean */
+    delExpTree(sine);
+    delExpTree(expanded);
+    delExpTree(exp);
+  }
+
+  /* Test the Bernstein range bounder of TM arithmetic. */
+  {
+    printf("\n=== Bernstein range bounder ===\n");
+    fflush(stdout);
+
+    /* Truncating x^3 - x^2 at order 1 moves it into the remainder. Its
+      range over [0, 1] is [-4/27, 0]. */
+    TaylorModel *tm = newTaylorModel(
+        strdup("x"),
+        newExpOp(EXP_SUB_OP, power(var("x"), "3"), power(var("x"), "2")),
+        newInterval(0, 0));
+    TaylorModel *truncated = truncateTM(tm, domains, 1);
+    testRange(&truncated->remainder, -1, 1, 0);
+    delTaylorModel(truncated);
+
+    setRangeBounder(RANGE_BOUNDER_BERNSTEIN);
+    truncated = truncateTM(tm, domains, 1);
+    testRange(&truncated->remainder, -4. / 27., 0, 1e-3);
+    setRangeBounder(RANGE_BOUNDER_INTERVAL);
+
+    /* Clean */
+    delTaylorModel(truncated);
+    delTaylorModel(tm);
+    clearBernsteinCache();
+  }
+
+  /* Test that coefficients which cancel in double arithmetic are still
+    enclosed. */
+  {
+    printf("\n=== Cancellation ===\n");
+    fflush(stdout);
+
+    /* 1e16 x + x - 1e16 x = x over [1, 2], while toPolynomial rounds the
+      coefficient of x to 0. */
+    Domain *wide = newDomainElem(NULL, strdup("x"), newInterval(1, 2));
+    ExpTree *exp = newExpOp(
+        EXP_SUB_OP,
+        newExpOp(EXP_ADD_OP, newExpOp(EXP_MUL_OP, num("1e16"), var("x")),
+                 var("x")),
+        newExpOp(EXP_MUL_OP, num("1e16"), var("x")));
+    Interval range = evaluateExpTreeBernstein(exp, wide);
+    testRange(&range, 1, 2, 4);
+
+    clearBernsteinCache();
+    setRangeBounder(RANGE_BOUNDER_BERNSTEIN);
+    range = boundExpTree(exp, wide);
+    setRangeBounder(RANGE_BOUNDER_INTERVAL);
+    testRange(&range, 1, 2, 4);
+
+    /* Clean */
+    delExpTree(exp);
+    delDomain(wide);
+    clearBernsteinCache();
+  }
+
+  /* Clean */
+  delDomain(domains);
+
+  return EXIT_SUCCESS;
+}
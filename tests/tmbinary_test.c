@@ -0,0 +1,240 @@
+#include "funexp.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "tmbinary.h"
+#include "variables.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Write the list into a temporary file, and map it back. */
+BinaryImage *roundTrip(int (*write)(const void *, FILE *), const void *list,
+                       FILE **file) {
+  *file = tmpfile();
+  assert(*file != NULL);
+  assert(write(list, *file) == 0);
+  fflush(*file);
+  BinaryImage *image = mapBinaryImage(fileno(*file));
+  assert(image != NULL);
+  return image;
+}
+
+int writeOdes(const void *list, FILE *out) {
+  return writeOdeListBinary((const ODEList *)list, out);
+}
+int writeDomains(const void *list, FILE *out) {
+  return writeDomainBinary((const Domain *)list, out);
+}
+int writeModels(const void *list, FILE *out) {
+  return writeTaylorModelBinary((const TaylorModel *)list, out);
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  /* Test the round trip of a system of ODEs. */
+  {
+    printf("\n=== ODE lists ===\n");
+    fflush(stdout);
+
+    /* x' = -x * sin(y); y' = x + 2 */
+    ODEList *odes = newOdeList(
+        strdup("y"), newExpOp(EXP_ADD_OP, var("x"), num("2")));
+    odes = newOdeElem(odes, strdup("x"),
+                      newExpOp(EXP_MUL_OP, newExpOp(EXP_NEG, var("x"), NULL),
+                               fun("sin", var("y"))));
+    FILE *file;
+    BinaryImage *image = roundTrip(writeOdes, odes, &file);
+
+    /* The arrays can be read in place: x and y are shared symbols. */
+    assert(image->header->kind == BINARY_ODE_LIST);
+    assert(image->header->entries == 2 && image->header->nodes == 8);
+    assert(image->header->symbols == 4);
+    assert(strcmp(binarySymbol(image, image->entries[0].name), "x") == 0);
+    const BinaryNode *root = &image->nodes[image->entries[0].root];
+    assert(root->type == EXP_MUL_OP && root->left < root->right);
+
+    ODEList *loaded = loadOdeList(image);
+    printOdeList(loaded, stdout);
+    printf("\n");
+    assert(isEqualOdeList(odes, loaded));
+    assert(strcmp(loaded->fun, "x") == 0);
+
+    /* Another kind of list is not loaded. */
+    assert(loadDomain(image) == NULL);
+    assert(loadTaylorModel(image) == NULL);
+
+    /* Clean */
+    delOdeList(loaded);
+    delBinaryImage(image);
+    fclose(file);
+    delOdeList(odes);
+  }
+
+  /* Test the round trip of domains and Taylor models. */
+  {
+    printf("\n=== Domains and Taylor models ===\n");
+    fflush(stdout);
+
+    Domain *domains = newDomainElem(NULL, strdup("y"), newInterval(2, 3));
+    domains = newDomainElem(domains, strdup("x"), newInterval(-0.1, 1e-300));
+    FILE *file;
+    BinaryImage *image = roundTrip(writeDomains, domains, &file);
+    Domain *loadedDomains = loadDomain(image);
+    printDomain(loadedDomains, stdout);
+    printf("\n");
+    assert(strcmp(loadedDomains->var, "x") == 0);
+    assert(loadedDomains->domain.left == -0.1);
+    assert(loadedDomains->domain.right == 1e-300);
+    assert(strcmp(loadedDomains->next->var, "y") == 0);
+    assert(loadedDomains->next->next == NULL);
+    delDomain(loadedDomains);
+    delBinaryImage(image);
+    fclose(file);
+
+    TaylorModel *tm = newTaylorModel(
+        strdup("y"), newExpOp(EXP_EXP_OP, var("y"), num("2")),
+        newInterval(-1e-9, 2e-9));
+    tm = newTMElem(tm, strdup("x"), num("0.5"), newInterval(0, 0));
+    image = roundTrip(writeModels, tm, &file);
+    TaylorModel *loaded = loadTaylorModel(image);
+    printTaylorModel(loaded, stdout);
+    printf("\n");
+    for (TaylorModel *left = tm, *right = loaded; left != NULL;
+         left = left->next, right = right->next) {
+      assert(right != NULL && strcmp(left->fun, right->fun) == 0);
+      assert(isEqual(left->exp, right->exp));
+      assert(left->remainder.left == right->remainder.left);
+      assert(left->remainder.right == right->remainder.right);
+    }
+
+    /* Clean */
+    delTaylorModel(loaded);
+    delBinaryImage(image);
+    fclose(file);
+    delTaylorModel(tm);
+    delDomain(domains);
+  }
+
+  /* Test that malformed files are rejected. */
+  {
+    printf("\n=== Validation ===\n");
+    fflush(stdout);
+
+    ODEList *odes = newOdeList(
+        strdup("x"), newExpOp(EXP_SUB_OP, var("x"), num("1")));
+    char *data;
+    size_t size;
+    FILE *stream = open_memstream(&data, &size);
+    assert(stream != NULL);
+    assert(writeOdeListBinary(odes, stream) == 0);
+    fclose(stream);
+
+    BinaryImage *image = newBinaryImage(data, size);
+    assert(image != NULL);
+    delBinaryImage(image);
+
+    /* Truncated */
+    assert(newBinaryImage(data, size - 1) == NULL);
+    assert(newBinaryImage(data, sizeof(BinaryHeader) - 1) == NULL);
+
+    /* Another version */
+    BinaryHeader *header = (BinaryHeader *)data;
+    header->version += 1;
+    assert(newBinaryImage(data, size) == NULL);
+    header->version -= 1;
+
+    /* A child that does not precede its parent */
+    BinaryNode *nodes =
+        (BinaryNode *)(data + sizeof(BinaryHeader) + sizeof(BinaryEntry));
+    nodes[2].left = 2;
+    assert(newBinaryImage(data, size) == NULL);
+    nodes[2].left = 0;
+
+    /* A node shared by two parents, which could expand exponentially */
+    nodes[2].right = 0;
+    assert(newBinaryImage(data, size) == NULL);
+    nodes[2].right = 1;
+
+    /* A pool whose size wraps the layout around */
+    const uint64_t poolSize = header->poolSize;
+    header->poolSize = UINT64_MAX - 8;
+    assert(newBinaryImage(data, size) == NULL);
+    header->poolSize = poolSize;
+
+    /* Empty and NaN intervals */
+    BinaryEntry *entries = (BinaryEntry *)(data + sizeof(BinaryHeader));
+    entries[0].interval = (Interval){1, 0};
+    assert(newBinaryImage(data, size) == NULL);
+    entries[0].interval = (Interval){NAN, 0};
+    assert(newBinaryImage(data, size) == NULL);
+    entries[0].interval = newInterval(0, 0);
+    image = newBinaryImage(data, size);
+    assert(image != NULL);
+
+    /* Clean */
+    delBinaryImage(image);
+    free(data);
+    delOdeList(odes);
+  }
+
+  /* Test that trees deeper than the limit are rejected, so that loading them
+    cannot overflow the stack. */
+  {
+    printf("\n=== Depth ===\n");
+    fflush(stdout);
+
+    for (unsigned int depth = BINARY_MAX_DEPTH; depth <= BINARY_MAX_DEPTH + 1;
+         ++depth) {
+      ExpTree *exp = var("x");
+      for (unsigned int it = 1; it < depth; ++it)
+        exp = newExpOp(EXP_NEG, exp, NULL);
+      ODEList *odes = newOdeList(strdup("x"), exp);
+      char *data;
+      size_t size;
+      FILE *stream = open_memstream(&data, &size);
+      assert(stream != NULL);
+      assert(writeOdeListBinary(odes, stream) == 0);
+      fclose(stream);
+
+      BinaryImage *image = newBinaryImage(data, size);
+      assert((image != NULL) == (depth <= BINARY_MAX_DEPTH));
+
+      /* Clean */
+      if (image != NULL)
+        delBinaryImage(image);
+      free(data);
+      delOdeList(odes);
+    }
+  }
+
+  /* Test that empty lists, without any arrays, are written. */
+  {
+    printf("\n=== Empty lists ===\n");
+    fflush(stdout);
+
+    char *data;
+    size_t size;
+    FILE *stream = open_memstream(&data, &size);
+    assert(stream != NULL);
+    assert(writeDomainBinary(NULL, stream) == 0);
+    fclose(stream);
+    assert(size == sizeof(BinaryHeader));
+
+    BinaryImage *image = newBinaryImage(data, size);
+    assert(image != NULL);
+    assert(image->header->entries == 0 && image->header->nodes == 0);
+    assert(loadDomain(image) == NULL);
+
+    /* Clean */
+    delBinaryImage(image);
+    free(data);
+  }
+
+  return EXIT_SUCCESS;
+}
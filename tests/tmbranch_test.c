@@ -0,0 +1,114 @@
+#include "funexp.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "threadpool.h"
+#include "tmbranch.h"
+#include "variables.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  /* z does not occur in the expressions, so it is never bisected. */
+  Domain *domains = newDomainElem(NULL, strdup("z"), newInterval(-1, 1));
+  domains = newDomainElem(domains, strdup("y"), newInterval(2, 3));
+  domains = newDomainElem(domains, strdup("x"), newInterval(0, 1));
+
+  /* Test the convergence of branch and bound. */
+  {
+    printf("\n=== Branch and bound ===\n");
+    fflush(stdout);
+
+    /* x^2 - x over [0, 1]: interval evaluation gives [-1, 1] */
+    ExpTree *exp = newExpOp(EXP_SUB_OP, power(var("x"), "2"), var("x"));
+    Interval range = evaluateExpTree(exp, domains);
+    testRange(&range, -0.25, 0, 1);
+
+    /* Without a budget, nothing is bisected. */
+    BranchBoundBudget budget = newBranchBoundBudget(0, 0, 0);
+    Interval bounded = evaluateExpTreeBranchBound(exp, domains, &budget, NULL);
+    assert(bounded.left == range.left && bounded.right == range.right);
+
+    budget = newBranchBoundBudget(100, 0, 1e-3);
+    bounded = evaluateExpTreeBranchBound(exp, domains, &budget, NULL);
+    testRange(&bounded, -0.25, 0, 2e-3);
+
+    /* The tolerance is reached before the box budget runs out. */
+    budget = newBranchBoundBudget(100000, 0, 1e-2);
+    bounded = evaluateExpTreeBranchBound(exp, domains, &budget, NULL);
+    testRange(&bounded, -0.25, 0, 2e-2);
+
+    /* A time budget stops the search early, but the result is sound. */
+    budget = newBranchBoundBudget(100000, 1e-9, 0);
+    bounded = evaluateExpTreeBranchBound(exp, domains, &budget, NULL);
+    testRange(&bounded, -0.25, 0, 1);
+    delExpTree(exp);
+
+    /* (x - 0.5) * (y - 2.5) over x in [0, 1], y in [2, 3] */
+    exp = newExpOp(EXP_MUL_OP, newExpOp(EXP_SUB_OP, var("x"), num("0.5")),
+                   newExpOp(EXP_SUB_OP, var("y"), num("2.5")));
+    budget = newBranchBoundBudget(200, 0, 1e-3);
+    bounded = evaluateExpTreeBranchBound(exp, domains, &budget, NULL);
+    testRange(&bounded, -0.25, 0.25, 2e-3);
+    delExpTree(exp);
+  }
+
+  /* Test that the pool does not change the result. */
+  {
+    printf("\n=== Parallel branch and bound ===\n");
+    fflush(stdout);
+
+    ThreadPool *pool = newThreadPool(4);
+    ExpTree *exp = newExpOp(
+        EXP_SUB_OP, newExpOp(EXP_MUL_OP, var("x"), power(var("y"), "2")),
+        power(newExpOp(EXP_SUB_OP, var("x"), var("y")), "2"));
+    BranchBoundBudget budget = newBranchBoundBudget(500, 0, 1e-6);
+    Interval serial = evaluateExpTreeBranchBound(exp, domains, &budget, NULL);
+    Interval parallel = evaluateExpTreeBranchBound(exp, domains, &budget, pool);
+    assert(serial.left == parallel.left && serial.right == parallel.right);
+
+    /* x * y^2 - (x - y)^2 is increasing in x, so the range is
+      [-y^2, 2y - 1] over y in [2, 3], i.e. [-9, 5]. */
+    testRange(&serial, -9, 5, 0.1);
+
+    /* Clean */
+    delExpTree(exp);
+    delThreadPool(pool);
+  }
+
+  /* Test the branch-and-bound range bounder of TM arithmetic. */
+  {
+    printf("\n=== Branch-and-bound range bounder ===\n");
+    fflush(stdout);
+
+    /* Truncating x^3 - x^2 at order 1 moves it into the remainder. Its
+      range over [0, 1] is [-4/27, 0]. */
+    TaylorModel *tm = newTaylorModel(
+        strdup("x"),
+        newExpOp(EXP_SUB_OP, power(var("x"), "3"), power(var("x"), "2")),
+        newInterval(0, 0));
+    TaylorModel *truncated = truncateTM(tm, domains, 1);
+    testRange(&truncated->remainder, -4. / 27., 0, 1);
+    delTaylorModel(truncated);
+
+    setRangeBounder(RANGE_BOUNDER_BRANCH_BOUND);
+    truncated = truncateTM(tm, domains, 1);
+    testRange(&truncated->remainder, -4. / 27., 0, 0.1);
+    setRangeBounder(RANGE_BOUNDER_INTERVAL);
+
+    /* Clean */
+    delTaylorModel(truncated);
+    delTaylorModel(tm);
+  }
+
+  /* Clean */
+  delDomain(domains);
+
+  return EXIT_SUCCESS;
+}
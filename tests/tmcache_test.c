@@ -0,0 +1,202 @@
+#include "funexp.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "tmcache.h"
+#include "tmsplit.h"
+#include <assert.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/* x' = x * y; y' = -x * x */
+ODEList *newSystem(void) {
+  ODEList *system = newOdeList(
+      strdup("y"),
+      newExpOp(EXP_MUL_OP, newExpOp(EXP_NEG, var("x"), NULL), var("x")));
+  return newOdeElem(system, strdup("x"),
+                    newExpOp(EXP_MUL_OP, var("x"), var("y")));
+}
+
+/* Whether both lists hold the same Taylor models. */
+bool isEqualTM(const TaylorModel *left, const TaylorModel *right) {
+  for (; left != NULL && right != NULL;
+       left = left->next, right = right->next)
+    if (strcmp(left->fun, right->fun) != 0 ||
+        !isEqual(left->exp, right->exp) ||
+        left->remainder.left != right->remainder.left ||
+        left->remainder.right != right->remainder.right)
+      return false;
+  return left == NULL && right == NULL;
+}
+
+/* The path of the cache entry of the key. */
+void entryPath(char *path, const size_t size, const ODEList *system,
+               const unsigned int order, const unsigned int k) {
+  snprintf(path, size, "%s/%016llx%s", getExpansionCache(),
+           (unsigned long long)hashExpansionKey(system, order, k),
+           EXPANSION_CACHE_SUFFIX);
+}
+
+/* The number of files in the directory, except . and .. */
+unsigned int countFiles(const char *directory) {
+  DIR *dir = opendir(directory);
+  assert(dir != NULL);
+  unsigned int count = 0;
+  for (struct dirent *item; (item = readdir(dir)) != NULL;)
+    if (item->d_name[0] != '.')
+      ++count;
+  closedir(dir);
+  return count;
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  char directory[] = "/tmp/tmcache_test_XXXXXX";
+  assert(mkdtemp(directory) != NULL);
+  char path[512];
+  unsigned int hits, misses;
+
+  ODEList *system = newSystem();
+  TaylorExpansion *expected = newTaylorExpansion(system, 3, 3, NULL);
+  assert(expected->linear == NULL);
+
+  /* Test the hash of the key. */
+  {
+    printf("\n=== Key ===\n");
+    fflush(stdout);
+
+    ODEList *copy = newSystem();
+    assert(hashExpansionKey(system, 3, 3) == hashExpansionKey(copy, 3, 3));
+    assert(hashExpansionKey(system, 3, 3) != hashExpansionKey(system, 2, 3));
+    assert(hashExpansionKey(system, 3, 3) != hashExpansionKey(system, 3, 4));
+    assert(hashExpansionKey(system, 3, 3) !=
+           hashExpansionKey(system->next, 3, 3));
+    delOdeList(copy);
+  }
+
+  /* Test that expansions are stored and loaded transparently. */
+  {
+    printf("\n=== Lookups ===\n");
+    fflush(stdout);
+
+    assert(setExpansionCache(directory, EXPANSION_CACHE_MAX_BYTES) == 0);
+    TaylorExpansion *first = newTaylorExpansion(system, 3, 3, NULL);
+    expansionCacheStats(&hits, &misses);
+    assert(hits == 0 && misses == 1);
+    assert(countFiles(directory) == 1);
+
+    TaylorExpansion *second = newTaylorExpansion(system, 3, 3, NULL);
+    expansionCacheStats(&hits, &misses);
+    assert(hits == 1 && misses == 1);
+    assert(second->order == 3 && second->linear == NULL);
+    assert(isEqualTM(second->polynomials, expected->polynomials));
+    assert(isEqualTM(second->lagrangeTerms, expected->lagrangeTerms));
+
+    /* Another order is another entry. */
+    assert(loadCachedExpansion(system, 2, 3) == NULL);
+
+    /* A corrupted entry is a miss, and is replaced. */
+    entryPath(path, sizeof(path), system, 3, 3);
+    FILE *file = fopen(path, "r+");
+    assert(file != NULL);
+    fputs("garbage", file);
+    fclose(file);
+    assert(loadCachedExpansion(system, 3, 3) == NULL);
+    TaylorExpansion *third = newTaylorExpansion(system, 3, 3, NULL);
+    assert(isEqualTM(third->polynomials, expected->polynomials));
+    TaylorExpansion *fourth = loadCachedExpansion(system, 3, 3);
+    assert(fourth != NULL);
+
+    /* Clean */
+    delTaylorExpansion(fourth);
+    delTaylorExpansion(third);
+    delTaylorExpansion(second);
+    delTaylorExpansion(first);
+  }
+
+  /* Test the eviction of the least recently used entry. */
+  {
+    printf("\n=== Eviction ===\n");
+    fflush(stdout);
+
+    entryPath(path, sizeof(path), system, 3, 3);
+    struct stat info;
+    assert(stat(path, &info) == 0);
+
+    /* Room for one entry of order 3, then age it. */
+    assert(setExpansionCache(directory, (size_t)info.st_size) == 0);
+    struct timespec old[2] = {{1, 0}, {1, 0}};
+    assert(utimensat(AT_FDCWD, path, old, 0) == 0);
+
+    TaylorExpansion *lower = newTaylorExpansion(system, 2, 2, NULL);
+    assert(countFiles(directory) == 1);
+    assert(stat(path, &info) != 0);
+    entryPath(path, sizeof(path), system, 2, 2);
+    assert(stat(path, &info) == 0);
+
+    /* Clean */
+    delTaylorExpansion(lower);
+  }
+
+  /* Test that the temporaries of crashed writers are deleted once stale. */
+  {
+    printf("\n=== Stale temporaries ===\n");
+    fflush(stdout);
+
+    assert(setExpansionCache(directory, EXPANSION_CACHE_MAX_BYTES) == 0);
+    char stale[512], fresh[512];
+    snprintf(stale, sizeof(stale), "%s/0123456789abcdef.a1B2c3", directory);
+    snprintf(fresh, sizeof(fresh), "%s/0123456789abcdef.d4E5f6", directory);
+    fclose(fopen(stale, "w"));
+    fclose(fopen(fresh, "w"));
+    struct timespec old[2] = {{1, 0}, {1, 0}};
+    assert(utimensat(AT_FDCWD, stale, old, 0) == 0);
+
+    /* Storing an entry evicts. */
+    TaylorExpansion *lower = newTaylorExpansion(system, 1, 1, NULL);
+    struct stat info;
+    assert(stat(stale, &info) != 0);
+    assert(stat(fresh, &info) == 0);
+
+    /* Clean */
+    remove(fresh);
+    delTaylorExpansion(lower);
+  }
+
+  /* Test that a disabled cache is not consulted. */
+  {
+    printf("\n=== Disabled ===\n");
+    fflush(stdout);
+
+    assert(setExpansionCache(NULL, 0) == 0);
+    assert(getExpansionCache() == NULL);
+    assert(loadCachedExpansion(system, 2, 2) == NULL);
+    expansionCacheStats(&hits, &misses);
+    TaylorExpansion *plain = newTaylorExpansion(system, 3, 3, NULL);
+    unsigned int after;
+    expansionCacheStats(&after, NULL);
+    assert(after == hits);
+    delTaylorExpansion(plain);
+  }
+
+  /* Clean */
+  DIR *dir = opendir(directory);
+  for (struct dirent *item; (item = readdir(dir)) != NULL;)
+    if (item->d_name[0] != '.') {
+      snprintf(path, sizeof(path), "%s/%s", directory, item->d_name);
+      remove(path);
+    }
+  closedir(dir);
+  remove(directory);
+  delTaylorExpansion(expected);
+  delOdeList(system);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+#include "funexp.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "tmcentered.h"
+#include "variables.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  Domain *domains = newDomainElem(NULL, strdup("y"), newInterval(2, 3));
+  domains = newDomainElem(domains, strdup("x"), newInterval(0, 1));
+  const double expMax = exp(0.1) - 0.1;
+
+  /* Test the centered form. */
+  {
+    printf("\n=== Centered form ===\n");
+    fflush(stdout);
+
+    /* x^2 - x over [0, 1]: f(0.5) + [-1, 1] * [-0.5, 0.5] */
+    ExpTree *exp = newExpOp(EXP_SUB_OP, power(var("x"), "2"), var("x"));
+    Interval range = evaluateExpTreeCentered(exp, domains);
+    testRange(&range, -0.25, 0, 0.5);
+    testRange(&range, -0.75, 0.25, 1e-12);
+    delExpTree(exp);
+
+    /* e^x - x over [-0.1, 0.1] has range [1, e^0.1 - 0.1]. Interval
+      evaluation gives [e^-0.1 - 0.1, e^0.1 + 0.1], about 0.4 wide. */
+    Domain *small = newDomainElem(NULL, strdup("x"), newInterval(-0.1, 0.1));
+    exp = newExpOp(EXP_SUB_OP, fun("exp", var("x")), var("x"));
+    range = evaluateExpTree(exp, small);
+    testRange(&range, 1, expMax, 0.25);
+    range = evaluateExpTreeCentered(exp, small);
+    testRange(&range, 1, expMax, 0.015);
+    delExpTree(exp);
+    delDomain(small);
+  }
+
+  /* Test the monotonicity detection. */
+  {
+    printf("\n=== Monotonicity ===\n");
+    fflush(stdout);
+
+    /* x * y - x is increasing in both x and y, so the range is exact:
+      [f(0, 2), f(1, 3)] */
+    ExpTree *exp = newExpOp(EXP_SUB_OP,
+                            newExpOp(EXP_MUL_OP, var("x"), var("y")),
+                            var("x"));
+    Interval range = evaluateExpTree(exp, domains);
+    testRange(&range, 0, 2, 1);
+    range = evaluateExpTreeCentered(exp, domains);
+    testRange(&range, 0, 2, 1e-12);
+    delExpTree(exp);
+
+    /* y / x^2 over x in [1, 2] is decreasing in x, increasing in y */
+    Domain *positive = newDomainElem(NULL, strdup("y"), newInterval(2, 3));
+    positive = newDomainElem(positive, strdup("x"), newInterval(1, 2));
+    exp = newExpOp(EXP_DIV_OP, var("y"), power(var("x"), "2"));
+    range = evaluateExpTreeCentered(exp, positive);
+    testRange(&range, 0.5, 3, 1e-12);
+    delExpTree(exp);
+    delDomain(positive);
+
+    /* sin(x) is increasing over [0, 1] */
+    exp = fun("sin", var("x"));
+    range = evaluateExpTreeCentered(exp, domains);
+    testRange(&range, 0, sin(1.), 1e-12);
+    delExpTree(exp);
+  }
+
+  /* Test the cache of gradients. */
+  {
+    printf("\n=== Gradient cache ===\n");
+    fflush(stdout);
+
+    clearGradientCache();
+    unsigned int hits, misses;
+    ExpTree *exp = newExpOp(EXP_MUL_OP, var("x"),
+                            newExpOp(EXP_SUB_OP, var("y"), var("x")));
+    Interval first = evaluateExpTreeCentered(exp, domains);
+    gradientCacheStats(&hits, &misses);
+    assert(hits == 0 && misses == 1);
+
+    /* A copy of the tree hits the cache, over any box. */
+    ExpTree *copy = cpyExpTree(exp);
+    Interval second = evaluateExpTreeCentered(copy, domains);
+    assert(first.left == second.left && first.right == second.right);
+    Domain *other = newDomainElem(NULL, strdup("y"), newInterval(2, 4));
+    other = newDomainElem(other, strdup("x"), newInterval(0, 1));
+    evaluateExpTreeCentered(copy, other);
+    gradientCacheStats(&hits, &misses);
+    assert(hits == 2 && misses == 1);
+
+    clearGradientCache();
+    gradientCacheStats(&hits, &misses);
+    assert(hits == 0 && misses == 0);
+
+    /* Clean */
+    delDomain(other);
+    delExpTree(copy);
+    delExpTree(exp);
+  }
+
+  /* Test the centered form range bounder of TM arithmetic. */
+  {
+    printf("\n=== Centered form range bounder ===\n");
+    fflush(stdout);
+
+    /* Truncating x^3 - x^2 at order 1 moves it into the remainder. Its
+      range over [0.5, 0.6] is [-0.144, -0.125]. */
+    Domain *small = newDomainElem(NULL, strdup("x"), newInterval(0.5, 0.6));
+    TaylorModel *tm = newTaylorModel(
+        strdup("x"),
+        newExpOp(EXP_SUB_OP, power(var("x"), "3"), power(var("x"), "2")),
+        newInterval(0, 0));
+    TaylorModel *truncated = truncateTM(tm, small, 1);
+    testRange(&truncated->remainder, -0.144, -0.125, 0.1);
+    assert(intervalWidth(&truncated->remainder) > 0.15);
+    delTaylorModel(truncated);
+
+    setRangeBounder(RANGE_BOUNDER_CENTERED);
+    truncated = truncateTM(tm, small, 1);
+    testRange(&truncated->remainder, -0.144, -0.125, 0.015);
+    setRangeBounder(RANGE_BOUNDER_INTERVAL);
+
+    /* Clean */
+    delTaylorModel(truncated);
+    delTaylorModel(tm);
+    delDomain(small);
+    clearGradientCache();
+  }
+
+  /* Clean */
+  delDomain(domains);
+
+  return EXIT_SUCCESS;
+}
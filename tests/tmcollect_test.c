@@ -0,0 +1,142 @@
+#include "funexp.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "tmcollect.h"
+#include "variables.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  Domain *domain = newDomainElem(NULL, strdup("x"), newInterval(-1, 1));
+
+  /* Test that exact coefficients leave the remainder alone. */
+  {
+    printf("\n=== Exact coefficients ===\n");
+    fflush(stdout);
+
+    /* x + x * 3 - 1 */
+    TaylorModel *tm = newTaylorModel(
+        strdup("f"),
+        newExpOp(EXP_SUB_OP,
+                 newExpOp(EXP_ADD_OP, var("x"),
+                          newExpOp(EXP_MUL_OP, var("x"), num("3"))),
+                 num("1")),
+        newInterval(-0.5, 0.5));
+    TaylorModel *collected = collectTM(tm, domain);
+    printTaylorModel(collected, stdout);
+    printf("\n");
+    fflush(stdout);
+
+    ExpTree *expected =
+        newExpOp(EXP_ADD_OP, newExpOp(EXP_NEG, num("1"), NULL),
+                 newExpOp(EXP_MUL_OP, num("4"), var("x")));
+    assert(isEqual(collected->exp, expected));
+    assert(collected->remainder.left == -0.5);
+    assert(collected->remainder.right == 0.5);
+    assert(strcmp(collected->fun, "f") == 0);
+
+    /* Clean */
+    delExpTree(expected);
+    delTaylorModel(collected);
+    delTaylorModel(tm);
+  }
+
+  /* Test that rounded coefficients widen the remainder. */
+  {
+    printf("\n=== Rounded coefficients ===\n");
+    fflush(stdout);
+
+    /* 0.1 x + 0.2 x, whose double sum 0.30000000000000004 is not 0.3 */
+    TaylorModel *tm = newTaylorModel(
+        strdup("f"),
+        newExpOp(EXP_ADD_OP, newExpOp(EXP_MUL_OP, num("0.1"), var("x")),
+                 newExpOp(EXP_MUL_OP, num("0.2"), var("x"))),
+        newInterval(0, 0));
+    TaylorModel *collected = collectTM(tm, domain);
+    printTaylorModel(collected, stdout);
+    printf("\n");
+    fflush(stdout);
+
+    /* The gap 0.3 - c, over x in [-1, 1], is on both sides of zero. */
+    assert(collected->remainder.left < 0);
+    assert(collected->remainder.right > 0);
+    assert(intervalWidth(&collected->remainder) < 1e-15);
+
+    /* Clean */
+    delTaylorModel(collected);
+    delTaylorModel(tm);
+  }
+
+  /* Test that components that cannot be collected are copied. */
+  {
+    printf("\n=== Uncollected ===\n");
+    fflush(stdout);
+
+    /* sin(x), and y * y, where y has no domain */
+    TaylorModel *tm = newTMElem(
+        newTaylorModel(strdup("g"),
+                       newExpOp(EXP_MUL_OP, var("y"), num("0.1")),
+                       newInterval(0, 0)),
+        strdup("f"), newExpTree(EXP_FUN, strdup("sin"), var("x"), NULL),
+        newInterval(0, 0));
+    TaylorModel *collected = collectTM(tm, domain);
+    printTaylorModel(collected, stdout);
+    printf("\n");
+    fflush(stdout);
+
+    assert(isEqual(collected->exp, tm->exp));
+    assert(isEqual(collected->next->exp, tm->next->exp));
+    assert(strcmp(collected->next->fun, "g") == 0);
+    assert(collected->next->remainder.left == 0);
+    assert(collected->next->remainder.right == 0);
+
+    /* Clean */
+    delTaylorModel(collected);
+    delTaylorModel(tm);
+  }
+
+  /* Test that the rounding of the integrated coefficients is enclosed. */
+  {
+    printf("\n=== Primitive ===\n");
+    fflush(stdout);
+
+    /* int_0^t x + t^2 dt = x t + 1/3 t^3, where 1/3 rounds down */
+    Domain *variables =
+        newDomainElem(cpyDomain(domain), strdup("t"), newInterval(0, 1));
+    TaylorModel *tm = newTaylorModel(
+        strdup("f"),
+        newExpOp(EXP_ADD_OP, var("x"), power(var("t"), "2")),
+        newInterval(-0.5, 0.5));
+    TaylorModel *primitive = collectPrimitiveTM(tm, "t", variables);
+    printTaylorModel(primitive, stdout);
+    printf("\n");
+    fflush(stdout);
+
+    Polynomial *poly = toPolynomial(primitive->exp);
+    assert(poly->length == 2);
+    const double *coefficients = poly->coefficients;
+    assert(coefficients[0] == 1.0 / 3 || coefficients[1] == 1.0 / 3);
+    assert(coefficients[0] == 1 || coefficients[1] == 1);
+    /* I * [0, 1], widened towards the exact 1/3 - fl(1/3) > 0 */
+    assert(primitive->remainder.left <= -0.5);
+    assert(primitive->remainder.right > 0.5);
+    assert(intervalWidth(&primitive->remainder) < 1 + 1e-15);
+
+    /* Clean */
+    delPolynomial(poly);
+    delTaylorModel(primitive);
+    delTaylorModel(tm);
+    delDomain(variables);
+  }
+
+  /* Clean */
+  delDomain(domain);
+
+  return EXIT_SUCCESS;
+}
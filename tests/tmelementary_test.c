@@ -0,0 +1,162 @@
+#include "funexp.h"
+#include "taylormodel.h"
+#include "testhelpers.h"
+#include "variables.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLES 21
+
+/* Check that the TM of f over x in [a, b] (y = 0.25) encloses f at sample
+  points, and that its remainder is at most maxWidth wide. */
+void testEnclosure(const char *name, const TaylorModel *tm,
+                   double (*f)(double, double), Interval x, double maxWidth) {
+  printf("%s: ", name);
+  printTaylorModel(tm, stdout);
+  printf("\nremainder width: %g\n", intervalWidth(&tm->remainder));
+  fflush(stdout);
+  assert(intervalWidth(&tm->remainder) <= maxWidth);
+
+  for (unsigned int it = 0; it < SAMPLES; ++it) {
+    double point = x.left + it * (x.right - x.left) / (SAMPLES - 1);
+    Valuation *values = newValuation(strdup("y"), 0.25);
+    values = appValuationElem(values, newValuation(strdup("x"), point));
+    double poly = evaluateExpTreeReal(tm->exp, values);
+    double expected = f(point, 0.25);
+    /* The polynomial is evaluated in rounded arithmetic. */
+    double slack = 1e-14 * fmax(1, fabs(expected));
+    assert(poly + tm->remainder.left - slack <= expected);
+    assert(expected <= poly + tm->remainder.right + slack);
+    delValuation(values);
+  }
+}
+
+double sinX(double x, double y) { return (void)y, sin(x); }
+double cosX(double x, double y) { return (void)y, cos(x); }
+double expX(double x, double y) { return (void)y, exp(x); }
+double logX(double x, double y) { return (void)y, log(x); }
+double sqrtX(double x, double y) { return (void)y, sqrt(x); }
+double invX(double x, double y) { return (void)y, 1 / x; }
+double pendulum(double x, double y) { return -y - sin(x); }
+double nested(double x, double y) { return exp(sin(x + y)); }
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  const unsigned int k = 5;
+
+  /* Test each function on the identity TM of x. */
+  {
+    printf("\n=== Elementary TM functions ===\n");
+    fflush(stdout);
+
+    Interval x = newInterval(0.9, 1.1);
+    Domain *domain =
+        newDomainElem(NULL, strdup("y"), newInterval(0.25, 0.25));
+    domain = newDomainElem(domain, strdup("x"), x);
+    TaylorModel *identity =
+        newTaylorModel(strdup("x"), var("x"), newInterval(0, 0));
+
+    TaylorModel *tm = sinTM(identity, domain, k);
+    testEnclosure("sin", tm, sinX, x, 1e-8);
+    delTaylorModel(tm);
+    tm = cosTM(identity, domain, k);
+    testEnclosure("cos", tm, cosX, x, 1e-8);
+    delTaylorModel(tm);
+    tm = expTM(identity, domain, k);
+    testEnclosure("exp", tm, expX, x, 1e-8);
+    delTaylorModel(tm);
+    tm = logTM(identity, domain, k);
+    testEnclosure("log", tm, logX, x, 1e-6);
+    delTaylorModel(tm);
+    tm = sqrtTM(identity, domain, k);
+    testEnclosure("sqrt", tm, sqrtX, x, 1e-7);
+    delTaylorModel(tm);
+    tm = reciprocalTM(identity, domain, k);
+    testEnclosure("1/x", tm, invX, x, 1e-5);
+    delTaylorModel(tm);
+
+    /* A wider input remainder widens the output remainder. */
+    identity->remainder = newInterval(-1e-3, 1e-3);
+    tm = expTM(identity, domain, k);
+    assert(tm->remainder.left <= -exp(1.1) * 1e-3);
+    assert(exp(1.1) * 1e-3 <= tm->remainder.right);
+    delTaylorModel(tm);
+
+    delTaylorModel(identity);
+    delDomain(domain);
+  }
+
+  /* Test elementary functions in TM evaluation of vector fields. */
+  {
+    printf("\n=== Elementary TM evaluation ===\n");
+    fflush(stdout);
+
+    Interval x = newInterval(-0.2, 0.2);
+    Domain *domain =
+        newDomainElem(NULL, strdup("y"), newInterval(0.25, 0.25));
+    domain = newDomainElem(domain, strdup("x"), x);
+    TaylorModel *list =
+        newTaylorModel(strdup("y"), var("y"), newInterval(0, 0));
+    list = newTMElem(list, strdup("x"), var("x"), newInterval(0, 0));
+
+    /* The pendulum: y' = -y - sin(x) */
+    ExpTree *field = newExpOp(EXP_SUB_OP, newExpOp(EXP_NEG, var("y"), NULL),
+                              fun("sin", var("x")));
+    TaylorModel *tm = evaluateExpTreeTM(field, list, "y", domain, k);
+    testEnclosure("pendulum", tm, pendulum, x, 1e-6);
+    delTaylorModel(tm);
+    delExpTree(field);
+
+    /* Nested functions of several variables: exp(sin(x + y)) */
+    field = fun("exp", fun("sin", newExpOp(EXP_ADD_OP, var("x"), var("y"))));
+    tm = evaluateExpTreeTM(field, list, "x", domain, k);
+    testEnclosure("nested", tm, nested, x, 1e-3);
+    delTaylorModel(tm);
+    delExpTree(field);
+
+    delTaylorModel(list);
+    delDomain(domain);
+  }
+
+  /* Test that functions fail cleanly outside of their domain. */
+  {
+    printf("\n=== Domain errors ===\n");
+    fflush(stdout);
+
+    Domain *domain =
+        newDomainElem(NULL, strdup("y"), newInterval(0.25, 0.25));
+    domain = newDomainElem(domain, strdup("x"), newInterval(-0.5, 0.5));
+    TaylorModel *list =
+        newTaylorModel(strdup("y"), var("y"), newInterval(0, 0));
+    list = newTMElem(list, strdup("x"), var("x"), newInterval(0, 0));
+
+    /* The range of x contains 0, that of y does not. */
+    assert(reciprocalTM(list, domain, k) == NULL);
+    assert(logTM(list, domain, k) == NULL);
+    assert(sqrtTM(list, domain, k) == NULL);
+    assert(divTM(list, list, domain, k) == NULL);
+    TaylorModel *tm = divTM(list->next, list->next, domain, k);
+    assert(tm != NULL);
+    delTaylorModel(tm);
+
+    /* A remainder may bring 0 into the range as well. */
+    list->next->remainder = newInterval(-0.5, 0.5);
+    assert(divTM(list->next, list->next, domain, k) == NULL);
+
+    /* The failure propagates through the evaluation: exp(y / x). */
+    ExpTree *field = fun("exp", newExpOp(EXP_DIV_OP, var("y"), var("x")));
+    assert(evaluateExpTreeTM(field, list, "x", domain, k) == NULL);
+    delExpTree(field);
+
+    delTaylorModel(list);
+    delDomain(domain);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+#include "funexp.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "threadpool.h"
+#include "tmflowpipe.h"
+#include "transformations.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Two vectors are identical iff. they match exactly, component by component:
+  names, polynomial trees and remainders. */
+bool isIdenticalTM(const TaylorModel *actual, const TaylorModel *expected) {
+  if (actual == NULL && expected == NULL)
+    return true;
+  if ((actual == NULL) != (expected == NULL))
+    return false;
+  if (strcmp(actual->fun, expected->fun) != 0)
+    return false;
+  if (!isEqual(actual->exp, expected->exp))
+    return false;
+  if (actual->remainder.left != expected->remainder.left ||
+      actual->remainder.right != expected->remainder.right)
+    return false;
+  return isIdenticalTM(actual->next, expected->next);
+}
+
+void testIdenticalTM(TaylorModel *actual, TaylorModel *expected) {
+  bool compare = isIdenticalTM(actual, expected);
+  printf("actual:    ");
+  printTaylorModel(actual, stdout);
+  printf("\nexpect: ");
+  printTaylorModel(expected, stdout);
+  printf("\nequal:  %i\n\n", compare);
+  fflush(stdout);
+  assert(compare);
+}
+
+/* Build a coupled, n-dimensional system x_i' = x_{i+1} * x_i + x_{i-1}. */
+ODEList *coupledSystem(unsigned int dim) {
+  ODEList *sys = NULL;
+  for (unsigned int it = dim; it > 0; --it) {
+    char name[16];
+    char prev[16];
+    char next[16];
+    snprintf(name, sizeof(name), "x%u", it - 1);
+    snprintf(prev, sizeof(prev), "x%u", (it + dim - 2) % dim);
+    snprintf(next, sizeof(next), "x%u", it % dim);
+    ExpTree *exp = newExpOp(EXP_ADD_OP,
+                            newExpOp(EXP_MUL_OP, newExpLeaf(EXP_VAR, next),
+                                     newExpLeaf(EXP_VAR, name)),
+                            newExpLeaf(EXP_VAR, prev));
+    sys = newOdeElem(sys, strdup(name), exp);
+  }
+  return sys;
+}
+
+Domain *coupledDomain(unsigned int dim) {
+  Domain *domains = newDomainElem(NULL, strdup("t"), newInterval(0, 0.1));
+  for (unsigned int it = dim; it > 0; --it) {
+    char name[16];
+    snprintf(name, sizeof(name), "x%u", it - 1);
+    domains = newDomainElem(domains, strdup(name), newInterval(-0.5, 0.5));
+  }
+  return domains;
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  const unsigned int dim = 6;
+  const unsigned int k = 3;
+  ThreadPool *pool = newThreadPool(4);
+  ODEList *sys = coupledSystem(dim);
+  Domain *domains = coupledDomain(dim);
+
+  /* The parallel Lie derivatives and Taylor polynomials must match the
+    serial ones exactly, including the component order. */
+  {
+    printf("\n=== Parallel Lie derivatives ===\n");
+    fflush(stdout);
+
+    TaylorModel *seed = initTaylorModel(sys);
+    TaylorModel *serial = lieDerivativeK(sys, seed, 2);
+    TaylorModel *parallel = lieDerivativeKParallel(sys, seed, 2, pool);
+    testIdenticalTM(parallel, serial);
+
+    TaylorModel *subSerial = substituteTaylorModel(sys, serial);
+    TaylorModel *subParallel = substituteTaylorModelParallel(sys, serial, pool);
+    testIdenticalTM(subParallel, subSerial);
+
+    TaylorModel *polySerial = computeTaylorPolynomial(sys, k, k);
+    TaylorModel *polyParallel =
+        computeTaylorPolynomialParallel(sys, k, k, pool);
+    testIdenticalTM(polyParallel, polySerial);
+
+    /* Clean */
+    delTaylorModel(seed);
+    delTaylorModel(serial);
+    delTaylorModel(parallel);
+    delTaylorModel(subSerial);
+    delTaylorModel(subParallel);
+    delTaylorModel(polySerial);
+    delTaylorModel(polyParallel);
+  }
+
+  /* The parallel TM arithmetic must match the serial TM arithmetic. */
+  {
+    printf("\n=== Parallel TM arithmetic ===\n");
+    fflush(stdout);
+
+    /* TM arithmetic operates on sum of products polynomials. */
+    TaylorModel *seed = initTaylorModel(sys);
+    TaylorModel *left = lieDerivativeK(sys, seed, 2);
+    for (TaylorModel *tm = left; tm != NULL; tm = tm->next) {
+      ExpTree *sumOfProds = toSumOfProducts(tm->exp);
+      delExpTree(tm->exp);
+      tm->exp = sumOfProds;
+    }
+    TaylorModel *right = initTaylorModel(sys);
+    for (TaylorModel *tm = right; tm != NULL; tm = tm->next)
+      tm->remainder = newInterval(-0.01, 0.02);
+
+    TaylorModel *serial = addTM(left, right, domains, k);
+    TaylorModel *parallel = addTMParallel(left, right, domains, k, pool);
+    testIdenticalTM(parallel, serial);
+    delTaylorModel(serial);
+    delTaylorModel(parallel);
+
+    serial = subTM(left, right, domains, k);
+    parallel = subTMParallel(left, right, domains, k, pool);
+    testIdenticalTM(parallel, serial);
+    delTaylorModel(serial);
+    delTaylorModel(parallel);
+
+    serial = mulTM(left, right, domains, k);
+    parallel = mulTMParallel(left, right, domains, k, pool);
+    testIdenticalTM(parallel, serial);
+    delTaylorModel(serial);
+    delTaylorModel(parallel);
+
+    serial = truncateTM(left, domains, 1);
+    parallel = truncateTMParallel(left, domains, 1, pool);
+    testIdenticalTM(parallel, serial);
+    delTaylorModel(serial);
+    delTaylorModel(parallel);
+
+    /* Without a pool the parallel variants fall back to serial execution. */
+    serial = mulTM(left, right, domains, k);
+    parallel = mulTMParallel(left, right, domains, k, NULL);
+    testIdenticalTM(parallel, serial);
+    delTaylorModel(serial);
+    delTaylorModel(parallel);
+
+    /* Clean */
+    delTaylorModel(seed);
+    delTaylorModel(left);
+    delTaylorModel(right);
+  }
+
+  /* Clean */
+  delDomain(domains);
+  delOdeList(sys);
+  delThreadPool(pool);
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+#include "funexp.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "threadpool.h"
+#include "tmsplit.h"
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool isIdenticalInterval(const Interval *actual, const Interval *expected) {
+  return actual->left == expected->left && actual->right == expected->right;
+}
+
+/* Two collections are identical iff. they have the same boxes and
+  remainders, in the same order. */
+bool isIdenticalSplit(const FlowpipeSegment *actual,
+                      const FlowpipeSegment *expected) {
+  for (; actual != NULL && expected != NULL;
+       actual = actual->next, expected = expected->next) {
+    const Domain *a = actual->domain;
+    const Domain *e = expected->domain;
+    for (; a != NULL && e != NULL; a = a->next, e = e->next)
+      if (strcmp(a->var, e->var) != 0 ||
+          !isIdenticalInterval(&a->domain, &e->domain))
+        return false;
+    if (a != NULL || e != NULL)
+      return false;
+
+    const TaylorModel *at = actual->flowpipe;
+    const TaylorModel *et = expected->flowpipe;
+    for (; at != NULL && et != NULL; at = at->next, et = et->next)
+      if (!isIdenticalInterval(&at->remainder, &et->remainder))
+        return false;
+    if (at != NULL || et != NULL)
+      return false;
+  }
+  return actual == NULL && expected == NULL;
+}
+
+/* The volume of the box, ignoring the time domain. */
+double boxVolume(const Domain *box) {
+  double volume = 1;
+  for (; box != NULL; box = box->next)
+    if (strcmp(box->var, VAR_TIME) != 0)
+      volume *= intervalWidth(&box->domain);
+  return volume;
+}
+
+/* The segments must cover the whole initial set, and each segment must
+  either be narrow enough or be as deep as allowed. */
+void testCover(const FlowpipeSegment *segments, const Domain *domain,
+               double threshold, unsigned int maxDepth) {
+  double volume = 0;
+  for (const FlowpipeSegment *seg = segments; seg != NULL; seg = seg->next) {
+    volume += boxVolume(seg->domain);
+    assert(widestRemainder(seg->flowpipe) <= threshold ||
+           seg->depth == maxDepth);
+  }
+  printf("segments: %u\n", lengthFlowpipeSegment(segments));
+  printf("Expect: %f\n", boxVolume(domain));
+  printf("Actual:    %f\n\n", volume);
+  fflush(stdout);
+  assert(fabs(volume - boxVolume(domain)) < 1e-12);
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  ThreadPool *pool = newThreadPool(4);
+
+  /* x' = 1 + y; y' = x^2 */
+  ODEList *sys = newOdeElem(
+      NULL, strdup("y"),
+      newExpOp(EXP_EXP_OP, newExpLeaf(EXP_VAR, "x"), newExpLeaf(EXP_NUM, "2")));
+  sys = newOdeElem(sys, strdup("x"),
+                   newExpOp(EXP_ADD_OP, newExpLeaf(EXP_NUM, "1"),
+                            newExpLeaf(EXP_VAR, "y")));
+  Domain *domain = newDomainElem(NULL, strdup("t"), newInterval(0, 0.5));
+  domain = newDomainElem(domain, strdup("y"), newInterval(-0.5, 0.5));
+  domain = newDomainElem(domain, strdup("x"), newInterval(-2, 2));
+
+  /* A loose threshold does not split at all. */
+  {
+    printf("\n=== No splitting ===\n");
+    fflush(stdout);
+
+    FlowpipeSegment *segments =
+        computeSplitFlowpipe(sys, domain, 3, 3, 1e9, 8, SPLIT_WIDEST, pool);
+    printFlowpipeSegment(segments, stdout);
+    assert(lengthFlowpipeSegment(segments) == 1);
+    assert(segments->depth == 0);
+    testCover(segments, domain, 1e9, 8);
+    delFlowpipeSegment(segments);
+  }
+
+  /* A tight threshold splits, the pieces have narrower remainders, and the
+    result does not depend on the pool. */
+  {
+    printf("\n=== Widest dimension splitting ===\n");
+    fflush(stdout);
+
+    FlowpipeSegment *whole =
+        computeSplitFlowpipe(sys, domain, 3, 3, 1e9, 0, SPLIT_WIDEST, NULL);
+    const double threshold = widestRemainder(whole->flowpipe) / 8;
+
+    FlowpipeSegment *serial = computeSplitFlowpipe(sys, domain, 3, 3, threshold,
+                                                   6, SPLIT_WIDEST, NULL);
+    FlowpipeSegment *parallel = computeSplitFlowpipe(
+        sys, domain, 3, 3, threshold, 6, SPLIT_WIDEST, pool);
+    testCover(parallel, domain, threshold, 6);
+    assert(lengthFlowpipeSegment(parallel) > 1);
+    assert(isIdenticalSplit(parallel, serial));
+
+    /* The first bisection halves x, the widest state variable. */
+    assert(parallel->domain->domain.left == -2);
+    assert(parallel->domain->domain.right <= 0);
+
+    delFlowpipeSegment(whole);
+    delFlowpipeSegment(serial);
+    delFlowpipeSegment(parallel);
+  }
+
+  {
+    printf("\n=== Most sensitive dimension splitting ===\n");
+    fflush(stdout);
+
+    FlowpipeSegment *serial = computeSplitFlowpipe(sys, domain, 3, 3, 0.05, 5,
+                                                   SPLIT_SENSITIVE, NULL);
+    FlowpipeSegment *parallel = computeSplitFlowpipe(sys, domain, 3, 3, 0.05,
+                                                     5, SPLIT_SENSITIVE, pool);
+    testCover(parallel, domain, 0.05, 5);
+    assert(isIdenticalSplit(parallel, serial));
+
+    delFlowpipeSegment(serial);
+    delFlowpipeSegment(parallel);
+  }
+
+  /* Clean */
+  delDomain(domain);
+  delOdeList(sys);
+  delThreadPool(pool);
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+#include "intervalbox.h"
+#include "odeparse.h"
+#include "sysode.h"
+#include "taylormodel.h"
+#include "threadpool.h"
+#include "tmsplit.h"
+#include "tmsweep.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SWEEP_POINTS 5
+
+bool isIdenticalInterval(const Interval *actual, const Interval *expected) {
+  return actual->left == expected->left && actual->right == expected->right;
+}
+
+/* Two collections are identical iff. they have the same boxes, polynomials
+  and remainders, in the same order. */
+bool isIdenticalSplit(const FlowpipeSegment *actual,
+                      const FlowpipeSegment *expected) {
+  for (; actual != NULL && expected != NULL;
+       actual = actual->next, expected = expected->next) {
+    const Domain *a = actual->domain;
+    const Domain *e = expected->domain;
+    for (; a != NULL && e != NULL; a = a->next, e = e->next)
+      if (strcmp(a->var, e->var) != 0 ||
+          !isIdenticalInterval(&a->domain, &e->domain))
+        return false;
+    if (a != NULL || e != NULL)
+      return false;
+
+    const TaylorModel *at = actual->flowpipe;
+    const TaylorModel *et = expected->flowpipe;
+    for (; at != NULL && et != NULL; at = at->next, et = et->next)
+      if (!isEqual(at->exp, et->exp) ||
+          !isIdenticalInterval(&at->remainder, &et->remainder))
+        return false;
+    if (at != NULL || et != NULL)
+      return false;
+  }
+  return actual == NULL && expected == NULL;
+}
+
+ODEList *parse(const char *str) {
+  ODEList *list = NULL;
+  int res = parseOdeString(str, &list);
+  assert(res == 0);
+  return list;
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  ThreadPool *pool = newThreadPool(4);
+
+  /* Van der Pol, with the damping mu as a parameter */
+  const char vdp[] = "param mu; x' = y; y' = mu * (1 - x^2) * y - x;";
+  ODEList *system = parse(vdp);
+  TaylorExpansion *expansion = newTaylorExpansion(system, 3, 3, pool);
+  assert(expansion->linear == NULL);
+
+  Domain *domain = newDomainElem(NULL, strdup(VAR_TIME), newInterval(0, 0.1));
+  domain = newDomainElem(domain, strdup("y"), newInterval(-0.1, 0.1));
+  domain = newDomainElem(domain, strdup("x"), newInterval(0.9, 1.1));
+
+  /* Test that the declared parameters are reported, and may not be state
+    variables. */
+  {
+    printf("\n=== Declarations ===\n");
+    fflush(stdout);
+
+    OdeParser *parser = newOdeParser();
+    ODEList *list = NULL;
+    assert(parseOdeStringWith(parser, "param a, b; param c; x' = a;",
+                              &list) == 0);
+    const SymbolTable *parameters = odeParserParameters(parser);
+    assert(parameters->length == 3);
+    assert(findSymbol(parameters, "b") != SYMBOL_NOT_FOUND);
+    assert(findSymbol(parameters, "x") == SYMBOL_NOT_FOUND);
+    delOdeList(list);
+
+    assert(parseOdeStringWith(parser, "param x; x' = 1;", &list) != 0);
+    assert(parseOdeStringWith(parser, "parm a; x' = a;", &list) != 0);
+    assert(parseOdeStringWith(parser, "x' = 1;", &list) == 0);
+    assert(odeParserParameters(parser)->length == 0);
+    delOdeList(list);
+
+    /* param is not reserved: systems that use it as a name still parse. */
+    assert(parseOdeStringWith(parser, "param' = -param; x' = param(x);",
+                              &list) == 0);
+    assert(odeParserParameters(parser)->length == 0);
+    /* The list is in reverse order of the input. */
+    assert(strcmp(list->next->fun, "param") == 0);
+    assert(list->next->exp->type == EXP_NEG);
+    assert(strcmp(list->next->exp->left->data, "param") == 0);
+    assert(list->exp->type == EXP_FUN);
+    assert(strcmp(list->exp->data, "param") == 0);
+    delOdeList(list);
+    assert(parseOdeStringWith(parser, "param param; x' = param * x;",
+                              &list) == 0);
+    assert(findSymbol(odeParserParameters(parser), "param") !=
+           SYMBOL_NOT_FOUND);
+
+    /* Clean */
+    delOdeList(list);
+    delOdeParser(parser);
+  }
+
+  /* Test that binding a parameter is the same as writing its value. */
+  {
+    printf("\n=== Binding ===\n");
+    fflush(stdout);
+
+    Valuation *half = newValuation(strdup("mu"), 0.5);
+    FlowpipeSegment **swept = sweepTaylorExpansion(
+        expansion, domain, &half, 1, 1e-3, 2, SPLIT_WIDEST, pool);
+
+    ODEList *written = parse("x' = y; y' = 0.5 * (1 - x^2) * y - x;");
+    FlowpipeSegment *expected = computeSplitFlowpipe(
+        written, domain, 3, 3, 1e-3, 2, SPLIT_WIDEST, pool);
+    printFlowpipeSegment(swept[0], stdout);
+    assert(isIdenticalSplit(swept[0], expected));
+
+    /* Clean */
+    delFlowpipeSegment(expected);
+    delOdeList(written);
+    delFlowpipeSegment(swept[0]);
+    free(swept);
+    delValuation(half);
+  }
+
+  /* Test that a sweep is the same with and without a pool. */
+  {
+    printf("\n=== Sweep ===\n");
+    fflush(stdout);
+
+    Valuation *points[SWEEP_POINTS];
+    for (unsigned int it = 0; it < SWEEP_POINTS; ++it)
+      points[it] = newValuation(strdup("mu"), (double)it - 1);
+
+    FlowpipeSegment **parallel = sweepTaylorExpansion(
+        expansion, domain, points, SWEEP_POINTS, 1e-3, 2, SPLIT_WIDEST, pool);
+    FlowpipeSegment **serial = sweepTaylorExpansion(
+        expansion, domain, points, SWEEP_POINTS, 1e-3, 2, SPLIT_WIDEST, NULL);
+    for (unsigned int it = 0; it < SWEEP_POINTS; ++it) {
+      printf("mu = %g: %u segments, widest remainder %g\n", points[it]->val,
+             lengthFlowpipeSegment(parallel[it]),
+             widestRemainder(parallel[it]->flowpipe));
+      assert(isIdenticalSplit(parallel[it], serial[it]));
+    }
+
+    /* Distinct values give distinct flowpipes. */
+    assert(!isIdenticalSplit(parallel[0], parallel[SWEEP_POINTS - 1]));
+
+    /* Clean */
+    for (unsigned int it = 0; it < SWEEP_POINTS; ++it) {
+      delFlowpipeSegment(parallel[it]);
+      delFlowpipeSegment(serial[it]);
+      delValuation(points[it]);
+    }
+    free(parallel);
+    free(serial);
+  }
+
+  /* Clean */
+  delDomain(domain);
+  delTaylorExpansion(expansion);
+  delOdeList(system);
+  delThreadPool(pool);
+
+  return EXIT_SUCCESS;
+}
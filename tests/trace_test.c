@@ -0,0 +1,148 @@
+#include "odeparse.h"
+#include "taylormodel.h"
+#include "threadpool.h"
+#include "tmflowpipe.h"
+#include "trace.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ORDER 3
+
+/* Write the trace into a newly heap-allocated string. */
+char *traceString(void) {
+  FILE *file = tmpfile();
+  assert(file != NULL);
+  writeTrace(file);
+  long length = ftell(file);
+  rewind(file);
+  char *trace = (char *)malloc(length + 1);
+  assert(fread(trace, 1, length, file) == (size_t)length);
+  trace[length] = '\0';
+  fclose(file);
+  return trace;
+}
+
+/* The number of events of the given name in the trace. */
+unsigned int countSpans(const char *trace, const char *name) {
+  char key[100];
+  snprintf(key, sizeof(key), "\"name\":\"%s\"", name);
+  unsigned int count = 0;
+  for (const char *it = strstr(trace, key); it != NULL;
+       it = strstr(it + 1, key))
+    ++count;
+  return count;
+}
+
+int main(int argc, char *argv[]) {
+  /* to avoid silly warnings about unused parameters */
+  (void)argc;
+  (void)argv;
+
+  ThreadPool *pool = newThreadPool(4);
+  Domain *domain = newDomainElem(NULL, strdup("y"), newInterval(-1, 1));
+  domain = newDomainElem(domain, strdup("x"), newInterval(-1, 1));
+
+  /* Test that nothing is recorded while tracing is off. */
+  {
+    printf("\n=== Off ===\n");
+    fflush(stdout);
+
+    setTraceEnabled(false);
+    assert(!traceEnabled());
+    ODEList *system = NULL;
+    assert(parseOdeString("x' = y; y' = -x;", &system) == 0);
+    TaylorModel *polynomials = computeTaylorPolynomial(system, ORDER, ORDER);
+
+    char *trace = traceString();
+    assert(countSpans(trace, "parseOdes") == 0);
+    assert(countSpans(trace, "computeTaylorPolynomial") == 0);
+
+    /* Clean */
+    free(trace);
+    delTaylorModel(polynomials);
+    delOdeList(system);
+  }
+
+  /* Test that the pipeline stages are recorded, once per order. */
+  {
+    printf("\n=== Stages ===\n");
+    fflush(stdout);
+
+    setTraceEnabled(true);
+    assert(traceEnabled());
+    ODEList *system = NULL;
+    assert(parseOdeString("x' = y; y' = (1 - x^2) * y - x;", &system) == 0);
+    TaylorModel *polynomials =
+        computeTaylorPolynomialParallel(system, ORDER, ORDER, pool);
+    TaylorModel *seed = initTaylorModel(system);
+    TaylorModel *product = mulTMParallel(seed, seed, domain, ORDER, pool);
+
+    char *trace = traceString();
+    printf("%s", trace);
+    assert(strncmp(trace, "{\"traceEvents\":[", 16) == 0);
+    assert(countSpans(trace, "parseOdes") == 1);
+    assert(countSpans(trace, "computeTaylorPolynomial") == 1);
+    assert(countSpans(trace, "lieDerivativeK") == ORDER);
+    assert(strstr(trace, "\"args\":{\"order\":3}") != NULL);
+    assert(countSpans(trace, "mulTM") == 1);
+
+    /* Clean */
+    free(trace);
+    delTaylorModel(product);
+    delTaylorModel(seed);
+    delTaylorModel(polynomials);
+    delOdeList(system);
+  }
+
+  /* Test that every vector operation is a single span, regardless of the
+    number of components. */
+  {
+    printf("\n=== Vector operations ===\n");
+    fflush(stdout);
+
+    clearTrace();
+    TaylorModel *left =
+        newTMElem(newTaylorModel(strdup("y"), newExpLeaf(EXP_VAR, "y"),
+                                 newInterval(0, 0)),
+                  strdup("x"), newExpLeaf(EXP_VAR, "x"), newInterval(0, 0));
+    TaylorModel *sum = addTM(left, left, domain, ORDER);
+    TaylorModel *negated = negTM(left, domain, ORDER);
+    TaylorModel *sine = sinTM(left, domain, ORDER);
+
+    char *trace = traceString();
+    assert(countSpans(trace, "addTM") == 1);
+    assert(countSpans(trace, "negTM") == 1);
+    assert(countSpans(trace, "sinTM") == 1);
+    /* The components truncate inside the kernels, not as vectors. */
+    assert(countSpans(trace, "truncateTM") == 0);
+
+    /* Clean */
+    free(trace);
+    delTaylorModel(sine);
+    delTaylorModel(negated);
+    delTaylorModel(sum);
+    delTaylorModel(left);
+  }
+
+  /* Test that clearing forgets all spans. */
+  {
+    printf("\n=== Clear ===\n");
+    fflush(stdout);
+
+    clearTrace();
+    char *trace = traceString();
+    assert(strstr(trace, "\"name\"") == NULL);
+
+    /* Clean */
+    free(trace);
+  }
+
+  /* Clean */
+  setTraceEnabled(false);
+  delDomain(domain);
+  delThreadPool(pool);
+
+  return EXIT_SUCCESS;
+}
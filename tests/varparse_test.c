@@ -37,7 +37,36 @@ int main(int argc, char *argv[]) {
   fflush(stdout);
   assert(strcmp(buffer, msg) == 0);
 
-  /* clean */
+  /* Test that a parser can be reused, and that it reports the line of a
+    syntax error. */
+  VarParser *parser = newVarParser();
+  Domain *other = NULL;
+  res = parseVarStringWith(parser, "x in [0, 1];\ny in [0 1];", &other);
+  assert(res != 0);
+  assert(varParserErrorLine(parser) == 2);
+  res = parseVarStringWith(parser, "z in [-1, 1];", &other);
+  assert(res == 0);
+  assert(varParserErrorLine(parser) == 0);
+  assert(other != NULL && strcmp(other->var, "z") == 0);
+  assert(other->domain.left == -1 && other->domain.right == 1);
+
+  delDomain(other);
+
+  /* Test parsing a mapped file. */
+  FILE *file = tmpfile();
+  assert(file != NULL);
+  fputs("x in [0, 1];\ny in [2, 3];", file);
+  fflush(file);
+  res = parseVarFdWith(parser, fileno(file), &other);
+  assert(res == 0);
+  assert(other != NULL && strcmp(other->var, "y") == 0);
+  assert(other->domain.left == 2 && other->domain.right == 3);
+
+  /* Clean */
+  fclose(file);
+  delDomain(other);
+  delVarParser(parser);
   delDomain(list);
+
   return 0;
 }